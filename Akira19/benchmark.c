@@ -0,0 +1,1403 @@
+/*
+* benchmark.c
+* ชุดวัดประสิทธิภาพของระบบจำลองการจราจร
+*/
+
+#include "benchmark.h"
+#include <string.h>
+#include <math.h>
+#include "graph.h"
+#include "route.h"
+#include "integer_route.h"
+#include "landmark.h"
+#include "hub_label.h"
+#include "isochrone.h"
+#include "traffic_signal.h"
+#include "simulation.h"
+#include "thread_pool.h"
+#include "event_engine.h"
+#include "link_model.h"
+#include "reroute.h"
+#include "demand.h"
+#include "checkpoint.h"
+#include "recorder.h"
+#include "junction_queue.h"
+#include "ensemble.h"
+#include "max_pressure.h"
+#include "green_wave.h"
+#include "wall_clock.h"
+#include <float.h>
+
+// ฟังก์ชันสำหรับสุ่มการจราจรบนถนนทุกเส้นเพื่อให้น้ำหนักของเส้นเชื่อมแตกต่างกัน
+static void randomize_road_loads(Graph* graph, unsigned int seed) {
+    for (int i = 0; i < graph->num_vertices; i++) {
+        Edge* current = graph->vertices[i].head;
+        while (current != NULL) {
+            seed = seed * 1103515245u + 12345u;
+            graph->edge_loads[current->id] = (int)((seed >> 8) % (unsigned int)(current->road->capacity + 1));
+            current = current->next;
+        }
+    }
+    refresh_junction_loads(graph);
+    update_edge_weight(graph);
+}
+
+// ฟังก์ชันสำหรับสุ่มคู่ต้นทางและปลายทางของการค้นหาเส้นทาง
+static void generate_queries(Graph* graph, int num_queries, int* sources, int* targets, unsigned int seed) {
+    for (int i = 0; i < num_queries; i++) {
+        seed = seed * 1103515245u + 12345u;
+        sources[i] = (int)((seed >> 8) % (unsigned int)graph->num_vertices);
+        seed = seed * 1103515245u + 12345u;
+        targets[i] = (int)((seed >> 8) % (unsigned int)graph->num_vertices);
+    }
+}
+
+// ฟังก์ชันสำหรับจับเวลาการค้นหาเส้นทางแบบจำนวนเต็ม (คืนค่าจำนวนการค้นหาต่อวินาที)
+static double time_integer_queries(Graph* graph, IntegerCostTable* table, IntQueueType queue_type,
+                                   int num_queries, int* sources, int* targets) {
+    double start = monotonic_seconds();
+    for (int i = 0; i < num_queries; i++) {
+        free_route(find_shortest_path_int(graph, table, sources[i], targets[i], queue_type));
+    }
+    double elapsed = monotonic_seconds() - start;
+    return (elapsed > 0.0) ? num_queries / elapsed : 0.0;
+}
+
+// ฟังก์ชันสำหรับวัดประสิทธิภาพการค้นหาเส้นทางแบบจำนวนเต็มเทียบกับแบบทศนิยม
+void benchmark_integer_routing(int rows, int cols, int num_queries) {
+    printf("\n=== Benchmark: Integer Routing (%dx%d grid, %d queries) ===\n", rows, cols, num_queries);
+    
+    Graph* graph = create_grid_network(rows, cols, 42);
+    int* sources = (int*)malloc(num_queries * sizeof(int));
+    int* targets = (int*)malloc(num_queries * sizeof(int));
+    if (sources == NULL || targets == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for benchmark queries\n");
+        exit(1);
+    }
+    generate_queries(graph, num_queries, sources, targets, 7);
+    
+    const char* scenarios[2] = {"Free flow", "Congested"};
+    for (int s = 0; s < 2; s++) {
+        if (s == 1) {
+            randomize_road_loads(graph, 99);
+        }
+        
+        IntegerCostTable* table = create_integer_cost_table(graph);
+        printf("\n%s (max edge cost: %u deciseconds):\n", scenarios[s], table->max_edge_cost);
+        
+        double start = monotonic_seconds();
+        for (int i = 0; i < num_queries; i++) {
+            free_route(find_shortest_path(graph, sources[i], targets[i]));
+        }
+        double elapsed = monotonic_seconds() - start;
+        printf("  Float Dijkstra (binary heap): %.0f queries/s\n",
+               (elapsed > 0.0) ? num_queries / elapsed : 0.0);
+        
+        printf("  Integer Dijkstra (radix heap): %.0f queries/s\n",
+               time_integer_queries(graph, table, INT_QUEUE_RADIX_HEAP, num_queries, sources, targets));
+        
+        if (choose_integer_queue(table) == INT_QUEUE_DIAL) {
+            printf("  Integer Dijkstra (Dial buckets): %.0f queries/s\n",
+                   time_integer_queries(graph, table, INT_QUEUE_DIAL, num_queries, sources, targets));
+        } else {
+            printf("  Integer Dijkstra (Dial buckets): n/a (cost range exceeds %d buckets)\n", DIAL_MAX_BUCKETS);
+        }
+        
+        check_integer_route_accuracy(graph, table, (num_queries < 200) ? num_queries : 200, 11);
+        
+        free_integer_cost_table(table);
+    }
+    
+    free(sources);
+    free(targets);
+    free_graph(graph);
+}
+
+// ฟังก์ชันสำหรับจับเวลาการค้นหาเส้นทาง (คืนค่าจำนวนการค้นหาต่อวินาที และเก็บเวลาเดินทางของแต่ละเส้นทาง)
+static double time_path_queries(Graph* graph, bool optimal, int num_queries, int* sources, int* targets,
+                                float* total_times) {
+    double start = monotonic_seconds();
+    for (int i = 0; i < num_queries; i++) {
+        Route* route = optimal ?
+            find_optimal_path(graph, sources[i], targets[i], 0.6f, 0.2f, 0.2f) :
+            find_shortest_path(graph, sources[i], targets[i]);
+        total_times[i] = route->total_time;
+        free_route(route);
+    }
+    double elapsed = monotonic_seconds() - start;
+    return (elapsed > 0.0) ? num_queries / elapsed : 0.0;
+}
+
+// ฟังก์ชันสำหรับวัดประสิทธิภาพการค้นหาเส้นทางแบบ ALT เทียบกับ Dijkstra
+void benchmark_alt_routing(int rows, int cols, int num_queries, int num_landmarks) {
+    printf("\n=== Benchmark: ALT Routing (%dx%d grid, %d queries, %d landmarks) ===\n",
+           rows, cols, num_queries, num_landmarks);
+    
+    Graph* graph = create_grid_network(rows, cols, 42);
+    randomize_road_loads(graph, 99);
+    
+    int* sources = (int*)malloc(num_queries * sizeof(int));
+    int* targets = (int*)malloc(num_queries * sizeof(int));
+    float* dijkstra_times = (float*)malloc(num_queries * sizeof(float));
+    float* alt_times = (float*)malloc(num_queries * sizeof(float));
+    if (sources == NULL || targets == NULL || dijkstra_times == NULL || alt_times == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for benchmark queries\n");
+        exit(1);
+    }
+    generate_queries(graph, num_queries, sources, targets, 7);
+    
+    const char* strategy_names[2] = {"farthest", "avoid"};
+    LandmarkStrategy strategies[2] = {LANDMARK_FARTHEST, LANDMARK_AVOID};
+    
+    for (int m = 0; m < 2; m++) {
+        bool optimal = (m == 1);
+        printf("\n%s:\n", optimal ? "find_optimal_path (0.6, 0.2, 0.2)" : "find_shortest_path");
+        
+        graph->landmarks = NULL;
+        printf("  Dijkstra: %.0f queries/s\n",
+               time_path_queries(graph, optimal, num_queries, sources, targets, dijkstra_times));
+        
+        for (int s = 0; s < 2; s++) {
+            double start = monotonic_seconds();
+            LandmarkSet* landmarks = optimal ?
+                create_landmark_set(graph, num_landmarks, strategies[s], 0.6f, 0.2f) :
+                create_landmark_set(graph, num_landmarks, strategies[s], 1.0f, 0.0f);
+            double preprocessing = monotonic_seconds() - start;
+            
+            graph->landmarks = landmarks;
+            double rate = time_path_queries(graph, optimal, num_queries, sources, targets, alt_times);
+            graph->landmarks = NULL;
+            
+            int mismatched = 0;
+            for (int i = 0; i < num_queries; i++) {
+                if (fabsf(alt_times[i] - dijkstra_times[i]) > 1e-4f * dijkstra_times[i]) {
+                    mismatched++;
+                }
+            }
+            
+            printf("  ALT (%s, preprocessing %.3f s): %.0f queries/s, %d mismatched routes\n",
+                   strategy_names[s], preprocessing, rate, mismatched);
+            
+            if (m == 0 && s == 1) {
+                print_landmark_memory_report(landmarks);
+            }
+            
+            free_landmark_set(landmarks);
+        }
+    }
+    
+    free(sources);
+    free(targets);
+    free(dijkstra_times);
+    free(alt_times);
+    free_graph(graph);
+}
+
+// ฟังก์ชันสำหรับวัดประสิทธิภาพการหาเวลาเดินทางด้วยป้ายกำกับฮับ
+void benchmark_hub_labels(int rows, int cols, int num_queries) {
+    printf("\n=== Benchmark: Hub Labels (%dx%d grid, %d queries) ===\n", rows, cols, num_queries);
+    
+    Graph* graph = create_grid_network(rows, cols, 42);
+    randomize_road_loads(graph, 99);
+    
+    int* sources = (int*)malloc(num_queries * sizeof(int));
+    int* targets = (int*)malloc(num_queries * sizeof(int));
+    float* label_eta = (float*)malloc(num_queries * sizeof(float));
+    if (sources == NULL || targets == NULL || label_eta == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for benchmark queries\n");
+        exit(1);
+    }
+    generate_queries(graph, num_queries, sources, targets, 7);
+    
+    double start = monotonic_seconds();
+    HubLabels* labels = create_hub_labels(graph, 0);
+    printf("Construction time: %.3f s\n", monotonic_seconds() - start);
+    print_hub_label_statistics(labels);
+    
+    // วนซ้ำหลายรอบเพื่อให้จับเวลาได้แม่นยำ
+    int rounds = 100;
+    start = monotonic_seconds();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < num_queries; i++) {
+            label_eta[i] = query_eta(labels, graph, sources[i], targets[i]);
+        }
+    }
+    double label_time = (monotonic_seconds() - start) / ((double)rounds * num_queries);
+    
+    int mismatched = 0;
+    start = monotonic_seconds();
+    for (int i = 0; i < num_queries; i++) {
+        Route* route = find_shortest_path(graph, sources[i], targets[i]);
+        float exact = (route->path[0] == sources[i]) ? route->total_time : FLT_MAX;
+        if (fabsf(exact - label_eta[i]) > 1e-4f * exact) {
+            mismatched++;
+        }
+        free_route(route);
+    }
+    double dijkstra_time = (monotonic_seconds() - start) / num_queries;
+    
+    printf("Hub label ETA query: %.3f us/query\n", label_time * 1e6);
+    printf("Dijkstra route query: %.3f us/query\n", dijkstra_time * 1e6);
+    printf("Mismatched ETAs: %d / %d\n", mismatched, num_queries);
+    
+    // เมื่อการจราจรเปลี่ยน ป้ายกำกับจะล้าสมัยและต้องใช้ route.c แทน
+    randomize_road_loads(graph, 123);
+    start = monotonic_seconds();
+    for (int i = 0; i < num_queries; i++) {
+        query_eta(labels, graph, sources[i], targets[i]);
+    }
+    printf("Stale labels (fallback to route search): %.3f us/query\n",
+           (monotonic_seconds() - start) / num_queries * 1e6);
+    
+    free_hub_labels(labels);
+    free(sources);
+    free(targets);
+    free(label_eta);
+    free_graph(graph);
+}
+
+// ฟังก์ชันสำหรับวัดประสิทธิภาพการคำนวณพื้นที่ที่เดินทางถึงได้ด้วย PHAST เทียบกับการค้นหาด้วยฮีป
+void benchmark_isochrones(int rows, int cols, int num_sources, float budget) {
+    printf("\n=== Benchmark: Isochrones (%dx%d grid, %d sources, %.1f minutes) ===\n",
+           rows, cols, num_sources, budget * 60.0f);
+    
+    Graph* graph = create_grid_network(rows, cols, 42);
+    randomize_road_loads(graph, 99);
+    
+    int* sources = (int*)malloc(num_sources * sizeof(int));
+    int* unused = (int*)malloc(num_sources * sizeof(int));
+    Isochrone** batch = (Isochrone**)malloc(num_sources * sizeof(Isochrone*));
+    if (sources == NULL || unused == NULL || batch == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for benchmark queries\n");
+        exit(1);
+    }
+    generate_queries(graph, num_sources, sources, unused, 11);
+    
+    double start = monotonic_seconds();
+    PhastGraph* phast = create_phast_graph(graph);
+    printf("Contraction time: %.3f s (%d shortcuts)\n", monotonic_seconds() - start, phast->num_shortcuts);
+    
+    start = monotonic_seconds();
+    compute_isochrones_batch(phast, graph, sources, num_sources, budget, batch);
+    double phast_time = (monotonic_seconds() - start) / num_sources;
+    
+    int mismatched = 0;
+    long total_reachable = 0;
+    start = monotonic_seconds();
+    for (int i = 0; i < num_sources; i++) {
+        Isochrone* single = compute_isochrone(graph, sources[i], budget);
+        
+        // ทั้งสองวิธีต้องให้ชุดทางแยกเดียวกัน (เรียงตามรหัสทางแยก)
+        bool same = (single->num_reachable == batch[i]->num_reachable);
+        for (int k = 0; same && k < single->num_reachable; k++) {
+            if (single->reachable[k] != batch[i]->reachable[k] ||
+                fabsf(single->arrival_time[k] - batch[i]->arrival_time[k]) > 1e-4f) {
+                same = false;
+            }
+        }
+        if (!same) {
+            mismatched++;
+        }
+        total_reachable += single->num_reachable;
+        free_isochrone(single);
+    }
+    double heap_time = (monotonic_seconds() - start) / num_sources;
+    
+    printf("Average reachable intersections: %.1f / %d\n", (double)total_reachable / num_sources,
+           graph->num_vertices);
+    printf("Heap search (bounded): %.3f ms/source\n", heap_time * 1e3);
+    printf("PHAST sweep: %.3f ms/source\n", phast_time * 1e3);
+    printf("Mismatched isochrones: %d / %d\n", mismatched, num_sources);
+    
+    for (int i = 0; i < num_sources; i++) {
+        free_isochrone(batch[i]);
+    }
+    free_phast_graph(phast);
+    free(batch);
+    free(sources);
+    free(unused);
+    free_graph(graph);
+}
+
+// ฟังก์ชันสำหรับวัดประสิทธิภาพการจำลองระยะยาวที่มียานพาหนะเข้าและออกอย่างต่อเนื่อง
+void benchmark_vehicle_churn(int rows, int cols, int num_ticks, int arrivals_per_tick) {
+    printf("\n=== Benchmark: Vehicle Churn (%dx%d grid, %d ticks, %d arrivals/tick) ===\n",
+           rows, cols, num_ticks, arrivals_per_tick);
+    
+    Graph* graph = create_grid_network(rows, cols, 42);
+    SignalSystem* signal_system = create_signal_system(graph);
+    TrafficSimulation* sim = create_simulation(graph, signal_system, 64);
+    start_simulation(sim);
+    
+    unsigned int seed = 2024;
+    int peak_active = 0;
+    double start = monotonic_seconds();
+    
+    for (int t = 0; t < num_ticks; t++) {
+        for (int k = 0; k < arrivals_per_tick; k++) {
+            seed = seed * 1103515245u + 12345u;
+            int origin = (int)((seed >> 8) % (unsigned int)graph->num_vertices);
+            seed = seed * 1103515245u + 12345u;
+            int destination = (int)((seed >> 8) % (unsigned int)graph->num_vertices);
+            add_vehicle(sim, origin, destination);
+        }
+        
+        update_simulation(sim);
+        if (sim->num_vehicles > peak_active) {
+            peak_active = sim->num_vehicles;
+        }
+    }
+    
+    double elapsed = monotonic_seconds() - start;
+    
+    printf("Trips added: %ld, completed: %ld, still traveling: %d\n",
+           sim->total_vehicles, sim->completed_vehicles, sim->num_vehicles);
+    printf("Peak active vehicles: %d (storage capacity %d, %d handles)\n",
+           peak_active, sim->vehicles.capacity, sim->vehicles.num_handles);
+    printf("Elapsed: %.3f s (%.1f ticks/s)\n", elapsed, (elapsed > 0.0) ? num_ticks / elapsed : 0.0);
+    
+    stop_simulation(sim);
+    free_simulation(sim);
+    free_signal_system(signal_system);
+    free_graph(graph);
+}
+
+// ผลรวมของการจำลองสำหรับตรวจสอบว่าทุกจำนวนเธรดให้ผลเหมือนกัน
+typedef struct {
+    long completed;
+    int traveling;
+    long total_load;
+    long long total_position;
+} SimulationChecksum;
+
+// ฟังก์ชันสำหรับคำนวณผลรวมของการจำลอง
+static SimulationChecksum simulation_checksum(TrafficSimulation* sim) {
+    SimulationChecksum checksum = {sim->completed_vehicles, sim->num_vehicles, 0, 0};
+    
+    for (int i = 0; i < sim->graph->num_vertices; i++) {
+        for (Edge* current = sim->graph->vertices[i].head; current != NULL; current = current->next) {
+            checksum.total_load += edge_load(sim->graph, current);
+        }
+    }
+    for (int i = 0; i < sim->num_vehicles; i++) {
+        checksum.total_position += sim->vehicles.current_pos[i];
+    }
+    
+    return checksum;
+}
+
+// ฟังก์ชันสำหรับวัดการเพิ่มความเร็วของการอัปเดตแบบขนานตั้งแต่ 1 เธรดถึง max_threads เธรด
+void benchmark_parallel_ticks(int rows, int cols, int num_vehicles, int num_ticks, int max_threads) {
+    if (max_threads <= 0) {
+        max_threads = available_cpu_count();
+    }
+    
+    printf("\n=== Benchmark: Parallel Ticks (%dx%d grid, %d vehicles, %d ticks, %d CPUs) ===\n",
+           rows, cols, num_vehicles, num_ticks, available_cpu_count());
+    printf("Threads | ticks/s   | speedup | result\n");
+    
+    SimulationChecksum serial = {0, 0, 0, 0};
+    double serial_rate = 0.0;
+    
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        // สร้างการจำลองเดิมทุกครั้งเพื่อให้เริ่มจากสถานะเดียวกัน
+        Graph* graph = create_grid_network(rows, cols, 42);
+        SignalSystem* signal_system = create_signal_system(graph);
+        SimulationConfig config = default_simulation_config();
+        config.seed = 77;
+        config.initial_capacity = num_vehicles;
+        config.num_threads = threads;
+        config.speed_variation = 0.1f;
+        TrafficSimulation* sim = create_simulation_with_config(graph, signal_system, &config);
+        generate_random_traffic(sim, num_vehicles);
+        
+        sim->is_running = true;
+        double start = monotonic_seconds();
+        for (int t = 0; t < num_ticks; t++) {
+            update_simulation(sim);
+        }
+        double elapsed = monotonic_seconds() - start;
+        double rate = (elapsed > 0.0) ? num_ticks / elapsed : 0.0;
+        
+        SimulationChecksum checksum = simulation_checksum(sim);
+        if (threads == 1) {
+            serial = checksum;
+            serial_rate = rate;
+        }
+        bool same = (checksum.completed == serial.completed && checksum.traveling == serial.traveling &&
+                     checksum.total_load == serial.total_load &&
+                     checksum.total_position == serial.total_position);
+        
+        // แผนภูมิแท่งของการเพิ่มความเร็ว (หนึ่ง # ต่อ 0.25 เท่า)
+        double speedup = (serial_rate > 0.0) ? rate / serial_rate : 0.0;
+        printf("%7d | %9.1f | %6.2fx | %s  ", threads, rate, speedup, same ? "same" : "DIFFERENT");
+        for (int b = 0; b < (int)(speedup * 4.0 + 0.5); b++) {
+            printf("#");
+        }
+        printf("\n");
+        
+        free_simulation(sim);
+        free_signal_system(signal_system);
+        free_graph(graph);
+        
+        // รวมจำนวนแกนของเครื่องไว้ในแผนภูมิด้วยถ้าไม่ใช่กำลังของสอง
+        if (threads < max_threads && threads * 2 > max_threads) {
+            threads = max_threads / 2;
+        }
+    }
+    
+    printf("Completed: %ld, traveling: %d, total road load: %ld\n",
+           serial.completed, serial.traveling, serial.total_load);
+}
+
+// ฟังก์ชันสำหรับสร้างการจำลองที่ใช้เปรียบเทียบโหมดจำลอง (สถานะเริ่มต้นเหมือนกันทุกครั้ง)
+static TrafficSimulation* create_comparison_simulation(Graph* graph, SignalSystem* signal_system, int num_vehicles) {
+    SimulationConfig config = default_simulation_config();
+    config.seed = 77;
+    config.initial_capacity = num_vehicles;
+    config.num_threads = 1;
+    config.speed_variation = 0.1f;
+    TrafficSimulation* sim = create_simulation_with_config(graph, signal_system, &config);
+    generate_random_traffic(sim, num_vehicles);
+    sim->is_running = true;
+    
+    return sim;
+}
+
+// ฟังก์ชันสำหรับวัดประสิทธิภาพการจำลองแบบเหตุการณ์เทียบกับการอัปเดตทุกขั้นตอนเวลา
+void benchmark_event_simulation(int rows, int cols, int num_vehicles, int duration) {
+    printf("\n=== Benchmark: Event-Driven Simulation (%dx%d grid, %d vehicles, %d seconds) ===\n",
+           rows, cols, num_vehicles, duration);
+    
+    // อัปเดตทุกขั้นตอนเวลา
+    Graph* graph = create_grid_network(rows, cols, 42);
+    SignalSystem* signal_system = create_signal_system(graph);
+    TrafficSimulation* sim = create_comparison_simulation(graph, signal_system, num_vehicles);
+    
+    double start = monotonic_seconds();
+    for (int t = 0; t < duration; t++) {
+        update_simulation(sim);
+    }
+    double tick_time = monotonic_seconds() - start;
+    SimulationChecksum ticked = simulation_checksum(sim);
+    
+    free_simulation(sim);
+    free_signal_system(signal_system);
+    free_graph(graph);
+    
+    // จำลองแบบเหตุการณ์จากสถานะเริ่มต้นเดียวกัน
+    graph = create_grid_network(rows, cols, 42);
+    signal_system = create_signal_system(graph);
+    sim = create_comparison_simulation(graph, signal_system, num_vehicles);
+    
+    start = monotonic_seconds();
+    EventEngine* engine = create_event_engine(sim);
+    long events = run_event_simulation(engine, duration);
+    double event_time = monotonic_seconds() - start;
+    SimulationChecksum evented = simulation_checksum(sim);
+    
+    bool same = (ticked.completed == evented.completed && ticked.traveling == evented.traveling &&
+                 ticked.total_load == evented.total_load && ticked.total_position == evented.total_position);
+    
+    printf("Tick mode: %.3f s (%d vehicle updates per tick)\n", tick_time, num_vehicles);
+    printf("Event mode: %.3f s (%ld events, %ld stale, %.0f events/s)\n", event_time, events,
+           engine->stale_events, (event_time > 0.0) ? events / event_time : 0.0);
+    printf("Speedup: %.2fx\n", (event_time > 0.0) ? tick_time / event_time : 0.0);
+    printf("Completed: %ld, traveling: %d, total road load: %ld (%s)\n",
+           evented.completed, evented.traveling, evented.total_load, same ? "same as tick mode" : "DIFFERENT");
+    
+    free_event_engine(engine);
+    free_simulation(sim);
+    free_signal_system(signal_system);
+    free_graph(graph);
+}
+
+// ฟังก์ชันสำหรับวัดประสิทธิภาพของแบบจำลองคิวของถนนเทียบกับการจำลองรายคัน
+void benchmark_link_model(int rows, int cols, int num_trips, int num_ticks) {
+    printf("\n=== Benchmark: Queue-Link Model (%dx%d grid, %d trips, %d ticks) ===\n",
+           rows, cols, num_trips, num_ticks);
+    
+    // จำลองรายคัน
+    Graph* graph = create_grid_network(rows, cols, 42);
+    SignalSystem* signal_system = create_signal_system(graph);
+    TrafficSimulation* sim = create_comparison_simulation(graph, signal_system, num_trips);
+    
+    double start = monotonic_seconds();
+    for (int t = 0; t < num_ticks; t++) {
+        update_simulation(sim);
+    }
+    double micro_time = monotonic_seconds() - start;
+    long micro_completed = sim->completed_vehicles;
+    
+    free_simulation(sim);
+    free_signal_system(signal_system);
+    free_graph(graph);
+    
+    // แบบจำลองคิวของถนนด้วยต้นทางและปลายทางชุดเดียวกับ generate_random_traffic
+    graph = create_grid_network(rows, cols, 42);
+    signal_system = create_signal_system(graph);
+    LinkModel* model = create_link_model(graph, signal_system, num_trips);
+    
+    uint64_t counter = 0;
+    for (int i = 0; i < num_trips; i++) {
+        int origin = random_int(77, RNG_STREAM_TRAFFIC, counter++, graph->num_vertices);
+        int destination;
+        do {
+            destination = random_int(77, RNG_STREAM_TRAFFIC, counter++, graph->num_vertices);
+        } while (destination == origin);
+        add_link_trip(model, origin, destination);
+    }
+    
+    start = monotonic_seconds();
+    for (int t = 0; t < num_ticks; t++) {
+        update_link_model(model);
+    }
+    double meso_time = monotonic_seconds() - start;
+    
+    printf("Per-vehicle model: %.3f s (%.1f ticks/s), completed %ld\n", micro_time,
+           (micro_time > 0.0) ? num_ticks / micro_time : 0.0, micro_completed);
+    printf("Queue-link model: %.3f s (%.1f ticks/s), completed %ld\n", meso_time,
+           (meso_time > 0.0) ? num_ticks / meso_time : 0.0, model->completed_trips);
+    printf("Speedup: %.2fx\n", (meso_time > 0.0) ? micro_time / meso_time : 0.0);
+    print_link_model_status(model);
+    
+    free_link_model(model);
+    free_signal_system(signal_system);
+    free_graph(graph);
+}
+
+// ฟังก์ชันสำหรับวัดประสิทธิภาพการเร่งการจำลองเทียบกับการอัปเดตทีละขั้นตอนเวลา
+void benchmark_fast_forward(int rows, int cols, int num_vehicles, int num_ticks, int batch) {
+    printf("\n=== Benchmark: Fast-Forward (%dx%d grid, %d vehicles, %d ticks, batches of %d) ===\n",
+           rows, cols, num_vehicles, num_ticks, batch);
+    printf("dt (s) | gating | mode         | ticks/s   | completed\n");
+    
+    // เมื่อสัญญาณไฟควบคุมการจราจร การเร่งต้องได้จำนวนการเดินทางที่จบเท่ากับการอัปเดตทีละขั้นตอนเวลา
+    const float steps[] = {1.0f, 0.25f, 1.0f};
+    const bool gating[] = {false, false, true};
+    for (int k = 0; k < 3; k++) {
+        for (int mode = 0; mode < 2; mode++) {
+            Graph* graph = create_grid_network(rows, cols, 42);
+            SignalSystem* signal_system = create_signal_system(graph);
+            SimulationConfig config = default_simulation_config();
+            config.seed = 77;
+            config.initial_capacity = num_vehicles;
+            config.dt = steps[k];
+            config.signal_gating = gating[k];
+            TrafficSimulation* sim = create_simulation_with_config(graph, signal_system, &config);
+            generate_random_traffic(sim, num_vehicles);
+            sim->is_running = true;
+            
+            double start = monotonic_seconds();
+            if (mode == 0) {
+                for (int t = 0; t < num_ticks; t++) {
+                    update_simulation(sim);
+                }
+            } else {
+                for (int t = 0; t < num_ticks; t += batch) {
+                    fast_forward_simulation(sim, (num_ticks - t < batch) ? num_ticks - t : batch);
+                }
+            }
+            double elapsed = monotonic_seconds() - start;
+            
+            printf("%6.2f | %-6s | %-12s | %9.1f | %ld\n", steps[k], gating[k] ? "on" : "off",
+                   (mode == 0) ? "every tick" : "fast-forward",
+                   (elapsed > 0.0) ? num_ticks / elapsed : 0.0, sim->completed_vehicles);
+            
+            free_simulation(sim);
+            free_signal_system(signal_system);
+            free_graph(graph);
+        }
+    }
+}
+
+// ฟังก์ชันสำหรับวัดผลของการเปลี่ยนเส้นทางระหว่างเดินทางเทียบกับการใช้เส้นทางเดิมตลอด
+void benchmark_rerouting(int rows, int cols, int num_vehicles, int num_ticks, int interval) {
+    printf("\n=== Benchmark: En-Route Rerouting (%dx%d grid, %d vehicles, %d ticks) ===\n",
+           rows, cols, num_vehicles, num_ticks);
+    
+    for (int mode = 0; mode < 2; mode++) {
+        Graph* graph = create_grid_network(rows, cols, 42);
+        SignalSystem* signal_system = create_signal_system(graph);
+        SimulationConfig config = default_simulation_config();
+        config.seed = 77;
+        config.initial_capacity = num_vehicles;
+        config.reroute_interval = (mode == 0) ? 0 : interval;
+        TrafficSimulation* sim = create_simulation_with_config(graph, signal_system, &config);
+        generate_random_traffic(sim, num_vehicles);
+        sim->is_running = true;
+        
+        double start = monotonic_seconds();
+        for (int t = 0; t < num_ticks; t++) {
+            update_simulation(sim);
+        }
+        double elapsed = monotonic_seconds() - start;
+        
+        printf("%s: %.3f s, completed %ld, still traveling %d\n", (mode == 0) ? "Fixed routes" : "Rerouting",
+               elapsed, sim->completed_vehicles, sim->num_vehicles);
+        if (mode == 1) {
+            print_reroute_stats(sim);
+        }
+        
+        free_simulation(sim);
+        free_signal_system(signal_system);
+        free_graph(graph);
+    }
+}
+
+// ฟังก์ชันสำหรับวัดหน่วยความจำและเวลาของการปล่อยการเดินทางตามเวลาออกเดินทางเทียบกับการเพิ่มทั้งหมดตั้งแต่เริ่ม
+void benchmark_demand_release(int rows, int cols, int num_pairs, int trips_per_pair, int num_ticks) {
+    printf("\n=== Benchmark: Streaming OD Demand (%dx%d grid, %d OD pairs x %d trips, %d ticks) ===\n",
+           rows, cols, num_pairs, trips_per_pair, num_ticks);
+    
+    // รูปแบบช่วงเร่งด่วน: 12 ช่วง ช่วงละ num_ticks / 12 วินาที มียอดตรงกลาง
+    const float peak[12] = {1, 2, 4, 7, 10, 12, 12, 10, 7, 4, 2, 1};
+    
+    for (int mode = 0; mode < 2; mode++) {
+        Graph* graph = create_grid_network(rows, cols, 42);
+        SignalSystem* signal_system = create_signal_system(graph);
+        TrafficSimulation* sim = create_simulation(graph, signal_system, 64);
+        start_simulation(sim);
+        
+        DemandModel* demand = create_demand_model(12, num_ticks / 12);
+        int profile = add_demand_profile(demand, "peak", peak);
+        for (int i = 0; i < num_pairs; i++) {
+            int origin = random_int(77, RNG_STREAM_TRAFFIC, 2 * (uint64_t)i, graph->num_vertices);
+            int destination = random_int(77, RNG_STREAM_TRAFFIC, 2 * (uint64_t)i + 1, graph->num_vertices);
+            add_demand_entry(demand, origin, destination, trips_per_pair, profile);
+        }
+        
+        int peak_active = 0;
+        double start = monotonic_seconds();
+        
+        if (mode == 0) {
+            // เพิ่มการเดินทางทั้งหมดตั้งแต่เริ่ม (แบบเดิม)
+            for (int i = 0; i < demand->num_entries; i++) {
+                for (int k = 0; k < demand->entries[i].trips; k++) {
+                    add_vehicle(sim, demand->entries[i].origin, demand->entries[i].destination);
+                }
+            }
+        }
+        
+        for (int t = 0; t < num_ticks; t++) {
+            if (mode == 1) {
+                release_demand(demand, sim);
+            }
+            update_simulation(sim);
+            if (sim->num_vehicles > peak_active) {
+                peak_active = sim->num_vehicles;
+            }
+        }
+        double elapsed = monotonic_seconds() - start;
+        
+        printf("%s: %.3f s, completed %ld / %ld, peak active %d, storage capacity %d\n",
+               (mode == 0) ? "All at t=0      " : "Released on time", elapsed,
+               sim->completed_vehicles, sim->total_vehicles, peak_active, sim->vehicles.capacity);
+        
+        free_demand_model(demand);
+        free_simulation(sim);
+        free_signal_system(signal_system);
+        free_graph(graph);
+    }
+}
+
+// ฟังก์ชันสำหรับสร้างการจำลองของชุดวัดการบันทึกสถานะ (เปลี่ยนเส้นทางระหว่างเดินทางเพื่อให้มีต้นทุนตามแผน)
+static TrafficSimulation* create_checkpoint_simulation(Graph* graph, SignalSystem* signal_system, int num_vehicles) {
+    SimulationConfig config = default_simulation_config();
+    config.seed = 77;
+    config.initial_capacity = num_vehicles;
+    config.speed_variation = 0.1f;
+    config.reroute_interval = 60;
+    return create_simulation_with_config(graph, signal_system, &config);
+}
+
+// ฟังก์ชันสำหรับวัดเวลาของการบันทึกและกู้คืนสถานะเทียบกับการจำลองซ้ำจนถึงเวลาเดียวกัน
+void benchmark_checkpoint(int rows, int cols, int num_vehicles, int warmup_ticks, int continue_ticks) {
+    printf("\n=== Benchmark: Checkpoint / Restore (%dx%d grid, %d vehicles, restore at tick %d) ===\n",
+           rows, cols, num_vehicles, warmup_ticks);
+    
+    const char* path = "benchmark_checkpoint.tsc";
+    
+    Graph* graph = create_grid_network(rows, cols, 42);
+    SignalSystem* signal_system = create_signal_system(graph);
+    TrafficSimulation* sim = create_checkpoint_simulation(graph, signal_system, num_vehicles);
+    generate_random_traffic(sim, num_vehicles);
+    sim->is_running = true;
+    
+    double start = monotonic_seconds();
+    for (int t = 0; t < warmup_ticks; t++) {
+        update_simulation(sim);
+    }
+    double simulate_time = monotonic_seconds() - start;
+    
+    start = monotonic_seconds();
+    bool saved = save_simulation_checkpoint(sim, path);
+    double save_time = monotonic_seconds() - start;
+    
+    // กู้คืนลงในการจำลองใหม่บนเครือข่ายที่สร้างใหม่ด้วย seed เดียวกัน
+    Graph* restored_graph = create_grid_network(rows, cols, 42);
+    SignalSystem* restored_signals = create_signal_system(restored_graph);
+    TrafficSimulation* restored = create_checkpoint_simulation(restored_graph, restored_signals, 1);
+    
+    start = monotonic_seconds();
+    bool loaded = saved && restore_simulation_checkpoint(restored, path);
+    double restore_time = monotonic_seconds() - start;
+    
+    long file_size = 0;
+    FILE* file = fopen(path, "rb");
+    if (file != NULL) {
+        fseek(file, 0, SEEK_END);
+        file_size = ftell(file);
+        fclose(file);
+    }
+    remove(path);
+    
+    printf("Re-simulate %d ticks: %.3f s\n", warmup_ticks, simulate_time);
+    printf("Save checkpoint:      %.3f s (%.1f MB, %d vehicles traveling)\n", save_time,
+           file_size / (1024.0 * 1024.0), sim->num_vehicles);
+    printf("Restore checkpoint:   %.3f s (%.0fx faster than re-simulating)\n", restore_time,
+           (restore_time > 0.0) ? simulate_time / restore_time : 0.0);
+    
+    if (loaded) {
+        // เดินการจำลองทั้งสองต่อ ผลต้องเหมือนกันทุกค่า
+        for (int t = 0; t < continue_ticks; t++) {
+            update_simulation(sim);
+            update_simulation(restored);
+        }
+        SimulationChecksum original = simulation_checksum(sim);
+        SimulationChecksum copy = simulation_checksum(restored);
+        bool same = (original.completed == copy.completed && original.traveling == copy.traveling &&
+                     original.total_load == copy.total_load && original.total_position == copy.total_position &&
+                     sim->traffic_counter == restored->traffic_counter);
+        printf("After %d more ticks: %s (completed %ld, traveling %d)\n", continue_ticks,
+               same ? "same" : "DIFFERENT", copy.completed, copy.traveling);
+    }
+    
+    free_simulation(restored);
+    free_signal_system(restored_signals);
+    free_graph(restored_graph);
+    free_simulation(sim);
+    free_signal_system(signal_system);
+    free_graph(graph);
+}
+
+// ฟังก์ชันสำหรับวัดผลของการบันทึกเส้นทางการเคลื่อนที่ต่อความเร็วของการจำลอง และตรวจว่าอ่านไฟล์กลับได้ถูกต้อง
+void benchmark_trajectory_recorder(int rows, int cols, int num_vehicles, int num_ticks) {
+    printf("\n=== Benchmark: Trajectory Recorder (%dx%d grid, %d vehicles, %d ticks) ===\n",
+           rows, cols, num_vehicles, num_ticks);
+    
+    const char* path = "benchmark_trajectory.trj";
+    double rates[2] = {0.0, 0.0};
+    bool verified = false;
+    
+    for (int mode = 0; mode < 2; mode++) {
+        Graph* graph = create_grid_network(rows, cols, 42);
+        SignalSystem* signal_system = create_signal_system(graph);
+        TrafficSimulation* sim = create_comparison_simulation(graph, signal_system, num_vehicles);
+        TrajectoryRecorder* recorder = (mode == 1) ? create_trajectory_recorder(path, graph, DEFAULT_TICKS_PER_BLOCK)
+                                                   : NULL;
+        
+        double start = monotonic_seconds();
+        for (int t = 0; t < num_ticks; t++) {
+            update_simulation(sim);
+            if (recorder != NULL) {
+                record_trajectory_tick(recorder, sim);
+            }
+        }
+        double elapsed = monotonic_seconds() - start;
+        rates[mode] = (elapsed > 0.0) ? num_ticks / elapsed : 0.0;
+        
+        if (recorder != NULL) {
+            finish_trajectory_recorder(recorder);
+            print_recorder_stats(recorder);
+            free_trajectory_recorder(recorder);
+            
+            // อ่านไฟล์ทั้งหมดและเทียบขั้นตอนเวลาสุดท้ายกับสถานะของการจำลอง
+            TrajectoryReader* reader = open_trajectory_file(path);
+            const TrajectoryFrame* frame = NULL;
+            const TrajectoryFrame* last = NULL;
+            int frames = 0;
+            while (reader != NULL && (frame = read_trajectory_tick(reader)) != NULL) {
+                last = frame;
+                frames++;
+            }
+            
+            verified = (last != NULL && frames == num_ticks && last->time_step == sim->time_step &&
+                        last->num_vehicles == sim->num_vehicles);
+            for (int i = 0; verified && i < sim->num_vehicles; i++) {
+                Edge* edge = sim->vehicles.current_edge[i];
+                verified = (last->trip_id[i] == sim->vehicles.trip_id[i] &&
+                            last->position[i] == sim->vehicles.current_pos[i] &&
+                            last->edge_id[i] == ((edge != NULL) ? edge->id : -1));
+            }
+            for (int v = 0; verified && v < graph->num_vertices; v++) {
+                for (Edge* edge = graph->vertices[v].head; edge != NULL; edge = edge->next) {
+                    verified = verified && (last->load[edge->id] == edge_load(graph, edge));
+                }
+            }
+            
+            close_trajectory_file(reader);
+            remove(path);
+        }
+        
+        free_simulation(sim);
+        free_signal_system(signal_system);
+        free_graph(graph);
+    }
+    
+    printf("Without recorder: %.1f ticks/s\n", rates[0]);
+    printf("With recorder:    %.1f ticks/s (%.1f%% slower)\n", rates[1],
+           (rates[0] > 0.0) ? (1.0 - rates[1] / rates[0]) * 100.0 : 0.0);
+    printf("Read back: %s\n", verified ? "same as simulation" : "DIFFERENT");
+}
+
+// ฟังก์ชันสำหรับวัดผลของการให้ยานพาหนะรอไฟเขียวที่ทางแยกเทียบกับการผ่านทางแยกทันที
+void benchmark_signal_gating(int rows, int cols, int num_vehicles, int num_ticks) {
+    printf("\n=== Benchmark: Signal-Gated Junctions (%dx%d grid, %d vehicles, %d ticks) ===\n",
+           rows, cols, num_vehicles, num_ticks);
+    printf("Mode          | ticks/s   | completed | waiting | result\n");
+    
+    SimulationChecksum serial = {0, 0, 0, 0};
+    for (int mode = 0; mode < 3; mode++) {
+        // 0 = ไม่รอไฟ, 1 = รอไฟ (1 เธรด), 2 = รอไฟ (2 เธรด ต้องได้ผลเหมือน 1 เธรด)
+        Graph* graph = create_grid_network(rows, cols, 42);
+        SignalSystem* signal_system = create_signal_system(graph);
+        SimulationConfig config = default_simulation_config();
+        config.seed = 77;
+        config.initial_capacity = num_vehicles;
+        config.speed_variation = 0.1f;
+        config.signal_gating = (mode > 0);
+        config.num_threads = (mode == 2) ? 2 : 1;
+        TrafficSimulation* sim = create_simulation_with_config(graph, signal_system, &config);
+        generate_random_traffic(sim, num_vehicles);
+        sim->is_running = true;
+        
+        double start = monotonic_seconds();
+        for (int t = 0; t < num_ticks; t++) {
+            update_simulation(sim);
+        }
+        double elapsed = monotonic_seconds() - start;
+        
+        SimulationChecksum checksum = simulation_checksum(sim);
+        if (mode == 1) {
+            serial = checksum;
+        }
+        bool same = (checksum.completed == serial.completed && checksum.traveling == serial.traveling &&
+                     checksum.total_load == serial.total_load &&
+                     checksum.total_position == serial.total_position);
+        
+        const char* names[3] = {"pass through", "gated (1 th)", "gated (2 th)"};
+        printf("%-13s | %9.1f | %9ld | %7ld | %s\n", names[mode], (elapsed > 0.0) ? num_ticks / elapsed : 0.0,
+               sim->completed_vehicles,
+               (sim->junction_queues != NULL) ? count_waiting_vehicles(sim->junction_queues) : 0L,
+               (mode == 0) ? "-" : (same ? "same" : "DIFFERENT"));
+        if (mode == 1) {
+            print_junction_queue_stats(sim->junction_queues);
+        }
+        
+        free_simulation(sim);
+        free_signal_system(signal_system);
+        free_graph(graph);
+    }
+}
+
+// ฟังก์ชันสำหรับวัดประสิทธิภาพของกลุ่มการจำลองที่ใช้เครือข่ายร่วมกันตามจำนวนเธรด
+void benchmark_ensemble(int rows, int cols, int num_replicas, int num_vehicles, int num_ticks) {
+    printf("\n=== Benchmark: Monte Carlo Ensemble (%dx%d grid, %d replicas, %d vehicles, %d ticks) ===\n",
+           rows, cols, num_replicas, num_vehicles, num_ticks);
+    
+    Graph* graph = create_grid_network(rows, cols, 42);
+    SignalSystem* signal_system = create_signal_system(graph);
+    SimulationConfig config = default_simulation_config();
+    config.seed = 77;
+    config.speed_variation = 0.1f;
+    
+    // เวลาของการสร้างเครือข่ายใหม่เทียบกับการสร้างสำเนาสำหรับหนึ่งชุด
+    int repeats = 50;
+    double start = monotonic_seconds();
+    for (int i = 0; i < repeats; i++) {
+        Graph* rebuilt = create_grid_network(rows, cols, 42);
+        SignalSystem* signals = create_signal_system(rebuilt);
+        free_signal_system(signals);
+        free_graph(rebuilt);
+    }
+    double rebuild_time = (monotonic_seconds() - start) / repeats;
+    start = monotonic_seconds();
+    for (int i = 0; i < repeats; i++) {
+        Graph* replica = create_graph_replica(graph);
+        SignalSystem* signals = clone_signal_system(signal_system);
+        free_signal_system(signals);
+        free_graph_replica(replica);
+    }
+    double clone_time = (monotonic_seconds() - start) / repeats;
+    printf("Per-replica network setup: rebuild %.3f ms, replica %.3f ms\n", rebuild_time * 1e3, clone_time * 1e3);
+    
+    // ผลของแต่ละชุดต้องเหมือนกันทุกจำนวนเธรด
+    int cpus = available_cpu_count();
+    int thread_counts[2] = {1, (cpus > 2) ? cpus : 2};
+    EnsembleResult* serial = NULL;
+    printf("Threads | wall (s) | replicas/s | speedup | result\n");
+    for (int k = 0; k < 2; k++) {
+        EnsembleResult* result = run_simulation_ensemble(graph, signal_system, &config, num_replicas,
+                                                         num_vehicles, num_ticks, thread_counts[k]);
+        bool same = true;
+        if (serial != NULL) {
+            for (int r = 0; r < num_replicas; r++) {
+                same = same && result->replicas[r].completed == serial->replicas[r].completed &&
+                       result->replicas[r].traveling == serial->replicas[r].traveling &&
+                       result->replicas[r].mean_congestion == serial->replicas[r].mean_congestion &&
+                       result->replicas[r].mean_speed == serial->replicas[r].mean_speed;
+            }
+        }
+        printf("%7d | %8.3f | %10.2f | %7.2f | %s\n", result->num_threads, result->wall_time,
+               num_replicas / result->wall_time, (serial != NULL) ? serial->wall_time / result->wall_time : 1.0,
+               (serial == NULL) ? "-" : (same ? "same" : "DIFFERENT"));
+        if (serial == NULL) {
+            serial = result;
+        } else {
+            print_ensemble_result(result);
+            free_ensemble_result(result);
+        }
+    }
+    
+    free_ensemble_result(serial);
+    free_signal_system(signal_system);
+    free_graph(graph);
+}
+
+// ฟังก์ชันสำหรับวัดเวลาของการปรับค่าความสำคัญในคิวของสัญญาณไฟตามขนาดของเครือข่าย
+void benchmark_signal_queue(int max_side, int num_rounds) {
+    printf("\n=== Benchmark: Signal Priority Queue (grids up to %dx%d, %d rounds) ===\n", max_side, max_side, num_rounds);
+    printf("Grid      | signals | manage queue (ms) | per signal (ns) | rebuild (ms)\n");
+    
+    for (int side = max_side / 4; side <= max_side; side *= 2) {
+        Graph* graph = create_grid_network(side, side, 42);
+        randomize_road_loads(graph, 7);
+        SignalSystem* signal_system = create_signal_system(graph);
+        int n = signal_system->num_signals;
+        
+        // ปรับค่าความสำคัญของทุกสัญญาณไฟ (ทำเครื่องหมายว่าทุกทางแยกเปลี่ยน ซึ่งเป็นกรณีที่มากที่สุด)
+        double start = monotonic_seconds();
+        for (int r = 0; r < num_rounds; r++) {
+            refresh_junction_loads(graph);
+            manage_signal_queue(graph, signal_system);
+        }
+        double manage_time = (monotonic_seconds() - start) / num_rounds;
+        
+        // สร้างคิวใหม่ทั้งหมดจากอาเรย์
+        int* junction_ids = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+        float* priorities = (float*)malloc((n > 0 ? n : 1) * sizeof(float));
+        for (int i = 0; i < n; i++) {
+            junction_ids[i] = signal_system->signals[i].junction_id;
+            priorities[i] = calculate_junction_congestion(graph, junction_ids[i]);
+        }
+        start = monotonic_seconds();
+        for (int r = 0; r < num_rounds; r++) {
+            rebuild_priority_queue(signal_system->queue, junction_ids, priorities, n);
+        }
+        double rebuild_time = (monotonic_seconds() - start) / num_rounds;
+        
+        char label[32];
+        snprintf(label, sizeof(label), "%dx%d", side, side);
+        printf("%-9s | %7d | %17.3f | %15.1f | %12.3f\n", label, n, manage_time * 1e3,
+               (n > 0) ? manage_time * 1e9 / n : 0.0, rebuild_time * 1e3);
+        
+        free(junction_ids);
+        free(priorities);
+        free_signal_system(signal_system);
+        free_graph(graph);
+    }
+}
+
+// ฟังก์ชันสำหรับวัดเวลาของการอัปเดตสัญญาณไฟเมื่ออ่านเฉพาะทางแยกที่เปลี่ยนเทียบกับการคำนวณทุกทางแยกใหม่
+void benchmark_junction_loads(int rows, int cols, int num_vehicles, int num_ticks) {
+    printf("\n=== Benchmark: Incremental Junction Loads (%dx%d grid, %d vehicles, %d ticks) ===\n",
+           rows, cols, num_vehicles, num_ticks);
+    
+    Graph* graph = create_grid_network(rows, cols, 42);
+    SignalSystem* signal_system = create_signal_system(graph);
+    TrafficSimulation* sim = create_comparison_simulation(graph, NULL, num_vehicles);
+    
+    // การจำลองไม่มีระบบสัญญาณไฟ จึงเรียกอัปเดตสัญญาณไฟเองหลังทุกขั้นตอนเวลา
+    // ขั้นตอนเวลาคี่คำนวณทุกทางแยกใหม่ (แบบเดิม) ขั้นตอนเวลาคู่อ่านเฉพาะทางแยกที่เปลี่ยน
+    double full_time = 0.0;
+    double incremental_time = 0.0;
+    long changed = 0;
+    for (int t = 0; t < num_ticks; t++) {
+        update_simulation(sim);
+        
+        bool full = (t % 2 == 1);
+        if (!full) {
+            changed += graph->num_changed_junctions;
+        }
+        double start = monotonic_seconds();
+        if (full) {
+            refresh_junction_loads(graph);
+        }
+        advance_signal_system(graph, signal_system, 1);
+        double elapsed = monotonic_seconds() - start;
+        
+        if (full) {
+            full_time += elapsed;
+        } else {
+            incremental_time += elapsed;
+        }
+    }
+    
+    int incremental_rounds = (num_ticks + 1) / 2;
+    int full_rounds = num_ticks / 2;
+    printf("Signals: %d, junctions changed per tick: %.1f (%.1f%%)\n", signal_system->num_signals,
+           (incremental_rounds > 0) ? (double)changed / incremental_rounds : 0.0,
+           (incremental_rounds > 0) ? 100.0 * changed / incremental_rounds / graph->num_vertices : 0.0);
+    printf("Signal update, all junctions:     %.3f ms\n", (full_rounds > 0) ? full_time * 1e3 / full_rounds : 0.0);
+    printf("Signal update, changed junctions: %.3f ms\n",
+           (incremental_rounds > 0) ? incremental_time * 1e3 / incremental_rounds : 0.0);
+    
+    free_simulation(sim);
+    free_signal_system(signal_system);
+    free_graph(graph);
+}
+
+// ฟังก์ชันสำหรับวัดเวลาของการเปลี่ยนเฟสด้วยวงล้อเวลาเทียบกับการนับถอยหลังของทุกสัญญาณไฟทุกวินาที
+void benchmark_signal_timing(int max_side, int num_seconds) {
+    printf("\n=== Benchmark: Signal Phase Timing Wheel (grids up to %dx%d, %d seconds) ===\n", max_side, max_side, num_seconds);
+    printf("Grid      | signals | phase changes | polling (ms) | timing wheel (ms) | speedup | result\n");
+    
+    for (int side = max_side / 4; side <= max_side; side *= 2) {
+        Graph* graph = create_grid_network(side, side, 42);
+        randomize_road_loads(graph, 7);
+        SignalSystem* wheel_system = create_signal_system(graph);
+        SignalSystem* polling_system = clone_signal_system(wheel_system);
+        int n = wheel_system->num_signals;
+        
+        // แบบเดิม: ปรับระยะเวลาและลดเวลาที่เหลือของทุกสัญญาณไฟทุกวินาที
+        double start = monotonic_seconds();
+        for (int t = 0; t < num_seconds; t++) {
+            for (int i = 0; i < n; i++) {
+                adjust_signal_timing(graph, &polling_system->signals[i]);
+                update_traffic_signal(&polling_system->signals[i]);
+            }
+        }
+        double polling_time = monotonic_seconds() - start;
+        
+        // วงล้อเวลา: อัปเดตเฉพาะสัญญาณไฟที่เฟสหมด
+        start = monotonic_seconds();
+        for (int t = 0; t < num_seconds; t++) {
+            advance_signal_system(graph, wheel_system, 1);
+        }
+        double wheel_time = monotonic_seconds() - start;
+        
+        // ทั้งสองแบบต้องได้เฟสและเวลาที่เหลือเหมือนกัน
+        sync_signal_remaining_times(wheel_system);
+        bool same = true;
+        for (int i = 0; same && i < n; i++) {
+            const TrafficSignal* a = &wheel_system->signals[i];
+            const TrafficSignal* b = &polling_system->signals[i];
+            same = (a->current_phase == b->current_phase);
+            for (int p = 0; same && p < a->num_phases; p++) {
+                same = (a->phases[p].state == b->phases[p].state && a->durations[p] == b->durations[p] &&
+                        a->remaining_times[p] == b->remaining_times[p]);
+            }
+        }
+        
+        char label[32];
+        snprintf(label, sizeof(label), "%dx%d", side, side);
+        printf("%-9s | %7d | %13ld | %12.3f | %17.3f | %6.1fx | %s\n", label, n, wheel_system->phase_changes,
+               polling_time * 1e3, wheel_time * 1e3, (wheel_time > 0.0) ? polling_time / wheel_time : 0.0,
+               same ? "same" : "DIFFERENT");
+        
+        free_signal_system(polling_system);
+        free_signal_system(wheel_system);
+        free_graph(graph);
+    }
+}
+
+// ฟังก์ชันสำหรับวัดอัตราการตัดสินใจและปริมาณการจราจรที่ผ่านเครือข่ายของตัวควบคุมแบบ max-pressure เทียบกับแบบเดิม
+void benchmark_max_pressure(int rows, int cols, int num_vehicles, int num_ticks, int decision_interval) {
+    printf("\n=== Benchmark: Max-Pressure Signal Control (%dx%d grid, %d vehicles, %d ticks, decisions every %d s) ===\n",
+           rows, cols, num_vehicles, num_ticks, decision_interval);
+    printf("Control             | ticks/s   | completed | waiting | phase switches | decisions/s | result\n");
+    
+    SimulationChecksum serial = {0, 0, 0, 0};
+    for (int mode = 0; mode < 3; mode++) {
+        // 0 = ปรับระยะเวลาตามความหนาแน่น (แบบเดิม), 1 = max-pressure (1 เธรด), 2 = max-pressure (2 เธรด ต้องได้ผลเหมือน 1 เธรด)
+        Graph* graph = create_grid_network(rows, cols, 42);
+        SignalSystem* signal_system = create_signal_system(graph);
+        SimulationConfig config = default_simulation_config();
+        config.seed = 77;
+        config.initial_capacity = num_vehicles;
+        config.speed_variation = 0.1f;
+        config.signal_gating = true;
+        config.num_threads = (mode == 2) ? 2 : 1;
+        TrafficSimulation* sim = create_simulation_with_config(graph, signal_system, &config);
+        if (mode > 0) {
+            set_max_pressure_control(graph, signal_system, sim->junction_queues, decision_interval, config.num_threads);
+        }
+        generate_random_traffic(sim, num_vehicles);
+        sim->is_running = true;
+        
+        double start = monotonic_seconds();
+        for (int t = 0; t < num_ticks; t++) {
+            update_simulation(sim);
+        }
+        double elapsed = monotonic_seconds() - start;
+        
+        SimulationChecksum checksum = simulation_checksum(sim);
+        if (mode == 1) {
+            serial = checksum;
+        }
+        bool same = (checksum.completed == serial.completed && checksum.traveling == serial.traveling &&
+                     checksum.total_load == serial.total_load &&
+                     checksum.total_position == serial.total_position);
+        
+        const MaxPressureController* controller = signal_system->controller;
+        char rate[32] = "-";
+        if (controller != NULL && controller->decision_time > 0.0) {
+            snprintf(rate, sizeof(rate), "%.0f", controller->decisions / controller->decision_time);
+        }
+        const char* names[3] = {"adaptive cycle", "max-pressure (1 th)", "max-pressure (2 th)"};
+        printf("%-19s | %9.1f | %9ld | %7ld | %14ld | %11s | %s\n", names[mode],
+               (elapsed > 0.0) ? num_ticks / elapsed : 0.0, sim->completed_vehicles,
+               count_waiting_vehicles(sim->junction_queues), signal_system->phase_changes, rate,
+               (mode == 0) ? "-" : (same ? "same" : "DIFFERENT"));
+        
+        free_simulation(sim);
+        free_signal_system(signal_system);
+        free_graph(graph);
+    }
+    
+    // อัตราการตัดสินใจเมื่อทุกทางแยกของเครือข่ายขนาดใหญ่ตัดสินใจพร้อมกัน
+    Graph* graph = create_grid_network(rows * 10, cols * 10, 42);
+    randomize_road_loads(graph, 7);
+    SignalSystem* signal_system = create_signal_system(graph);
+    int n = signal_system->num_signals;
+    int* all_signals = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        all_signals[i] = i;
+    }
+    int thread_counts[2] = {1, available_cpu_count()};
+    for (int k = 0; k < 2; k++) {
+        set_max_pressure_control(graph, signal_system, NULL, decision_interval, thread_counts[k]);
+        for (int r = 0; r < 20; r++) {
+            run_max_pressure_decisions(signal_system, all_signals, n);
+        }
+        const MaxPressureController* controller = signal_system->controller;
+        printf("All %d junctions of a %dx%d grid, %d thread(s): %.0f decisions/s\n", n, rows * 10, cols * 10,
+               thread_counts[k], (controller->decision_time > 0.0) ? controller->decisions / controller->decision_time : 0.0);
+    }
+    
+    free(all_signals);
+    free_signal_system(signal_system);
+    free_graph(graph);
+}
+
+// ฟังก์ชันสำหรับวัดการค้นหา offset ของคลื่นไฟเขียวแบบขนาน และตรวจการเขียน/อ่านไฟล์ offset
+void benchmark_green_wave(int rows, int cols, int num_vehicles, int num_ticks) {
+    printf("\n=== Benchmark: Green Wave Offsets (%dx%d grid, %d vehicles, %d ticks per candidate) ===\n",
+           rows, cols, num_vehicles, num_ticks);
+    
+    const char* path = "benchmark_offsets.txt";
+    
+    Graph* graph = create_grid_network(rows, cols, 42);
+    SignalSystem* signal_system = create_signal_system(graph);
+    SimulationConfig config = default_simulation_config();
+    config.seed = 77;
+    
+    GreenWaveCorridors* corridors = find_green_wave_corridors(graph, signal_system, GREEN_WAVE_MIN_LANES);
+    int longest = 0;
+    for (int c = 0; c < corridors->num_corridors; c++) {
+        int length = corridors->corridor_offset[c + 1] - corridors->corridor_offset[c];
+        if (length > longest) {
+            longest = length;
+        }
+    }
+    printf("Corridors: %d (%d junctions, longest %d) of %d signals\n", corridors->num_corridors,
+           corridors->corridor_offset[corridors->num_corridors], longest, signal_system->num_signals);
+    free_green_wave_corridors(corridors);
+    
+    // การค้นหาต้องได้ผลเหมือนกันไม่ว่าจะใช้กี่เธรด
+    GreenWaveResult* serial = optimize_green_wave(graph, signal_system, &config, GREEN_WAVE_CYCLE, num_vehicles,
+                                                  num_ticks, 1);
+    GreenWaveResult* parallel = optimize_green_wave(graph, signal_system, &config, GREEN_WAVE_CYCLE, num_vehicles,
+                                                    num_ticks, available_cpu_count());
+    print_green_wave_result(parallel);
+    
+    bool same = (serial->num_candidates == parallel->num_candidates && serial->best == parallel->best);
+    for (int c = 0; same && c < serial->num_candidates; c++) {
+        same = (serial->completed[c] == parallel->completed[c] && serial->waiting[c] == parallel->waiting[c]);
+    }
+    for (int i = 0; same && i < signal_system->num_signals; i++) {
+        same = (serial->offsets[i] == parallel->offsets[i]);
+    }
+    printf("1 thread: %.3f s, %d threads: %.3f s (speedup %.2fx), result: %s\n", serial->wall_time,
+           parallel->num_threads, parallel->wall_time,
+           (parallel->wall_time > 0.0) ? serial->wall_time / parallel->wall_time : 0.0, same ? "same" : "DIFFERENT");
+    
+    // เขียน offset ลงไฟล์ แล้วอ่านกลับ สถานะของสัญญาณไฟต้องเหมือนกับการเลื่อนโดยตรง
+    bool round_trip = save_signal_offsets(signal_system, parallel->cycle, parallel->offsets, path);
+    SignalSystem* loaded = round_trip ? create_signal_system_with_offsets(graph, path) : NULL;
+    round_trip = (loaded != NULL);
+    apply_green_wave_offsets(signal_system, parallel->cycle, parallel->offsets);
+    for (int i = 0; round_trip && i < signal_system->num_signals; i++) {
+        const TrafficSignal* expected = &signal_system->signals[i];
+        const TrafficSignal* actual = &loaded->signals[i];
+        round_trip = (expected->current_phase == actual->current_phase && expected->is_adaptive == actual->is_adaptive);
+        for (int p = 0; round_trip && p < expected->num_phases; p++) {
+            round_trip = (expected->phases[p].state == actual->phases[p].state &&
+                          expected->durations[p] == actual->durations[p] &&
+                          expected->remaining_times[p] == actual->remaining_times[p]);
+        }
+    }
+    printf("Offset file round trip: %s\n", round_trip ? "same" : "DIFFERENT");
+    remove(path);
+    
+    // หลังจำลองหลายรอบ (รวมการปรับระยะเวลาของสัญญาณไฟอื่นตามความหนาแน่น) เฟสของสัญญาณไฟที่ประสานต้องยังตรงกับ offset
+    int kept = 0;
+    if (loaded != NULL) {
+        config.signal_gating = true;
+        config.initial_capacity = num_vehicles;
+        TrafficSimulation* sim = create_simulation_with_config(graph, loaded, &config);
+        generate_random_traffic(sim, num_vehicles);
+        sim->is_running = true;
+        for (int t = 0; t < num_ticks; t++) {
+            update_simulation(sim);
+        }
+        
+        sync_signal_remaining_times(loaded);
+        long now = timing_wheel_time(loaded->phase_timers);
+        for (int i = 0; i < loaded->num_signals; i++) {
+            TrafficSignal* signal = &loaded->signals[i];
+            if (parallel->offsets[i] < 0) {
+                continue;
+            }
+            int phase = signal->current_phase;
+            int remaining = signal->remaining_times[phase];
+            set_signal_offset(signal, parallel->offsets[i], now);
+            if (signal->current_phase == phase && signal->remaining_times[phase] == remaining) {
+                kept++;
+            }
+        }
+        free_simulation(sim);
+    }
+    printf("Offsets kept after %d ticks: %d / %d coordinated signals\n", num_ticks, kept, parallel->num_coordinated);
+    
+    free_signal_system(loaded);
+    free_green_wave_result(serial);
+    free_green_wave_result(parallel);
+    free_signal_system(signal_system);
+    free_graph(graph);
+}
+
+// ฟังก์ชันสำหรับเรียกชุดวัดประสิทธิภาพตามชื่อ ("all" = ทั้งหมด)
+int run_benchmark(const char* name) {
+    bool all = (strcmp(name, "all") == 0);
+    bool found = false;
+    
+    if (all || strcmp(name, "int-routing") == 0) {
+        benchmark_integer_routing(100, 100, 500);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "alt") == 0) {
+        benchmark_alt_routing(100, 100, 500, 16);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "hub-labels") == 0) {
+        benchmark_hub_labels(40, 40, 500);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "isochrone") == 0) {
+        benchmark_isochrones(100, 100, 200, 2.0f);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "churn") == 0) {
+        benchmark_vehicle_churn(20, 20, 3600, 10);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "parallel") == 0) {
+        int cpus = available_cpu_count();
+        benchmark_parallel_ticks(20, 20, 100000, 600, (cpus > 4) ? cpus : 4);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "events") == 0) {
+        benchmark_event_simulation(20, 20, 20000, 3600);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "link-model") == 0) {
+        benchmark_link_model(20, 20, 100000, 1800);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "fast-forward") == 0) {
+        benchmark_fast_forward(20, 20, 20000, 3600, 60);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "reroute") == 0) {
+        benchmark_rerouting(20, 20, 50000, 1800, 30);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "demand") == 0) {
+        benchmark_demand_release(20, 20, 2000, 25, 3600);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "checkpoint") == 0) {
+        benchmark_checkpoint(20, 20, 100000, 900, 300);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "recorder") == 0) {
+        benchmark_trajectory_recorder(20, 20, 100000, 600);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "gating") == 0) {
+        benchmark_signal_gating(20, 20, 50000, 1800);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "ensemble") == 0) {
+        benchmark_ensemble(20, 20, 16, 5000, 600);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "signal-queue") == 0) {
+        benchmark_signal_queue(400, 20);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "junction-loads") == 0) {
+        benchmark_junction_loads(60, 60, 10000, 200);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "signal-timing") == 0) {
+        benchmark_signal_timing(200, 600);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "max-pressure") == 0) {
+        benchmark_max_pressure(20, 20, 20000, 1800, DEFAULT_PRESSURE_INTERVAL);
+        found = true;
+    }
+    
+    if (all || strcmp(name, "green-wave") == 0) {
+        benchmark_green_wave(20, 20, 3000, 1800);
+        found = true;
+    }
+    
+    if (!found) {
+        fprintf(stderr, "Error: Unknown benchmark '%s'\n", name);
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,71 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ 
+ // ฟังก์ชันสำหรับวัดประสิทธิภาพการค้นหาเส้นทางแบบจำนวนเต็มเทียบกับแบบทศนิยม
+ void benchmark_integer_routing(int rows, int cols, int num_queries);
+ 
+ // ฟังก์ชันสำหรับวัดประสิทธิภาพการค้นหาเส้นทางแบบ ALT เทียบกับ Dijkstra
+ void benchmark_alt_routing(int rows, int cols, int num_queries, int num_landmarks);
+ 
+ // ฟังก์ชันสำหรับวัดประสิทธิภาพการหาเวลาเดินทางด้วยป้ายกำกับฮับ
+ void benchmark_hub_labels(int rows, int cols, int num_queries);
+ 
+ // ฟังก์ชันสำหรับวัดประสิทธิภาพการคำนวณพื้นที่ที่เดินทางถึงได้ด้วย PHAST เทียบกับการค้นหาด้วยฮีป
+ void benchmark_isochrones(int rows, int cols, int num_sources, float budget);
+ 
+ // ฟังก์ชันสำหรับวัดประสิทธิภาพการจำลองระยะยาวที่มียานพาหนะเข้าและออกอย่างต่อเนื่อง
+ void benchmark_vehicle_churn(int rows, int cols, int num_ticks, int arrivals_per_tick);
+ 
+ // ฟังก์ชันสำหรับวัดการเพิ่มความเร็วของการอัปเดตแบบขนานตั้งแต่ 1 เธรดถึง max_threads เธรด
+ void benchmark_parallel_ticks(int rows, int cols, int num_vehicles, int num_ticks, int max_threads);
+ 
+ // ฟังก์ชันสำหรับวัดประสิทธิภาพการจำลองแบบเหตุการณ์เทียบกับการอัปเดตทุกขั้นตอนเวลา
+ void benchmark_event_simulation(int rows, int cols, int num_vehicles, int duration);
+ 
+ // ฟังก์ชันสำหรับวัดประสิทธิภาพของแบบจำลองคิวของถนนเทียบกับการจำลองรายคัน
+ void benchmark_link_model(int rows, int cols, int num_trips, int num_ticks);
+ 
+ // ฟังก์ชันสำหรับวัดประสิทธิภาพการเร่งการจำลองเทียบกับการอัปเดตทีละขั้นตอนเวลา
+ void benchmark_fast_forward(int rows, int cols, int num_vehicles, int num_ticks, int batch);
+ 
+ // ฟังก์ชันสำหรับวัดผลของการเปลี่ยนเส้นทางระหว่างเดินทางเทียบกับการใช้เส้นทางเดิมตลอด
+ void benchmark_rerouting(int rows, int cols, int num_vehicles, int num_ticks, int interval);
+ 
+ // ฟังก์ชันสำหรับวัดหน่วยความจำและเวลาของการปล่อยการเดินทางตามเวลาออกเดินทางเทียบกับการเพิ่มทั้งหมดตั้งแต่เริ่ม
+ void benchmark_demand_release(int rows, int cols, int num_pairs, int trips_per_pair, int num_ticks);
+ 
+ // ฟังก์ชันสำหรับวัดเวลาของการบันทึกและกู้คืนสถานะเทียบกับการจำลองซ้ำจนถึงเวลาเดียวกัน
+ void benchmark_checkpoint(int rows, int cols, int num_vehicles, int warmup_ticks, int continue_ticks);
+ 
+ // ฟังก์ชันสำหรับวัดผลของการบันทึกเส้นทางการเคลื่อนที่ต่อความเร็วของการจำลอง และตรวจว่าอ่านไฟล์กลับได้ถูกต้อง
+ void benchmark_trajectory_recorder(int rows, int cols, int num_vehicles, int num_ticks);
+ 
+ // ฟังก์ชันสำหรับวัดผลของการให้ยานพาหนะรอไฟเขียวที่ทางแยกเทียบกับการผ่านทางแยกทันที
+ void benchmark_signal_gating(int rows, int cols, int num_vehicles, int num_ticks);
+ 
+ // ฟังก์ชันสำหรับวัดประสิทธิภาพของกลุ่มการจำลองที่ใช้เครือข่ายร่วมกันตามจำนวนเธรด
+ void benchmark_ensemble(int rows, int cols, int num_replicas, int num_vehicles, int num_ticks);
+ 
+ // ฟังก์ชันสำหรับวัดเวลาของการปรับค่าความสำคัญในคิวของสัญญาณไฟตามขนาดของเครือข่าย
+ void benchmark_signal_queue(int max_side, int num_rounds);
+ 
+ // ฟังก์ชันสำหรับวัดเวลาของการอัปเดตสัญญาณไฟเมื่ออ่านเฉพาะทางแยกที่เปลี่ยนเทียบกับการคำนวณทุกทางแยกใหม่
+ void benchmark_junction_loads(int rows, int cols, int num_vehicles, int num_ticks);
+ 
+ // ฟังก์ชันสำหรับวัดเวลาของการเปลี่ยนเฟสด้วยวงล้อเวลาเทียบกับการนับถอยหลังของทุกสัญญาณไฟทุกวินาที
+ void benchmark_signal_timing(int max_side, int num_seconds);
+ 
+ // ฟังก์ชันสำหรับวัดอัตราการตัดสินใจและปริมาณการจราจรที่ผ่านเครือข่ายของตัวควบคุมแบบ max-pressure เทียบกับแบบเดิม
+ void benchmark_max_pressure(int rows, int cols, int num_vehicles, int num_ticks, int decision_interval);
+ 
+ // ฟังก์ชันสำหรับวัดการค้นหา offset ของคลื่นไฟเขียวแบบขนาน และตรวจการเขียน/อ่านไฟล์ offset
+ void benchmark_green_wave(int rows, int cols, int num_vehicles, int num_ticks);
+ 
+ // ฟังก์ชันสำหรับเรียกชุดวัดประสิทธิภาพตามชื่อ ("all" = ทั้งหมด)
+ int run_benchmark(const char* name);
+ 
+ #endif
@@ -0,0 +1,626 @@
+/*
+* checkpoint.c
+* การบันทึกและกู้คืนสถานะทั้งหมดของการจำลองด้วยไฟล์ไบนารี
+*/
+
+#include "checkpoint.h"
+#include "junction_queue.h"
+#include <string.h>
+
+// ค่าสถานะและการตั้งค่าของการจำลองที่บันทึกเป็นก้อนเดียว
+typedef struct {
+    uint64_t seed;              // seed ของเลขสุ่ม
+    uint64_t traffic_counter;   // ตัวนับของกระแสเลขสุ่มสำหรับสร้างการจราจร
+    int64_t total_vehicles;     // จำนวนยานพาหนะที่เพิ่มเข้ามาทั้งหมด
+    int64_t completed_vehicles; // จำนวนยานพาหนะที่ถึงจุดหมายแล้ว
+    int64_t next_trip_id;       // หมายเลขการเดินทางถัดไป
+    float dt;                   // ความยาวของหนึ่งขั้นตอนเวลา (วินาที)
+    float speed_variation;      // ความแตกต่างของความเร็วระหว่างผู้ขับขี่
+    float reroute_threshold;    // เกณฑ์ของการเปลี่ยนเส้นทาง
+    int32_t reroute_interval;   // ช่วงของการเปลี่ยนเส้นทาง (ขั้นตอนเวลา)
+    int32_t time_step;          // ขั้นตอนเวลาปัจจุบัน
+    int32_t signal_seconds;     // จำนวนวินาทีที่อัปเดตสัญญาณไฟไปแล้ว
+    int32_t is_running;         // การจำลองกำลังทำงานหรือไม่
+    int32_t num_vehicles;       // จำนวนยานพาหนะที่กำลังเดินทาง
+    int32_t num_handles;        // จำนวนตัวระบุที่เคยใช้
+    int32_t num_free_handles;   // จำนวนตัวระบุที่ว่าง
+    int32_t queue_size;         // จำนวนสมาชิกในคิวของสัญญาณไฟ
+    int32_t num_approaches;     // จำนวนคิวรอไฟเขียวของถนนขาเข้า (0 = ไม่ใช้ signal_gating)
+} CheckpointState;
+
+// ข้อมูลของเส้นทางหนึ่งเส้นที่บันทึกก่อนอาเรย์ของจุดยอด
+typedef struct {
+    int32_t length;             // จำนวนจุดยอดในเส้นทาง
+    int32_t has_planned_cost;   // มีต้นทุนสะสมตามแผนตามมาหรือไม่
+    float total_time;           // เวลาการเดินทางทั้งหมด
+    float total_distance;       // ระยะทางทั้งหมด
+} CheckpointRoute;
+
+// ฟังก์ชันสำหรับเขียนข้อมูลหนึ่งก้อนลงไฟล์ (คืนค่า false ถ้าเขียนไม่ครบ)
+static bool write_block(FILE* file, const void* data, size_t size, size_t count) {
+    if (count == 0) {
+        return true;
+    }
+    return fwrite(data, size, count, file) == count;
+}
+
+// ฟังก์ชันสำหรับอ่านข้อมูลหนึ่งก้อนจากไฟล์ (คืนค่า false ถ้าอ่านไม่ครบ)
+static bool read_block(FILE* file, void* data, size_t size, size_t count) {
+    if (count == 0) {
+        return true;
+    }
+    return fread(data, size, count, file) == count;
+}
+
+// ฟังก์ชันสำหรับคำนวณค่าแฮชของโครงสร้างเครือข่ายถนน (FNV-1a)
+static uint32_t topology_hash(const Graph* graph) {
+    uint32_t hash = 2166136261u;
+    
+    for (int v = 0; v < graph->num_vertices; v++) {
+        for (Edge* edge = graph->vertices[v].head; edge != NULL; edge = edge->next) {
+            int32_t values[5] = {v, edge->dest, edge->road->lanes, edge->road->capacity, 0};
+            memcpy(&values[4], &edge->road->length, sizeof(float));
+            
+            const unsigned char* bytes = (const unsigned char*)values;
+            for (size_t b = 0; b < sizeof(values); b++) {
+                hash = (hash ^ bytes[b]) * 16777619u;
+            }
+        }
+    }
+    
+    return hash;
+}
+
+// ฟังก์ชันสำหรับสร้างส่วนหัวของไฟล์จากการจำลอง
+static CheckpointHeader make_checkpoint_header(const TrafficSimulation* sim) {
+    CheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.num_vertices = sim->graph->num_vertices;
+    header.num_edges = sim->graph->num_edges;
+    header.num_signals = (sim->signal_system != NULL) ? sim->signal_system->num_signals : 0;
+    header.topology_hash = topology_hash(sim->graph);
+    
+    return header;
+}
+
+// ฟังก์ชันสำหรับสร้างตารางเส้นเชื่อมตาม Edge.id
+static Edge** collect_edges(Graph* graph) {
+    Edge** edges = (Edge**)calloc(graph->num_edges > 0 ? graph->num_edges : 1, sizeof(Edge*));
+    if (edges == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for checkpoint edges\n");
+        exit(1);
+    }
+    
+    for (int v = 0; v < graph->num_vertices; v++) {
+        for (Edge* edge = graph->vertices[v].head; edge != NULL; edge = edge->next) {
+            edges[edge->id] = edge;
+        }
+    }
+    
+    return edges;
+}
+
+// ฟังก์ชันสำหรับเขียนคอลัมน์ของยานพาหนะและเส้นทาง
+static bool write_vehicles(FILE* file, const TrafficSimulation* sim) {
+    const VehicleStore* store = &sim->vehicles;
+    int n = sim->num_vehicles;
+    
+    bool ok = write_block(file, store->current_pos, sizeof(int), n) &&
+              write_block(file, store->speed, sizeof(float), n) &&
+              write_block(file, store->road_end, sizeof(int), n) &&
+              write_block(file, store->route_index, sizeof(int), n) &&
+              write_block(file, store->handle_index, sizeof(int), n) &&
+              write_block(file, store->origin, sizeof(int), n) &&
+              write_block(file, store->destination, sizeof(int), n) &&
+              write_block(file, store->current_road, sizeof(int), n) &&
+              write_block(file, store->entered_at, sizeof(int), n) &&
+              write_block(file, store->handle_generation, sizeof(unsigned int), store->num_handles) &&
+              write_block(file, store->free_handles, sizeof(int), store->num_free_handles);
+    if (!ok) {
+        return false;
+    }
+    
+    // เส้นเชื่อมเก็บเป็น Edge.id และหมายเลขการเดินทางเป็น 64 บิตเสมอ
+    int32_t* edge_ids = (int32_t*)malloc((n > 0 ? n : 1) * sizeof(int32_t));
+    int64_t* trip_ids = (int64_t*)malloc((n > 0 ? n : 1) * sizeof(int64_t));
+    if (edge_ids == NULL || trip_ids == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for checkpoint\n");
+        exit(1);
+    }
+    
+    for (int i = 0; i < n; i++) {
+        edge_ids[i] = (store->current_edge[i] != NULL) ? store->current_edge[i]->id : -1;
+        trip_ids[i] = store->trip_id[i];
+    }
+    ok = write_block(file, edge_ids, sizeof(int32_t), n) && write_block(file, trip_ids, sizeof(int64_t), n);
+    
+    free(edge_ids);
+    free(trip_ids);
+    
+    for (int i = 0; ok && i < n; i++) {
+        const Route* route = store->route[i];
+        CheckpointRoute info;
+        memset(&info, 0, sizeof(info));
+        info.length = route->length;
+        info.has_planned_cost = (route->planned_cost != NULL);
+        info.total_time = route->total_time;
+        info.total_distance = route->total_distance;
+        
+        ok = write_block(file, &info, sizeof(info), 1) &&
+             write_block(file, route->path, sizeof(int), route->length);
+        if (ok && info.has_planned_cost) {
+            ok = write_block(file, route->planned_cost, sizeof(float), route->length);
+        }
+    }
+    
+    return ok;
+}
+
+// ฟังก์ชันสำหรับเขียนคิวรอไฟเขียวของถนนขาเข้า (ยานพาหนะเรียงจากหัวคิว)
+static bool write_approach_queues(FILE* file, const JunctionQueues* queues) {
+    if (queues == NULL) {
+        return true;
+    }
+    
+    int64_t counters[2] = {queues->arrived, queues->released};
+    bool ok = write_block(file, counters, sizeof(int64_t), 2) &&
+              write_block(file, &queues->longest_queue, sizeof(int), 1);
+    
+    for (int a = 0; ok && a < queues->num_approaches; a++) {
+        const SignalApproach* approach = &queues->approaches[a];
+        int32_t values[2] = {approach->count, approach->last_green};
+        ok = write_block(file, values, sizeof(int32_t), 2) && write_block(file, &approach->credit, sizeof(float), 1);
+        for (int i = 0; ok && i < approach->count; i++) {
+            ok = write_block(file, &approach->slots[(approach->head + i) & (approach->capacity - 1)],
+                             sizeof(VehicleHandle), 1);
+        }
+    }
+    
+    return ok;
+}
+
+// ฟังก์ชันสำหรับบันทึกสถานะทั้งหมดของการจำลองลงไฟล์ (คืนค่า false ถ้าเขียนไม่สำเร็จ)
+bool save_simulation_checkpoint(const TrafficSimulation* sim, const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Unable to open checkpoint file %s\n", path);
+        return false;
+    }
+    
+    Graph* graph = sim->graph;
+    SignalSystem* system = sim->signal_system;
+    
+    CheckpointHeader header = make_checkpoint_header(sim);
+    
+    CheckpointState state;
+    memset(&state, 0, sizeof(state));
+    state.seed = sim->config.seed;
+    state.traffic_counter = sim->traffic_counter;
+    state.total_vehicles = sim->total_vehicles;
+    state.completed_vehicles = sim->completed_vehicles;
+    state.next_trip_id = sim->next_trip_id;
+    state.dt = sim->config.dt;
+    state.speed_variation = sim->config.speed_variation;
+    state.reroute_threshold = sim->config.reroute_threshold;
+    state.reroute_interval = sim->config.reroute_interval;
+    state.time_step = sim->time_step;
+    state.signal_seconds = sim->signal_seconds;
+    state.is_running = sim->is_running;
+    state.num_vehicles = sim->num_vehicles;
+    state.num_handles = sim->vehicles.num_handles;
+    state.num_free_handles = sim->vehicles.num_free_handles;
+    state.queue_size = (system != NULL) ? system->queue->size : 0;
+    state.num_approaches = (sim->junction_queues != NULL) ? sim->junction_queues->num_approaches : 0;
+    
+    bool ok = write_block(file, &header, sizeof(header), 1) && write_block(file, &state, sizeof(state), 1);
+    
+    // จำนวนรถและน้ำหนักของเส้นเชื่อมตาม Edge.id
+    if (ok) {
+        int32_t* loads = (int32_t*)malloc((graph->num_edges > 0 ? graph->num_edges : 1) * sizeof(int32_t));
+        float* weights = (float*)malloc((graph->num_edges > 0 ? graph->num_edges : 1) * sizeof(float));
+        if (loads == NULL || weights == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for checkpoint\n");
+            exit(1);
+        }
+        
+        for (int e = 0; e < graph->num_edges; e++) {
+            loads[e] = graph->edge_loads[e];
+            weights[e] = graph->edge_weights[e];
+        }
+        ok = write_block(file, loads, sizeof(int32_t), graph->num_edges) &&
+             write_block(file, weights, sizeof(float), graph->num_edges);
+        
+        free(loads);
+        free(weights);
+    }
+    
+    // เฟสและเวลาที่เหลือของสัญญาณไฟ และคิวของสัญญาณไฟตามลำดับความสำคัญ
+    if (ok && system != NULL) {
+        sync_signal_remaining_times(system);
+    }
+    for (int s = 0; ok && s < header.num_signals; s++) {
+        const TrafficSignal* signal = &system->signals[s];
+        int32_t values[3] = {signal->current_phase, signal->num_phases, signal->is_adaptive ? 1 : 0};
+        ok = write_block(file, values, sizeof(int32_t), 3);
+    }
+    if (ok && system != NULL) {
+        ok = write_block(file, system->phases, sizeof(SignalPhase), system->num_phases) &&
+             write_block(file, system->phase_durations, sizeof(int), system->num_phases) &&
+             write_block(file, system->phase_remaining, sizeof(int), system->num_phases);
+    }
+    if (ok && system != NULL && system->queue->size > 0) {
+        QueueNode* entries = (QueueNode*)malloc(system->queue->size * sizeof(QueueNode));
+        if (entries == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for checkpoint\n");
+            exit(1);
+        }
+        int count = queue_entries_in_order(system->queue, entries);
+        for (int q = 0; ok && q < count; q++) {
+            ok = write_block(file, &entries[q].junction_id, sizeof(int), 1) &&
+                 write_block(file, &entries[q].priority, sizeof(float), 1);
+        }
+        free(entries);
+    }
+    
+    if (ok) {
+        ok = write_approach_queues(file, sim->junction_queues) && write_vehicles(file, sim);
+    }
+    
+    if (fclose(file) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        fprintf(stderr, "Error: Unable to write checkpoint file %s\n", path);
+    }
+    
+    return ok;
+}
+
+// ฟังก์ชันสำหรับตรวจว่าส่วนหัวของไฟล์ตรงกับการจำลองหรือไม่
+static bool check_checkpoint_header(const TrafficSimulation* sim, const CheckpointHeader* header, const char* path) {
+    if (memcmp(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic)) != 0) {
+        fprintf(stderr, "Error: %s is not a simulation checkpoint\n", path);
+        return false;
+    }
+    if (header->version != CHECKPOINT_VERSION) {
+        fprintf(stderr, "Error: Unsupported checkpoint version %u in %s\n", (unsigned int)header->version, path);
+        return false;
+    }
+    
+    CheckpointHeader expected = make_checkpoint_header(sim);
+    if (header->num_vertices != expected.num_vertices || header->num_edges != expected.num_edges ||
+        header->num_signals != expected.num_signals || header->topology_hash != expected.topology_hash) {
+        fprintf(stderr, "Error: Checkpoint %s was saved from a different road network\n", path);
+        return false;
+    }
+    
+    return true;
+}
+
+// ฟังก์ชันสำหรับตรวจค่าสถานะที่อ่านจากไฟล์ว่าอยู่ในช่วงที่ถูกต้อง
+static bool check_checkpoint_state(const CheckpointState* state) {
+    return state->dt > 0.0f && state->time_step >= 0 && state->num_vehicles >= 0 &&
+           state->num_handles >= state->num_vehicles &&
+           state->num_free_handles >= 0 && state->num_free_handles <= state->num_handles &&
+           state->num_vehicles + state->num_free_handles == state->num_handles &&
+           state->queue_size >= 0 && state->num_approaches >= 0;
+}
+
+// ฟังก์ชันสำหรับอ่านเฟสของสัญญาณไฟและคิวของสัญญาณไฟ
+static bool read_signals(FILE* file, SignalSystem* system, int queue_size) {
+    if (system == NULL) {
+        return true;
+    }
+    
+    // คิวมีสมาชิกได้หนึ่งตัวต่อทางแยกที่มีสัญญาณไฟ
+    if (queue_size > system->num_signals) {
+        return false;
+    }
+    
+    for (int s = 0; s < system->num_signals; s++) {
+        TrafficSignal* signal = &system->signals[s];
+        int32_t values[3];
+        if (!read_block(file, values, sizeof(int32_t), 3) || values[1] != signal->num_phases ||
+            values[0] < 0 || values[0] >= signal->num_phases || values[2] < 0 || values[2] > 1) {
+            return false;
+        }
+        
+        // สัญญาณไฟที่ใช้รอบคงที่ (เช่น ประสานแบบคลื่นไฟเขียว) ต้องไม่กลับไปปรับตามความหนาแน่นหลังกู้คืน
+        signal->current_phase = values[0];
+        signal->is_adaptive = (values[2] == 1);
+    }
+    
+    // ตารางเฟสของทุกสัญญาณไฟอ่านทั้งก้อน
+    if (!read_block(file, system->phases, sizeof(SignalPhase), system->num_phases) ||
+        !read_block(file, system->phase_durations, sizeof(int), system->num_phases) ||
+        !read_block(file, system->phase_remaining, sizeof(int), system->num_phases)) {
+        return false;
+    }
+    
+    // สร้างคิวใหม่ตามลำดับที่บันทึกไว้ (ค่าความสำคัญเท่ากันออกตามลำดับในไฟล์ ลำดับจึงเหมือนเดิม)
+    int* junction_ids = (int*)malloc((queue_size > 0 ? queue_size : 1) * sizeof(int));
+    float* priorities = (float*)malloc((queue_size > 0 ? queue_size : 1) * sizeof(float));
+    if (junction_ids == NULL || priorities == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for checkpoint\n");
+        exit(1);
+    }
+    bool ok = true;
+    for (int q = 0; ok && q < queue_size; q++) {
+        ok = read_block(file, &junction_ids[q], sizeof(int), 1) && read_block(file, &priorities[q], sizeof(float), 1) &&
+             junction_ids[q] >= 0;
+    }
+    if (ok) {
+        rebuild_priority_queue(system->queue, junction_ids, priorities, queue_size);
+        refresh_signal_schedule(system);
+    }
+    free(junction_ids);
+    free(priorities);
+    
+    return ok;
+}
+
+// ฟังก์ชันสำหรับอ่านคิวรอไฟเขียวของถนนขาเข้า (เขียนทับคิวเดิมทั้งหมด)
+static bool read_approach_queues(FILE* file, JunctionQueues* queues) {
+    if (queues == NULL) {
+        return true;
+    }
+    
+    int64_t counters[2];
+    if (!read_block(file, counters, sizeof(int64_t), 2) || !read_block(file, &queues->longest_queue, sizeof(int), 1)) {
+        return false;
+    }
+    queues->released = (long)counters[1];
+    
+    for (int a = 0; a < queues->num_approaches; a++) {
+        SignalApproach* approach = &queues->approaches[a];
+        int32_t values[2];
+        if (!read_block(file, values, sizeof(int32_t), 2) || values[0] < 0 ||
+            !read_block(file, &approach->credit, sizeof(float), 1)) {
+            return false;
+        }
+        
+        // push_approach_vehicle นับยานพาหนะที่มาถึงด้วย จึงคืนค่าตัวนับหลังอ่านครบ
+        approach->head = 0;
+        approach->count = 0;
+        approach->last_green = values[1];
+        for (int i = 0; i < values[0]; i++) {
+            VehicleHandle handle;
+            if (!read_block(file, &handle, sizeof(VehicleHandle), 1)) {
+                return false;
+            }
+            push_approach_vehicle(queues, a, handle);
+        }
+    }
+    queues->arrived = (long)counters[0];
+    
+    return true;
+}
+
+// ฟังก์ชันสำหรับอ่านเส้นทางหนึ่งเส้นเข้าสู่เส้นทางที่นำกลับมาใช้ (หรือสร้างใหม่)
+static Route* read_route(FILE* file, VehicleStore* store, int num_vertices) {
+    CheckpointRoute info;
+    if (!read_block(file, &info, sizeof(info), 1) || info.length < 0) {
+        return NULL;
+    }
+    
+    Route* route = (store->num_spare_routes > 0) ? store->spare_routes[--store->num_spare_routes]
+                                                 : create_route(info.length);
+    if (route->capacity < info.length) {
+        int* path = (int*)realloc(route->path, info.length * sizeof(int));
+        if (path == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for route\n");
+            exit(1);
+        }
+        route->path = path;
+        route->capacity = info.length;
+    }
+    
+    // ต้นทุนตามแผนมีขนาดเท่ากับ capacity เสมอ
+    free(route->planned_cost);
+    route->planned_cost = NULL;
+    if (info.has_planned_cost) {
+        route->planned_cost = (float*)malloc((route->capacity > 0 ? route->capacity : 1) * sizeof(float));
+        if (route->planned_cost == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for route\n");
+            exit(1);
+        }
+    }
+    
+    route->length = info.length;
+    route->total_time = info.total_time;
+    route->total_distance = info.total_distance;
+    
+    bool ok = read_block(file, route->path, sizeof(int), info.length);
+    if (ok && info.has_planned_cost) {
+        ok = read_block(file, route->planned_cost, sizeof(float), info.length);
+    }
+    for (int j = 0; ok && j < info.length; j++) {
+        ok = (route->path[j] >= 0 && route->path[j] < num_vertices);
+    }
+    
+    if (!ok) {
+        free_route(route);
+        return NULL;
+    }
+    return route;
+}
+
+// ฟังก์ชันสำหรับอ่านคอลัมน์ของยานพาหนะและเส้นทาง (คืนค่าจำนวนยานพาหนะที่อ่านครบ หรือ -1 ถ้าไฟล์เสียหาย)
+static int read_vehicles(FILE* file, TrafficSimulation* sim, const CheckpointState* state) {
+    VehicleStore* store = &sim->vehicles;
+    int n = state->num_vehicles;
+    
+    reserve_vehicle_store(sim, state->num_handles);
+    
+    bool ok = read_block(file, store->current_pos, sizeof(int), n) &&
+              read_block(file, store->speed, sizeof(float), n) &&
+              read_block(file, store->road_end, sizeof(int), n) &&
+              read_block(file, store->route_index, sizeof(int), n) &&
+              read_block(file, store->handle_index, sizeof(int), n) &&
+              read_block(file, store->origin, sizeof(int), n) &&
+              read_block(file, store->destination, sizeof(int), n) &&
+              read_block(file, store->current_road, sizeof(int), n) &&
+              read_block(file, store->entered_at, sizeof(int), n) &&
+              read_block(file, store->handle_generation, sizeof(unsigned int), state->num_handles) &&
+              read_block(file, store->free_handles, sizeof(int), state->num_free_handles);
+    if (!ok) {
+        return -1;
+    }
+    
+    int32_t* edge_ids = (int32_t*)malloc((n > 0 ? n : 1) * sizeof(int32_t));
+    int64_t* trip_ids = (int64_t*)malloc((n > 0 ? n : 1) * sizeof(int64_t));
+    if (edge_ids == NULL || trip_ids == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for checkpoint\n");
+        exit(1);
+    }
+    ok = read_block(file, edge_ids, sizeof(int32_t), n) && read_block(file, trip_ids, sizeof(int64_t), n);
+    
+    // แปลง Edge.id กลับเป็นเส้นเชื่อม และสร้างตารางตัวระบุใหม่จากตำแหน่งของยานพาหนะ
+    Graph* graph = sim->graph;
+    Edge** edges = collect_edges(graph);
+    
+    for (int h = 0; h < state->num_handles; h++) {
+        store->handle_slot[h] = -1;
+    }
+    for (int i = 0; ok && i < n; i++) {
+        int index = store->handle_index[i];
+        ok = (edge_ids[i] >= -1 && edge_ids[i] < graph->num_edges) &&
+             (index >= 0 && index < state->num_handles && store->handle_slot[index] == -1);
+        if (ok) {
+            store->current_edge[i] = (edge_ids[i] >= 0) ? edges[edge_ids[i]] : NULL;
+            store->trip_id[i] = (long)trip_ids[i];
+            store->completed[i] = false;
+            store->handle_slot[index] = i;
+        }
+    }
+    for (int f = 0; ok && f < state->num_free_handles; f++) {
+        int index = store->free_handles[f];
+        ok = (index >= 0 && index < state->num_handles && store->handle_slot[index] == -1);
+    }
+    
+    free(edges);
+    free(edge_ids);
+    free(trip_ids);
+    
+    store->num_handles = state->num_handles;
+    store->num_free_handles = state->num_free_handles;
+    
+    int restored = 0;
+    while (ok && restored < n) {
+        Route* route = read_route(file, store, graph->num_vertices);
+        if (route == NULL) {
+            ok = false;
+            break;
+        }
+        store->route[restored++] = route;
+    }
+    
+    if (!ok) {
+        // คืนเส้นทางที่อ่านแล้วและล้างตารางตัวระบุ เพื่อให้การจำลองว่างเปล่าแต่ใช้งานต่อได้
+        for (int i = 0; i < restored; i++) {
+            store->spare_routes[store->num_spare_routes++] = store->route[i];
+        }
+        for (int h = 0; h < state->num_handles; h++) {
+            store->handle_slot[h] = -1;
+            store->free_handles[h] = h;
+        }
+        store->num_free_handles = state->num_handles;
+        return -1;
+    }
+    
+    return n;
+}
+
+// ฟังก์ชันสำหรับกู้คืนสถานะของการจำลองจากไฟล์ (sim ต้องสร้างบนเครือข่ายถนนและระบบสัญญาณไฟชุดเดียวกัน)
+bool restore_simulation_checkpoint(TrafficSimulation* sim, const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Unable to open checkpoint file %s\n", path);
+        return false;
+    }
+    
+    CheckpointHeader header;
+    CheckpointState state;
+    if (!read_block(file, &header, sizeof(header), 1) || !check_checkpoint_header(sim, &header, path)) {
+        fclose(file);
+        return false;
+    }
+    if (!read_block(file, &state, sizeof(state), 1) || !check_checkpoint_state(&state)) {
+        fprintf(stderr, "Error: Checkpoint %s is corrupted\n", path);
+        fclose(file);
+        return false;
+    }
+    
+    int num_approaches = (sim->junction_queues != NULL) ? sim->junction_queues->num_approaches : 0;
+    if (state.num_approaches != num_approaches) {
+        fprintf(stderr, "Error: Checkpoint %s was saved with a different signal gating setting\n", path);
+        fclose(file);
+        return false;
+    }
+    
+    Graph* graph = sim->graph;
+    int num_edges = graph->num_edges;
+    int32_t* loads = (int32_t*)malloc((num_edges > 0 ? num_edges : 1) * sizeof(int32_t));
+    float* weights = (float*)malloc((num_edges > 0 ? num_edges : 1) * sizeof(float));
+    if (loads == NULL || weights == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for checkpoint\n");
+        exit(1);
+    }
+    if (!read_block(file, loads, sizeof(int32_t), num_edges) || !read_block(file, weights, sizeof(float), num_edges)) {
+        fprintf(stderr, "Error: Checkpoint %s is corrupted\n", path);
+        free(loads);
+        free(weights);
+        fclose(file);
+        return false;
+    }
+    
+    // นำยานพาหนะเดิมออก (เส้นทางถูกเก็บไว้ใช้กับยานพาหนะที่กู้คืน) แล้ววางจำนวนรถและน้ำหนักตามไฟล์
+    clear_vehicles(sim);
+    
+    for (int e = 0; e < num_edges; e++) {
+        graph->edge_loads[e] = loads[e];
+        graph->edge_weights[e] = weights[e];
+    }
+    refresh_junction_loads(graph);
+    graph->weight_version++;
+    free(loads);
+    free(weights);
+    
+    sim->config.seed = state.seed;
+    sim->config.dt = state.dt;
+    sim->config.speed_variation = state.speed_variation;
+    sim->config.reroute_interval = state.reroute_interval;
+    sim->config.reroute_threshold = state.reroute_threshold;
+    sim->step_scale = state.dt * 1000000.0f / 3600.0f;
+    sim->traffic_counter = state.traffic_counter;
+    sim->total_vehicles = (long)state.total_vehicles;
+    sim->completed_vehicles = (long)state.completed_vehicles;
+    sim->next_trip_id = (long)state.next_trip_id;
+    sim->time_step = state.time_step;
+    sim->signal_seconds = state.signal_seconds;
+    sim->is_running = state.is_running != 0;
+    
+    bool ok = read_signals(file, sim->signal_system, state.queue_size) &&
+              read_approach_queues(file, sim->junction_queues);
+    int restored = ok ? read_vehicles(file, sim, &state) : -1;
+    fclose(file);
+    
+    if (restored < 0) {
+        // ไม่มียานพาหนะบนถนนแล้ว จึงล้างจำนวนรถที่วางไว้
+        for (int e = 0; e < graph->num_edges; e++) {
+            graph->edge_loads[e] = 0;
+        }
+        refresh_junction_loads(graph);
+        update_edge_weight(graph);
+        refresh_route_cost_table(graph, sim->route_costs);
+        fprintf(stderr, "Error: Checkpoint %s is corrupted\n", path);
+        return false;
+    }
+    
+    sim->num_vehicles = restored;
+    refresh_route_cost_table(graph, sim->route_costs);
+    
+    return true;
+}
@@ -0,0 +1,35 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include <stdint.h>
+ #include "simulation.h"
+ 
+ // รหัสและรุ่นของรูปแบบไฟล์บันทึกสถานะ
+ #define CHECKPOINT_MAGIC "TSCP"
+ #define CHECKPOINT_VERSION 4
+ 
+ // ส่วนหัวของไฟล์บันทึกสถานะ (ใช้ตรวจว่าไฟล์ตรงกับเครือข่ายถนนที่จะกู้คืนหรือไม่)
+ typedef struct {
+     char magic[4];           // รหัสของไฟล์ ("TSCP")
+     uint32_t version;        // รุ่นของรูปแบบไฟล์
+     int32_t num_vertices;    // จำนวนทางแยกของเครือข่าย
+     int32_t num_edges;       // จำนวนเส้นเชื่อมของเครือข่าย
+     int32_t num_signals;     // จำนวนสัญญาณไฟจราจร
+     uint32_t topology_hash;  // ค่าแฮชของโครงสร้างเครือข่าย (ปลายทาง, ช่องทาง, ความจุ และความยาวของทุกเส้นเชื่อม)
+ } CheckpointHeader;
+ 
+ // ไฟล์บันทึกสถานะเป็นข้อมูลไบนารีตามลำดับไบต์ของเครื่อง (ใช้กู้คืนบนเครื่องชนิดเดียวกัน)
+ // เก็บคอลัมน์ของยานพาหนะ เส้นทาง จำนวนรถและน้ำหนักของเส้นเชื่อม เฟสของสัญญาณไฟ คิวรอไฟเขียว และตัวนับของเลขสุ่ม
+ // การกู้คืนอ่านคอลัมน์ทั้งก้อนเข้าที่เก็บโดยตรง จึงเร็วกว่าการจำลองซ้ำตั้งแต่เริ่มมาก
+ 
+ // ฟังก์ชันสำหรับบันทึกสถานะทั้งหมดของการจำลองลงไฟล์ (คืนค่า false ถ้าเขียนไม่สำเร็จ)
+ bool save_simulation_checkpoint(const TrafficSimulation* sim, const char* path);
+ 
+ // ฟังก์ชันสำหรับกู้คืนสถานะของการจำลองจากไฟล์ (sim ต้องสร้างบนเครือข่ายถนนและระบบสัญญาณไฟชุดเดียวกัน)
+ // คืนค่า false ถ้าไฟล์ไม่ถูกต้องหรือไม่ตรงกับเครือข่าย ถ้าไฟล์เสียหายระหว่างอ่านข้อมูลยานพาหนะ การจำลองจะว่างเปล่า
+ bool restore_simulation_checkpoint(TrafficSimulation* sim, const char* path);
+ 
+ #endif
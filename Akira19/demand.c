@@ -0,0 +1,284 @@
+/*
+* demand.c
+* การสร้างการเดินทางตามตาราง OD และรูปแบบเวลาออกเดินทาง โดยปล่อยยานพาหนะเมื่อถึงเวลา
+*/
+
+#include "demand.h"
+#include <string.h>
+#include <math.h>
+
+// ฟังก์ชันสำหรับสร้างตารางความต้องการเดินทางว่าง
+DemandModel* create_demand_model(int num_bins, int bin_seconds) {
+    if (num_bins <= 0 || bin_seconds <= 0) {
+        fprintf(stderr, "Error: Demand bins and bin length must be greater than 0\n");
+        return NULL;
+    }
+    
+    DemandModel* model = (DemandModel*)calloc(1, sizeof(DemandModel));
+    if (model == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for demand model\n");
+        exit(1);
+    }
+    
+    model->num_bins = num_bins;
+    model->bin_seconds = bin_seconds;
+    
+    return model;
+}
+
+// ฟังก์ชันสำหรับเพิ่มรูปแบบเวลาออกเดินทาง (weights มี num_bins ค่า, คืนค่าดัชนี หรือ -1 ถ้าไม่ถูกต้อง)
+int add_demand_profile(DemandModel* model, const char* name, const float* weights) {
+    float total = 0.0f;
+    for (int b = 0; b < model->num_bins; b++) {
+        if (weights[b] < 0.0f) {
+            fprintf(stderr, "Error: Demand profile weights must not be negative\n");
+            return -1;
+        }
+        total += weights[b];
+    }
+    if (total <= 0.0f) {
+        fprintf(stderr, "Error: Demand profile '%s' has no departures\n", name);
+        return -1;
+    }
+    
+    if (model->num_profiles >= model->profile_capacity) {
+        int new_capacity = (model->profile_capacity > 0) ? model->profile_capacity * 2 : 4;
+        DemandProfile* profiles = (DemandProfile*)realloc(model->profiles, new_capacity * sizeof(DemandProfile));
+        if (profiles == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for demand profiles\n");
+            exit(1);
+        }
+        model->profiles = profiles;
+        model->profile_capacity = new_capacity;
+    }
+    
+    DemandProfile* profile = &model->profiles[model->num_profiles];
+    strncpy(profile->name, name, DEMAND_PROFILE_NAME_LENGTH - 1);
+    profile->name[DEMAND_PROFILE_NAME_LENGTH - 1] = '\0';
+    profile->cumulative = (float*)malloc((model->num_bins + 1) * sizeof(float));
+    if (profile->cumulative == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for demand profiles\n");
+        exit(1);
+    }
+    
+    // ปรับสัดส่วนให้รวมเป็นหนึ่งแล้วเก็บเป็นค่าสะสม
+    float sum = 0.0f;
+    profile->cumulative[0] = 0.0f;
+    for (int b = 0; b < model->num_bins; b++) {
+        sum += weights[b];
+        profile->cumulative[b + 1] = sum / total;
+    }
+    profile->cumulative[model->num_bins] = 1.0f;
+    
+    return model->num_profiles++;
+}
+
+// ฟังก์ชันสำหรับหารูปแบบเวลาออกเดินทางจากชื่อ (-1 = ไม่พบ)
+int find_demand_profile(const DemandModel* model, const char* name) {
+    for (int i = 0; i < model->num_profiles; i++) {
+        if (strcmp(model->profiles[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// ฟังก์ชันสำหรับเพิ่มแถวของตาราง OD
+bool add_demand_entry(DemandModel* model, int origin, int destination, int trips, int profile) {
+    if (trips < 0 || profile < 0 || profile >= model->num_profiles) {
+        fprintf(stderr, "Error: Invalid demand entry\n");
+        return false;
+    }
+    
+    if (model->num_entries >= model->entry_capacity) {
+        int new_capacity = (model->entry_capacity > 0) ? model->entry_capacity * 2 : 16;
+        DemandEntry* entries = (DemandEntry*)realloc(model->entries, new_capacity * sizeof(DemandEntry));
+        if (entries == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for demand entries\n");
+            exit(1);
+        }
+        model->entries = entries;
+        model->entry_capacity = new_capacity;
+    }
+    
+    // แถวใหม่ยังปล่อยไม่ครบ จึงสลับแถวแรกที่ปล่อยครบแล้วไปไว้ท้ายตาราง
+    DemandEntry entry = {origin, destination, trips, profile, 0};
+    if (model->num_active < model->num_entries) {
+        model->entries[model->num_entries] = model->entries[model->num_active];
+    }
+    model->entries[model->num_active] = entry;
+    model->num_active++;
+    model->num_entries++;
+    model->total_trips += trips;
+    
+    return true;
+}
+
+// ฟังก์ชันสำหรับอ่านตาราง OD จากไฟล์ข้อความ (คืนค่า NULL ถ้าอ่านไม่สำเร็จ)
+DemandModel* load_demand_file(const char* path, const Graph* graph) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Unable to open demand file '%s'\n", path);
+        return NULL;
+    }
+    
+    DemandModel* model = NULL;
+    float* weights = NULL;
+    char line[1024];
+    int line_number = 0;
+    bool ok = true;
+    
+    while (ok && fgets(line, sizeof(line), file) != NULL) {
+        line_number++;
+        
+        char* token = strtok(line, " \t\r\n");
+        if (token == NULL || token[0] == '#') {
+            continue;
+        }
+        
+        if (strcmp(token, "bins") == 0) {
+            char* count = strtok(NULL, " \t\r\n");
+            char* seconds = strtok(NULL, " \t\r\n");
+            if (model != NULL || count == NULL || seconds == NULL) {
+                ok = false;
+                break;
+            }
+            model = create_demand_model(atoi(count), atoi(seconds));
+            if (model == NULL) {
+                ok = false;
+                break;
+            }
+            weights = (float*)malloc(model->num_bins * sizeof(float));
+            if (weights == NULL) {
+                fprintf(stderr, "Error: Unable to allocate memory for demand profiles\n");
+                exit(1);
+            }
+        } else if (strcmp(token, "profile") == 0 && model != NULL) {
+            char* name = strtok(NULL, " \t\r\n");
+            int b = 0;
+            char* value;
+            while (name != NULL && b < model->num_bins && (value = strtok(NULL, " \t\r\n")) != NULL) {
+                weights[b++] = (float)atof(value);
+            }
+            if (name == NULL || b != model->num_bins || find_demand_profile(model, name) >= 0 ||
+                add_demand_profile(model, name, weights) < 0) {
+                ok = false;
+            }
+        } else if (strcmp(token, "od") == 0 && model != NULL) {
+            char* fields[4];
+            int n = 0;
+            while (n < 4 && (fields[n] = strtok(NULL, " \t\r\n")) != NULL) {
+                n++;
+            }
+            if (n != 4) {
+                ok = false;
+                break;
+            }
+            
+            int origin = atoi(fields[0]);
+            int destination = atoi(fields[1]);
+            if (origin < 0 || origin >= graph->num_vertices || destination < 0 || destination >= graph->num_vertices) {
+                fprintf(stderr, "Error: Invalid vertex ID\n");
+                ok = false;
+                break;
+            }
+            
+            int profile = find_demand_profile(model, fields[3]);
+            if (profile < 0) {
+                fprintf(stderr, "Error: Unknown demand profile '%s'\n", fields[3]);
+                ok = false;
+                break;
+            }
+            ok = add_demand_entry(model, origin, destination, atoi(fields[2]), profile);
+        } else {
+            ok = false;
+        }
+    }
+    
+    fclose(file);
+    free(weights);
+    
+    if (!ok || model == NULL) {
+        fprintf(stderr, "Error: Invalid demand file '%s' (line %d)\n", path, line_number);
+        free_demand_model(model);
+        return NULL;
+    }
+    
+    return model;
+}
+
+// ฟังก์ชันสำหรับคำนวณสัดส่วนของการเดินทางที่ออกเดินทางแล้ว ณ เวลา seconds
+static double departed_fraction(const DemandModel* model, const DemandProfile* profile, double seconds) {
+    double bin = seconds / model->bin_seconds;
+    if (bin >= model->num_bins) {
+        return 1.0;
+    }
+    if (bin <= 0.0) {
+        return 0.0;
+    }
+    
+    // กระจายสม่ำเสมอภายในช่วง
+    int b = (int)bin;
+    double within = bin - b;
+    return profile->cumulative[b] + within * (profile->cumulative[b + 1] - profile->cumulative[b]);
+}
+
+// ฟังก์ชันสำหรับปล่อยการเดินทางที่ถึงเวลาออกเดินทางเข้าสู่การจำลอง (คืนค่าจำนวนยานพาหนะที่เพิ่ม)
+int release_demand(DemandModel* model, TrafficSimulation* sim) {
+    double now = simulation_seconds(sim);
+    int added = 0;
+    
+    for (int i = 0; i < model->num_active; ) {
+        DemandEntry* entry = &model->entries[i];
+        double fraction = departed_fraction(model, &model->profiles[entry->profile], now);
+        int due = (int)floor(entry->trips * fraction + 1e-9);
+        
+        // ยานพาหนะถูกสร้างและหาเส้นทางเฉพาะตอนออกเดินทาง
+        for (; entry->released < due; entry->released++) {
+            VehicleHandle handle = add_vehicle(sim, entry->origin, entry->destination);
+            if (handle.index >= 0) {
+                added++;
+            } else {
+                model->dropped_trips++;
+            }
+            model->released_trips++;
+        }
+        
+        // แถวที่ปล่อยครบแล้วสลับไปไว้ท้ายช่วงที่ยังทำงาน จึงไม่ต้องตรวจอีก
+        if (entry->released >= entry->trips) {
+            DemandEntry done = *entry;
+            model->entries[i] = model->entries[model->num_active - 1];
+            model->entries[model->num_active - 1] = done;
+            model->num_active--;
+        } else {
+            i++;
+        }
+    }
+    
+    return added;
+}
+
+// ฟังก์ชันสำหรับตรวจสอบว่าปล่อยการเดินทางครบทุกแถวแล้วหรือไม่
+bool demand_finished(const DemandModel* model) {
+    return model->num_active == 0;
+}
+
+// ฟังก์ชันสำหรับแสดงข้อมูลสรุปของตาราง OD
+void print_demand_summary(const DemandModel* model) {
+    printf("Demand: %d OD pairs, %d profiles, %d bins of %d seconds\n",
+           model->num_entries, model->num_profiles, model->num_bins, model->bin_seconds);
+    printf("Trips: %ld total, %ld released, %ld dropped (no route)\n",
+           model->total_trips, model->released_trips, model->dropped_trips);
+}
+
+// ฟังก์ชันสำหรับลบตารางความต้องการเดินทางและคืนหน่วยความจำ
+void free_demand_model(DemandModel* model) {
+    if (model == NULL) return;
+    
+    for (int i = 0; i < model->num_profiles; i++) {
+        free(model->profiles[i].cumulative);
+    }
+    free(model->profiles);
+    free(model->entries);
+    free(model);
+}
@@ -0,0 +1,78 @@
+#ifndef DEMAND_H
+#define DEMAND_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include "graph.h"
+ #include "simulation.h"
+ 
+ // ความยาวสูงสุดของชื่อรูปแบบเวลาออกเดินทาง
+ #define DEMAND_PROFILE_NAME_LENGTH 32
+ 
+ // รูปแบบเวลาออกเดินทาง: สัดส่วนของการเดินทางในแต่ละช่วงเวลา (กระจายสม่ำเสมอภายในช่วง)
+ typedef struct {
+     char name[DEMAND_PROFILE_NAME_LENGTH]; // ชื่อของรูปแบบ
+     float* cumulative;       // สัดส่วนสะสม ณ ต้นแต่ละช่วง (ขนาด num_bins + 1, ค่าสุดท้าย = 1)
+ } DemandProfile;
+ 
+ // จำนวนการเดินทางระหว่างต้นทางและปลายทางหนึ่งคู่ (หนึ่งแถวของตาราง OD)
+ typedef struct {
+     int origin;              // ทางแยกต้นทาง
+     int destination;         // ทางแยกปลายทาง
+     int trips;               // จำนวนการเดินทางทั้งหมด
+     int profile;             // รูปแบบเวลาออกเดินทาง (ดัชนีใน profiles)
+     int released;            // จำนวนการเดินทางที่ปล่อยเข้าสู่การจำลองแล้ว
+ } DemandEntry;
+ 
+ // ความต้องการเดินทางที่เปลี่ยนตามเวลาจากตาราง OD
+ // ไม่สร้างการเดินทางทั้งหมดไว้ล่วงหน้า แต่คำนวณจำนวนที่ต้องออกเดินทางจนถึงเวลาปัจจุบันจากสัดส่วนสะสม
+ // แล้วเพิ่มยานพาหนะ (และหาเส้นทาง) เฉพาะเมื่อถึงเวลาออกเดินทาง หน่วยความจำจึงขึ้นกับจำนวนแถว
+ // ของตารางและยานพาหนะที่อยู่บนถนน ไม่ใช่จำนวนการเดินทางทั้งหมด
+ typedef struct {
+     int num_bins;            // จำนวนช่วงเวลา
+     int bin_seconds;         // ความยาวของแต่ละช่วง (วินาที)
+     DemandProfile* profiles; // รูปแบบเวลาออกเดินทาง
+     int num_profiles;
+     int profile_capacity;
+     DemandEntry* entries;    // แถวของตาราง OD
+     int num_entries;
+     int entry_capacity;
+     long total_trips;        // จำนวนการเดินทางทั้งหมดในตาราง
+     long released_trips;     // จำนวนการเดินทางที่ปล่อยแล้ว
+     long dropped_trips;      // จำนวนการเดินทางที่ปล่อยไม่สำเร็จ (หาเส้นทางไม่ได้)
+     int num_active;          // แถวที่ยังปล่อยไม่ครบอยู่ในช่วง [0, num_active)
+ } DemandModel;
+ 
+ // ฟังก์ชันสำหรับสร้างตารางความต้องการเดินทางว่าง
+ DemandModel* create_demand_model(int num_bins, int bin_seconds);
+ 
+ // ฟังก์ชันสำหรับเพิ่มรูปแบบเวลาออกเดินทาง (weights มี num_bins ค่า, คืนค่าดัชนี หรือ -1 ถ้าไม่ถูกต้อง)
+ int add_demand_profile(DemandModel* model, const char* name, const float* weights);
+ 
+ // ฟังก์ชันสำหรับหารูปแบบเวลาออกเดินทางจากชื่อ (-1 = ไม่พบ)
+ int find_demand_profile(const DemandModel* model, const char* name);
+ 
+ // ฟังก์ชันสำหรับเพิ่มแถวของตาราง OD
+ bool add_demand_entry(DemandModel* model, int origin, int destination, int trips, int profile);
+ 
+ // ฟังก์ชันสำหรับอ่านตาราง OD จากไฟล์ข้อความ (คืนค่า NULL ถ้าอ่านไม่สำเร็จ)
+ // รูปแบบ (บรรทัดที่ขึ้นต้นด้วย # เป็นหมายเหตุ):
+ //   bins <จำนวนช่วง> <วินาทีต่อช่วง>
+ //   profile <ชื่อ> <สัดส่วนช่วงที่ 1> ... <สัดส่วนช่วงสุดท้าย>
+ //   od <ต้นทาง> <ปลายทาง> <จำนวนการเดินทาง> <ชื่อรูปแบบ>
+ DemandModel* load_demand_file(const char* path, const Graph* graph);
+ 
+ // ฟังก์ชันสำหรับปล่อยการเดินทางที่ถึงเวลาออกเดินทางเข้าสู่การจำลอง (คืนค่าจำนวนยานพาหนะที่เพิ่ม)
+ int release_demand(DemandModel* model, TrafficSimulation* sim);
+ 
+ // ฟังก์ชันสำหรับตรวจสอบว่าปล่อยการเดินทางครบทุกแถวแล้วหรือไม่
+ bool demand_finished(const DemandModel* model);
+ 
+ // ฟังก์ชันสำหรับแสดงข้อมูลสรุปของตาราง OD
+ void print_demand_summary(const DemandModel* model);
+ 
+ // ฟังก์ชันสำหรับลบตารางความต้องการเดินทางและคืนหน่วยความจำ
+ void free_demand_model(DemandModel* model);
+ 
+ #endif
@@ -0,0 +1,215 @@
+/*
+* ensemble.c
+* กลุ่มการจำลองแบบมอนติคาร์โลที่ใช้เครือข่ายถนนชุดเดียวร่วมกัน และสรุปผลพร้อมช่วงความเชื่อมั่น
+*/
+
+#include "ensemble.h"
+#include <math.h>
+#include "thread_pool.h"
+#include "wall_clock.h"
+#include "max_pressure.h"
+
+// ค่าวิกฤตของ t-distribution สำหรับช่วงความเชื่อมั่น 95% (สองด้าน) ตามองศาอิสระ 1 ถึง 30
+static const double T_CRITICAL_95[30] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+// ข้อมูลที่ใช้ร่วมกันระหว่างเธรดของกลุ่มการจำลอง
+typedef struct {
+    const Graph* graph;                // กราฟต้นฉบับ (อ่านอย่างเดียว)
+    const SignalSystem* signal_system; // ระบบสัญญาณไฟต้นฉบับ (อ่านอย่างเดียว)
+    const SimulationConfig* config;    // การตั้งค่าของการจำลอง
+    int num_vehicles;                  // จำนวนยานพาหนะของแต่ละชุด
+    int num_ticks;                     // จำนวนขั้นตอนเวลาของแต่ละชุด
+    ReplicaResult* replicas;           // ผลของแต่ละชุด (แต่ละเธรดเขียนเฉพาะชุดของตัวเอง)
+} EnsembleTask;
+
+// ฟังก์ชันสำหรับเก็บตัวชี้วัดของการจำลองหนึ่งชุดเมื่อจบ
+static void collect_replica_result(const TrafficSimulation* sim, ReplicaResult* result) {
+    const Graph* graph = sim->graph;
+    const VehicleStore* store = &sim->vehicles;
+    
+    result->completed = sim->completed_vehicles;
+    result->traveling = sim->num_vehicles;
+    
+    // ความหนาแน่นเฉลี่ยของถนนทุกเส้น
+    double congestion = 0.0;
+    for (int v = 0; v < graph->num_vertices; v++) {
+        for (const Edge* edge = graph->vertices[v].head; edge != NULL; edge = edge->next) {
+            if (edge->road->capacity > 0) {
+                congestion += (double)edge_load(graph, edge) / edge->road->capacity;
+            }
+        }
+    }
+    result->mean_congestion = (graph->num_edges > 0) ? congestion / graph->num_edges : 0.0;
+    
+    // ความเร็วเฉลี่ยของยานพาหนะที่อยู่บนถนน (รวมคันที่หยุดรอ)
+    double speed = 0.0;
+    int on_road = 0;
+    for (int i = 0; i < sim->num_vehicles; i++) {
+        if (store->current_edge[i] != NULL) {
+            speed += store->speed[i];
+            on_road++;
+        }
+    }
+    result->mean_speed = (on_road > 0) ? speed / on_road : 0.0;
+}
+
+// ฟังก์ชันสำหรับรันการจำลองหนึ่งชุดบนสำเนาของกราฟและระบบสัญญาณไฟ
+static void run_replica(const EnsembleTask* task, int replica) {
+    ReplicaResult* result = &task->replicas[replica];
+    double start = monotonic_seconds();
+    
+    Graph* graph = create_graph_replica(task->graph);
+    SignalSystem* signal_system = clone_signal_system(task->signal_system);
+    
+    // ทุกชุดทำงานแบบลำดับภายในเธรดของตัวเอง ความขนานอยู่ที่ระดับชุด
+    SimulationConfig config = *task->config;
+    config.seed = random_u64(task->config->seed, RNG_STREAM_ENSEMBLE, (uint64_t)replica);
+    config.num_threads = 1;
+    if (config.initial_capacity < task->num_vehicles) {
+        config.initial_capacity = task->num_vehicles;
+    }
+    
+    TrafficSimulation* sim = create_simulation_with_config(graph, signal_system, &config);
+    copy_max_pressure_control(task->signal_system, graph, signal_system, sim->junction_queues);
+    generate_random_traffic(sim, task->num_vehicles);
+    sim->is_running = true;
+    double ready = monotonic_seconds();
+    
+    for (int t = 0; t < task->num_ticks; t++) {
+        update_simulation(sim);
+    }
+    
+    result->seed = config.seed;
+    collect_replica_result(sim, result);
+    result->setup_time = ready - start;
+    result->run_time = monotonic_seconds() - ready;
+    
+    free_simulation(sim);
+    free_signal_system(signal_system);
+    free_graph_replica(graph);
+}
+
+// ฟังก์ชันสำหรับรันการจำลองในช่วง [begin, end) ของหมายเลขชุด
+static void run_replica_range(void* ctx, int worker, int begin, int end) {
+    (void)worker;
+    const EnsembleTask* task = (const EnsembleTask*)ctx;
+    for (int r = begin; r < end; r++) {
+        run_replica(task, r);
+    }
+}
+
+// ฟังก์ชันสำหรับคำนวณค่าเฉลี่ย ส่วนเบี่ยงเบนมาตรฐาน และช่วงความเชื่อมั่น 95% ของตัวอย่าง
+static EnsembleStat summarize_samples(const double* samples, int count) {
+    EnsembleStat stat = {0.0, 0.0, 0.0};
+    if (count <= 0) {
+        return stat;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        stat.mean += samples[i];
+    }
+    stat.mean /= count;
+    
+    if (count > 1) {
+        double sum_squares = 0.0;
+        for (int i = 0; i < count; i++) {
+            double d = samples[i] - stat.mean;
+            sum_squares += d * d;
+        }
+        stat.stddev = sqrt(sum_squares / (count - 1));
+        
+        int df = count - 1;
+        double t = (df <= 30) ? T_CRITICAL_95[df - 1] : 1.96;
+        stat.half_width = t * stat.stddev / sqrt((double)count);
+    }
+    
+    return stat;
+}
+
+// ฟังก์ชันสำหรับรันการจำลอง num_replicas ชุดแบบขนาน (num_threads <= 0 = ใช้จำนวนแกนของเครื่อง)
+// แต่ละชุดสร้างการจราจรแบบสุ่ม num_vehicles คันแล้วจำลอง num_ticks ขั้นตอนเวลา (คืนค่า NULL ถ้าค่าไม่ถูกต้อง)
+EnsembleResult* run_simulation_ensemble(const Graph* graph, const SignalSystem* signal_system,
+                                        const SimulationConfig* config, int num_replicas,
+                                        int num_vehicles, int num_ticks, int num_threads) {
+    if (graph == NULL || signal_system == NULL || config == NULL) {
+        fprintf(stderr, "Error: Ensemble requires a network, a signal system and a configuration\n");
+        return NULL;
+    }
+    if (num_replicas <= 0 || num_vehicles <= 0 || num_ticks < 0) {
+        fprintf(stderr, "Error: Invalid ensemble size (replicas %d, vehicles %d, ticks %d)\n",
+                num_replicas, num_vehicles, num_ticks);
+        return NULL;
+    }
+    
+    EnsembleResult* result = (EnsembleResult*)calloc(1, sizeof(EnsembleResult));
+    ReplicaResult* replicas = (ReplicaResult*)calloc(num_replicas, sizeof(ReplicaResult));
+    double* samples = (double*)malloc(4 * (size_t)num_replicas * sizeof(double));
+    if (result == NULL || replicas == NULL || samples == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for ensemble results\n");
+        exit(1);
+    }
+    
+    if (num_threads <= 0) {
+        num_threads = available_cpu_count();
+    }
+    if (num_threads > num_replicas) {
+        num_threads = num_replicas;
+    }
+    
+    EnsembleTask task = {graph, signal_system, config, num_vehicles, num_ticks, replicas};
+    double start = monotonic_seconds();
+    
+    // แบ่งงานทีละชุดเพื่อให้เธรดที่ว่างขโมยชุดที่เหลือได้
+    ThreadPool* pool = create_thread_pool(num_threads);
+    parallel_for(pool, num_replicas, 1, run_replica_range, &task);
+    free_thread_pool(pool);
+    
+    result->wall_time = monotonic_seconds() - start;
+    result->num_replicas = num_replicas;
+    result->num_threads = num_threads;
+    result->replicas = replicas;
+    result->replica_bytes = sizeof(Graph) +
+                            (size_t)graph->num_vertices * (sizeof(JunctionLoad) + sizeof(int)) +
+                            (size_t)graph->num_edges * (sizeof(int) + sizeof(float));
+    
+    // สรุปตัวชี้วัดของทุกชุด (ตัวอย่างของตัวชี้วัดแต่ละตัวเรียงต่อกันใน samples)
+    for (int r = 0; r < num_replicas; r++) {
+        samples[r] = (double)replicas[r].completed;
+        samples[num_replicas + r] = (double)replicas[r].traveling;
+        samples[2 * num_replicas + r] = replicas[r].mean_congestion;
+        samples[3 * num_replicas + r] = replicas[r].mean_speed;
+    }
+    result->completed = summarize_samples(samples, num_replicas);
+    result->traveling = summarize_samples(samples + num_replicas, num_replicas);
+    result->congestion = summarize_samples(samples + 2 * num_replicas, num_replicas);
+    result->speed = summarize_samples(samples + 3 * num_replicas, num_replicas);
+    
+    free(samples);
+    return result;
+}
+
+// ฟังก์ชันสำหรับแสดงผลรวมของกลุ่มการจำลอง
+void print_ensemble_result(const EnsembleResult* result) {
+    printf("Ensemble: %d replicas on %d threads, %.3f s, %zu bytes per graph replica (topology shared)\n",
+           result->num_replicas, result->num_threads, result->wall_time, result->replica_bytes);
+    printf("Metric              | mean       | stddev     | 95%% CI\n");
+    
+    const char* names[4] = {"completed vehicles", "still traveling", "road congestion", "speed (km/h)"};
+    const EnsembleStat* stats[4] = {&result->completed, &result->traveling, &result->congestion, &result->speed};
+    for (int i = 0; i < 4; i++) {
+        printf("%-19s | %10.3f | %10.3f | [%.3f, %.3f]\n", names[i], stats[i]->mean, stats[i]->stddev,
+               stats[i]->mean - stats[i]->half_width, stats[i]->mean + stats[i]->half_width);
+    }
+}
+
+// ฟังก์ชันสำหรับลบผลของกลุ่มการจำลองและคืนหน่วยความจำ
+void free_ensemble_result(EnsembleResult* result) {
+    if (result == NULL) return;
+    
+    free(result->replicas);
+    free(result);
+}
@@ -0,0 +1,61 @@
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include <stdint.h>
+ #include "graph.h"
+ #include "traffic_signal.h"
+ #include "simulation.h"
+ 
+ // กลุ่มการจำลองแบบมอนติคาร์โล (ensemble)
+ // เครือข่ายถนนถูกสร้างหรือโหลดครั้งเดียว แล้วแต่ละชุดการจำลอง (replica) ได้สำเนาของส่วนที่เปลี่ยนแปลงได้
+ // (จำนวนรถ น้ำหนักของเส้นเชื่อม ผลรวมของทางแยก สัญญาณไฟ และยานพาหนะ) ส่วนทางแยก ถนน และจุดอ้างอิงใช้ร่วมกัน
+ // แต่ละชุดใช้ seed ที่ได้จาก (config.seed, หมายเลขชุด) ผลจึงเหมือนกันทุกจำนวนเธรด
+ // กราฟและระบบสัญญาณไฟต้นฉบับถูกอ่านอย่างเดียวระหว่างการทำงาน
+ 
+ // ผลของการจำลองหนึ่งชุด
+ typedef struct {
+     uint64_t seed;           // seed ของชุดนี้
+     long completed;          // จำนวนยานพาหนะที่ถึงจุดหมาย
+     long traveling;          // จำนวนยานพาหนะที่ยังเดินทางเมื่อจบ
+     double mean_congestion;  // ความหนาแน่นเฉลี่ยของถนน (จำนวนรถ / ความจุ) เมื่อจบ
+     double mean_speed;       // ความเร็วเฉลี่ยของยานพาหนะที่กำลังเคลื่อนที่เมื่อจบ (กม./ชม.)
+     double setup_time;       // เวลาที่ใช้สร้างสำเนาและยานพาหนะ (วินาที)
+     double run_time;         // เวลาที่ใช้จำลอง (วินาที)
+ } ReplicaResult;
+ 
+ // ค่าสถิติของตัวชี้วัดหนึ่งตัวจากทุกชุด
+ typedef struct {
+     double mean;             // ค่าเฉลี่ย
+     double stddev;           // ส่วนเบี่ยงเบนมาตรฐานของตัวอย่าง
+     double half_width;       // ครึ่งหนึ่งของช่วงความเชื่อมั่น 95% (t-distribution)
+ } EnsembleStat;
+ 
+ // ผลรวมของกลุ่มการจำลอง
+ typedef struct {
+     int num_replicas;        // จำนวนชุด
+     int num_threads;         // จำนวนเธรดที่ใช้
+     ReplicaResult* replicas; // ผลของแต่ละชุดเรียงตามหมายเลขชุด
+     EnsembleStat completed;  // จำนวนยานพาหนะที่ถึงจุดหมาย
+     EnsembleStat traveling;  // จำนวนยานพาหนะที่ยังเดินทาง
+     EnsembleStat congestion; // ความหนาแน่นเฉลี่ยของถนน
+     EnsembleStat speed;      // ความเร็วเฉลี่ย
+     size_t replica_bytes;    // ขนาดของสำเนากราฟหนึ่งชุด (จำนวนรถ น้ำหนัก และผลรวมของทางแยก ไม่รวมโครงข่ายที่ใช้ร่วมกัน) (ไบต์)
+     double wall_time;        // เวลาทั้งหมด (วินาที)
+ } EnsembleResult;
+ 
+ // ฟังก์ชันสำหรับรันการจำลอง num_replicas ชุดแบบขนาน (num_threads <= 0 = ใช้จำนวนแกนของเครื่อง)
+ // แต่ละชุดสร้างการจราจรแบบสุ่ม num_vehicles คันแล้วจำลอง num_ticks ขั้นตอนเวลา (คืนค่า NULL ถ้าค่าไม่ถูกต้อง)
+ EnsembleResult* run_simulation_ensemble(const Graph* graph, const SignalSystem* signal_system,
+                                         const SimulationConfig* config, int num_replicas,
+                                         int num_vehicles, int num_ticks, int num_threads);
+ 
+ // ฟังก์ชันสำหรับแสดงผลรวมของกลุ่มการจำลอง
+ void print_ensemble_result(const EnsembleResult* result);
+ 
+ // ฟังก์ชันสำหรับลบผลของกลุ่มการจำลองและคืนหน่วยความจำ
+ void free_ensemble_result(EnsembleResult* result);
+ 
+ #endif
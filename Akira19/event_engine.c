@@ -0,0 +1,359 @@
+/*
+* event_engine.c
+* การจำลองแบบเหตุการณ์ไม่ต่อเนื่องด้วยคิวแบบปฏิทิน
+*/
+
+#include "event_engine.h"
+
+// ---------------------------------------------------------------------------
+// คิวแบบปฏิทิน
+// ---------------------------------------------------------------------------
+
+// ฟังก์ชันสำหรับเพิ่มเหตุการณ์ลงในช่องของปฏิทิน
+static void bucket_push(CalendarBucket* bucket, VehicleEvent event) {
+    if (bucket->size >= bucket->capacity) {
+        int new_capacity = (bucket->capacity > 0) ? bucket->capacity * 2 : 4;
+        VehicleEvent* events = (VehicleEvent*)realloc(bucket->events, new_capacity * sizeof(VehicleEvent));
+        if (events == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for calendar queue\n");
+            exit(1);
+        }
+        bucket->events = events;
+        bucket->capacity = new_capacity;
+    }
+    
+    bucket->events[bucket->size++] = event;
+}
+
+// ฟังก์ชันสำหรับสร้างคิวแบบปฏิทิน
+CalendarQueue* create_calendar_queue(int num_buckets, int start_time) {
+    CalendarQueue* queue = (CalendarQueue*)malloc(sizeof(CalendarQueue));
+    if (queue == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for calendar queue\n");
+        exit(1);
+    }
+    
+    // ปัดจำนวนช่องขึ้นเป็นกำลังของสองเพื่อใช้ & แทน %
+    int n = 1;
+    while (n < num_buckets) {
+        n *= 2;
+    }
+    
+    queue->buckets = (CalendarBucket*)calloc(n, sizeof(CalendarBucket));
+    if (queue->buckets == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for calendar queue\n");
+        exit(1);
+    }
+    
+    queue->num_buckets = n;
+    queue->size = 0;
+    queue->current_time = start_time;
+    
+    return queue;
+}
+
+// ฟังก์ชันสำหรับขยายจำนวนช่องของปฏิทินเป็นสองเท่าและย้ายเหตุการณ์ทั้งหมด
+static void calendar_queue_resize(CalendarQueue* queue) {
+    int old_count = queue->num_buckets;
+    CalendarBucket* old_buckets = queue->buckets;
+    
+    queue->num_buckets = old_count * 2;
+    queue->buckets = (CalendarBucket*)calloc(queue->num_buckets, sizeof(CalendarBucket));
+    if (queue->buckets == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for calendar queue\n");
+        exit(1);
+    }
+    
+    int mask = queue->num_buckets - 1;
+    for (int b = 0; b < old_count; b++) {
+        for (int i = 0; i < old_buckets[b].size; i++) {
+            VehicleEvent event = old_buckets[b].events[i];
+            bucket_push(&queue->buckets[event.time & mask], event);
+        }
+        free(old_buckets[b].events);
+    }
+    free(old_buckets);
+}
+
+// ฟังก์ชันสำหรับเพิ่มเหตุการณ์ลงในคิว (เวลาต้องไม่น้อยกว่า current_time)
+void calendar_queue_insert(CalendarQueue* queue, VehicleEvent event) {
+    if (event.time < queue->current_time) {
+        event.time = queue->current_time;
+    }
+    
+    bucket_push(&queue->buckets[event.time & (queue->num_buckets - 1)], event);
+    queue->size++;
+    
+    // ให้แต่ละช่องมีเหตุการณ์เฉลี่ยไม่เกินสองเหตุการณ์
+    if (queue->size > queue->num_buckets * 2) {
+        calendar_queue_resize(queue);
+    }
+}
+
+// ฟังก์ชันสำหรับตรวจสอบว่าช่องมีเหตุการณ์ของเวลา time หรือไม่
+static bool bucket_has_time(const CalendarBucket* bucket, int time) {
+    for (int i = 0; i < bucket->size; i++) {
+        if (bucket->events[i].time == time) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ฟังก์ชันสำหรับหาเวลาของเหตุการณ์ถัดไปที่ไม่เกิน limit (-1 = ไม่มี)
+int calendar_queue_next_time(CalendarQueue* queue, int limit) {
+    if (queue->size == 0) {
+        return -1;
+    }
+    
+    int mask = queue->num_buckets - 1;
+    
+    // ไล่ช่องของปฏิทินตามวันไปหนึ่งปี
+    for (int t = queue->current_time; t < queue->current_time + queue->num_buckets; t++) {
+        if (t > limit) {
+            return -1;
+        }
+        if (bucket_has_time(&queue->buckets[t & mask], t)) {
+            queue->current_time = t;
+            return t;
+        }
+    }
+    
+    // ไม่มีเหตุการณ์ภายในหนึ่งปี: ค้นหาเวลาที่น้อยที่สุดโดยตรง
+    int earliest = -1;
+    for (int b = 0; b < queue->num_buckets; b++) {
+        for (int i = 0; i < queue->buckets[b].size; i++) {
+            int time = queue->buckets[b].events[i].time;
+            if (earliest < 0 || time < earliest) {
+                earliest = time;
+            }
+        }
+    }
+    
+    if (earliest > limit) {
+        return -1;
+    }
+    queue->current_time = earliest;
+    return earliest;
+}
+
+// ฟังก์ชันสำหรับนำเหตุการณ์ทั้งหมดของเวลา time ออกจากคิว (คืนค่าจำนวนเหตุการณ์)
+int calendar_queue_extract(CalendarQueue* queue, int time, VehicleEvent** batch, int* batch_capacity) {
+    CalendarBucket* bucket = &queue->buckets[time & (queue->num_buckets - 1)];
+    int count = 0;
+    
+    for (int i = 0; i < bucket->size; ) {
+        if (bucket->events[i].time != time) {
+            i++;
+            continue;
+        }
+        
+        if (count >= *batch_capacity) {
+            int new_capacity = (*batch_capacity > 0) ? *batch_capacity * 2 : 64;
+            VehicleEvent* grown = (VehicleEvent*)realloc(*batch, new_capacity * sizeof(VehicleEvent));
+            if (grown == NULL) {
+                fprintf(stderr, "Error: Unable to allocate memory for event batch\n");
+                exit(1);
+            }
+            *batch = grown;
+            *batch_capacity = new_capacity;
+        }
+        
+        // นำออกโดยสลับกับเหตุการณ์สุดท้ายของช่อง
+        (*batch)[count++] = bucket->events[i];
+        bucket->events[i] = bucket->events[--bucket->size];
+    }
+    
+    queue->size -= count;
+    if (time + 1 > queue->current_time) {
+        queue->current_time = time + 1;
+    }
+    
+    return count;
+}
+
+// ฟังก์ชันสำหรับลบคิวและคืนหน่วยความจำ
+void free_calendar_queue(CalendarQueue* queue) {
+    if (queue == NULL) return;
+    
+    for (int b = 0; b < queue->num_buckets; b++) {
+        free(queue->buckets[b].events);
+    }
+    free(queue->buckets);
+    free(queue);
+}
+
+// ---------------------------------------------------------------------------
+// เครื่องจำลองแบบเหตุการณ์
+// ---------------------------------------------------------------------------
+
+// ฟังก์ชันสำหรับคำนวณขั้นตอนเวลาที่ยานพาหนะถึงปลายถนนปัจจุบัน (-1 = ไม่ถึง)
+// ใน update_simulation ยานพาหนะเลื่อนครั้งละ step มิลลิเมตรทุกขั้นตอนเวลาหลังจากเข้าถนน
+// จึงถึงปลายถนนหลังจากเข้าถนน max(1, ceil(road_end / step)) ขั้นตอนเวลา
+static int vehicle_arrival_time(const TrafficSimulation* sim, int position) {
+    const VehicleStore* store = &sim->vehicles;
+    if (store->completed[position] || store->current_edge[position] == NULL) {
+        return -1;
+    }
+    
+    // ถนนที่ยาวเป็นศูนย์ถึงปลายถนนในขั้นตอนเวลาถัดไปเสมอ แม้ยานพาหนะจะหยุดนิ่ง
+    int road_end = store->road_end[position];
+    if (road_end <= 0) {
+        return store->entered_at[position] + 1;
+    }
+    
+    int step = vehicle_step_mm(store->speed[position], sim->step_scale);
+    if (step <= 0) {
+        return -1;
+    }
+    
+    int ticks = (road_end + step - 1) / step;
+    
+    return store->entered_at[position] + ticks;
+}
+
+// ฟังก์ชันสำหรับจัดตารางเหตุการณ์ของยานพาหนะที่ตำแหน่ง position
+static void schedule_position(EventEngine* engine, int position) {
+    int time = vehicle_arrival_time(engine->sim, position);
+    if (time < 0) {
+        return;
+    }
+    
+    VehicleEvent event;
+    event.time = time;
+    event.handle = get_vehicle_handle(engine->sim, position);
+    calendar_queue_insert(engine->queue, event);
+}
+
+// ฟังก์ชันสำหรับจัดตารางเหตุการณ์ของยานพาหนะที่เพิ่มเข้ามาหลังจากการจัดตารางครั้งก่อน
+// ยานพาหนะเรียงตามลำดับที่เพิ่มเข้ามา จึงไล่จากท้ายที่เก็บจนเจอยานพาหนะที่จัดตารางแล้ว
+static void schedule_new_vehicles(EventEngine* engine) {
+    TrafficSimulation* sim = engine->sim;
+    int first = sim->num_vehicles;
+    
+    while (first > 0 && sim->vehicles.trip_id[first - 1] >= engine->scheduled_trip_id) {
+        first--;
+    }
+    
+    for (int i = first; i < sim->num_vehicles; i++) {
+        schedule_position(engine, i);
+    }
+    
+    engine->scheduled_trip_id = sim->next_trip_id;
+}
+
+// ฟังก์ชันสำหรับสร้างเครื่องจำลองแบบเหตุการณ์และจัดตารางเหตุการณ์ของยานพาหนะทุกคันในการจำลอง
+EventEngine* create_event_engine(TrafficSimulation* sim) {
+    // ยานพาหนะที่รอไฟเขียวไม่มีเวลาถึงปลายถนนที่คำนวณล่วงหน้าได้
+    if (sim->junction_queues != NULL) {
+        fprintf(stderr, "Error: Event simulation does not support signal gating\n");
+        return NULL;
+    }
+    
+    EventEngine* engine = (EventEngine*)malloc(sizeof(EventEngine));
+    if (engine == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for event engine\n");
+        exit(1);
+    }
+    
+    engine->sim = sim;
+    engine->queue = create_calendar_queue(1024, sim->time_step + 1);
+    engine->scheduled_trip_id = 0;
+    engine->batch = NULL;
+    engine->batch_capacity = 0;
+    engine->events_processed = 0;
+    engine->stale_events = 0;
+    
+    schedule_new_vehicles(engine);
+    
+    return engine;
+}
+
+// ฟังก์ชันสำหรับจัดตารางเหตุการณ์ของยานพาหนะใหม่ (เรียกเมื่อความเร็วของยานพาหนะเปลี่ยนระหว่างถนน)
+// เหตุการณ์เดิมไม่ต้องลบ เพราะจะถูกข้ามเมื่อเวลาไม่ตรงกับเวลาที่คำนวณจากข้อมูลปัจจุบัน
+void schedule_vehicle_event(EventEngine* engine, VehicleHandle handle) {
+    int position = vehicle_position(engine->sim, handle);
+    if (position >= 0) {
+        schedule_position(engine, position);
+    }
+}
+
+// ฟังก์ชันสำหรับเลื่อนเวลาของการจำลองไปยัง time
+// ระหว่างเหตุการณ์การจราจรไม่เปลี่ยน การอัปเดตสัญญาณไฟรวดเดียวจึงได้ผลเหมือนอัปเดตทุกวินาที
+static void advance_clock(TrafficSimulation* sim, int time) {
+    if (sim->time_step < time) {
+        sim->time_step = time;
+        sync_signal_clock(sim);
+    }
+}
+
+// ฟังก์ชันสำหรับจำลองแบบเหตุการณ์เป็นเวลา duration ขั้นตอนเวลา (คืนค่าจำนวนเหตุการณ์ที่ประมวลผล)
+long run_event_simulation(EventEngine* engine, int duration) {
+    TrafficSimulation* sim = engine->sim;
+    if (!sim->is_running || duration <= 0) {
+        return 0;
+    }
+    
+    schedule_new_vehicles(engine);
+    
+    int end_time = sim->time_step + duration;
+    long processed = 0;
+    TickWorker* worker = &sim->workers[0];
+    
+    while (true) {
+        int time = calendar_queue_next_time(engine->queue, end_time);
+        if (time < 0) {
+            break;
+        }
+        
+        advance_clock(sim, time);
+        
+        int count = calendar_queue_extract(engine->queue, time, &engine->batch, &engine->batch_capacity);
+        
+        // ประมวลผลเหตุการณ์ของเวลาเดียวกันเป็นชุด โดยใช้การจราจร ณ ต้นขั้นตอนเวลาเหมือน update_simulation
+        reset_tick_worker(worker);
+        for (int i = 0; i < count; i++) {
+            int position = vehicle_position(sim, engine->batch[i].handle);
+            if (position < 0 || vehicle_arrival_time(sim, position) != time) {
+                engine->stale_events++;
+                continue;
+            }
+            
+            if (!advance_vehicle(sim, worker, position)) {
+                schedule_position(engine, position);
+            }
+            processed++;
+        }
+        
+        // ระหว่างเหตุการณ์การจราจรไม่เปลี่ยน จึงอัปเดตน้ำหนักเฉพาะเส้นเชื่อมที่จำนวนรถเปลี่ยน
+        int first_completed = worker->first_completed;
+        apply_load_changes(sim, worker, true);
+        if (first_completed >= 0) {
+            compact_vehicles(sim, first_completed);
+        }
+    }
+    
+    advance_clock(sim, end_time);
+    
+    // คำนวณตำแหน่งของยานพาหนะ ณ เวลาสุดท้าย (ระหว่างเหตุการณ์ไม่ได้เลื่อนตำแหน่ง)
+    VehicleStore* store = &sim->vehicles;
+    for (int i = 0; i < sim->num_vehicles; i++) {
+        int step = vehicle_step_mm(store->speed[i], sim->step_scale);
+        if (store->current_edge[i] != NULL && step > 0) {
+            store->current_pos[i] = (end_time - store->entered_at[i]) * step;
+        }
+    }
+    
+    engine->events_processed += processed;
+    sim->vehicle_updates += processed;
+    return processed;
+}
+
+// ฟังก์ชันสำหรับลบเครื่องจำลองแบบเหตุการณ์และคืนหน่วยความจำ
+void free_event_engine(EventEngine* engine) {
+    if (engine == NULL) return;
+    
+    free_calendar_queue(engine->queue);
+    free(engine->batch);
+    free(engine);
+}
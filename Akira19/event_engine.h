@@ -0,0 +1,73 @@
+#ifndef EVENT_ENGINE_H
+#define EVENT_ENGINE_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include "simulation.h"
+ 
+ // เหตุการณ์ที่ยานพาหนะถึงปลายถนนปัจจุบัน
+ typedef struct {
+     int time;                // ขั้นตอนเวลาที่ถึงปลายถนน
+     VehicleHandle handle;    // ยานพาหนะ
+ } VehicleEvent;
+ 
+ // ช่อง (วัน) ของปฏิทินหนึ่งช่อง
+ typedef struct {
+     VehicleEvent* events;    // เหตุการณ์ในช่องนี้ (ไม่เรียงลำดับ)
+     int size;                // จำนวนเหตุการณ์
+     int capacity;            // ขนาดของอาเรย์
+ } CalendarBucket;
+ 
+ // คิวแบบปฏิทิน (calendar queue) สำหรับเวลาที่เป็นจำนวนเต็ม
+ // เหตุการณ์เวลา t อยู่ในช่อง t % num_buckets หนึ่งรอบของปฏิทิน (ปี) จึงยาว num_buckets ขั้นตอนเวลา
+ // เหตุการณ์ของปีถัดไปอยู่ในช่องเดียวกันแต่ถูกข้ามจนกว่าจะถึงเวลา
+ typedef struct {
+     CalendarBucket* buckets; // ช่องของปฏิทิน
+     int num_buckets;         // จำนวนช่อง (กำลังของสอง ขยายเมื่อมีเหตุการณ์มากกว่า 2 เท่าของจำนวนช่อง)
+     int size;                // จำนวนเหตุการณ์ทั้งหมด
+     int current_time;        // เวลาปัจจุบันของคิว (ไม่มีเหตุการณ์ใดก่อนเวลานี้)
+ } CalendarQueue;
+ 
+ // เครื่องจำลองแบบเหตุการณ์ไม่ต่อเนื่อง (discrete-event)
+ // แทนที่จะเลื่อนยานพาหนะทุกคันทุกขั้นตอนเวลา จะคำนวณเวลาที่ยานพาหนะถึงปลายถนนไว้ล่วงหน้า
+ // แล้วกระโดดไปยังเวลาของเหตุการณ์ถัดไป ผลลัพธ์ตรงกับ update_simulation ทุกประการ
+ typedef struct {
+     TrafficSimulation* sim;  // การจำลองที่ใช้ข้อมูลร่วมกัน
+     CalendarQueue* queue;    // คิวของเหตุการณ์
+     long scheduled_trip_id;  // ยานพาหนะที่มีหมายเลขการเดินทางตั้งแต่ค่านี้ยังไม่ได้จัดตารางเหตุการณ์
+     VehicleEvent* batch;     // เหตุการณ์ของเวลาเดียวกันที่กำลังประมวลผล
+     int batch_capacity;      // ขนาดของอาเรย์ batch
+     long events_processed;   // จำนวนเหตุการณ์ที่ประมวลผลแล้ว
+     long stale_events;       // จำนวนเหตุการณ์ที่ถูกข้ามเพราะล้าสมัย
+ } EventEngine;
+ 
+ // ฟังก์ชันสำหรับสร้างคิวแบบปฏิทิน
+ CalendarQueue* create_calendar_queue(int num_buckets, int start_time);
+ 
+ // ฟังก์ชันสำหรับเพิ่มเหตุการณ์ลงในคิว (เวลาต้องไม่น้อยกว่า current_time)
+ void calendar_queue_insert(CalendarQueue* queue, VehicleEvent event);
+ 
+ // ฟังก์ชันสำหรับหาเวลาของเหตุการณ์ถัดไปที่ไม่เกิน limit (-1 = ไม่มี)
+ int calendar_queue_next_time(CalendarQueue* queue, int limit);
+ 
+ // ฟังก์ชันสำหรับนำเหตุการณ์ทั้งหมดของเวลา time ออกจากคิว (คืนค่าจำนวนเหตุการณ์)
+ int calendar_queue_extract(CalendarQueue* queue, int time, VehicleEvent** batch, int* batch_capacity);
+ 
+ // ฟังก์ชันสำหรับลบคิวและคืนหน่วยความจำ
+ void free_calendar_queue(CalendarQueue* queue);
+ 
+ // ฟังก์ชันสำหรับสร้างเครื่องจำลองแบบเหตุการณ์และจัดตารางเหตุการณ์ของยานพาหนะทุกคันในการจำลอง
+ // (คืนค่า NULL ถ้าการจำลองใช้ signal_gating)
+ EventEngine* create_event_engine(TrafficSimulation* sim);
+ 
+ // ฟังก์ชันสำหรับจัดตารางเหตุการณ์ของยานพาหนะใหม่ (เรียกเมื่อความเร็วของยานพาหนะเปลี่ยนระหว่างถนน)
+ void schedule_vehicle_event(EventEngine* engine, VehicleHandle handle);
+ 
+ // ฟังก์ชันสำหรับจำลองแบบเหตุการณ์เป็นเวลา duration ขั้นตอนเวลา (คืนค่าจำนวนเหตุการณ์ที่ประมวลผล)
+ long run_event_simulation(EventEngine* engine, int duration);
+ 
+ // ฟังก์ชันสำหรับลบเครื่องจำลองแบบเหตุการณ์และคืนหน่วยความจำ
+ void free_event_engine(EventEngine* engine);
+ 
+ #endif
@@ -10,6 +10,9 @@ Graph* create_graph(int num_vertices) {
     }
     
     graph->num_vertices = num_vertices;
+    graph->num_edges = 0;
+    graph->landmarks = NULL;
+    graph->weight_version = 0;
     graph->vertices = (Vertex*)malloc(num_vertices * sizeof(Vertex));
     if (graph->vertices == NULL) {
         fprintf(stderr, "Error: Unable to allocate memory for vertices\n");
@@ -17,6 +20,24 @@ Graph* create_graph(int num_vertices) {
         exit(1);
     }
     
+    // จำนวนรถและน้ำหนักของเส้นเชื่อม (ขยายเมื่อเพิ่มเส้นเชื่อม)
+    graph->edge_capacity = 16;
+    graph->edge_loads = (int*)malloc(graph->edge_capacity * sizeof(int));
+    graph->edge_weights = (float*)malloc(graph->edge_capacity * sizeof(float));
+    if (graph->edge_loads == NULL || graph->edge_weights == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for edge loads\n");
+        exit(1);
+    }
+    
+    // ผลรวมของการจราจรของแต่ละทางแยกและรายการทางแยกที่เปลี่ยน
+    graph->junction_loads = (JunctionLoad*)calloc(num_vertices > 0 ? num_vertices : 1, sizeof(JunctionLoad));
+    graph->changed_junctions = (int*)malloc((num_vertices > 0 ? num_vertices : 1) * sizeof(int));
+    graph->num_changed_junctions = 0;
+    if (graph->junction_loads == NULL || graph->changed_junctions == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for junction loads\n");
+        exit(1);
+    }
+    
     // เริ่มต้นค่าสำหรับแต่ละจุดยอด
     for (int i = 0; i < num_vertices; i++) {
         graph->vertices[i].id = i;
@@ -62,7 +83,6 @@ Road* create_road(int lanes, float length, float speed_limit, int capacity) {
     road->length = length;
     road->speed_limit = speed_limit;
     road->capacity = capacity;
-    road->current_load = 0;  // เริ่มต้นไม่มีรถบนถนน
     
     return road;
 }
@@ -82,23 +102,51 @@ void add_edge(Graph* graph, int src, int dest, Road* road) {
         return;
     }
     
-    // คำนวณเวลาการเดินทางเริ่มต้น
-    float travel_time = calculate_travel_time(road);
+    // ขยายอาเรย์ของจำนวนรถและน้ำหนักเมื่อเต็ม
+    if (graph->num_edges >= graph->edge_capacity) {
+        int new_capacity = graph->edge_capacity * 2;
+        int* loads = (int*)realloc(graph->edge_loads, new_capacity * sizeof(int));
+        if (loads == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for edge loads\n");
+            exit(1);
+        }
+        graph->edge_loads = loads;
+        float* weights = (float*)realloc(graph->edge_weights, new_capacity * sizeof(float));
+        if (weights == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for edge weights\n");
+            exit(1);
+        }
+        graph->edge_weights = weights;
+        graph->edge_capacity = new_capacity;
+    }
     
+    new_edge->id = graph->num_edges++;
+    new_edge->src = src;
     new_edge->dest = dest;
     new_edge->road = road;
-    new_edge->weight = travel_time;
     new_edge->next = graph->vertices[src].head;
     graph->vertices[src].head = new_edge;
+    
+    // เริ่มต้นไม่มีรถบนถนน และคำนวณเวลาการเดินทางเริ่มต้น
+    graph->edge_loads[new_edge->id] = 0;
+    graph->edge_weights[new_edge->id] = calculate_travel_time(road, 0);
+    
+    // เพิ่มถนนเข้าในผลรวมของทางแยกต้นทาง
+    JunctionLoad* junction = &graph->junction_loads[src];
+    junction->total_capacity += road->capacity;
+    junction->directions_stale = true;
+    
+    // ตารางระยะทางของจุดอ้างอิงอาจไม่เป็นขอบล่างอีกต่อไปเมื่อมีถนนใหม่
+    graph->landmarks = NULL;
 }
 
-// ฟังก์ชันสำหรับคำนวณเวลาการเดินทางบนถนน
-float calculate_travel_time(Road* road) {
+// ฟังก์ชันสำหรับคำนวณเวลาการเดินทางบนถนนเมื่อมีรถ load คัน
+float calculate_travel_time(const Road* road, int load) {
     // เวลาการเดินทางพื้นฐาน = ความยาว / ความเร็วจำกัด (ในชั่วโมง)
     float base_time = road->length / road->speed_limit;
     
     // คำนวณความหนาแน่นของการจราจร (0.0 - 1.0)
-    float congestion = (float)road->current_load / road->capacity;
+    float congestion = (float)load / road->capacity;
     if (congestion > 1.0) congestion = 1.0;  // ป้องกันค่าเกิน
     
     // ปรับเวลาการเดินทางตามความหนาแน่นของการจราจร
@@ -109,15 +157,118 @@ float calculate_travel_time(Road* road) {
     return adjusted_time;
 }
 
+// ฟังก์ชันสำหรับคำนวณเวลาการเดินทางเมื่อไม่มีการจราจร (ขอบล่างของ calculate_travel_time)
+float calculate_free_flow_time(Road* road) {
+    return road->length / road->speed_limit;
+}
+
+// ฟังก์ชันสำหรับคำนวณผลรวมของการจราจรของทุกทางแยกใหม่จาก edge_loads (ทุกทางแยกถูกบันทึกว่าเปลี่ยน)
+void refresh_junction_loads(Graph* graph) {
+    graph->num_changed_junctions = 0;
+    for (int v = 0; v < graph->num_vertices; v++) {
+        JunctionLoad* junction = &graph->junction_loads[v];
+        junction->total_load = 0;
+        junction->total_capacity = 0;
+        for (Edge* edge = graph->vertices[v].head; edge != NULL; edge = edge->next) {
+            junction->total_load += graph->edge_loads[edge->id];
+            junction->total_capacity += edge->road->capacity;
+        }
+        junction->directions_stale = true;
+        junction->changed = true;
+        graph->changed_junctions[graph->num_changed_junctions++] = v;
+    }
+}
+
+// ฟังก์ชันสำหรับอ่านความหนาแน่นสูงสุดของถนนขาออกแต่ละทิศทาง (คำนวณใหม่เฉพาะเมื่อจำนวนรถเปลี่ยน)
+const float* junction_direction_congestion(Graph* graph, int junction_id) {
+    JunctionLoad* junction = &graph->junction_loads[junction_id];
+    if (junction->directions_stale) {
+        for (int d = 0; d < JUNCTION_DIRECTIONS; d++) {
+            junction->direction_max[d] = 0.0f;
+        }
+        
+        // ทิศทางของถนนกำหนดจากทางแยกปลายทาง (เป็นเพียงตัวอย่าง เหมือนที่สัญญาณไฟใช้กำหนดเฟส)
+        for (Edge* edge = graph->vertices[junction_id].head; edge != NULL; edge = edge->next) {
+            int direction = edge->dest % JUNCTION_DIRECTIONS;
+            float road_congestion = (float)graph->edge_loads[edge->id] / edge->road->capacity;
+            if (road_congestion > 1.0) road_congestion = 1.0;
+            if (road_congestion > junction->direction_max[direction]) {
+                junction->direction_max[direction] = road_congestion;
+            }
+        }
+        junction->directions_stale = false;
+    }
+    return junction->direction_max;
+}
+
 // ฟังก์ชันสำหรับอัปเดตน้ำหนักของเส้นเชื่อมตามสภาพการจราจร
 void update_edge_weight(Graph* graph) {
     for (int i = 0; i < graph->num_vertices; i++) {
         Edge* current = graph->vertices[i].head;
         while (current != NULL) {
-            current->weight = calculate_travel_time(current->road);
+            graph->edge_weights[current->id] = calculate_travel_time(current->road, graph->edge_loads[current->id]);
             current = current->next;
         }
     }
+    
+    graph->weight_version++;
+}
+
+// ฟังก์ชันสำหรับอัปเดตน้ำหนักของเส้นเชื่อมเดียวหลังจากการจราจรบนถนนเปลี่ยน
+void refresh_edge_weight(Graph* graph, Edge* edge) {
+    graph->edge_weights[edge->id] = calculate_travel_time(edge->road, graph->edge_loads[edge->id]);
+    graph->weight_version++;
+}
+
+// ฟังก์ชันสำหรับสร้างรายการเส้นเชื่อมขาเข้าของแต่ละจุดยอด
+ReverseAdjacency* build_reverse_adjacency(Graph* graph) {
+    ReverseAdjacency* rev = (ReverseAdjacency*)malloc(sizeof(ReverseAdjacency));
+    if (rev == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for reverse adjacency\n");
+        exit(1);
+    }
+    
+    rev->offset = (int*)calloc(graph->num_vertices + 1, sizeof(int));
+    rev->source = (int*)malloc((graph->num_edges + 1) * sizeof(int));
+    rev->edge = (Edge**)malloc((graph->num_edges + 1) * sizeof(Edge*));
+    int* fill = (int*)malloc((graph->num_vertices + 1) * sizeof(int));
+    
+    if (rev->offset == NULL || rev->source == NULL || rev->edge == NULL || fill == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for reverse adjacency\n");
+        exit(1);
+    }
+    
+    // นับจำนวนเส้นเชื่อมขาเข้าของแต่ละจุดยอด
+    for (int u = 0; u < graph->num_vertices; u++) {
+        for (Edge* current = graph->vertices[u].head; current != NULL; current = current->next) {
+            rev->offset[current->dest + 1]++;
+        }
+    }
+    for (int v = 0; v < graph->num_vertices; v++) {
+        rev->offset[v + 1] += rev->offset[v];
+    }
+    
+    memcpy(fill, rev->offset, (graph->num_vertices + 1) * sizeof(int));
+    for (int u = 0; u < graph->num_vertices; u++) {
+        for (Edge* current = graph->vertices[u].head; current != NULL; current = current->next) {
+            int slot = fill[current->dest]++;
+            rev->source[slot] = u;
+            rev->edge[slot] = current;
+        }
+    }
+    
+    free(fill);
+    return rev;
+}
+
+// ฟังก์ชันสำหรับลบรายการเส้นเชื่อมขาเข้าและคืนหน่วยความจำ
+void free_reverse_adjacency(ReverseAdjacency* rev) {
+    if (rev == NULL) return;
+    
+    free(rev->offset);
+    free(rev->source);
+    free(rev->edge);
+    free(rev);
 }
 
 // ฟังก์ชันสำหรับแสดงข้อมูลของกราฟ
@@ -142,8 +293,8 @@ void print_graph(Graph* graph) {
             printf("\n");
             printf("    Road: Lanes=%d, Length=%.2f km, Speed Limit=%.2f km/h, Capacity=%d, Current Load=%d\n",
                    current->road->lanes, current->road->length, current->road->speed_limit,
-                   current->road->capacity, current->road->current_load);
-            printf("    Current Travel Time: %.2f hours\n", current->weight);
+                   current->road->capacity, edge_load(graph, current));
+            printf("    Current Travel Time: %.2f hours\n", edge_weight(graph, current));
             
             current = current->next;
         }
@@ -176,9 +327,85 @@ void free_graph(Graph* graph) {
         }
     }
     
-    // ลบอาเรย์ของจุดยอด
+    // ลบอาเรย์ของจุดยอด จำนวนรถและน้ำหนักของเส้นเชื่อม และผลรวมของทางแยก
     free(graph->vertices);
+    free(graph->edge_loads);
+    free(graph->edge_weights);
+    free(graph->junction_loads);
+    free(graph->changed_junctions);
     
     // ลบกราฟ
     free(graph);
 }
+
+// ฟังก์ชันสำหรับสร้างสำเนาของกราฟสำหรับการจำลองหนึ่งชุด (replica)
+// สำเนาชี้ไปยังจุดยอด เส้นเชื่อม และถนนของต้นฉบับ และคัดลอกเฉพาะจำนวนรถ น้ำหนัก และผลรวมของทางแยก
+// ข้อมูลของสำเนาทั้งหมดอยู่ในหน่วยความจำก้อนเดียว (Graph, JunctionLoad, น้ำหนัก, จำนวนรถ, รายการทางแยกที่เปลี่ยน)
+Graph* create_graph_replica(const Graph* graph) {
+    size_t junction_bytes = (size_t)graph->num_vertices * sizeof(JunctionLoad);
+    size_t weight_bytes = (size_t)graph->num_edges * sizeof(float);
+    size_t load_bytes = (size_t)graph->num_edges * sizeof(int);
+    size_t changed_bytes = (size_t)graph->num_vertices * sizeof(int);
+    char* block = (char*)malloc(sizeof(Graph) + junction_bytes + weight_bytes + load_bytes + changed_bytes);
+    if (block == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for graph replica\n");
+        exit(1);
+    }
+    
+    Graph* replica = (Graph*)block;
+    *replica = *graph;
+    replica->junction_loads = (JunctionLoad*)(block + sizeof(Graph));
+    replica->edge_weights = (float*)(block + sizeof(Graph) + junction_bytes);
+    replica->edge_loads = (int*)(block + sizeof(Graph) + junction_bytes + weight_bytes);
+    replica->changed_junctions = (int*)(block + sizeof(Graph) + junction_bytes + weight_bytes + load_bytes);
+    replica->edge_capacity = graph->num_edges;
+    
+    memcpy(replica->junction_loads, graph->junction_loads, junction_bytes);
+    memcpy(replica->edge_weights, graph->edge_weights, weight_bytes);
+    memcpy(replica->edge_loads, graph->edge_loads, load_bytes);
+    memcpy(replica->changed_junctions, graph->changed_junctions, (size_t)graph->num_changed_junctions * sizeof(int));
+    
+    return replica;
+}
+
+// ฟังก์ชันสำหรับลบสำเนาของกราฟ (ไม่ลบโครงข่ายซึ่งเป็นของกราฟต้นฉบับ)
+void free_graph_replica(Graph* replica) {
+    free(replica);
+}
+
+// ฟังก์ชันสำหรับสร้างเครือข่ายถนนแบบตาราง (ใช้สำหรับวัดประสิทธิภาพกับเครือข่ายขนาดใหญ่)
+// ทางแยกที่อยู่ติดกันเชื่อมถึงกันทั้งสองทิศทาง ความยาวและประเภทถนนสุ่มจาก seed
+Graph* create_grid_network(int rows, int cols, unsigned int seed) {
+    Graph* graph = create_graph(rows * cols);
+    
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            char name[32];
+            snprintf(name, sizeof(name), "Grid %d,%d", r, c);
+            add_vertex(graph, r * cols + c, name, true);
+        }
+    }
+    
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            int id = r * cols + c;
+            int neighbors[2] = {(c + 1 < cols) ? id + 1 : -1, (r + 1 < rows) ? id + cols : -1};
+            
+            for (int k = 0; k < 2; k++) {
+                if (neighbors[k] == -1) continue;
+                
+                seed = seed * 1103515245u + 12345u;
+                float length = 0.5f + (float)((seed >> 8) % 2500) / 1000.0f; // 0.5 - 3.0 กม.
+                seed = seed * 1103515245u + 12345u;
+                int lanes = 1 + (int)((seed >> 8) % 4);
+                float speed_limit = 30.0f + 10.0f * lanes;
+                int capacity = 100 * lanes;
+                
+                add_edge(graph, id, neighbors[k], create_road(lanes, length, speed_limit, capacity));
+                add_edge(graph, neighbors[k], id, create_road(lanes, length, speed_limit, capacity));
+            }
+        }
+    }
+    
+    return graph;
+}
@@ -5,20 +5,20 @@
  #include <stdlib.h>
  #include <stdbool.h>
  
- // โครงสร้างข้อมูลสำหรับเก็บข้อมูลของถนน
+ // โครงสร้างข้อมูลสำหรับเก็บข้อมูลของถนน (ไม่เปลี่ยนระหว่างการจำลอง จำนวนรถปัจจุบันอยู่ใน Graph.edge_loads)
  typedef struct {
      int lanes;          // จำนวนช่องทาง
      float length;       // ความยาวของถนน (กิโลเมตร)
      float speed_limit;  // ความเร็วจำกัด (กม./ชม.)
      int capacity;       // ความจุของถนน (จำนวนรถสูงสุด)
-     int current_load;   // จำนวนรถปัจจุบันบนถนน
  } Road;
  
- // โครงสร้างข้อมูลสำหรับเก็บข้อมูลของเส้นเชื่อมในกราฟ
+ // โครงสร้างข้อมูลสำหรับเก็บข้อมูลของเส้นเชื่อมในกราฟ (น้ำหนักปัจจุบันอยู่ใน Graph.edge_weights)
  typedef struct Edge {
+     int id;             // รหัสของเส้นเชื่อม (ใช้เป็นดัชนีของอาเรย์ต่อเส้นเชื่อม)
+     int src;            // จุดเริ่มต้นของเส้นเชื่อม (ทางแยก)
      int dest;           // ปลายทางของเส้นเชื่อม (ทางแยก)
      Road* road;         // ข้อมูลของถนน
-     float weight;       // น้ำหนักของเส้นเชื่อม (เวลาในการเดินทาง)
      struct Edge* next;  // ชี้ไปยังเส้นเชื่อมถัดไป
  } Edge;
  
@@ -30,12 +30,44 @@
      Edge* head;         // ชี้ไปยังเส้นเชื่อมแรก
  } Vertex;
  
+ // จำนวนทิศทางของถนนขาออกที่สัญญาณไฟแยกพิจารณา (ทิศทาง = dest % 4)
+ #define JUNCTION_DIRECTIONS 4
+ 
+ // ผลรวมของการจราจรบนถนนขาออกของทางแยก (อัปเดตทุกครั้งที่จำนวนรถบนถนนเปลี่ยนผ่าน change_road_load)
+ typedef struct {
+     int total_load;          // จำนวนรถรวมของถนนขาออก
+     int total_capacity;      // ความจุรวมของถนนขาออก
+     float direction_max[JUNCTION_DIRECTIONS]; // ความหนาแน่นสูงสุดของถนนขาออกในแต่ละทิศทาง
+     bool directions_stale;   // ต้องคำนวณ direction_max ใหม่ (จำนวนรถบนถนนขาออกเปลี่ยนแล้ว)
+     bool changed;            // อยู่ในรายการ changed_junctions แล้ว
+ } JunctionLoad;
+ 
+ struct LandmarkSet;
+ 
  // โครงสร้างข้อมูลสำหรับเก็บข้อมูลของกราฟ
+ // จุดยอด เส้นเชื่อม และถนนเป็นโครงข่ายที่ไม่เปลี่ยน ส่วนจำนวนรถและน้ำหนักเก็บเป็นอาเรย์ตาม Edge.id
+ // สำเนาของกราฟ (create_graph_replica) จึงใช้โครงข่ายร่วมกับต้นฉบับและมีเพียงอาเรย์เหล่านี้เป็นของตัวเอง
  typedef struct {
      int num_vertices;   // จำนวนจุดยอด (ทางแยก)
+     int num_edges;      // จำนวนเส้นเชื่อมทั้งหมด
      Vertex* vertices;   // อาเรย์ของจุดยอด
+     int* edge_loads;    // จำนวนรถปัจจุบันบนถนนของแต่ละเส้นเชื่อม ตาม Edge.id
+     float* edge_weights; // น้ำหนักของแต่ละเส้นเชื่อม (เวลาในการเดินทาง) ตาม Edge.id
+     int edge_capacity;  // ขนาดของ edge_loads และ edge_weights
+     struct LandmarkSet* landmarks; // จุดอ้างอิงสำหรับค้นหาเส้นทางแบบ ALT (NULL = ไม่ใช้, กราฟไม่ได้เป็นเจ้าของ)
+     unsigned long weight_version;  // เพิ่มขึ้นทุกครั้งที่น้ำหนักของเส้นเชื่อมเปลี่ยน (ใช้ตรวจข้อมูลที่คำนวณไว้ล่วงหน้าว่าล้าสมัยหรือไม่)
+     JunctionLoad* junction_loads;  // ผลรวมของการจราจรบนถนนขาออกของแต่ละทางแยก
+     int* changed_junctions;        // ทางแยกที่จำนวนรถเปลี่ยนตั้งแต่ระบบสัญญาณไฟอ่านครั้งล่าสุด (ไม่ซ้ำกัน)
+     int num_changed_junctions;     // จำนวนทางแยกในรายการ
  } Graph;
  
+ // รายการเส้นเชื่อมขาเข้าของแต่ละจุดยอดแบบ CSR (สำหรับค้นหาย้อนกลับ)
+ typedef struct {
+     int* offset;        // ตำแหน่งเริ่มต้นของเส้นเชื่อมขาเข้าของแต่ละจุดยอด (ขนาด num_vertices + 1)
+     int* source;        // จุดเริ่มต้นของเส้นเชื่อมขาเข้า
+     Edge** edge;        // เส้นเชื่อมขาเข้า
+ } ReverseAdjacency;
+ 
  // ฟังก์ชันสำหรับสร้างกราฟใหม่
  Graph* create_graph(int num_vertices);
  
@@ -48,19 +80,71 @@
  // ฟังก์ชันสำหรับสร้างถนนใหม่
  Road* create_road(int lanes, float length, float speed_limit, int capacity);
  
- // ฟังก์ชันสำหรับคำนวณเวลาการเดินทางบนถนน
- float calculate_travel_time(Road* road);
+ // ฟังก์ชันสำหรับคำนวณเวลาการเดินทางบนถนนเมื่อมีรถ load คัน
+ float calculate_travel_time(const Road* road, int load);
+ 
+ // ฟังก์ชันสำหรับคำนวณเวลาการเดินทางเมื่อไม่มีการจราจร (ขอบล่างของ calculate_travel_time)
+ float calculate_free_flow_time(Road* road);
+ 
+ // ฟังก์ชันสำหรับอ่านจำนวนรถปัจจุบันบนถนนของเส้นเชื่อม
+ static inline int edge_load(const Graph* graph, const Edge* edge) {
+     return graph->edge_loads[edge->id];
+ }
+ 
+ // ฟังก์ชันสำหรับอ่านน้ำหนักปัจจุบันของเส้นเชื่อม (เวลาในการเดินทาง)
+ static inline float edge_weight(const Graph* graph, const Edge* edge) {
+     return graph->edge_weights[edge->id];
+ }
+ 
+ // ฟังก์ชันสำหรับเปลี่ยนจำนวนรถบนถนน พร้อมอัปเดตผลรวมของทางแยกต้นทางและบันทึกว่าทางแยกเปลี่ยน
+ // ทุกการเปลี่ยน edge_loads ต้องผ่านฟังก์ชันนี้ (หรือเรียก refresh_junction_loads หลังเขียนโดยตรง)
+ static inline void change_road_load(Graph* graph, Edge* edge, int delta) {
+     JunctionLoad* junction = &graph->junction_loads[edge->src];
+     graph->edge_loads[edge->id] += delta;
+     junction->total_load += delta;
+     junction->directions_stale = true;
+     if (!junction->changed) {
+         junction->changed = true;
+         graph->changed_junctions[graph->num_changed_junctions++] = edge->src;
+     }
+ }
+ 
+ // ฟังก์ชันสำหรับคำนวณผลรวมของการจราจรของทุกทางแยกใหม่จาก edge_loads (ทุกทางแยกถูกบันทึกว่าเปลี่ยน)
+ void refresh_junction_loads(Graph* graph);
+ 
+ // ฟังก์ชันสำหรับอ่านความหนาแน่นสูงสุดของถนนขาออกแต่ละทิศทาง (คำนวณใหม่เฉพาะเมื่อจำนวนรถเปลี่ยน)
+ const float* junction_direction_congestion(Graph* graph, int junction_id);
  
  // ฟังก์ชันสำหรับอัปเดตน้ำหนักของเส้นเชื่อมตามสภาพการจราจร
  void update_edge_weight(Graph* graph);
  
+ // ฟังก์ชันสำหรับอัปเดตน้ำหนักของเส้นเชื่อมเดียวหลังจากการจราจรบนถนนเปลี่ยน
+ void refresh_edge_weight(Graph* graph, Edge* edge);
+ 
+ // ฟังก์ชันสำหรับสร้างรายการเส้นเชื่อมขาเข้าของแต่ละจุดยอด
+ ReverseAdjacency* build_reverse_adjacency(Graph* graph);
+ 
+ // ฟังก์ชันสำหรับลบรายการเส้นเชื่อมขาเข้าและคืนหน่วยความจำ
+ void free_reverse_adjacency(ReverseAdjacency* rev);
+ 
  // ฟังก์ชันสำหรับแสดงข้อมูลของกราฟ
  void print_graph(Graph* graph);
  
  // ฟังก์ชันสำหรับลบกราฟและคืนหน่วยความจำ
  void free_graph(Graph* graph);
-
+ 
+ // ฟังก์ชันสำหรับสร้างสำเนาของกราฟสำหรับการจำลองหนึ่งชุด (replica)
+ // สำเนามีจำนวนรถ น้ำหนัก และผลรวมของทางแยกเป็นของตัวเอง แต่ใช้จุดยอด เส้นเชื่อม ถนน และจุดอ้างอิงร่วมกับต้นฉบับ
+ // (ต้องลบก่อนกราฟต้นฉบับ และห้ามเพิ่มทางแยกหรือเส้นเชื่อมให้กราฟต้นฉบับหรือสำเนาระหว่างที่สำเนายังอยู่)
+ Graph* create_graph_replica(const Graph* graph);
+ 
+ // ฟังก์ชันสำหรับลบสำเนาของกราฟ (ไม่ลบโครงข่ายซึ่งเป็นของกราฟต้นฉบับ)
+ void free_graph_replica(Graph* replica);
+ 
  Graph* create_sample_network();
-
+ 
+ // ฟังก์ชันสำหรับสร้างเครือข่ายถนนแบบตาราง (ใช้สำหรับวัดประสิทธิภาพกับเครือข่ายขนาดใหญ่)
+ Graph* create_grid_network(int rows, int cols, unsigned int seed);
+ 
  
  #endif
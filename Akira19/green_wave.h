@@ -0,0 +1,79 @@
+#ifndef GREEN_WAVE_H
+#define GREEN_WAVE_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include "graph.h"
+ #include "traffic_signal.h"
+ #include "simulation.h"
+ 
+ // ถนนสายหลักมีอย่างน้อยกี่ช่องทาง และแนวถนนหนึ่งแนวมีทางแยกได้มากที่สุดกี่จุด
+ #define GREEN_WAVE_MIN_LANES 3
+ #define GREEN_WAVE_MAX_JUNCTIONS 16
+ 
+ // รอบคงที่เริ่มต้นของสัญญาณไฟในแนวถนน (วินาที) และจำนวน seed ที่ใช้ประเมินผู้สมัครแต่ละตัว
+ #define GREEN_WAVE_CYCLE 60
+ #define GREEN_WAVE_SEEDS 4
+ 
+ // แนวถนนสายหลัก (corridor) สำหรับประสานสัญญาณไฟแบบคลื่นไฟเขียว (green wave)
+ // แนวถนนเริ่มจากถนนสายหลักที่สำคัญที่สุดที่ยังไม่ถูกใช้ แล้วต่อไปตามถนนสายหลักขาออกที่สำคัญที่สุดทีละทางแยก
+ // แต่ละทางแยกอยู่ในแนวถนนได้แนวเดียว (แนวที่สำคัญกว่าได้ก่อน) ความสำคัญของถนน = ช่องทาง × ความเร็วจำกัด
+ typedef struct {
+     int num_corridors;       // จำนวนแนวถนน
+     int* corridor_offset;    // ตำแหน่งเริ่มต้นของทางแยกของแต่ละแนวถนนใน junctions (ขนาด num_corridors + 1)
+     int* junctions;          // ทางแยกของทุกแนวถนนเรียงตามลำดับการเดินทาง
+     float* arrival_time;     // เวลาเดินทางแบบไม่มีการจราจรจากต้นแนวถนนถึงทางแยก (วินาที)
+     int* approach_phase;     // เฟสของสัญญาณไฟที่ให้ไฟเขียวแก่ถนนขาเข้าตามแนวถนน (-1 = ทางแยกแรก)
+ } GreenWaveCorridors;
+ 
+ // ผลการค้นหา offset ของรอบสัญญาณไฟ
+ // สัญญาณไฟในแนวถนนใช้รอบคงที่เดียวกัน (ไม่ปรับตามความหนาแน่น) offset จึงยังตรงกันตลอดการจำลอง
+ // ผู้สมัครแต่ละตัวคือสัดส่วนของความเร็วของคลื่นไฟเขียวต่อความเร็วจำกัด
+ // (-1 = ตั้งเวลาเดิมแบบปรับตามความหนาแน่น, 0 = รอบคงที่แต่ไม่ประสานสัญญาณไฟ)
+ // ทุกผู้สมัครถูกประเมินด้วยการจำลองสั้น ๆ ชุด seed เดียวกัน num_seeds ค่า (จำนวนการเดินทางที่จบรวมมากกว่าดีกว่า)
+ // คลื่นไฟเขียวถูกเลือกเฉพาะเมื่อจบการเดินทางมากกว่าแบบที่ไม่ประสานที่ดีกว่าในทุก seed
+ typedef struct {
+     int cycle;               // รอบคงที่ของสัญญาณไฟในแนวถนน (วินาที)
+     int num_seeds;           // จำนวน seed ที่ใช้ประเมินผู้สมัครแต่ละตัว
+     int num_candidates;      // จำนวนผู้สมัครที่ประเมิน
+     int num_threads;         // จำนวนเธรดที่ใช้
+     float* speed_ratio;      // สัดส่วนของความเร็วของแต่ละผู้สมัคร
+     long* completed;         // จำนวนการเดินทางที่จบรวมทุก seed ของแต่ละผู้สมัคร
+     long* waiting;           // จำนวนยานพาหนะที่รอไฟเขียวเมื่อจบการจำลองรวมทุก seed ของแต่ละผู้สมัคร
+     int best_wave;           // คลื่นไฟเขียวที่จบการเดินทางรวมมากที่สุด
+     int seeds_won;           // จำนวน seed ที่ best_wave จบการเดินทางมากกว่าแบบที่ไม่ประสานที่ดีกว่า
+     int best;                // ผู้สมัครที่เลือก (best_wave หรือแบบที่ไม่ประสานที่ดีกว่า)
+     int* offsets;            // offset ของผู้สมัครที่ดีที่สุดตามดัชนีของสัญญาณไฟ (-1 = ไม่ใช้รอบคงที่)
+     int num_coordinated;     // จำนวนสัญญาณไฟที่ถูกประสาน
+     double wall_time;        // เวลาที่ใช้ทั้งหมด (วินาที)
+ } GreenWaveResult;
+ 
+ // ฟังก์ชันสำหรับหาแนวถนนสายหลักที่มีสัญญาณไฟ (min_lanes = จำนวนช่องทางขั้นต่ำของถนนสายหลัก)
+ GreenWaveCorridors* find_green_wave_corridors(const Graph* graph, const SignalSystem* system, int min_lanes);
+ 
+ // ฟังก์ชันสำหรับคำนวณ offset ของทุกสัญญาณไฟในแนวถนนเมื่อคลื่นไฟเขียวเคลื่อนที่ด้วย speed_ratio × ความเร็วจำกัด
+ // ทุกสัญญาณไฟในแนวถนนใช้รอบคงที่ cycle วินาที (offsets ตามดัชนีของสัญญาณไฟ, -1 = ไม่อยู่ในแนวถนน)
+ // speed_ratio = 0 ให้ offset 0 ทุกจุด (รอบคงที่แต่ไม่ประสาน) และ speed_ratio < 0 ให้ -1 ทุกจุด (ไม่ใช้รอบคงที่)
+ void compute_green_wave_offsets(const GreenWaveCorridors* corridors, const SignalSystem* system, int cycle,
+                                 float speed_ratio, int* offsets);
+ 
+ // ฟังก์ชันสำหรับตั้งรอบคงที่และเลื่อนรอบของสัญญาณไฟที่มี offset (offsets ตามดัชนีของสัญญาณไฟ, -1 = ไม่เปลี่ยน)
+ void apply_green_wave_offsets(SignalSystem* system, int cycle, const int* offsets);
+ 
+ // ฟังก์ชันสำหรับค้นหา offset ที่ดีที่สุดแบบขนาน (ประเมินผู้สมัครแต่ละตัวด้วยการจำลองสั้น ๆ หลาย seed บนสำเนาของเครือข่าย)
+ // cycle คือรอบคงที่ของสัญญาณไฟในแนวถนน config คือการตั้งค่าของการจำลองที่ใช้ประเมิน
+ // (ใช้ signal_gating เสมอ เพราะสัญญาณไฟต้องมีผลต่อการจราจร) คืนค่า NULL ถ้าค่าไม่ถูกต้องหรือใช้ตัวควบคุมแบบ max-pressure
+ GreenWaveResult* optimize_green_wave(const Graph* graph, const SignalSystem* system, const SimulationConfig* config,
+                                      int cycle, int num_vehicles, int num_ticks, int num_threads);
+ 
+ // ฟังก์ชันสำหรับแสดงผลการค้นหา offset
+ void print_green_wave_result(const GreenWaveResult* result);
+ 
+ // ฟังก์ชันสำหรับลบแนวถนนและคืนหน่วยความจำ
+ void free_green_wave_corridors(GreenWaveCorridors* corridors);
+ 
+ // ฟังก์ชันสำหรับลบผลการค้นหาและคืนหน่วยความจำ
+ void free_green_wave_result(GreenWaveResult* result);
+ 
+ #endif
@@ -0,0 +1,284 @@
+/*
+* headless.c
+* การจำลองแบบไม่แสดงผลที่ทำงานเร็วที่สุด พร้อมรายงานอัตราการทำงาน
+*/
+
+#include "headless.h"
+#include <string.h>
+#include "graph.h"
+#include "traffic_signal.h"
+#include "demand.h"
+#include "max_pressure.h"
+#include "green_wave.h"
+#include "wall_clock.h"
+
+// ฟังก์ชันสำหรับแปลงข้อความเป็นจำนวนเต็มที่ไม่ติดลบ (คืนค่า false ถ้าไม่ใช่ตัวเลขทั้งหมด)
+static bool parse_count(const char* value, long* result) {
+    char* end = NULL;
+    long number = strtol(value, &end, 10);
+    if (end == value || *end != '\0' || number < 0 || number > INT_MAX) {
+        return false;
+    }
+    *result = number;
+    return true;
+}
+
+// ฟังก์ชันสำหรับแปลงข้อความเป็นจำนวนจริงที่ไม่ติดลบ (คืนค่า false ถ้าไม่ใช่ตัวเลขทั้งหมด)
+static bool parse_real(const char* value, double* result) {
+    char* end = NULL;
+    double number = strtod(value, &end);
+    if (end == value || *end != '\0' || number < 0.0) {
+        return false;
+    }
+    *result = number;
+    return true;
+}
+
+// ฟังก์ชันสำหรับอ่านการตั้งค่าเริ่มต้นของการจำลองแบบไม่แสดงผล
+HeadlessOptions default_headless_options(void) {
+    HeadlessOptions options;
+    options.grid_network = false;
+    options.rows = 20;
+    options.cols = 20;
+    options.network_seed = 42;
+    options.demand_path[0] = '\0';
+    options.num_vehicles = 180;
+    options.num_ticks = 600;
+    options.pressure_interval = 0;
+    options.offsets_path[0] = '\0';
+    options.optimize_path[0] = '\0';
+    options.config = default_simulation_config();
+    return options;
+}
+
+// ฟังก์ชันสำหรับกำหนดค่าหนึ่งรายการตามชื่อ (คืนค่า false ถ้าชื่อหรือค่าไม่ถูกต้อง)
+bool set_headless_option(HeadlessOptions* options, const char* name, const char* value) {
+    long count = 0;
+    double real = 0.0;
+    bool ok = true;
+    
+    if (strcmp(name, "network") == 0) {
+        ok = (strcmp(value, "sample") == 0 || strcmp(value, "grid") == 0);
+        options->grid_network = (strcmp(value, "grid") == 0);
+    } else if (strcmp(name, "rows") == 0) {
+        ok = parse_count(value, &count) && count > 0;
+        options->rows = (int)count;
+    } else if (strcmp(name, "cols") == 0) {
+        ok = parse_count(value, &count) && count > 0;
+        options->cols = (int)count;
+    } else if (strcmp(name, "network-seed") == 0) {
+        ok = parse_count(value, &count);
+        options->network_seed = (unsigned int)count;
+    } else if (strcmp(name, "demand") == 0) {
+        ok = strlen(value) < HEADLESS_PATH_LENGTH;
+        if (ok) {
+            strcpy(options->demand_path, value);
+        }
+    } else if (strcmp(name, "vehicles") == 0) {
+        ok = parse_count(value, &count);
+        options->num_vehicles = (int)count;
+    } else if (strcmp(name, "ticks") == 0) {
+        ok = parse_count(value, &count);
+        options->num_ticks = (int)count;
+    } else if (strcmp(name, "seed") == 0) {
+        char* end = NULL;
+        unsigned long long seed = strtoull(value, &end, 10);
+        ok = (end != value && *end == '\0');
+        options->config.seed = (uint64_t)seed;
+    } else if (strcmp(name, "threads") == 0) {
+        ok = parse_count(value, &count);
+        options->config.num_threads = (int)count;
+    } else if (strcmp(name, "dt") == 0) {
+        ok = parse_real(value, &real) && real > 0.0;
+        options->config.dt = (float)real;
+    } else if (strcmp(name, "speed-variation") == 0) {
+        ok = parse_real(value, &real) && real < 1.0;
+        options->config.speed_variation = (float)real;
+    } else if (strcmp(name, "reroute") == 0) {
+        ok = parse_count(value, &count);
+        options->config.reroute_interval = (int)count;
+    } else if (strcmp(name, "gating") == 0) {
+        ok = parse_count(value, &count) && count <= 1;
+        options->config.signal_gating = (count == 1);
+    } else if (strcmp(name, "max-pressure") == 0) {
+        ok = parse_count(value, &count);
+        options->pressure_interval = (int)count;
+    } else if (strcmp(name, "offsets") == 0) {
+        ok = strlen(value) < HEADLESS_PATH_LENGTH;
+        if (ok) {
+            strcpy(options->offsets_path, value);
+        }
+    } else if (strcmp(name, "optimize-offsets") == 0) {
+        ok = strlen(value) < HEADLESS_PATH_LENGTH;
+        if (ok) {
+            strcpy(options->optimize_path, value);
+        }
+    } else {
+        fprintf(stderr, "Error: Unknown headless option '%s'\n", name);
+        return false;
+    }
+    
+    if (!ok) {
+        fprintf(stderr, "Error: Invalid value '%s' for headless option '%s'\n", value, name);
+    }
+    return ok;
+}
+
+// ฟังก์ชันสำหรับอ่านไฟล์การตั้งค่า (คืนค่า false ถ้าอ่านไม่สำเร็จ)
+bool load_headless_config(HeadlessOptions* options, const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Unable to open headless config '%s'\n", path);
+        return false;
+    }
+    
+    char line[512];
+    int line_number = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), file) != NULL) {
+        line_number++;
+        
+        // ตัดหมายเหตุ แล้วข้ามบรรทัดว่าง
+        char* comment = strchr(line, '#');
+        if (comment != NULL) {
+            *comment = '\0';
+        }
+        char name[64];
+        char value[HEADLESS_PATH_LENGTH];
+        char extra[2];
+        int fields = sscanf(line, "%63s %255s %1s", name, value, extra);
+        if (fields <= 0) {
+            continue;
+        }
+        
+        if (fields != 2) {
+            fprintf(stderr, "Error: Expected '<name> <value>' at %s:%d\n", path, line_number);
+            ok = false;
+        } else {
+            ok = set_headless_option(options, name, value);
+        }
+    }
+    
+    fclose(file);
+    return ok;
+}
+
+// ฟังก์ชันสำหรับแสดงวิธีใช้ตัวเลือกของการจำลองแบบไม่แสดงผล
+static void print_headless_usage(void) {
+    fprintf(stderr, "Usage: --headless [--config <file>] [--network sample|grid] [--rows N] [--cols N]\n"
+                    "                  [--network-seed N] [--demand <file.od>] [--vehicles N] [--ticks N]\n"
+                    "                  [--seed N] [--threads N] [--dt S] [--speed-variation F] [--reroute N]\n"
+                    "                  [--gating 0|1] [--max-pressure S] [--offsets <file>]\n"
+                    "                  [--optimize-offsets <file>]\n");
+}
+
+// ฟังก์ชันสำหรับรันการจำลองเร็วที่สุดโดยไม่แสดงผลระหว่างทาง แล้วรายงานอัตราการทำงาน
+// argv คือตัวเลือกหลัง --headless (--config <ไฟล์> และ --ชื่อ ค่า ตามลำดับ) คืนค่า exit code
+int run_headless(int argc, char* argv[]) {
+    HeadlessOptions options = default_headless_options();
+    
+    // ตัวเลือกถูกใช้ตามลำดับ ค่าบนบรรทัดคำสั่งหลัง --config จึงแทนค่าในไฟล์
+    for (int i = 0; i < argc; i += 2) {
+        if (strncmp(argv[i], "--", 2) != 0 || i + 1 >= argc) {
+            fprintf(stderr, "Error: Expected '--<name> <value>' but got '%s'\n", argv[i]);
+            print_headless_usage();
+            return 1;
+        }
+        
+        const char* name = argv[i] + 2;
+        bool ok = (strcmp(name, "config") == 0) ? load_headless_config(&options, argv[i + 1])
+                                                : set_headless_option(&options, name, argv[i + 1]);
+        if (!ok) {
+            print_headless_usage();
+            return 1;
+        }
+    }
+    
+    // สร้างเครือข่ายถนน ระบบสัญญาณไฟ และความต้องการเดินทาง
+    Graph* graph = options.grid_network ? create_grid_network(options.rows, options.cols, options.network_seed)
+                                        : create_sample_network();
+    DemandModel* demand = NULL;
+    if (options.demand_path[0] != '\0') {
+        demand = load_demand_file(options.demand_path, graph);
+        if (demand == NULL) {
+            free_graph(graph);
+            return 1;
+        }
+    }
+    SignalSystem* signal_system = (options.offsets_path[0] != '\0')
+                                      ? create_signal_system_with_offsets(graph, options.offsets_path)
+                                      : create_signal_system(graph);
+    if (signal_system == NULL) {
+        free_demand_model(demand);
+        free_graph(graph);
+        return 1;
+    }
+    
+    SimulationConfig config = options.config;
+    if (config.initial_capacity < options.num_vehicles) {
+        config.initial_capacity = options.num_vehicles;
+    }
+    
+    // ค้นหา offset ของรอบสัญญาณไฟด้วยการจำลองสั้น ๆ (vehicles คันแบบสุ่ม ticks ขั้นตอน) แล้วเขียนลงไฟล์แทนการรัน
+    if (options.optimize_path[0] != '\0') {
+        GreenWaveResult* result = optimize_green_wave(graph, signal_system, &config, GREEN_WAVE_CYCLE,
+                                                      options.num_vehicles, options.num_ticks, config.num_threads);
+        bool saved = false;
+        if (result != NULL) {
+            print_green_wave_result(result);
+            saved = save_signal_offsets(signal_system, result->cycle, result->offsets, options.optimize_path);
+            if (saved) {
+                printf("Signal offsets written to %s\n", options.optimize_path);
+            }
+        }
+        free_green_wave_result(result);
+        free_demand_model(demand);
+        free_signal_system(signal_system);
+        free_graph(graph);
+        return saved ? 0 : 1;
+    }
+    TrafficSimulation* sim = create_simulation_with_config(graph, signal_system, &config);
+    if (options.pressure_interval > 0) {
+        set_max_pressure_control(graph, signal_system, sim->junction_queues, options.pressure_interval, config.num_threads);
+    }
+    
+    // จับเวลาตั้งแต่สร้างการจราจร (รวมการหาเส้นทางของยานพาหนะชุดแรก) จนจบขั้นตอนเวลาสุดท้าย
+    double start = monotonic_seconds();
+    if (demand == NULL && options.num_vehicles > 0) {
+        generate_random_traffic(sim, options.num_vehicles);
+    }
+    sim->is_running = true;
+    
+    double loop_start = monotonic_seconds();
+    for (int t = 0; t < options.num_ticks; t++) {
+        if (demand != NULL) {
+            release_demand(demand, sim);
+        }
+        update_simulation(sim);
+    }
+    double end = monotonic_seconds();
+    
+    double loop_time = end - loop_start;
+    double run_time = end - start;
+    printf("Headless run: %s network (%d junctions, %d roads), %d ticks of %g s (%g s simulated)\n",
+           options.grid_network ? "grid" : "sample", graph->num_vertices, graph->num_edges,
+           options.num_ticks, config.dt, simulation_seconds(sim));
+    printf("Vehicles: %ld added, %ld completed, %d still traveling\n",
+           sim->total_vehicles, sim->completed_vehicles, sim->num_vehicles);
+    printf("Wall time: %.3f s (setup %.3f s, ticks %.3f s)\n", run_time, loop_start - start, loop_time);
+    printf("Ticks/s: %.1f\n", (loop_time > 0.0) ? options.num_ticks / loop_time : 0.0);
+    printf("Vehicle updates/s: %.0f (%ld updates)\n",
+           (loop_time > 0.0) ? sim->vehicle_updates / loop_time : 0.0, sim->vehicle_updates);
+    printf("Route queries/s: %.0f (%ld queries)\n",
+           (run_time > 0.0) ? sim->route_queries / run_time : 0.0, sim->route_queries);
+    if (signal_system->controller != NULL) {
+        print_max_pressure_stats(signal_system->controller);
+    }
+    
+    free_simulation(sim);
+    free_demand_model(demand);
+    free_signal_system(signal_system);
+    free_graph(graph);
+    
+    return 0;
+}
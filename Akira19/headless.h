@@ -0,0 +1,49 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include "simulation.h"
+ 
+ // ความยาวสูงสุดของชื่อไฟล์ในการตั้งค่า
+ #define HEADLESS_PATH_LENGTH 256
+ 
+ // การตั้งค่าของการจำลองแบบไม่แสดงผล (headless)
+ // อ่านจากตัวเลือกบรรทัดคำสั่ง (--ชื่อ ค่า) หรือไฟล์การตั้งค่า (บรรทัดละ "ชื่อ ค่า", # = หมายเหตุ) ด้วยชื่อชุดเดียวกัน:
+ //   network  sample | grid        เครือข่ายตัวอย่าง หรือเครือข่ายแบบตาราง
+ //   rows / cols / network-seed     ขนาดและ seed ของเครือข่ายแบบตาราง
+ //   demand   <ไฟล์ .od>            ปล่อยการเดินทางตามตาราง OD (ไม่ระบุ = สุ่ม vehicles คันตอนเริ่ม)
+ //   vehicles / ticks               จำนวนยานพาหนะแบบสุ่ม และจำนวนขั้นตอนเวลา
+ //   seed / threads / dt / speed-variation / reroute / gating   ค่าใน SimulationConfig
+ //   max-pressure <วินาที>          ควบคุมสัญญาณไฟแบบ max-pressure ทุกกี่วินาที (0 = ปรับระยะเวลาตามความหนาแน่น)
+ //   offsets <ไฟล์>                 อ่านรอบคงที่และ offset ของสัญญาณไฟ (คลื่นไฟเขียว) ก่อนเริ่ม
+ //   optimize-offsets <ไฟล์>        ค้นหา offset ด้วยการจำลองสั้น ๆ ตาม vehicles / ticks / threads แล้วเขียนลงไฟล์แทนการรัน
+ typedef struct {
+     bool grid_network;       // ใช้เครือข่ายแบบตาราง (false = เครือข่ายตัวอย่าง)
+     int rows;                // จำนวนแถวของเครือข่ายแบบตาราง
+     int cols;                // จำนวนคอลัมน์ของเครือข่ายแบบตาราง
+     unsigned int network_seed; // seed ของเครือข่ายแบบตาราง
+     char demand_path[HEADLESS_PATH_LENGTH]; // ไฟล์ตาราง OD (ว่าง = สุ่มการจราจร)
+     int num_vehicles;        // จำนวนยานพาหนะแบบสุ่มตอนเริ่ม
+     int num_ticks;           // จำนวนขั้นตอนเวลา
+     int pressure_interval;   // ช่วงเวลาระหว่างการตัดสินใจแบบ max-pressure (0 = ไม่ใช้)
+     char offsets_path[HEADLESS_PATH_LENGTH]; // ไฟล์ offset ของรอบสัญญาณไฟ (ว่าง = ทุกสัญญาณไฟเริ่มที่เฟส 0)
+     char optimize_path[HEADLESS_PATH_LENGTH]; // ไฟล์ที่เขียน offset ที่ค้นหาได้ (ว่าง = รันการจำลองตามปกติ)
+     SimulationConfig config; // การตั้งค่าของการจำลอง
+ } HeadlessOptions;
+ 
+ // ฟังก์ชันสำหรับอ่านการตั้งค่าเริ่มต้นของการจำลองแบบไม่แสดงผล
+ HeadlessOptions default_headless_options(void);
+ 
+ // ฟังก์ชันสำหรับกำหนดค่าหนึ่งรายการตามชื่อ (คืนค่า false ถ้าชื่อหรือค่าไม่ถูกต้อง)
+ bool set_headless_option(HeadlessOptions* options, const char* name, const char* value);
+ 
+ // ฟังก์ชันสำหรับอ่านไฟล์การตั้งค่า (คืนค่า false ถ้าอ่านไม่สำเร็จ)
+ bool load_headless_config(HeadlessOptions* options, const char* path);
+ 
+ // ฟังก์ชันสำหรับรันการจำลองเร็วที่สุดโดยไม่แสดงผลระหว่างทาง แล้วรายงานอัตราการทำงาน
+ // argv คือตัวเลือกหลัง --headless (--config <ไฟล์> และ --ชื่อ ค่า ตามลำดับ) คืนค่า exit code
+ int run_headless(int argc, char* argv[]);
+ 
+ #endif
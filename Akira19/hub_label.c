@@ -0,0 +1,343 @@
+/*
+* hub_label.c
+* การสร้างป้ายกำกับฮับด้วย Pruned Landmark Labeling และการหาเวลาเดินทางจากป้ายกำกับ
+*/
+
+#include "hub_label.h"
+#include <float.h>
+#include <string.h>
+
+// รายการป้ายกำกับที่ขยายได้ (ใช้ระหว่างการสร้าง)
+typedef struct {
+    int* hub;
+    float* dist;
+    int size;
+    int capacity;
+} LabelList;
+
+// ฟังก์ชันสำหรับเพิ่มฮับลงในรายการป้ายกำกับ
+static void label_push(LabelList* list, int hub, float dist) {
+    if (list->size >= list->capacity) {
+        int new_capacity = (list->capacity > 0) ? list->capacity * 2 : 4;
+        int* hubs = (int*)realloc(list->hub, new_capacity * sizeof(int));
+        float* dists = (float*)realloc(list->dist, new_capacity * sizeof(float));
+        if (hubs == NULL || dists == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for hub labels\n");
+            exit(1);
+        }
+        list->hub = hubs;
+        list->dist = dists;
+        list->capacity = new_capacity;
+    }
+    
+    list->hub[list->size] = hub;
+    list->dist[list->size] = dist;
+    list->size++;
+}
+
+// ฟังก์ชันสำหรับหาระยะทางที่สั้นที่สุดผ่านฮับในรายการเทียบกับตารางของจุดเริ่มต้น
+static inline float label_lookup(const LabelList* list, const float* root_label) {
+    float best = FLT_MAX;
+    for (int i = 0; i < list->size; i++) {
+        float through = root_label[list->hub[i]];
+        if (through != FLT_MAX && through + list->dist[i] < best) {
+            best = through + list->dist[i];
+        }
+    }
+    return best;
+}
+
+// ข้อมูลชั่วคราวสำหรับการค้นหาแบบตัดกิ่ง
+typedef struct {
+    float* dist;       // ระยะทางจากจุดเริ่มต้น
+    int* touched;      // จุดยอดที่ถูกเปลี่ยนค่า (สำหรับล้างค่าอย่างรวดเร็ว)
+    int num_touched;
+    float* root_label; // ป้ายกำกับของจุดเริ่มต้นในรูปแบบตาราง (ดัชนีตามลำดับของฮับ)
+    MinHeap* heap;
+} PrunedSearch;
+
+// ฟังก์ชันสำหรับค้นหาแบบตัดกิ่งจาก root แล้วเพิ่ม root เป็นฮับในป้ายของจุดที่ไม่ถูกตัด
+// forward = true: ค้นหาตามทิศของถนนและเพิ่มในป้ายขาเข้า, false: ค้นหาย้อนกลับและเพิ่มในป้ายขาออก
+static void pruned_search(Graph* graph, const ReverseAdjacency* rev, int root, int root_rank, bool forward,
+                          LabelList* root_labels, LabelList* target_labels, PrunedSearch* search) {
+    // โหลดป้ายของ root ลงในตาราง
+    for (int i = 0; i < root_labels[root].size; i++) {
+        search->root_label[root_labels[root].hub[i]] = root_labels[root].dist[i];
+    }
+    
+    search->dist[root] = 0.0f;
+    search->touched[search->num_touched++] = root;
+    insert_min_heap(search->heap, root, 0.0f, 0.0f);
+    
+    while (search->heap->size > 0) {
+        HeapNode min = extract_min(search->heap);
+        int u = min.vertex;
+        
+        if (min.dist > search->dist[u]) {
+            continue;
+        }
+        
+        // ตัดกิ่งถ้าฮับที่สำคัญกว่าให้ระยะทางที่ไม่มากกว่านี้อยู่แล้ว
+        if (label_lookup(&target_labels[u], search->root_label) <= min.dist) {
+            continue;
+        }
+        
+        label_push(&target_labels[u], root_rank, min.dist);
+        
+        if (forward) {
+            for (Edge* current = graph->vertices[u].head; current != NULL; current = current->next) {
+                int v = current->dest;
+                float new_dist = min.dist + edge_weight(graph, current);
+                if (new_dist < search->dist[v]) {
+                    if (search->dist[v] == FLT_MAX) {
+                        search->touched[search->num_touched++] = v;
+                    }
+                    search->dist[v] = new_dist;
+                    insert_min_heap(search->heap, v, new_dist, new_dist);
+                }
+            }
+        } else {
+            for (int k = rev->offset[u]; k < rev->offset[u + 1]; k++) {
+                int v = rev->source[k];
+                float new_dist = min.dist + edge_weight(graph, rev->edge[k]);
+                if (new_dist < search->dist[v]) {
+                    if (search->dist[v] == FLT_MAX) {
+                        search->touched[search->num_touched++] = v;
+                    }
+                    search->dist[v] = new_dist;
+                    insert_min_heap(search->heap, v, new_dist, new_dist);
+                }
+            }
+        }
+    }
+    
+    // ล้างค่าชั่วคราว
+    for (int i = 0; i < search->num_touched; i++) {
+        search->dist[search->touched[i]] = FLT_MAX;
+    }
+    search->num_touched = 0;
+    for (int i = 0; i < root_labels[root].size; i++) {
+        search->root_label[root_labels[root].hub[i]] = FLT_MAX;
+    }
+}
+
+// ฟังก์ชันสำหรับแปลงรายการป้ายกำกับเป็นอาเรย์แบบ CSR
+static void compact_labels(LabelList* lists, int n, int** offset, int** hub, float** dist) {
+    *offset = (int*)malloc((n + 1) * sizeof(int));
+    if (*offset == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for hub labels\n");
+        exit(1);
+    }
+    
+    (*offset)[0] = 0;
+    for (int v = 0; v < n; v++) {
+        (*offset)[v + 1] = (*offset)[v] + lists[v].size;
+    }
+    
+    int total = (*offset)[n];
+    *hub = (int*)malloc((total + 1) * sizeof(int));
+    *dist = (float*)malloc((total + 1) * sizeof(float));
+    if (*hub == NULL || *dist == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for hub labels\n");
+        exit(1);
+    }
+    
+    for (int v = 0; v < n; v++) {
+        if (lists[v].size > 0) {
+            memcpy(&(*hub)[(*offset)[v]], lists[v].hub, lists[v].size * sizeof(int));
+            memcpy(&(*dist)[(*offset)[v]], lists[v].dist, lists[v].size * sizeof(float));
+        }
+        free(lists[v].hub);
+        free(lists[v].dist);
+    }
+}
+
+// ฟังก์ชันสำหรับสร้างป้ายกำกับฮับจากน้ำหนักปัจจุบันของเส้นเชื่อม
+HubLabels* create_hub_labels(Graph* graph, unsigned long max_stale_updates) {
+    int n = graph->num_vertices;
+    
+    HubLabels* labels = (HubLabels*)malloc(sizeof(HubLabels));
+    if (labels == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for hub labels\n");
+        exit(1);
+    }
+    
+    labels->num_vertices = n;
+    labels->weight_version = graph->weight_version;
+    labels->max_stale_updates = max_stale_updates;
+    labels->rank = (int*)malloc((n + 1) * sizeof(int));
+    
+    int* order = (int*)malloc((n + 1) * sizeof(int));
+    int* degree = (int*)calloc(n + 1, sizeof(int));
+    LabelList* out_lists = (LabelList*)calloc(n + 1, sizeof(LabelList));
+    LabelList* in_lists = (LabelList*)calloc(n + 1, sizeof(LabelList));
+    
+    PrunedSearch search;
+    search.dist = (float*)malloc((n + 1) * sizeof(float));
+    search.touched = (int*)malloc((n + 1) * sizeof(int));
+    search.root_label = (float*)malloc((n + 1) * sizeof(float));
+    search.num_touched = 0;
+    search.heap = create_min_heap(graph->num_edges + 1);
+    
+    if (labels->rank == NULL || order == NULL || degree == NULL || out_lists == NULL ||
+        in_lists == NULL || search.dist == NULL || search.touched == NULL || search.root_label == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for hub labels\n");
+        exit(1);
+    }
+    
+    // เรียงจุดยอดตามจำนวนถนนที่เชื่อมต่อ (มากไปน้อย) ทางแยกที่เชื่อมต่อมากมักเป็นฮับที่ดี
+    ReverseAdjacency* rev = build_reverse_adjacency(graph);
+    for (int v = 0; v < n; v++) {
+        degree[v] = rev->offset[v + 1] - rev->offset[v];
+        for (Edge* current = graph->vertices[v].head; current != NULL; current = current->next) {
+            degree[v]++;
+        }
+        order[v] = v;
+    }
+    
+    // เรียงแบบ counting sort เพราะจำนวนถนนต่อทางแยกมีค่าน้อย
+    int max_degree = 0;
+    for (int v = 0; v < n; v++) {
+        if (degree[v] > max_degree) max_degree = degree[v];
+    }
+    int position = 0;
+    for (int d = max_degree; d >= 0; d--) {
+        for (int v = 0; v < n; v++) {
+            if (degree[v] == d) {
+                order[position++] = v;
+            }
+        }
+    }
+    
+    for (int i = 0; i < n; i++) {
+        labels->rank[order[i]] = i;
+        search.dist[i] = FLT_MAX;
+        search.root_label[i] = FLT_MAX;
+    }
+    
+    for (int k = 0; k < n; k++) {
+        int root = order[k];
+        pruned_search(graph, rev, root, k, true, out_lists, in_lists, &search);
+        pruned_search(graph, rev, root, k, false, in_lists, out_lists, &search);
+    }
+    
+    compact_labels(out_lists, n, &labels->out_offset, &labels->out_hub, &labels->out_dist);
+    compact_labels(in_lists, n, &labels->in_offset, &labels->in_hub, &labels->in_dist);
+    
+    free_reverse_adjacency(rev);
+    free(order);
+    free(degree);
+    free(out_lists);
+    free(in_lists);
+    free(search.dist);
+    free(search.touched);
+    free(search.root_label);
+    free_heap(search.heap);
+    
+    return labels;
+}
+
+// ฟังก์ชันสำหรับตรวจสอบว่าป้ายกำกับล้าสมัยหรือไม่
+bool hub_labels_are_stale(const HubLabels* labels, const Graph* graph) {
+    if (labels->num_vertices != graph->num_vertices) {
+        return true;
+    }
+    return graph->weight_version - labels->weight_version > labels->max_stale_updates;
+}
+
+// ฟังก์ชันสำหรับหาเวลาเดินทาง (ชั่วโมง) จากป้ายกำกับเท่านั้น (คืนค่า FLT_MAX ถ้าไปไม่ถึง)
+float query_hub_label_distance(const HubLabels* labels, int src, int dest) {
+    int i = labels->out_offset[src];
+    int i_end = labels->out_offset[src + 1];
+    int j = labels->in_offset[dest];
+    int j_end = labels->in_offset[dest + 1];
+    float best = FLT_MAX;
+    
+    // รวมสองรายการที่เรียงตามลำดับของฮับ
+    while (i < i_end && j < j_end) {
+        int hub_i = labels->out_hub[i];
+        int hub_j = labels->in_hub[j];
+        
+        if (hub_i == hub_j) {
+            float dist = labels->out_dist[i] + labels->in_dist[j];
+            if (dist < best) {
+                best = dist;
+            }
+            i++;
+            j++;
+        } else if (hub_i < hub_j) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+    
+    return best;
+}
+
+// ฟังก์ชันสำหรับหาเวลาเดินทางโดยประมาณ (ชั่วโมง)
+// ใช้ป้ายกำกับถ้ายังไม่ล้าสมัย มิฉะนั้นค้นหาด้วย find_shortest_path (คืนค่า FLT_MAX ถ้าไปไม่ถึง)
+float query_eta(const HubLabels* labels, Graph* graph, int src, int dest) {
+    if (src < 0 || src >= graph->num_vertices ||
+        dest < 0 || dest >= graph->num_vertices) {
+        fprintf(stderr, "Error: Invalid vertex ID\n");
+        return FLT_MAX;
+    }
+    
+    if (labels != NULL && !hub_labels_are_stale(labels, graph)) {
+        return query_hub_label_distance(labels, src, dest);
+    }
+    
+    Route* route = find_shortest_path(graph, src, dest);
+    if (route == NULL) {
+        return FLT_MAX;
+    }
+    
+    // build_path คืนเส้นทางที่มีเพียงปลายทางถ้าไปไม่ถึง
+    float eta = (route->length > 0 && route->path[0] == src) ? route->total_time : FLT_MAX;
+    free_route(route);
+    
+    return eta;
+}
+
+// ฟังก์ชันสำหรับแสดงสถิติขนาดของป้ายกำกับ
+void print_hub_label_statistics(const HubLabels* labels) {
+    int n = labels->num_vertices;
+    int max_out = 0;
+    int max_in = 0;
+    
+    for (int v = 0; v < n; v++) {
+        int out_size = labels->out_offset[v + 1] - labels->out_offset[v];
+        int in_size = labels->in_offset[v + 1] - labels->in_offset[v];
+        if (out_size > max_out) max_out = out_size;
+        if (in_size > max_in) max_in = in_size;
+    }
+    
+    long total_out = labels->out_offset[n];
+    long total_in = labels->in_offset[n];
+    size_t bytes = (size_t)(total_out + total_in) * (sizeof(int) + sizeof(float)) +
+                   (size_t)(n + 1) * 2 * sizeof(int) + (size_t)n * sizeof(int);
+    
+    printf("Hub Label Statistics:\n");
+    printf("  Intersections: %d\n", n);
+    printf("  Outgoing labels: %ld hubs (average %.1f, max %d per intersection)\n",
+           total_out, (n > 0) ? (double)total_out / n : 0.0, max_out);
+    printf("  Incoming labels: %ld hubs (average %.1f, max %d per intersection)\n",
+           total_in, (n > 0) ? (double)total_in / n : 0.0, max_in);
+    printf("  Memory: %zu bytes (%.1f bytes per intersection)\n",
+           bytes, (n > 0) ? (double)bytes / n : 0.0);
+}
+
+// ฟังก์ชันสำหรับลบป้ายกำกับและคืนหน่วยความจำ
+void free_hub_labels(HubLabels* labels) {
+    if (labels == NULL) return;
+    
+    free(labels->rank);
+    free(labels->out_offset);
+    free(labels->out_hub);
+    free(labels->out_dist);
+    free(labels->in_offset);
+    free(labels->in_hub);
+    free(labels->in_dist);
+    free(labels);
+}
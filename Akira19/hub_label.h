@@ -0,0 +1,45 @@
+#ifndef HUB_LABEL_H
+#define HUB_LABEL_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include "graph.h"
+ #include "route.h"
+ 
+ // ป้ายกำกับฮับ (Hub Labels) สำหรับตอบเวลาเดินทางระหว่างทางแยกโดยไม่ต้องค้นหาเส้นทาง
+ // สร้างด้วย Pruned Landmark Labeling จากน้ำหนักของเส้นเชื่อม ณ เวลาที่สร้าง
+ // ป้ายกำกับของแต่ละจุดยอดเก็บแบบ CSR และเรียงตามลำดับของฮับ เพื่อให้ค้นหาด้วยการรวม (merge) สองรายการ
+ typedef struct {
+    int num_vertices;            // จำนวนจุดยอด
+    int* rank;                   // ลำดับความสำคัญของแต่ละจุดยอด (0 = สำคัญที่สุด)
+    int* out_offset;             // ตำแหน่งเริ่มต้นของป้ายขาออกของแต่ละจุดยอด (ขนาด num_vertices + 1)
+    int* out_hub;                // ลำดับของฮับในป้ายขาออก (ฮับที่ไปถึงได้จากจุดยอด)
+    float* out_dist;             // เวลาเดินทางจากจุดยอดไปยังฮับ
+    int* in_offset;              // ตำแหน่งเริ่มต้นของป้ายขาเข้าของแต่ละจุดยอด (ขนาด num_vertices + 1)
+    int* in_hub;                 // ลำดับของฮับในป้ายขาเข้า (ฮับที่มาถึงจุดยอดได้)
+    float* in_dist;              // เวลาเดินทางจากฮับมายังจุดยอด
+    unsigned long weight_version;    // weight_version ของกราฟ ณ เวลาที่สร้าง
+    unsigned long max_stale_updates; // จำนวนการเปลี่ยนน้ำหนักที่ยอมรับได้ก่อนถือว่าป้ายล้าสมัย
+ } HubLabels;
+ 
+ // ฟังก์ชันสำหรับสร้างป้ายกำกับฮับจากน้ำหนักปัจจุบันของเส้นเชื่อม
+ HubLabels* create_hub_labels(Graph* graph, unsigned long max_stale_updates);
+ 
+ // ฟังก์ชันสำหรับตรวจสอบว่าป้ายกำกับล้าสมัยหรือไม่
+ bool hub_labels_are_stale(const HubLabels* labels, const Graph* graph);
+ 
+ // ฟังก์ชันสำหรับหาเวลาเดินทาง (ชั่วโมง) จากป้ายกำกับเท่านั้น (คืนค่า FLT_MAX ถ้าไปไม่ถึง)
+ float query_hub_label_distance(const HubLabels* labels, int src, int dest);
+ 
+ // ฟังก์ชันสำหรับหาเวลาเดินทางโดยประมาณ (ชั่วโมง)
+ // ใช้ป้ายกำกับถ้ายังไม่ล้าสมัย มิฉะนั้นค้นหาด้วย find_shortest_path (คืนค่า FLT_MAX ถ้าไปไม่ถึง)
+ float query_eta(const HubLabels* labels, Graph* graph, int src, int dest);
+ 
+ // ฟังก์ชันสำหรับแสดงสถิติขนาดของป้ายกำกับ
+ void print_hub_label_statistics(const HubLabels* labels);
+ 
+ // ฟังก์ชันสำหรับลบป้ายกำกับและคืนหน่วยความจำ
+ void free_hub_labels(HubLabels* labels);
+ 
+ #endif
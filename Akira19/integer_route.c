@@ -0,0 +1,335 @@
+/*
+* integer_route.c
+* การค้นหาเส้นทางด้วยต้นทุนแบบจำนวนเต็ม (Radix Heap และคิวแบบถังของ Dial)
+*/
+
+#include "integer_route.h"
+#include <math.h>
+
+// สมาชิกของคิวแบบจำนวนเต็ม
+typedef struct {
+    uint32_t key;   // ต้นทุนสะสมจากจุดเริ่มต้น
+    int vertex;     // จุดยอด
+} IntQueueItem;
+
+// ถังของสมาชิก (อาเรย์ที่ขยายได้)
+typedef struct {
+    IntQueueItem* items;
+    int size;
+    int capacity;
+} IntBucket;
+
+// ฟังก์ชันสำหรับเพิ่มสมาชิกลงในถัง
+static void bucket_push(IntBucket* bucket, uint32_t key, int vertex) {
+    if (bucket->size >= bucket->capacity) {
+        int new_capacity = (bucket->capacity > 0) ? bucket->capacity * 2 : 8;
+        IntQueueItem* items = (IntQueueItem*)realloc(bucket->items, new_capacity * sizeof(IntQueueItem));
+        if (items == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for queue bucket\n");
+            exit(1);
+        }
+        bucket->items = items;
+        bucket->capacity = new_capacity;
+    }
+    
+    bucket->items[bucket->size].key = key;
+    bucket->items[bucket->size].vertex = vertex;
+    bucket->size++;
+}
+
+// ---------------------------------------------------------------------------
+// Radix Heap: คิวแบบ monotone สำหรับคีย์ 32 บิต
+// สมาชิกอยู่ในถังตามบิตสูงสุดที่ต่างจากคีย์ที่ถูกนำออกล่าสุด
+// ---------------------------------------------------------------------------
+
+#define RADIX_NUM_BUCKETS 33
+
+typedef struct {
+    IntBucket buckets[RADIX_NUM_BUCKETS];
+    uint32_t last;  // คีย์ที่ถูกนำออกล่าสุด
+    int size;       // จำนวนสมาชิกทั้งหมด
+} RadixHeap;
+
+// ฟังก์ชันสำหรับหาดัชนีถังของคีย์
+static inline int radix_bucket_index(uint32_t key, uint32_t last) {
+    return (key == last) ? 0 : 32 - __builtin_clz(key ^ last);
+}
+
+static void radix_push(RadixHeap* heap, uint32_t key, int vertex) {
+    bucket_push(&heap->buckets[radix_bucket_index(key, heap->last)], key, vertex);
+    heap->size++;
+}
+
+static IntQueueItem radix_pop(RadixHeap* heap) {
+    // ถ้าถังแรกว่าง ให้กระจายสมาชิกของถังแรกที่ไม่ว่างลงในถังที่ต่ำกว่า
+    if (heap->buckets[0].size == 0) {
+        int i = 1;
+        while (heap->buckets[i].size == 0) {
+            i++;
+        }
+        
+        IntBucket* bucket = &heap->buckets[i];
+        uint32_t new_last = bucket->items[0].key;
+        for (int j = 1; j < bucket->size; j++) {
+            if (bucket->items[j].key < new_last) {
+                new_last = bucket->items[j].key;
+            }
+        }
+        
+        heap->last = new_last;
+        for (int j = 0; j < bucket->size; j++) {
+            IntQueueItem item = bucket->items[j];
+            bucket_push(&heap->buckets[radix_bucket_index(item.key, new_last)], item.key, item.vertex);
+        }
+        bucket->size = 0;
+    }
+    
+    IntBucket* first = &heap->buckets[0];
+    heap->size--;
+    return first->items[--first->size];
+}
+
+// ---------------------------------------------------------------------------
+// คิวแบบถังของ Dial: อาเรย์วงกลมของถังขนาด (ต้นทุนสูงสุดของเส้นเชื่อม + 1)
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    IntBucket* buckets;
+    int num_buckets;
+    uint32_t cursor;  // ต้นทุนของถังปัจจุบัน
+    int size;         // จำนวนสมาชิกทั้งหมด
+} DialQueue;
+
+static void dial_push(DialQueue* queue, uint32_t key, int vertex) {
+    bucket_push(&queue->buckets[key % queue->num_buckets], key, vertex);
+    queue->size++;
+}
+
+static IntQueueItem dial_pop(DialQueue* queue) {
+    while (queue->buckets[queue->cursor % queue->num_buckets].size == 0) {
+        queue->cursor++;
+    }
+    
+    IntBucket* bucket = &queue->buckets[queue->cursor % queue->num_buckets];
+    queue->size--;
+    return bucket->items[--bucket->size];
+}
+
+// แมโครสำหรับสร้างลูปค้นหาแบบ Dijkstra สำหรับคิวแต่ละชนิด
+#define DEFINE_INTEGER_SEARCH(NAME, QUEUE_TYPE, PUSH, POP)                      \
+static void NAME(Graph* graph, const uint32_t* edge_cost, int src, int dest,   \
+                 QUEUE_TYPE* queue, uint32_t* dist, int* prev) {               \
+    dist[src] = 0;                                                             \
+    PUSH(queue, 0, src);                                                       \
+                                                                               \
+    while (queue->size > 0) {                                                  \
+        IntQueueItem min = POP(queue);                                         \
+        int u = min.vertex;                                                    \
+                                                                               \
+        /* ข้ามสมาชิกที่ล้าสมัย */                                                 \
+        if (min.key > dist[u]) {                                               \
+            continue;                                                          \
+        }                                                                      \
+                                                                               \
+        if (u == dest) {                                                       \
+            break;                                                             \
+        }                                                                      \
+                                                                               \
+        for (Edge* current = graph->vertices[u].head; current != NULL;         \
+             current = current->next) {                                        \
+            int v = current->dest;                                             \
+            uint32_t new_dist = min.key + edge_cost[current->id];              \
+                                                                               \
+            if (new_dist < dist[v]) {                                          \
+                dist[v] = new_dist;                                            \
+                prev[v] = u;                                                   \
+                PUSH(queue, new_dist, v);                                      \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+}
+
+DEFINE_INTEGER_SEARCH(search_radix_heap, RadixHeap, radix_push, radix_pop)
+DEFINE_INTEGER_SEARCH(search_dial, DialQueue, dial_push, dial_pop)
+
+// ฟังก์ชันสำหรับแปลงเวลาการเดินทาง (ชั่วโมง) เป็นเดซิวินาที
+static inline uint32_t quantize_travel_time(float hours) {
+    float scaled = hours * INTEGER_COST_SCALE + 0.5f;
+    if (scaled <= 0.0f) return 0;
+    if (scaled >= (float)(UINT32_MAX / 2)) return UINT32_MAX / 2;
+    return (uint32_t)scaled;
+}
+
+// ฟังก์ชันสำหรับสร้างตารางต้นทุนแบบจำนวนเต็มจากน้ำหนักปัจจุบันของเส้นเชื่อม
+IntegerCostTable* create_integer_cost_table(Graph* graph) {
+    IntegerCostTable* table = (IntegerCostTable*)malloc(sizeof(IntegerCostTable));
+    if (table == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for integer cost table\n");
+        exit(1);
+    }
+    
+    table->num_edges = 0;
+    table->edge_cost = NULL;
+    table->max_edge_cost = 0;
+    
+    refresh_integer_cost_table(graph, table);
+    
+    return table;
+}
+
+// ฟังก์ชันสำหรับแปลงน้ำหนักปัจจุบันของเส้นเชื่อมเป็นจำนวนเต็มใหม่
+void refresh_integer_cost_table(Graph* graph, IntegerCostTable* table) {
+    if (graph->num_edges > table->num_edges) {
+        uint32_t* edge_cost = (uint32_t*)realloc(table->edge_cost, graph->num_edges * sizeof(uint32_t));
+        if (edge_cost == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for integer cost table\n");
+            exit(1);
+        }
+        table->edge_cost = edge_cost;
+        table->num_edges = graph->num_edges;
+    }
+    
+    table->max_edge_cost = 0;
+    for (int i = 0; i < graph->num_vertices; i++) {
+        Edge* current = graph->vertices[i].head;
+        while (current != NULL) {
+            uint32_t cost = quantize_travel_time(edge_weight(graph, current));
+            table->edge_cost[current->id] = cost;
+            if (cost > table->max_edge_cost) {
+                table->max_edge_cost = cost;
+            }
+            current = current->next;
+        }
+    }
+}
+
+// ฟังก์ชันสำหรับเลือกชนิดของคิวที่เหมาะสมกับช่วงของต้นทุน
+IntQueueType choose_integer_queue(IntegerCostTable* table) {
+    return (table->max_edge_cost < DIAL_MAX_BUCKETS) ? INT_QUEUE_DIAL : INT_QUEUE_RADIX_HEAP;
+}
+
+// ฟังก์ชันสำหรับค้นหาเส้นทางที่ใช้เวลาน้อยที่สุดด้วยต้นทุนแบบจำนวนเต็ม
+Route* find_shortest_path_int(Graph* graph, IntegerCostTable* table, int src, int dest, IntQueueType queue_type) {
+    if (src < 0 || src >= graph->num_vertices ||
+        dest < 0 || dest >= graph->num_vertices) {
+        fprintf(stderr, "Error: Invalid vertex ID\n");
+        return NULL;
+    }
+    
+    if (table->num_edges < graph->num_edges) {
+        refresh_integer_cost_table(graph, table);
+    }
+    
+    if (queue_type == INT_QUEUE_AUTO) {
+        queue_type = choose_integer_queue(table);
+    }
+    
+    // คิวแบบ Dial ใช้ไม่ได้ถ้าช่วงของต้นทุนกว้างเกินไป
+    if (queue_type == INT_QUEUE_DIAL && table->max_edge_cost >= DIAL_MAX_BUCKETS) {
+        queue_type = INT_QUEUE_RADIX_HEAP;
+    }
+    
+    uint32_t* dist = (uint32_t*)malloc(graph->num_vertices * sizeof(uint32_t));
+    int* prev = (int*)malloc(graph->num_vertices * sizeof(int));
+    
+    if (dist == NULL || prev == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory\n");
+        exit(1);
+    }
+    
+    for (int i = 0; i < graph->num_vertices; i++) {
+        dist[i] = UINT32_MAX;
+        prev[i] = -1;
+    }
+    
+    if (queue_type == INT_QUEUE_DIAL) {
+        DialQueue queue;
+        queue.num_buckets = (int)table->max_edge_cost + 1;
+        queue.buckets = (IntBucket*)calloc(queue.num_buckets, sizeof(IntBucket));
+        if (queue.buckets == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for queue buckets\n");
+            exit(1);
+        }
+        queue.cursor = 0;
+        queue.size = 0;
+        
+        search_dial(graph, table->edge_cost, src, dest, &queue, dist, prev);
+        
+        for (int i = 0; i < queue.num_buckets; i++) {
+            free(queue.buckets[i].items);
+        }
+        free(queue.buckets);
+    } else {
+        RadixHeap heap = {0};
+        
+        search_radix_heap(graph, table->edge_cost, src, dest, &heap, dist, prev);
+        
+        for (int i = 0; i < RADIX_NUM_BUCKETS; i++) {
+            free(heap.buckets[i].items);
+        }
+    }
+    
+    Route* route = build_path(graph, prev, src, dest);
+    
+    free(dist);
+    free(prev);
+    
+    return route;
+}
+
+// ฟังก์ชันสำหรับตรวจสอบความแม่นยำของเส้นทางแบบจำนวนเต็มเทียบกับแบบทศนิยม
+// คืนค่าความคลาดเคลื่อนสัมพัทธ์สูงสุดของเวลาการเดินทาง
+float check_integer_route_accuracy(Graph* graph, IntegerCostTable* table, int num_queries, unsigned int seed) {
+    float max_error = 0.0f;
+    double total_error = 0.0;
+    int mismatched = 0;
+    
+    for (int i = 0; i < num_queries; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int src = (int)((seed >> 8) % (unsigned int)graph->num_vertices);
+        seed = seed * 1103515245u + 12345u;
+        int dest = (int)((seed >> 8) % (unsigned int)graph->num_vertices);
+        
+        Route* exact = find_shortest_path(graph, src, dest);
+        Route* radix = find_shortest_path_int(graph, table, src, dest, INT_QUEUE_RADIX_HEAP);
+        Route* dial = find_shortest_path_int(graph, table, src, dest, INT_QUEUE_DIAL);
+        
+        Route* approx[2] = {radix, dial};
+        for (int j = 0; j < 2; j++) {
+            float error = 0.0f;
+            if (exact->total_time > 0.0f) {
+                error = fabsf(approx[j]->total_time - exact->total_time) / exact->total_time;
+            }
+            if (error > max_error) {
+                max_error = error;
+            }
+            if (error > 0.0f) {
+                mismatched++;
+            }
+            total_error += error;
+        }
+        
+        free_route(exact);
+        free_route(radix);
+        free_route(dial);
+    }
+    
+    printf("Integer routing accuracy (%d queries):\n", num_queries);
+    printf("  Routes with different travel time: %d / %d\n", mismatched, num_queries * 2);
+    printf("  Mean relative error: %.6f%%\n",
+           (num_queries > 0) ? (total_error / (num_queries * 2)) * 100.0 : 0.0);
+    printf("  Max relative error: %.6f%%\n", max_error * 100.0);
+    
+    return max_error;
+}
+
+// ฟังก์ชันสำหรับลบตารางต้นทุนและคืนหน่วยความจำ
+void free_integer_cost_table(IntegerCostTable* table) {
+    if (table == NULL) return;
+    
+    if (table->edge_cost != NULL) {
+        free(table->edge_cost);
+    }
+    
+    free(table);
+}
@@ -0,0 +1,50 @@
+#ifndef INTEGER_ROUTE_H
+#define INTEGER_ROUTE_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include <stdint.h>
+ #include "graph.h"
+ #include "route.h"
+ 
+ // ตัวคูณสำหรับแปลงเวลาการเดินทาง (ชั่วโมง) เป็นจำนวนเต็ม (เดซิวินาที)
+ #define INTEGER_COST_SCALE 36000.0f
+ 
+ // จำนวนถังสูงสุดที่คิวแบบ Dial ใช้ได้ (ถ้าต้นทุนของเส้นเชื่อมมากกว่านี้จะใช้ Radix Heap)
+ #define DIAL_MAX_BUCKETS 4096
+ 
+ // ชนิดของคิวลำดับความสำคัญสำหรับต้นทุนแบบจำนวนเต็ม
+ typedef enum {
+     INT_QUEUE_AUTO,        // เลือกอัตโนมัติตามช่วงของต้นทุน
+     INT_QUEUE_RADIX_HEAP,  // Radix Heap (ใช้ได้กับทุกช่วงของต้นทุน)
+     INT_QUEUE_DIAL         // คิวแบบถังของ Dial (เหมาะกับต้นทุนช่วงแคบ)
+ } IntQueueType;
+ 
+ // ตารางต้นทุนแบบจำนวนเต็มของเส้นเชื่อม
+ typedef struct {
+     int num_edges;           // จำนวนเส้นเชื่อมในตาราง
+     uint32_t* edge_cost;     // ต้นทุนของแต่ละเส้นเชื่อม (เดซิวินาที, ดัชนีตาม Edge.id)
+     uint32_t max_edge_cost;  // ต้นทุนสูงสุดของเส้นเชื่อม
+ } IntegerCostTable;
+ 
+ // ฟังก์ชันสำหรับสร้างตารางต้นทุนแบบจำนวนเต็มจากน้ำหนักปัจจุบันของเส้นเชื่อม
+ IntegerCostTable* create_integer_cost_table(Graph* graph);
+ 
+ // ฟังก์ชันสำหรับแปลงน้ำหนักปัจจุบันของเส้นเชื่อมเป็นจำนวนเต็มใหม่
+ void refresh_integer_cost_table(Graph* graph, IntegerCostTable* table);
+ 
+ // ฟังก์ชันสำหรับเลือกชนิดของคิวที่เหมาะสมกับช่วงของต้นทุน
+ IntQueueType choose_integer_queue(IntegerCostTable* table);
+ 
+ // ฟังก์ชันสำหรับค้นหาเส้นทางที่ใช้เวลาน้อยที่สุดด้วยต้นทุนแบบจำนวนเต็ม
+ Route* find_shortest_path_int(Graph* graph, IntegerCostTable* table, int src, int dest, IntQueueType queue_type);
+ 
+ // ฟังก์ชันสำหรับตรวจสอบความแม่นยำของเส้นทางแบบจำนวนเต็มเทียบกับแบบทศนิยม
+ // คืนค่าความคลาดเคลื่อนสัมพัทธ์สูงสุดของเวลาการเดินทาง
+ float check_integer_route_accuracy(Graph* graph, IntegerCostTable* table, int num_queries, unsigned int seed);
+ 
+ // ฟังก์ชันสำหรับลบตารางต้นทุนและคืนหน่วยความจำ
+ void free_integer_cost_table(IntegerCostTable* table);
+ 
+ #endif
@@ -0,0 +1,651 @@
+/*
+* isochrone.c
+* การคำนวณพื้นที่ที่เดินทางถึงได้ภายในเวลาที่กำหนด และการคำนวณจากหนึ่งต้นทางไปทุกจุดแบบ PHAST
+*/
+
+#include "isochrone.h"
+#include <float.h>
+
+// ---------------------------------------------------------------------------
+// พื้นที่ที่เดินทางถึงได้
+// ---------------------------------------------------------------------------
+
+// ฟังก์ชันสำหรับสร้างพื้นที่ที่เดินทางถึงได้จากอาเรย์ของเวลาเดินทาง (ดัชนีตามรหัสทางแยก)
+static Isochrone* build_isochrone(Graph* graph, int source, float budget, const float* dist) {
+    Isochrone* isochrone = (Isochrone*)malloc(sizeof(Isochrone));
+    if (isochrone == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for isochrone\n");
+        exit(1);
+    }
+    
+    isochrone->source = source;
+    isochrone->budget = budget;
+    isochrone->num_reachable = 0;
+    isochrone->num_boundary = 0;
+    
+    // นับจำนวนทางแยกที่ไปถึงได้และถนนบนขอบ
+    for (int u = 0; u < graph->num_vertices; u++) {
+        if (dist[u] > budget) continue;
+        
+        isochrone->num_reachable++;
+        for (Edge* current = graph->vertices[u].head; current != NULL; current = current->next) {
+            if (dist[current->dest] > budget) {
+                isochrone->num_boundary++;
+            }
+        }
+    }
+    
+    isochrone->reachable = (int*)malloc((isochrone->num_reachable + 1) * sizeof(int));
+    isochrone->arrival_time = (float*)malloc((isochrone->num_reachable + 1) * sizeof(float));
+    isochrone->boundary_src = (int*)malloc((isochrone->num_boundary + 1) * sizeof(int));
+    isochrone->boundary_dest = (int*)malloc((isochrone->num_boundary + 1) * sizeof(int));
+    isochrone->boundary_fraction = (float*)malloc((isochrone->num_boundary + 1) * sizeof(float));
+    
+    if (isochrone->reachable == NULL || isochrone->arrival_time == NULL ||
+        isochrone->boundary_src == NULL || isochrone->boundary_dest == NULL ||
+        isochrone->boundary_fraction == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for isochrone\n");
+        exit(1);
+    }
+    
+    int r = 0;
+    int b = 0;
+    for (int u = 0; u < graph->num_vertices; u++) {
+        if (dist[u] > budget) continue;
+        
+        isochrone->reachable[r] = u;
+        isochrone->arrival_time[r] = dist[u];
+        r++;
+        
+        for (Edge* current = graph->vertices[u].head; current != NULL; current = current->next) {
+            if (dist[current->dest] > budget) {
+                float fraction = (edge_weight(graph, current) > 0.0f) ? (budget - dist[u]) / edge_weight(graph, current) : 1.0f;
+                if (fraction > 1.0f) fraction = 1.0f;
+                
+                isochrone->boundary_src[b] = u;
+                isochrone->boundary_dest[b] = current->dest;
+                isochrone->boundary_fraction[b] = fraction;
+                b++;
+            }
+        }
+    }
+    
+    return isochrone;
+}
+
+// ฟังก์ชันสำหรับคำนวณพื้นที่ที่เดินทางถึงได้ภายในเวลาที่กำหนด (ค้นหาด้วยฮีปจากต้นทางเดียว)
+Isochrone* compute_isochrone(Graph* graph, int source, float budget) {
+    if (source < 0 || source >= graph->num_vertices) {
+        fprintf(stderr, "Error: Invalid vertex ID\n");
+        return NULL;
+    }
+    
+    float* dist = (float*)malloc(graph->num_vertices * sizeof(float));
+    if (dist == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory\n");
+        exit(1);
+    }
+    
+    for (int i = 0; i < graph->num_vertices; i++) {
+        dist[i] = FLT_MAX;
+    }
+    
+    MinHeap* heap = create_min_heap(graph->num_edges + 1);
+    dist[source] = 0.0f;
+    insert_min_heap(heap, source, 0.0f, 0.0f);
+    
+    while (heap->size > 0) {
+        HeapNode min = extract_min(heap);
+        int u = min.vertex;
+        
+        // ทางแยกที่เหลือทั้งหมดอยู่นอกเวลาที่กำหนด
+        if (min.dist > budget) {
+            break;
+        }
+        
+        if (min.dist > dist[u]) {
+            continue;
+        }
+        
+        for (Edge* current = graph->vertices[u].head; current != NULL; current = current->next) {
+            float new_dist = min.dist + edge_weight(graph, current);
+            if (new_dist < dist[current->dest]) {
+                dist[current->dest] = new_dist;
+                insert_min_heap(heap, current->dest, new_dist, new_dist);
+            }
+        }
+    }
+    
+    Isochrone* isochrone = build_isochrone(graph, source, budget, dist);
+    
+    free(dist);
+    free_heap(heap);
+    
+    return isochrone;
+}
+
+// ---------------------------------------------------------------------------
+// การสร้างลำดับชั้นของการหดจุดยอด
+// ---------------------------------------------------------------------------
+
+// จำนวนจุดยอดสูงสุดที่การค้นหาพยาน (witness search) เยี่ยมชมก่อนยอมเพิ่มเส้นทางลัด
+#define WITNESS_SETTLE_LIMIT 64
+
+// เส้นเชื่อมระหว่างการหดจุดยอด
+typedef struct {
+    int to;
+    float weight;
+} ChArc;
+
+// รายการเส้นเชื่อมที่ขยายได้
+typedef struct {
+    ChArc* arcs;
+    int size;
+    int capacity;
+} ChArcList;
+
+// เส้นเชื่อมของลำดับชั้น (เก็บเป็นรหัสทางแยกก่อนแปลงเป็นลำดับชั้น)
+typedef struct {
+    int from;
+    int to;
+    float weight;
+} ChEdge;
+
+// ข้อมูลระหว่างการสร้างลำดับชั้น
+typedef struct {
+    int n;
+    ChArcList* out;          // เส้นเชื่อมขาออกของจุดยอดที่ยังไม่ถูกหด
+    ChArcList* in;           // เส้นเชื่อมขาเข้าของจุดยอดที่ยังไม่ถูกหด
+    bool* contracted;        // จุดยอดถูกหดแล้วหรือไม่
+    int* deleted_neighbors;  // จำนวนเพื่อนบ้านที่ถูกหดแล้ว
+    float* witness_dist;     // ระยะทางของการค้นหาพยาน
+    int* touched;            // จุดยอดที่ถูกเปลี่ยนค่าในการค้นหาพยาน
+    int num_touched;
+    MinHeap* heap;
+    ChEdge* up;              // เส้นเชื่อมขาขึ้นของลำดับชั้น
+    int num_up;
+    int up_capacity;
+    ChEdge* down;            // เส้นเชื่อมขาลงของลำดับชั้น
+    int num_down;
+    int down_capacity;
+    int num_shortcuts;
+} ChBuilder;
+
+// ฟังก์ชันสำหรับเพิ่มหรือปรับเส้นเชื่อมในรายการ (เก็บน้ำหนักที่น้อยที่สุด)
+static bool arc_list_set(ChArcList* list, int to, float weight) {
+    for (int i = 0; i < list->size; i++) {
+        if (list->arcs[i].to == to) {
+            if (weight < list->arcs[i].weight) {
+                list->arcs[i].weight = weight;
+            }
+            return false;
+        }
+    }
+    
+    if (list->size >= list->capacity) {
+        int new_capacity = (list->capacity > 0) ? list->capacity * 2 : 4;
+        ChArc* arcs = (ChArc*)realloc(list->arcs, new_capacity * sizeof(ChArc));
+        if (arcs == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for contraction hierarchy\n");
+            exit(1);
+        }
+        list->arcs = arcs;
+        list->capacity = new_capacity;
+    }
+    
+    list->arcs[list->size].to = to;
+    list->arcs[list->size].weight = weight;
+    list->size++;
+    return true;
+}
+
+// ฟังก์ชันสำหรับเพิ่มเส้นเชื่อมลงในลำดับชั้น
+static void ch_edge_push(ChEdge** edges, int* size, int* capacity, int from, int to, float weight) {
+    if (*size >= *capacity) {
+        int new_capacity = (*capacity > 0) ? *capacity * 2 : 64;
+        ChEdge* grown = (ChEdge*)realloc(*edges, new_capacity * sizeof(ChEdge));
+        if (grown == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for contraction hierarchy\n");
+            exit(1);
+        }
+        *edges = grown;
+        *capacity = new_capacity;
+    }
+    
+    (*edges)[*size].from = from;
+    (*edges)[*size].to = to;
+    (*edges)[*size].weight = weight;
+    (*size)++;
+}
+
+// ฟังก์ชันสำหรับค้นหาเส้นทางพยานจาก source โดยไม่ผ่าน avoid (จำกัดระยะทางและจำนวนจุดยอด)
+static void witness_search(ChBuilder* b, int source, int avoid, float max_dist) {
+    b->witness_dist[source] = 0.0f;
+    b->touched[b->num_touched++] = source;
+    insert_min_heap(b->heap, source, 0.0f, 0.0f);
+    
+    int settled = 0;
+    while (b->heap->size > 0) {
+        HeapNode min = extract_min(b->heap);
+        int u = min.vertex;
+        
+        if (min.dist > b->witness_dist[u]) {
+            continue;
+        }
+        if (min.dist > max_dist || ++settled > WITNESS_SETTLE_LIMIT) {
+            break;
+        }
+        
+        for (int i = 0; i < b->out[u].size; i++) {
+            int x = b->out[u].arcs[i].to;
+            if (x == avoid || b->contracted[x]) continue;
+            
+            float new_dist = min.dist + b->out[u].arcs[i].weight;
+            if (new_dist < b->witness_dist[x]) {
+                if (b->witness_dist[x] == FLT_MAX) {
+                    b->touched[b->num_touched++] = x;
+                }
+                b->witness_dist[x] = new_dist;
+                insert_min_heap(b->heap, x, new_dist, new_dist);
+            }
+        }
+    }
+    
+    b->heap->size = 0;
+}
+
+// ฟังก์ชันสำหรับล้างค่าของการค้นหาพยาน
+static void witness_reset(ChBuilder* b) {
+    for (int i = 0; i < b->num_touched; i++) {
+        b->witness_dist[b->touched[i]] = FLT_MAX;
+    }
+    b->num_touched = 0;
+}
+
+// ฟังก์ชันสำหรับหดจุดยอด v (หรือจำลองการหดถ้า add_shortcuts = false)
+// คืนค่าจำนวนเส้นทางลัดที่ต้องเพิ่ม
+static int contract_vertex(ChBuilder* b, int v, bool add_shortcuts) {
+    int shortcuts = 0;
+    
+    for (int i = 0; i < b->in[v].size; i++) {
+        int u = b->in[v].arcs[i].to;
+        float w_uv = b->in[v].arcs[i].weight;
+        if (b->contracted[u]) continue;
+        
+        float max_via = -1.0f;
+        for (int j = 0; j < b->out[v].size; j++) {
+            int x = b->out[v].arcs[j].to;
+            if (x == u || b->contracted[x]) continue;
+            if (w_uv + b->out[v].arcs[j].weight > max_via) {
+                max_via = w_uv + b->out[v].arcs[j].weight;
+            }
+        }
+        if (max_via < 0.0f) continue;
+        
+        witness_search(b, u, v, max_via);
+        
+        for (int j = 0; j < b->out[v].size; j++) {
+            int x = b->out[v].arcs[j].to;
+            if (x == u || b->contracted[x]) continue;
+            
+            float via = w_uv + b->out[v].arcs[j].weight;
+            if (b->witness_dist[x] > via) {
+                shortcuts++;
+                if (add_shortcuts) {
+                    if (arc_list_set(&b->out[u], x, via)) {
+                        b->num_shortcuts++;
+                    }
+                    arc_list_set(&b->in[x], u, via);
+                }
+            }
+        }
+        
+        witness_reset(b);
+    }
+    
+    return shortcuts;
+}
+
+// ฟังก์ชันสำหรับคำนวณลำดับความสำคัญของการหด (ค่าน้อยถูกหดก่อน)
+static float contraction_priority(ChBuilder* b, int v) {
+    int removed = 0;
+    for (int i = 0; i < b->in[v].size; i++) {
+        if (!b->contracted[b->in[v].arcs[i].to]) removed++;
+    }
+    for (int i = 0; i < b->out[v].size; i++) {
+        if (!b->contracted[b->out[v].arcs[i].to]) removed++;
+    }
+    
+    return (float)(contract_vertex(b, v, false) - removed + 2 * b->deleted_neighbors[v]);
+}
+
+// ฟังก์ชันสำหรับสร้างลำดับชั้นของการหดจุดยอดจากน้ำหนักปัจจุบันของเส้นเชื่อม
+PhastGraph* create_phast_graph(Graph* graph) {
+    int n = graph->num_vertices;
+    
+    ChBuilder b;
+    b.n = n;
+    b.out = (ChArcList*)calloc(n + 1, sizeof(ChArcList));
+    b.in = (ChArcList*)calloc(n + 1, sizeof(ChArcList));
+    b.contracted = (bool*)calloc(n + 1, sizeof(bool));
+    b.deleted_neighbors = (int*)calloc(n + 1, sizeof(int));
+    b.witness_dist = (float*)malloc((n + 1) * sizeof(float));
+    b.touched = (int*)malloc((n + 1) * sizeof(int));
+    b.num_touched = 0;
+    b.heap = create_min_heap(n + 1);
+    b.up = NULL;
+    b.num_up = 0;
+    b.up_capacity = 0;
+    b.down = NULL;
+    b.num_down = 0;
+    b.down_capacity = 0;
+    b.num_shortcuts = 0;
+    
+    PhastGraph* phast = (PhastGraph*)malloc(sizeof(PhastGraph));
+    if (phast == NULL || b.out == NULL || b.in == NULL || b.contracted == NULL ||
+        b.deleted_neighbors == NULL || b.witness_dist == NULL || b.touched == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for contraction hierarchy\n");
+        exit(1);
+    }
+    
+    phast->num_vertices = n;
+    phast->weight_version = graph->weight_version;
+    phast->rank = (int*)malloc((n + 1) * sizeof(int));
+    phast->vertex_at = (int*)malloc((n + 1) * sizeof(int));
+    if (phast->rank == NULL || phast->vertex_at == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for contraction hierarchy\n");
+        exit(1);
+    }
+    
+    for (int u = 0; u < n; u++) {
+        b.witness_dist[u] = FLT_MAX;
+        for (Edge* current = graph->vertices[u].head; current != NULL; current = current->next) {
+            if (current->dest == u) continue;
+            arc_list_set(&b.out[u], current->dest, edge_weight(graph, current));
+            arc_list_set(&b.in[current->dest], u, edge_weight(graph, current));
+        }
+    }
+    
+    // คิวของจุดยอดตามลำดับความสำคัญ (ปรับค่าแบบ lazy เมื่อถูกนำออก)
+    MinHeap* order = create_min_heap(n + 1);
+    for (int v = 0; v < n; v++) {
+        float priority = contraction_priority(&b, v);
+        insert_min_heap(order, v, priority, priority);
+    }
+    
+    int next_rank = 0;
+    while (order->size > 0) {
+        HeapNode min = extract_min(order);
+        int v = min.vertex;
+        if (b.contracted[v]) continue;
+        
+        float priority = contraction_priority(&b, v);
+        if (order->size > 0 && priority > order->array[0].priority) {
+            insert_min_heap(order, v, priority, priority);
+            continue;
+        }
+        
+        // เก็บเส้นเชื่อมไปยังจุดยอดที่ยังไม่ถูกหด (ซึ่งจะมีลำดับชั้นสูงกว่า)
+        for (int i = 0; i < b.out[v].size; i++) {
+            int x = b.out[v].arcs[i].to;
+            if (b.contracted[x]) continue;
+            ch_edge_push(&b.up, &b.num_up, &b.up_capacity, v, x, b.out[v].arcs[i].weight);
+            b.deleted_neighbors[x]++;
+        }
+        for (int i = 0; i < b.in[v].size; i++) {
+            int u = b.in[v].arcs[i].to;
+            if (b.contracted[u]) continue;
+            ch_edge_push(&b.down, &b.num_down, &b.down_capacity, u, v, b.in[v].arcs[i].weight);
+            b.deleted_neighbors[u]++;
+        }
+        
+        contract_vertex(&b, v, true);
+        b.contracted[v] = true;
+        phast->rank[v] = next_rank;
+        phast->vertex_at[next_rank] = v;
+        next_rank++;
+    }
+    
+    // แปลงเส้นเชื่อมเป็นอาเรย์แบบ CSR ตามลำดับชั้น
+    phast->up_offset = (int*)calloc(n + 1, sizeof(int));
+    phast->up_target = (int*)malloc((b.num_up + 1) * sizeof(int));
+    phast->up_weight = (float*)malloc((b.num_up + 1) * sizeof(float));
+    phast->down_offset = (int*)calloc(n + 1, sizeof(int));
+    phast->down_source = (int*)malloc((b.num_down + 1) * sizeof(int));
+    phast->down_weight = (float*)malloc((b.num_down + 1) * sizeof(float));
+    int* fill = (int*)malloc((n + 1) * sizeof(int));
+    
+    if (phast->up_offset == NULL || phast->up_target == NULL || phast->up_weight == NULL ||
+        phast->down_offset == NULL || phast->down_source == NULL || phast->down_weight == NULL ||
+        fill == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for contraction hierarchy\n");
+        exit(1);
+    }
+    
+    for (int i = 0; i < b.num_up; i++) {
+        phast->up_offset[phast->rank[b.up[i].from] + 1]++;
+    }
+    for (int i = 0; i < b.num_down; i++) {
+        phast->down_offset[phast->rank[b.down[i].to] + 1]++;
+    }
+    for (int r = 0; r < n; r++) {
+        phast->up_offset[r + 1] += phast->up_offset[r];
+        phast->down_offset[r + 1] += phast->down_offset[r];
+    }
+    
+    for (int r = 0; r <= n; r++) fill[r] = phast->up_offset[r];
+    for (int i = 0; i < b.num_up; i++) {
+        int slot = fill[phast->rank[b.up[i].from]]++;
+        phast->up_target[slot] = phast->rank[b.up[i].to];
+        phast->up_weight[slot] = b.up[i].weight;
+    }
+    
+    for (int r = 0; r <= n; r++) fill[r] = phast->down_offset[r];
+    for (int i = 0; i < b.num_down; i++) {
+        int slot = fill[phast->rank[b.down[i].to]]++;
+        phast->down_source[slot] = phast->rank[b.down[i].from];
+        phast->down_weight[slot] = b.down[i].weight;
+    }
+    
+    phast->num_shortcuts = b.num_shortcuts;
+    
+    for (int v = 0; v < n; v++) {
+        free(b.out[v].arcs);
+        free(b.in[v].arcs);
+    }
+    free(b.out);
+    free(b.in);
+    free(b.contracted);
+    free(b.deleted_neighbors);
+    free(b.witness_dist);
+    free(b.touched);
+    free(b.up);
+    free(b.down);
+    free(fill);
+    free_heap(b.heap);
+    free_heap(order);
+    
+    return phast;
+}
+
+// ฟังก์ชันสำหรับตรวจสอบว่าลำดับชั้นล้าสมัยหรือไม่ (น้ำหนักของเส้นเชื่อมเปลี่ยนหลังจากสร้าง)
+bool phast_is_stale(const PhastGraph* phast, const Graph* graph) {
+    return phast->num_vertices != graph->num_vertices ||
+           phast->weight_version != graph->weight_version;
+}
+
+// ---------------------------------------------------------------------------
+// PHAST: ค้นหาขาขึ้นจากต้นทาง แล้วไล่เส้นเชื่อมขาลงตามลำดับชั้นจากสูงไปต่ำ
+// ---------------------------------------------------------------------------
+
+// ฟังก์ชันสำหรับคำนวณเวลาเดินทางไปทุกจุด (dist_by_rank ดัชนีตามลำดับชั้น)
+static void phast_sweep(const PhastGraph* phast, int source, float* dist_by_rank, MinHeap* heap) {
+    int n = phast->num_vertices;
+    
+    for (int r = 0; r < n; r++) {
+        dist_by_rank[r] = FLT_MAX;
+    }
+    
+    // ค้นหาขาขึ้น: เยี่ยมชมเฉพาะจุดยอดที่มีลำดับชั้นสูงกว่า จึงมีขนาดเล็ก
+    int source_rank = phast->rank[source];
+    dist_by_rank[source_rank] = 0.0f;
+    insert_min_heap(heap, source_rank, 0.0f, 0.0f);
+    
+    while (heap->size > 0) {
+        HeapNode min = extract_min(heap);
+        int r = min.vertex;
+        
+        if (min.dist > dist_by_rank[r]) {
+            continue;
+        }
+        
+        for (int k = phast->up_offset[r]; k < phast->up_offset[r + 1]; k++) {
+            float new_dist = min.dist + phast->up_weight[k];
+            if (new_dist < dist_by_rank[phast->up_target[k]]) {
+                dist_by_rank[phast->up_target[k]] = new_dist;
+                insert_min_heap(heap, phast->up_target[k], new_dist, new_dist);
+            }
+        }
+    }
+    
+    // ไล่เส้นเชื่อมขาลงแบบเชิงเส้น: ต้นทางของเส้นเชื่อมมีลำดับชั้นสูงกว่าเสมอจึงมีค่าสุดท้ายแล้ว
+    for (int r = n - 1; r >= 0; r--) {
+        float best = dist_by_rank[r];
+        for (int k = phast->down_offset[r]; k < phast->down_offset[r + 1]; k++) {
+            float via = dist_by_rank[phast->down_source[k]] + phast->down_weight[k];
+            if (via < best) {
+                best = via;
+            }
+        }
+        dist_by_rank[r] = best;
+    }
+}
+
+// ฟังก์ชันสำหรับคำนวณเวลาเดินทางจากต้นทางไปยังทุกทางแยก (dist ดัชนีตามรหัสทางแยก)
+void phast_one_to_all(const PhastGraph* phast, int source, float* dist) {
+    int n = phast->num_vertices;
+    float* dist_by_rank = (float*)malloc((n + 1) * sizeof(float));
+    if (dist_by_rank == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory\n");
+        exit(1);
+    }
+    
+    MinHeap* heap = create_min_heap(64);
+    phast_sweep(phast, source, dist_by_rank, heap);
+    
+    for (int r = 0; r < n; r++) {
+        dist[phast->vertex_at[r]] = dist_by_rank[r];
+    }
+    
+    free(dist_by_rank);
+    free_heap(heap);
+}
+
+// ฟังก์ชันสำหรับคำนวณพื้นที่ที่เดินทางถึงได้ของหลายต้นทางด้วย PHAST
+// ผลลัพธ์เก็บใน results (ขนาด num_sources) และคืนค่าจำนวนพื้นที่ที่คำนวณได้
+int compute_isochrones_batch(const PhastGraph* phast, Graph* graph, const int* sources, int num_sources,
+                             float budget, Isochrone** results) {
+    // ลำดับชั้นที่ล้าสมัยให้เวลาเดินทางจากน้ำหนักเก่า จึงค้นหาจากแต่ละต้นทางด้วยน้ำหนักปัจจุบันแทน
+    if (phast_is_stale(phast, graph)) {
+        int count = 0;
+        for (int i = 0; i < num_sources; i++) {
+            results[i] = compute_isochrone(graph, sources[i], budget);
+            if (results[i] != NULL) {
+                count++;
+            }
+        }
+        return count;
+    }
+    
+    int n = phast->num_vertices;
+    float* dist_by_rank = (float*)malloc((n + 1) * sizeof(float));
+    float* dist = (float*)malloc((n + 1) * sizeof(float));
+    if (dist_by_rank == NULL || dist == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory\n");
+        exit(1);
+    }
+    
+    MinHeap* heap = create_min_heap(64);
+    int count = 0;
+    
+    for (int i = 0; i < num_sources; i++) {
+        int source = sources[i];
+        if (source < 0 || source >= n) {
+            fprintf(stderr, "Error: Invalid vertex ID\n");
+            results[i] = NULL;
+            continue;
+        }
+        
+        phast_sweep(phast, source, dist_by_rank, heap);
+        for (int r = 0; r < n; r++) {
+            dist[phast->vertex_at[r]] = dist_by_rank[r];
+        }
+        
+        results[i] = build_isochrone(graph, source, budget, dist);
+        count++;
+    }
+    
+    free(dist_by_rank);
+    free(dist);
+    free_heap(heap);
+    
+    return count;
+}
+
+// ฟังก์ชันสำหรับแสดงข้อมูลของพื้นที่ที่เดินทางถึงได้
+void print_isochrone(Graph* graph, Isochrone* isochrone) {
+    if (isochrone == NULL) {
+        printf("Isochrone is empty\n");
+        return;
+    }
+    
+    printf("Reachable area from Intersection ID %d", isochrone->source);
+    if (graph->vertices[isochrone->source].name != NULL) {
+        printf(" (%s)", graph->vertices[isochrone->source].name);
+    }
+    printf(" within %.1f minutes:\n", isochrone->budget * 60.0f);
+    
+    printf("  Reachable intersections: %d\n", isochrone->num_reachable);
+    for (int i = 0; i < isochrone->num_reachable; i++) {
+        int id = isochrone->reachable[i];
+        printf("    Intersection ID %d", id);
+        if (graph->vertices[id].name != NULL) {
+            printf(" (%s)", graph->vertices[id].name);
+        }
+        printf(": %.1f minutes\n", isochrone->arrival_time[i] * 60.0f);
+    }
+    
+    printf("  Boundary roads: %d\n", isochrone->num_boundary);
+    for (int i = 0; i < isochrone->num_boundary; i++) {
+        printf("    %d -> %d (%.0f%% reachable)\n",
+               isochrone->boundary_src[i], isochrone->boundary_dest[i],
+               isochrone->boundary_fraction[i] * 100.0f);
+    }
+}
+
+// ฟังก์ชันสำหรับลบพื้นที่ที่เดินทางถึงได้และคืนหน่วยความจำ
+void free_isochrone(Isochrone* isochrone) {
+    if (isochrone == NULL) return;
+    
+    free(isochrone->reachable);
+    free(isochrone->arrival_time);
+    free(isochrone->boundary_src);
+    free(isochrone->boundary_dest);
+    free(isochrone->boundary_fraction);
+    free(isochrone);
+}
+
+// ฟังก์ชันสำหรับลบลำดับชั้นและคืนหน่วยความจำ
+void free_phast_graph(PhastGraph* phast) {
+    if (phast == NULL) return;
+    
+    free(phast->rank);
+    free(phast->vertex_at);
+    free(phast->up_offset);
+    free(phast->up_target);
+    free(phast->up_weight);
+    free(phast->down_offset);
+    free(phast->down_source);
+    free(phast->down_weight);
+    free(phast);
+}
@@ -0,0 +1,67 @@
+#ifndef ISOCHRONE_H
+#define ISOCHRONE_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include "graph.h"
+ #include "route.h"
+ 
+ // พื้นที่ที่เดินทางถึงได้ภายในเวลาที่กำหนดจากทางแยกต้นทาง
+ typedef struct {
+    int source;              // ทางแยกต้นทาง
+    float budget;            // เวลาที่กำหนด (ชั่วโมง)
+    int num_reachable;       // จำนวนทางแยกที่ไปถึงได้
+    int* reachable;          // ทางแยกที่ไปถึงได้
+    float* arrival_time;     // เวลาที่ไปถึงทางแยกแต่ละแห่ง (ชั่วโมง)
+    int num_boundary;        // จำนวนถนนที่อยู่บนขอบของพื้นที่
+    int* boundary_src;       // ทางแยกต้นทางของถนนบนขอบ (ไปถึงได้)
+    int* boundary_dest;      // ทางแยกปลายทางของถนนบนขอบ (ไปไม่ถึงภายในเวลาที่กำหนด)
+    float* boundary_fraction; // สัดส่วนของถนนที่เดินทางได้ก่อนหมดเวลา (0.0 - 1.0)
+ } Isochrone;
+ 
+ // ลำดับชั้นของการหดจุดยอด (Contraction Hierarchy) สำหรับการคำนวณแบบ PHAST
+ // จุดยอดถูกจัดเรียงตามลำดับชั้น เส้นเชื่อมขาลงจัดกลุ่มตามจุดปลายทาง
+ // การคำนวณจากต้นทางหนึ่งไปทุกจุดจึงเป็นการค้นหาขาขึ้นขนาดเล็กแล้วไล่อาเรย์แบบเชิงเส้นหนึ่งรอบ
+ typedef struct {
+    int num_vertices;            // จำนวนจุดยอด
+    int* rank;                   // ลำดับชั้นของแต่ละทางแยก
+    int* vertex_at;              // ทางแยกที่อยู่ในลำดับชั้นแต่ละระดับ
+    int* up_offset;              // เส้นเชื่อมขาขึ้น (ไปยังลำดับที่สูงกว่า) จัดกลุ่มตามลำดับของต้นทาง
+    int* up_target;              // ลำดับของปลายทางของเส้นเชื่อมขาขึ้น
+    float* up_weight;            // น้ำหนักของเส้นเชื่อมขาขึ้น
+    int* down_offset;            // เส้นเชื่อมขาลง (จากลำดับที่สูงกว่า) จัดกลุ่มตามลำดับของปลายทาง
+    int* down_source;            // ลำดับของต้นทางของเส้นเชื่อมขาลง
+    float* down_weight;          // น้ำหนักของเส้นเชื่อมขาลง
+    int num_shortcuts;           // จำนวนเส้นทางลัดที่เพิ่มระหว่างการหดจุดยอด
+    unsigned long weight_version; // weight_version ของกราฟ ณ เวลาที่สร้าง
+ } PhastGraph;
+ 
+ // ฟังก์ชันสำหรับคำนวณพื้นที่ที่เดินทางถึงได้ภายในเวลาที่กำหนด (ค้นหาด้วยฮีปจากต้นทางเดียว)
+ Isochrone* compute_isochrone(Graph* graph, int source, float budget);
+ 
+ // ฟังก์ชันสำหรับสร้างลำดับชั้นของการหดจุดยอดจากน้ำหนักปัจจุบันของเส้นเชื่อม
+ PhastGraph* create_phast_graph(Graph* graph);
+ 
+ // ฟังก์ชันสำหรับตรวจสอบว่าลำดับชั้นล้าสมัยหรือไม่ (น้ำหนักของเส้นเชื่อมเปลี่ยนหลังจากสร้าง)
+ bool phast_is_stale(const PhastGraph* phast, const Graph* graph);
+ 
+ // ฟังก์ชันสำหรับคำนวณเวลาเดินทางจากต้นทางไปยังทุกทางแยก (dist ดัชนีตามรหัสทางแยก)
+ void phast_one_to_all(const PhastGraph* phast, int source, float* dist);
+ 
+ // ฟังก์ชันสำหรับคำนวณพื้นที่ที่เดินทางถึงได้ของหลายต้นทางด้วย PHAST
+ // ผลลัพธ์เก็บใน results (ขนาด num_sources) และคืนค่าจำนวนพื้นที่ที่คำนวณได้
+ // ถ้าลำดับชั้นล้าสมัยจะใช้ compute_isochrone ของแต่ละต้นทางแทน ผลจึงตรงกับน้ำหนักปัจจุบันเสมอ
+ int compute_isochrones_batch(const PhastGraph* phast, Graph* graph, const int* sources, int num_sources,
+                             float budget, Isochrone** results);
+ 
+ // ฟังก์ชันสำหรับแสดงข้อมูลของพื้นที่ที่เดินทางถึงได้
+ void print_isochrone(Graph* graph, Isochrone* isochrone);
+ 
+ // ฟังก์ชันสำหรับลบพื้นที่ที่เดินทางถึงได้และคืนหน่วยความจำ
+ void free_isochrone(Isochrone* isochrone);
+ 
+ // ฟังก์ชันสำหรับลบลำดับชั้นและคืนหน่วยความจำ
+ void free_phast_graph(PhastGraph* phast);
+ 
+ #endif
@@ -0,0 +1,219 @@
+/*
+* junction_queue.c
+* คิวของยานพาหนะที่รอไฟเขียวที่ทางแยกที่มีสัญญาณไฟ (บัฟเฟอร์วงแหวนต่อถนนขาเข้า)
+*/
+
+#include "junction_queue.h"
+#include <string.h>
+
+// ฟังก์ชันสำหรับจองหน่วยความจำของอาเรย์ (ออกจากโปรแกรมถ้าหน่วยความจำไม่พอ)
+static void* allocate_queue_array(size_t count, size_t element_size) {
+    void* array = malloc((count > 0 ? count : 1) * element_size);
+    if (array == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for junction queues\n");
+        exit(1);
+    }
+    return array;
+}
+
+// ฟังก์ชันสำหรับสร้างคิวของทุกถนนขาเข้าของทางแยกที่มีสัญญาณไฟ (dt = ความยาวของหนึ่งขั้นตอนเวลา)
+JunctionQueues* create_junction_queues(Graph* graph, SignalSystem* system, float dt) {
+    JunctionQueues* queues = (JunctionQueues*)calloc(1, sizeof(JunctionQueues));
+    if (queues == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for junction queues\n");
+        exit(1);
+    }
+    
+    // สัญญาณไฟของแต่ละทางแยก (-1 = ไม่มี) เฟสใช้ตำแหน่งเดียวกับตารางเฟสของระบบสัญญาณไฟ
+    int* signal_of_vertex = (int*)allocate_queue_array(graph->num_vertices, sizeof(int));
+    for (int v = 0; v < graph->num_vertices; v++) {
+        signal_of_vertex[v] = -1;
+    }
+    
+    int num_phases = system->num_phases;
+    for (int s = 0; s < system->num_signals; s++) {
+        if (system->signals[s].num_phases > 0) {
+            signal_of_vertex[system->signals[s].junction_id] = s;
+        }
+    }
+    
+    // นับถนนขาเข้าของแต่ละทางแยกตามลำดับของรายการเส้นเชื่อม แล้วกำหนดเฟสที่ควบคุม
+    int* incoming = (int*)calloc(graph->num_vertices > 0 ? graph->num_vertices : 1, sizeof(int));
+    int* phase_of_approach = (int*)allocate_queue_array(graph->num_edges, sizeof(int));
+    queues->approach_of_edge = (int*)allocate_queue_array(graph->num_edges, sizeof(int));
+    queues->approaches = (SignalApproach*)allocate_queue_array(graph->num_edges, sizeof(SignalApproach));
+    if (incoming == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for junction queues\n");
+        exit(1);
+    }
+    
+    for (int v = 0; v < graph->num_vertices; v++) {
+        for (Edge* edge = graph->vertices[v].head; edge != NULL; edge = edge->next) {
+            int s = signal_of_vertex[edge->dest];
+            queues->approach_of_edge[edge->id] = -1;
+            if (s < 0) {
+                continue;
+            }
+            
+            int a = queues->num_approaches++;
+            SignalApproach* approach = &queues->approaches[a];
+            approach->edge = edge;
+            approach->capacity = 4;
+            while (approach->capacity < edge->road->capacity) {
+                approach->capacity *= 2;
+            }
+            approach->slots = (VehicleHandle*)allocate_queue_array(approach->capacity, sizeof(VehicleHandle));
+            approach->head = 0;
+            approach->count = 0;
+            approach->flow_per_tick = edge->road->lanes * SATURATION_FLOW_PER_LANE / 3600.0f * dt;
+            approach->credit = 0.0f;
+            approach->last_green = -2;
+            
+            phase_of_approach[a] = system->signals[s].first_phase + incoming[edge->dest]++ % system->signals[s].num_phases;
+            queues->approach_of_edge[edge->id] = a;
+        }
+    }
+    
+    // จัดถนนขาเข้าตามเฟส (CSR) เพื่อให้ตรวจเฉพาะเฟสที่เป็นไฟเขียว
+    queues->phase_offset = (int*)calloc(num_phases + 1, sizeof(int));
+    queues->phase_approaches = (int*)allocate_queue_array(queues->num_approaches, sizeof(int));
+    if (queues->phase_offset == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for junction queues\n");
+        exit(1);
+    }
+    for (int a = 0; a < queues->num_approaches; a++) {
+        queues->phase_offset[phase_of_approach[a] + 1]++;
+    }
+    for (int p = 0; p < num_phases; p++) {
+        queues->phase_offset[p + 1] += queues->phase_offset[p];
+    }
+    int* fill = (int*)allocate_queue_array(num_phases, sizeof(int));
+    memcpy(fill, queues->phase_offset, num_phases * sizeof(int));
+    for (int a = 0; a < queues->num_approaches; a++) {
+        queues->phase_approaches[fill[phase_of_approach[a]]++] = a;
+    }
+    
+    free(fill);
+    free(phase_of_approach);
+    free(incoming);
+    free(signal_of_vertex);
+    
+    return queues;
+}
+
+// ฟังก์ชันสำหรับเพิ่มยานพาหนะต่อท้ายคิวของถนนขาเข้า
+void push_approach_vehicle(JunctionQueues* queues, int approach_index, VehicleHandle handle) {
+    SignalApproach* approach = &queues->approaches[approach_index];
+    
+    // ขยายบัฟเฟอร์เป็นสองเท่าและเรียงยานพาหนะใหม่ให้เริ่มที่ตำแหน่ง 0
+    if (approach->count == approach->capacity) {
+        int capacity = approach->capacity * 2;
+        VehicleHandle* slots = (VehicleHandle*)allocate_queue_array(capacity, sizeof(VehicleHandle));
+        for (int i = 0; i < approach->count; i++) {
+            slots[i] = approach->slots[(approach->head + i) & (approach->capacity - 1)];
+        }
+        free(approach->slots);
+        approach->slots = slots;
+        approach->capacity = capacity;
+        approach->head = 0;
+    }
+    
+    approach->slots[(approach->head + approach->count) & (approach->capacity - 1)] = handle;
+    approach->count++;
+    
+    queues->arrived++;
+    if (approach->count > queues->longest_queue) {
+        queues->longest_queue = approach->count;
+    }
+}
+
+// ฟังก์ชันสำหรับปล่อยยานพาหนะจากคิวของถนนขาเข้าหนึ่งเส้นตามจำนวนที่สะสมไว้
+static int release_approach(TrafficSimulation* sim, TickWorker* worker, SignalApproach* approach) {
+    JunctionQueues* queues = sim->junction_queues;
+    VehicleStore* store = &sim->vehicles;
+    
+    // เริ่มสะสมใหม่เมื่อไฟเพิ่งเปลี่ยนเป็นสีเขียว
+    if (approach->last_green != sim->time_step - 1) {
+        approach->credit = 0.0f;
+    }
+    approach->last_green = sim->time_step;
+    approach->credit += approach->flow_per_tick;
+    
+    int released = 0;
+    while (approach->count > 0 && approach->credit >= 1.0f) {
+        VehicleHandle handle = approach->slots[approach->head];
+        approach->head = (approach->head + 1) & (approach->capacity - 1);
+        approach->count--;
+        
+        // ข้ามยานพาหนะที่ถูกนำออกจากการจำลองหรือไม่ได้รออยู่ที่ถนนนี้แล้ว
+        int position = vehicle_position(sim, handle);
+        if (position < 0 || store->road_end[position] != ROAD_END_WAITING ||
+            store->current_edge[position] != approach->edge) {
+            continue;
+        }
+        
+        advance_vehicle(sim, worker, position);
+        approach->credit -= 1.0f;
+        released++;
+    }
+    
+    // ความจุที่ไม่ได้ใช้ไม่สะสมไว้ใช้ภายหลัง
+    float limit = (approach->flow_per_tick > 1.0f) ? approach->flow_per_tick : 1.0f;
+    if (approach->count == 0 && approach->credit > limit) {
+        approach->credit = limit;
+    }
+    
+    queues->released += released;
+    return released;
+}
+
+// ฟังก์ชันสำหรับปล่อยยานพาหนะจากคิวของเฟสที่เป็นไฟเขียว (คืนค่าจำนวนที่ปล่อย)
+int release_green_approaches(TrafficSimulation* sim, TickWorker* worker) {
+    JunctionQueues* queues = sim->junction_queues;
+    SignalSystem* system = sim->signal_system;
+    int released = 0;
+    
+    for (int s = 0; s < system->num_signals; s++) {
+        const TrafficSignal* signal = &system->signals[s];
+        if (signal->num_phases == 0 || signal->phases[signal->current_phase].state != GREEN) {
+            continue;
+        }
+        
+        int phase = signal->first_phase + signal->current_phase;
+        for (int k = queues->phase_offset[phase]; k < queues->phase_offset[phase + 1]; k++) {
+            released += release_approach(sim, worker, &queues->approaches[queues->phase_approaches[k]]);
+        }
+    }
+    
+    return released;
+}
+
+// ฟังก์ชันสำหรับนับจำนวนยานพาหนะที่กำลังรอไฟเขียว
+long count_waiting_vehicles(const JunctionQueues* queues) {
+    long waiting = 0;
+    for (int a = 0; a < queues->num_approaches; a++) {
+        waiting += queues->approaches[a].count;
+    }
+    return waiting;
+}
+
+// ฟังก์ชันสำหรับแสดงสถิติของคิวที่ทางแยก
+void print_junction_queue_stats(const JunctionQueues* queues) {
+    printf("Signal approaches: %d, stops at stop lines: %ld, released on green: %ld\n",
+           queues->num_approaches, queues->arrived, queues->released);
+    printf("Vehicles waiting now: %ld, longest queue: %d\n", count_waiting_vehicles(queues), queues->longest_queue);
+}
+
+// ฟังก์ชันสำหรับลบคิวที่ทางแยกและคืนหน่วยความจำ
+void free_junction_queues(JunctionQueues* queues) {
+    if (queues == NULL) return;
+    
+    for (int a = 0; a < queues->num_approaches; a++) {
+        free(queues->approaches[a].slots);
+    }
+    free(queues->approaches);
+    free(queues->approach_of_edge);
+    free(queues->phase_offset);
+    free(queues->phase_approaches);
+    free(queues);
+}
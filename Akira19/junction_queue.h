@@ -0,0 +1,68 @@
+#ifndef JUNCTION_QUEUE_H
+#define JUNCTION_QUEUE_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include "graph.h"
+ #include "traffic_signal.h"
+ #include "simulation.h"
+ 
+ // อัตราการไหลอิ่มตัวของหนึ่งช่องทาง (คันต่อชั่วโมงเมื่อไฟเขียว)
+ #define SATURATION_FLOW_PER_LANE 1800.0f
+ 
+ // คิวของยานพาหนะที่รอที่เส้นหยุดของทางแยกที่มีสัญญาณไฟ
+ // ถนนขาเข้าแต่ละเส้น (approach) มีบัฟเฟอร์วงแหวนแบบ FIFO ของตัวระบุยานพาหนะ
+ // ถนนขาเข้าลำดับที่ k ของทางแยกถูกควบคุมโดยเฟส k % num_phases ของสัญญาณไฟ
+ // แต่ละขั้นตอนเวลาตรวจเฉพาะถนนขาเข้าของเฟสที่เป็นไฟเขียว และปล่อยยานพาหนะตามอัตราการไหลอิ่มตัว
+ // บัฟเฟอร์ขยายเป็นสองเท่าเมื่อเต็มเท่านั้น จึงไม่จองหน่วยความจำเพิ่มเมื่อคิวมีขนาดคงที่
+ 
+ // คิวของถนนขาเข้าหนึ่งเส้น
+ typedef struct {
+     Edge* edge;              // ถนนขาเข้า
+     VehicleHandle* slots;    // บัฟเฟอร์วงแหวนของยานพาหนะที่รอ
+     int capacity;            // ขนาดของบัฟเฟอร์ (กำลังของสอง)
+     int head;                // ตำแหน่งของยานพาหนะคันแรก
+     int count;               // จำนวนยานพาหนะที่รอ
+     float flow_per_tick;     // จำนวนยานพาหนะที่ผ่านได้ต่อขั้นตอนเวลาเมื่อไฟเขียว
+     float credit;            // จำนวนยานพาหนะที่ผ่านได้สะสมระหว่างไฟเขียว
+     int last_green;          // ขั้นตอนเวลาล่าสุดที่ถนนนี้ได้ไฟเขียว
+ } SignalApproach;
+ 
+ // คิวของทุกทางแยกที่มีสัญญาณไฟ
+ typedef struct JunctionQueues {
+     int num_approaches;          // จำนวนถนนขาเข้าที่ควบคุมด้วยสัญญาณไฟ
+     SignalApproach* approaches;  // คิวของถนนขาเข้า
+     int* approach_of_edge;       // คิวของแต่ละเส้นเชื่อมตาม Edge.id (-1 = ไม่มีสัญญาณไฟที่ปลายถนน)
+     int* phase_offset;           // ตำแหน่งเริ่มต้นของถนนขาเข้าของแต่ละเฟส (ตามตารางเฟสของระบบ) ใน phase_approaches
+     int* phase_approaches;       // ถนนขาเข้าเรียงตามสัญญาณไฟและเฟส
+     long arrived;                // จำนวนครั้งที่ยานพาหนะหยุดรอที่เส้นหยุด
+     long released;               // จำนวนยานพาหนะที่ถูกปล่อยเมื่อไฟเขียว
+     int longest_queue;           // คิวที่ยาวที่สุดที่เคยเกิดขึ้น
+ } JunctionQueues;
+ 
+ // ฟังก์ชันสำหรับสร้างคิวของทุกถนนขาเข้าของทางแยกที่มีสัญญาณไฟ (dt = ความยาวของหนึ่งขั้นตอนเวลา)
+ JunctionQueues* create_junction_queues(Graph* graph, SignalSystem* system, float dt);
+ 
+ // ฟังก์ชันสำหรับหาคิวของถนนขาเข้า (-1 = ปลายถนนไม่มีสัญญาณไฟ)
+ static inline int signal_approach_of(const JunctionQueues* queues, const Edge* edge) {
+     return queues->approach_of_edge[edge->id];
+ }
+ 
+ // ฟังก์ชันสำหรับเพิ่มยานพาหนะต่อท้ายคิวของถนนขาเข้า
+ void push_approach_vehicle(JunctionQueues* queues, int approach, VehicleHandle handle);
+ 
+ // ฟังก์ชันสำหรับปล่อยยานพาหนะจากคิวของเฟสที่เป็นไฟเขียว (คืนค่าจำนวนที่ปล่อย)
+ // ยานพาหนะที่ปล่อยถูกย้ายไปยังถนนถัดไปด้วย advance_vehicle การเปลี่ยนแปลงจำนวนรถจึงอยู่ใน worker
+ int release_green_approaches(TrafficSimulation* sim, TickWorker* worker);
+ 
+ // ฟังก์ชันสำหรับนับจำนวนยานพาหนะที่กำลังรอไฟเขียว
+ long count_waiting_vehicles(const JunctionQueues* queues);
+ 
+ // ฟังก์ชันสำหรับแสดงสถิติของคิวที่ทางแยก
+ void print_junction_queue_stats(const JunctionQueues* queues);
+ 
+ // ฟังก์ชันสำหรับลบคิวที่ทางแยกและคืนหน่วยความจำ
+ void free_junction_queues(JunctionQueues* queues);
+ 
+ #endif
@@ -0,0 +1,370 @@
+/*
+* landmark.c
+* การเลือกจุดอ้างอิงและตารางระยะทางสำหรับการค้นหาเส้นทางแบบ ALT
+*/
+
+#include "landmark.h"
+#include <float.h>
+#include "route.h"
+
+// ฟังก์ชันสำหรับคำนวณต้นทุนของเส้นเชื่อมตามตัวชี้วัดของตาราง
+static inline float landmark_edge_cost(const LandmarkSet* set, Edge* edge) {
+    return set->time_weight * calculate_free_flow_time(edge->road) +
+           set->distance_weight * edge->road->length;
+}
+
+// ฟังก์ชันสำหรับคำนวณต้นทุนเมื่อไม่มีการจราจรจากจุดเดียวไปยังทุกจุด
+// ถ้า rev ไม่เป็น NULL จะคำนวณจากทุกจุดไปยัง root แทน
+// order (ถ้าไม่เป็น NULL) เก็บลำดับของจุดยอดที่ถูกเยี่ยมชม และคืนค่าจำนวนจุดยอดในลำดับ
+static int free_flow_dijkstra(Graph* graph, const LandmarkSet* set, const ReverseAdjacency* rev,
+                              int root, float* dist, int* parent, int* order) {
+    for (int i = 0; i < graph->num_vertices; i++) {
+        dist[i] = FLT_MAX;
+        parent[i] = -1;
+    }
+    
+    MinHeap* heap = create_min_heap(graph->num_edges + 1);
+    int count = 0;
+    
+    dist[root] = 0.0f;
+    insert_min_heap(heap, root, 0.0f, 0.0f);
+    
+    while (heap->size > 0) {
+        HeapNode min = extract_min(heap);
+        int u = min.vertex;
+        
+        if (min.dist > dist[u]) {
+            continue;
+        }
+        
+        if (order != NULL) {
+            order[count] = u;
+        }
+        count++;
+        
+        if (rev == NULL) {
+            for (Edge* current = graph->vertices[u].head; current != NULL; current = current->next) {
+                float new_dist = dist[u] + landmark_edge_cost(set, current);
+                if (new_dist < dist[current->dest]) {
+                    dist[current->dest] = new_dist;
+                    parent[current->dest] = u;
+                    insert_min_heap(heap, current->dest, new_dist, new_dist);
+                }
+            }
+        } else {
+            for (int k = rev->offset[u]; k < rev->offset[u + 1]; k++) {
+                float new_dist = dist[u] + landmark_edge_cost(set, rev->edge[k]);
+                if (new_dist < dist[rev->source[k]]) {
+                    dist[rev->source[k]] = new_dist;
+                    parent[rev->source[k]] = u;
+                    insert_min_heap(heap, rev->source[k], new_dist, new_dist);
+                }
+            }
+        }
+    }
+    
+    free_heap(heap);
+    return count;
+}
+
+// ฟังก์ชันสำหรับเลือกจุดที่ไกลจากจุดอ้างอิงเดิมมากที่สุด (จุดที่ไปไม่ถึงถือว่าไกลที่สุด)
+static int select_farthest(Graph* graph, const float* min_dist, const bool* is_landmark) {
+    int best = -1;
+    float best_dist = -1.0f;
+    
+    for (int v = 0; v < graph->num_vertices; v++) {
+        if (!is_landmark[v] && min_dist[v] > best_dist) {
+            best_dist = min_dist[v];
+            best = v;
+        }
+    }
+    
+    return best;
+}
+
+// ฟังก์ชันสำหรับเลือกจุดอ้างอิงแบบ avoid
+// สร้างต้นไม้เส้นทางจาก root แล้วเดินลงกิ่งที่ขอบล่างจากจุดอ้างอิงเดิมประมาณได้แย่ที่สุด
+// (กิ่งที่มีจุดอ้างอิงอยู่แล้วจะถูกข้าม) จนถึงใบของต้นไม้
+static int select_avoid(Graph* graph, const LandmarkSet* set, int root, int num_selected, float* const* from_dist,
+                        float* const* to_dist, const bool* is_landmark,
+                        float* dist, int* parent, int* order) {
+    int n = graph->num_vertices;
+    int count = free_flow_dijkstra(graph, set, NULL, root, dist, parent, order);
+    
+    float* size = (float*)calloc(n, sizeof(float));
+    bool* covered = (bool*)calloc(n, sizeof(bool));
+    int* best_child = (int*)malloc(n * sizeof(int));
+    if (size == NULL || covered == NULL || best_child == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for landmark selection\n");
+        exit(1);
+    }
+    
+    // น้ำหนักของจุดยอด = ระยะทางจริง - ขอบล่างที่ได้จากจุดอ้างอิงเดิม
+    for (int i = 0; i < count; i++) {
+        int v = order[i];
+        float bound = 0.0f;
+        for (int l = 0; l < num_selected; l++) {
+            if (from_dist[l][v] != FLT_MAX && from_dist[l][root] != FLT_MAX &&
+                from_dist[l][v] - from_dist[l][root] > bound) {
+                bound = from_dist[l][v] - from_dist[l][root];
+            }
+            if (to_dist[l][root] != FLT_MAX && to_dist[l][v] != FLT_MAX &&
+                to_dist[l][root] - to_dist[l][v] > bound) {
+                bound = to_dist[l][root] - to_dist[l][v];
+            }
+        }
+        size[v] = dist[v] - bound;
+        covered[v] = is_landmark[v];
+        best_child[v] = -1;
+    }
+    
+    // รวมน้ำหนักของกิ่งจากใบขึ้นไปหาราก
+    for (int i = count - 1; i > 0; i--) {
+        int v = order[i];
+        if (covered[v]) {
+            size[v] = 0.0f;
+            covered[parent[v]] = true;
+        }
+        size[parent[v]] += size[v];
+    }
+    if (covered[root]) {
+        size[root] = 0.0f;
+    }
+    
+    for (int i = 1; i < count; i++) {
+        int v = order[i];
+        int p = parent[v];
+        if (size[v] > 0.0f && (best_child[p] == -1 || size[v] > size[best_child[p]])) {
+            best_child[p] = v;
+        }
+    }
+    
+    int current = root;
+    while (best_child[current] != -1) {
+        current = best_child[current];
+    }
+    
+    free(size);
+    free(covered);
+    free(best_child);
+    
+    return (current == root || is_landmark[current]) ? -1 : current;
+}
+
+// ฟังก์ชันสำหรับแปลงระยะทางเป็นค่าในตาราง (ปัดลงเพื่อให้ยังเป็นขอบล่าง)
+static inline uint16_t quantize_landmark_distance(float dist, float scale) {
+    if (dist == FLT_MAX) {
+        return LANDMARK_UNREACHABLE;
+    }
+    
+    float units = dist / scale;
+    if (units >= (float)(LANDMARK_UNREACHABLE - 1)) {
+        return LANDMARK_UNREACHABLE - 1;
+    }
+    return (uint16_t)units;
+}
+
+// ฟังก์ชันสำหรับสร้างชุดจุดอ้างอิงและคำนวณตารางระยะทาง
+LandmarkSet* create_landmark_set(Graph* graph, int num_landmarks, LandmarkStrategy strategy,
+                                 float time_weight, float distance_weight) {
+    int n = graph->num_vertices;
+    if (num_landmarks > n) {
+        num_landmarks = n;
+    }
+    if (num_landmarks <= 0 || n <= 0 || time_weight < 0.0f || distance_weight < 0.0f) {
+        fprintf(stderr, "Error: Invalid number of landmarks\n");
+        return NULL;
+    }
+    
+    LandmarkSet* set = (LandmarkSet*)malloc(sizeof(LandmarkSet));
+    if (set == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for landmark set\n");
+        exit(1);
+    }
+    
+    set->num_landmarks = 0;
+    set->time_weight = time_weight;
+    set->distance_weight = distance_weight;
+    set->num_vertices = n;
+    set->landmarks = (int*)malloc(num_landmarks * sizeof(int));
+    set->scale = (float*)malloc(num_landmarks * sizeof(float));
+    set->distances = (uint16_t*)malloc((size_t)n * num_landmarks * 2 * sizeof(uint16_t));
+    
+    // ตารางระยะทางแบบทศนิยมชั่วคราวระหว่างเลือกจุดอ้างอิง
+    float** from_dist = (float**)malloc(num_landmarks * sizeof(float*));
+    float** to_dist = (float**)malloc(num_landmarks * sizeof(float*));
+    float* min_dist = (float*)malloc(n * sizeof(float));
+    float* dist = (float*)malloc(n * sizeof(float));
+    int* parent = (int*)malloc(n * sizeof(int));
+    int* order = (int*)malloc(n * sizeof(int));
+    bool* is_landmark = (bool*)calloc(n, sizeof(bool));
+    
+    if (set->landmarks == NULL || set->scale == NULL || set->distances == NULL ||
+        from_dist == NULL || to_dist == NULL || min_dist == NULL || dist == NULL ||
+        parent == NULL || order == NULL || is_landmark == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for landmark set\n");
+        exit(1);
+    }
+    
+    ReverseAdjacency* rev = build_reverse_adjacency(graph);
+    
+    // จุดอ้างอิงแรกคือจุดที่ไกลที่สุดจากทางแยก 0
+    free_flow_dijkstra(graph, set, NULL, 0, min_dist, parent, NULL);
+    unsigned int seed = 12345u;
+    
+    for (int l = 0; l < num_landmarks; l++) {
+        int landmark = -1;
+        
+        if (strategy == LANDMARK_AVOID && l > 0) {
+            seed = seed * 1103515245u + 12345u;
+            int root = (int)((seed >> 8) % (unsigned int)n);
+            landmark = select_avoid(graph, set, root, l, from_dist, to_dist, is_landmark, dist, parent, order);
+        }
+        
+        if (landmark == -1) {
+            landmark = select_farthest(graph, min_dist, is_landmark);
+        }
+        if (landmark == -1) {
+            break;
+        }
+        
+        from_dist[l] = (float*)malloc(n * sizeof(float));
+        to_dist[l] = (float*)malloc(n * sizeof(float));
+        if (from_dist[l] == NULL || to_dist[l] == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for landmark distances\n");
+            exit(1);
+        }
+        
+        free_flow_dijkstra(graph, set, NULL, landmark, from_dist[l], parent, NULL);
+        free_flow_dijkstra(graph, set, rev, landmark, to_dist[l], parent, NULL);
+        
+        is_landmark[landmark] = true;
+        set->landmarks[l] = landmark;
+        set->num_landmarks++;
+        
+        for (int v = 0; v < n; v++) {
+            if (l == 0 || from_dist[l][v] < min_dist[v]) {
+                min_dist[v] = from_dist[l][v];
+            }
+        }
+    }
+    
+    // แปลงเป็นตาราง 16 บิต โดยแต่ละจุดอ้างอิงมีสเกลของตัวเอง
+    int count = set->num_landmarks;
+    for (int l = 0; l < count; l++) {
+        float max_dist = 0.0f;
+        for (int v = 0; v < n; v++) {
+            if (from_dist[l][v] != FLT_MAX && from_dist[l][v] > max_dist) max_dist = from_dist[l][v];
+            if (to_dist[l][v] != FLT_MAX && to_dist[l][v] > max_dist) max_dist = to_dist[l][v];
+        }
+        set->scale[l] = (max_dist > 0.0f) ? max_dist / (float)(LANDMARK_UNREACHABLE - 2) : 1.0f;
+        
+        for (int v = 0; v < n; v++) {
+            set->distances[((size_t)v * count + l) * 2] = quantize_landmark_distance(from_dist[l][v], set->scale[l]);
+            set->distances[((size_t)v * count + l) * 2 + 1] = quantize_landmark_distance(to_dist[l][v], set->scale[l]);
+        }
+        
+        free(from_dist[l]);
+        free(to_dist[l]);
+    }
+    
+    free(from_dist);
+    free(to_dist);
+    free(min_dist);
+    free(dist);
+    free(parent);
+    free(order);
+    free(is_landmark);
+    free_reverse_adjacency(rev);
+    
+    return set;
+}
+
+// ฟังก์ชันสำหรับคำนวณตัวคูณของขอบล่างสำหรับตัวชี้วัดอื่น (0 = ใช้ไม่ได้)
+// ต้นทุน a * เวลา + b * ระยะทาง มีขอบล่างเป็น k * ขอบล่างของตาราง เมื่อ k * time_weight <= a และ k * distance_weight <= b
+float landmark_heuristic_scale(const LandmarkSet* set, float time_weight, float distance_weight) {
+    float scale = FLT_MAX;
+    
+    if (set->time_weight > 0.0f && time_weight / set->time_weight < scale) {
+        scale = time_weight / set->time_weight;
+    }
+    if (set->distance_weight > 0.0f && distance_weight / set->distance_weight < scale) {
+        scale = distance_weight / set->distance_weight;
+    }
+    
+    return (scale == FLT_MAX || scale < 0.0f) ? 0.0f : scale;
+}
+
+// ฟังก์ชันสำหรับเลือกจุดอ้างอิงที่ให้ขอบล่างดีที่สุดสำหรับคู่ต้นทาง-ปลายทาง
+void prepare_landmark_query(const LandmarkSet* set, int src, int dest, LandmarkQuery* query) {
+    query->set = set;
+    query->count = 0;
+    
+    float bounds[LANDMARK_MAX_ACTIVE];
+    const uint16_t* target_row = &set->distances[(size_t)dest * set->num_landmarks * 2];
+    
+    for (int l = 0; l < set->num_landmarks; l++) {
+        // ประเมินขอบล่างที่ต้นทางเมื่อใช้จุดอ้างอิงนี้เพียงจุดเดียว
+        LandmarkQuery single;
+        single.set = set;
+        single.count = 1;
+        single.index[0] = l;
+        single.from_target[0] = target_row[l * 2];
+        single.to_target[0] = target_row[l * 2 + 1];
+        float bound = landmark_lower_bound(&single, src);
+        
+        // แทรกแบบเรียงลำดับ เก็บไว้เฉพาะจุดที่ดีที่สุด
+        int pos = query->count;
+        while (pos > 0 && bounds[pos - 1] < bound) {
+            pos--;
+        }
+        if (pos >= LANDMARK_MAX_ACTIVE) {
+            continue;
+        }
+        
+        int last = (query->count < LANDMARK_MAX_ACTIVE) ? query->count : LANDMARK_MAX_ACTIVE - 1;
+        for (int k = last; k > pos; k--) {
+            bounds[k] = bounds[k - 1];
+            query->index[k] = query->index[k - 1];
+            query->from_target[k] = query->from_target[k - 1];
+            query->to_target[k] = query->to_target[k - 1];
+        }
+        
+        bounds[pos] = bound;
+        query->index[pos] = l;
+        query->from_target[pos] = single.from_target[0];
+        query->to_target[pos] = single.to_target[0];
+        if (query->count < LANDMARK_MAX_ACTIVE) {
+            query->count++;
+        }
+    }
+}
+
+// ฟังก์ชันสำหรับแสดงรายงานการใช้หน่วยความจำของแต่ละจุดอ้างอิง
+void print_landmark_memory_report(const LandmarkSet* set) {
+    size_t per_landmark = (size_t)set->num_vertices * 2 * sizeof(uint16_t) + sizeof(int) + sizeof(float);
+    size_t float_tables = (size_t)set->num_vertices * 2 * sizeof(float);
+    
+    printf("Landmark Memory Report:\n");
+    printf("  Number of landmarks: %d (metric: %.2f * time + %.2f * distance)\n",
+           set->num_landmarks, set->time_weight, set->distance_weight);
+    
+    for (int l = 0; l < set->num_landmarks; l++) {
+        printf("  Landmark %d: Intersection ID %d, %zu bytes (resolution %.6f cost units)\n",
+               l, set->landmarks[l], per_landmark, set->scale[l]);
+    }
+    
+    printf("  Total: %zu bytes (%.1f%% of equivalent float tables)\n",
+           per_landmark * set->num_landmarks,
+           (float_tables > 0) ? (float)per_landmark / float_tables * 100.0f : 0.0f);
+}
+
+// ฟังก์ชันสำหรับลบชุดจุดอ้างอิงและคืนหน่วยความจำ
+void free_landmark_set(LandmarkSet* set) {
+    if (set == NULL) return;
+    
+    free(set->landmarks);
+    free(set->scale);
+    free(set->distances);
+    free(set);
+}
@@ -0,0 +1,92 @@
+#ifndef LANDMARK_H
+#define LANDMARK_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include <stdint.h>
+ #include "graph.h"
+ 
+ // จำนวนจุดอ้างอิงสูงสุดที่ใช้ในการค้นหาแต่ละครั้ง
+ #define LANDMARK_MAX_ACTIVE 4
+ 
+ // ค่าที่ใช้แทนระยะทางที่ไปไม่ถึงในตาราง
+ #define LANDMARK_UNREACHABLE UINT16_MAX
+ 
+ // วิธีเลือกจุดอ้างอิง
+ typedef enum {
+     LANDMARK_FARTHEST,  // เลือกจุดที่ไกลจากจุดอ้างอิงเดิมมากที่สุด
+     LANDMARK_AVOID      // เลือกจากกิ่งของต้นไม้เส้นทางที่ขอบล่างเดิมประมาณได้แย่ที่สุด
+ } LandmarkStrategy;
+ 
+ // ชุดจุดอ้างอิงสำหรับ ALT (A*, Landmarks, Triangle inequality)
+ // ระยะทางคำนวณจาก time_weight * เวลาเดินทางเมื่อไม่มีการจราจร + distance_weight * ความยาวถนน
+ // ซึ่งเป็นขอบล่างของต้นทุนจริงเสมอ จึงยังใช้ได้เมื่อการจราจรบนถนนเปลี่ยน (ต้องสร้างใหม่เมื่อเพิ่มถนน)
+ typedef struct LandmarkSet {
+     int num_landmarks;      // จำนวนจุดอ้างอิง
+     float time_weight;      // ค่าน้ำหนักของเวลาในตัวชี้วัดของตาราง
+     float distance_weight;  // ค่าน้ำหนักของระยะทางในตัวชี้วัดของตาราง
+     int num_vertices;       // จำนวนจุดยอดของกราฟ
+     int* landmarks;         // รหัสทางแยกของจุดอ้างอิง
+     float* scale;           // ต้นทุนต่อหน่วยในตารางของแต่ละจุดอ้างอิง
+     uint16_t* distances;    // ตารางระยะทาง [(v * num_landmarks + l) * 2 + 0] = d(L, v), [... + 1] = d(v, L)
+ } LandmarkSet;
+ 
+ // จุดอ้างอิงที่เลือกใช้สำหรับปลายทางหนึ่ง
+ typedef struct {
+     const LandmarkSet* set;                    // ชุดจุดอ้างอิง
+     int count;                                 // จำนวนจุดอ้างอิงที่ใช้
+     int index[LANDMARK_MAX_ACTIVE];            // ดัชนีของจุดอ้างอิง
+     int from_target[LANDMARK_MAX_ACTIVE];      // d(L, ปลายทาง) ในหน่วยของตาราง
+     int to_target[LANDMARK_MAX_ACTIVE];        // d(ปลายทาง, L) ในหน่วยของตาราง
+ } LandmarkQuery;
+ 
+ // ฟังก์ชันสำหรับสร้างชุดจุดอ้างอิงและคำนวณตารางระยะทาง
+ // (1.0, 0.0) เหมาะกับ find_shortest_path ส่วน (0.6, 0.2) เหมาะกับเส้นทางของยานพาหนะ
+ LandmarkSet* create_landmark_set(Graph* graph, int num_landmarks, LandmarkStrategy strategy,
+                                  float time_weight, float distance_weight);
+ 
+ // ฟังก์ชันสำหรับคำนวณตัวคูณของขอบล่างสำหรับตัวชี้วัดอื่น (0 = ใช้ไม่ได้)
+ float landmark_heuristic_scale(const LandmarkSet* set, float time_weight, float distance_weight);
+ 
+ // ฟังก์ชันสำหรับเลือกจุดอ้างอิงที่ให้ขอบล่างดีที่สุดสำหรับคู่ต้นทาง-ปลายทาง
+ void prepare_landmark_query(const LandmarkSet* set, int src, int dest, LandmarkQuery* query);
+ 
+ // ฟังก์ชันสำหรับคำนวณขอบล่างของต้นทุน (ตามตัวชี้วัดของตาราง) จากจุดยอดไปยังปลายทาง
+ static inline float landmark_lower_bound(const LandmarkQuery* query, int vertex) {
+     const LandmarkSet* set = query->set;
+     const uint16_t* row = &set->distances[(size_t)vertex * set->num_landmarks * 2];
+     float best = 0.0f;
+ 
+     for (int i = 0; i < query->count; i++) {
+         int l = query->index[i];
+         int from_v = row[l * 2];
+         int to_v = row[l * 2 + 1];
+ 
+         // d(v, t) >= d(L, t) - d(L, v) และ d(v, t) >= d(v, L) - d(t, L)
+         // ลบหนึ่งหน่วยเพราะค่าในตารางถูกปัดลง
+         int bound = 0;
+         if (from_v != LANDMARK_UNREACHABLE && query->from_target[i] != LANDMARK_UNREACHABLE) {
+             bound = query->from_target[i] - from_v - 1;
+         }
+         if (to_v != LANDMARK_UNREACHABLE && query->to_target[i] != LANDMARK_UNREACHABLE &&
+             to_v - query->to_target[i] - 1 > bound) {
+             bound = to_v - query->to_target[i] - 1;
+         }
+ 
+         float estimate = bound * set->scale[l];
+         if (estimate > best) {
+             best = estimate;
+         }
+     }
+ 
+     return best;
+ }
+ 
+ // ฟังก์ชันสำหรับแสดงรายงานการใช้หน่วยความจำของแต่ละจุดอ้างอิง
+ void print_landmark_memory_report(const LandmarkSet* set);
+ 
+ // ฟังก์ชันสำหรับลบชุดจุดอ้างอิงและคืนหน่วยความจำ
+ void free_landmark_set(LandmarkSet* set);
+ 
+ #endif
@@ -0,0 +1,346 @@
+/*
+* link_model.c
+* แบบจำลองการจราจรระดับกลางแบบคิวของถนน (queue-link) สำหรับเครือข่ายขนาดใหญ่
+*/
+
+#include "link_model.h"
+#include "simulation.h"
+#include <math.h>
+
+// ฟังก์ชันสำหรับขยายอาเรย์ของการเดินทาง
+static void* resize_trip_column(void* column, size_t count, size_t element_size) {
+    void* resized = realloc(column, count * element_size);
+    if (resized == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for link model trips\n");
+        exit(1);
+    }
+    return resized;
+}
+
+// ฟังก์ชันสำหรับขยายอาเรย์ของการเดินทางทั้งหมด
+static void resize_trips(LinkModel* model, int capacity) {
+    size_t n = (size_t)capacity;
+    model->trip_route = (Route**)resize_trip_column(model->trip_route, n, sizeof(Route*));
+    model->trip_route_index = (int*)resize_trip_column(model->trip_route_index, n, sizeof(int));
+    model->trip_ready_time = (int*)resize_trip_column(model->trip_ready_time, n, sizeof(int));
+    model->trip_next_free = (int*)resize_trip_column(model->trip_next_free, n, sizeof(int));
+    model->trip_capacity = capacity;
+}
+
+// ฟังก์ชันสำหรับสร้างแบบจำลองคิวของถนนจากเครือข่ายถนน
+LinkModel* create_link_model(Graph* graph, SignalSystem* signal_system, int initial_trips) {
+    if (graph == NULL) {
+        fprintf(stderr, "Error: Graph is required for link model\n");
+        return NULL;
+    }
+    
+    LinkModel* model = (LinkModel*)calloc(1, sizeof(LinkModel));
+    if (model == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for link model\n");
+        exit(1);
+    }
+    
+    int n = graph->num_edges;
+    model->graph = graph;
+    model->signal_system = signal_system;
+    model->route_costs = create_route_cost_table(graph, VEHICLE_ROUTE_TIME_WEIGHT,
+                                                 VEHICLE_ROUTE_DISTANCE_WEIGHT, VEHICLE_ROUTE_CONGESTION_WEIGHT);
+    model->num_links = n;
+    model->link_edge = (Edge**)malloc((n + 1) * sizeof(Edge*));
+    model->free_flow_ticks = (int*)malloc((n + 1) * sizeof(int));
+    model->storage = (int*)malloc((n + 1) * sizeof(int));
+    model->flow_per_tick = (float*)malloc((n + 1) * sizeof(float));
+    model->flow_credit = (float*)malloc((n + 1) * sizeof(float));
+    model->queue_offset = (int*)malloc((n + 1) * sizeof(int));
+    model->queue_head = (int*)malloc((n + 1) * sizeof(int));
+    model->queue_count = (int*)malloc((n + 1) * sizeof(int));
+    if (model->link_edge == NULL || model->free_flow_ticks == NULL || model->storage == NULL ||
+        model->flow_per_tick == NULL || model->flow_credit == NULL || model->queue_offset == NULL ||
+        model->queue_head == NULL || model->queue_count == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for link model\n");
+        exit(1);
+    }
+    
+    // คำนวณคุณสมบัติของแต่ละถนนจากจำนวนช่องทาง ความจุ และความเร็วจำกัด
+    for (int i = 0; i < graph->num_vertices; i++) {
+        for (Edge* edge = graph->vertices[i].head; edge != NULL; edge = edge->next) {
+            Road* road = edge->road;
+            int id = edge->id;
+            
+            model->link_edge[id] = edge;
+            model->free_flow_ticks[id] = (int)ceilf(calculate_free_flow_time(road) * 3600.0f);
+            if (model->free_flow_ticks[id] < 1) model->free_flow_ticks[id] = 1;
+            model->storage[id] = (road->capacity > 0) ? road->capacity : 1;
+            model->flow_per_tick[id] = road->lanes * LINK_SATURATION_FLOW / 3600.0f;
+            model->flow_credit[id] = 0.0f;
+            model->queue_head[id] = 0;
+            model->queue_count[id] = 0;
+        }
+    }
+    
+    // คิวของทุกถนนอยู่ในอาเรย์เดียว แต่ละถนนใช้ช่วงขนาด storage
+    int total_slots = 0;
+    for (int id = 0; id < n; id++) {
+        model->queue_offset[id] = total_slots;
+        total_slots += model->storage[id];
+    }
+    model->queue_offset[n] = total_slots;
+    
+    model->queue_slots = (int*)malloc(((size_t)total_slots + 1) * sizeof(int));
+    if (model->queue_slots == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for link queues\n");
+        exit(1);
+    }
+    
+    if (initial_trips < 16) initial_trips = 16;
+    resize_trips(model, initial_trips);
+    model->free_trip = -1;
+    
+    return model;
+}
+
+// ฟังก์ชันสำหรับหาเส้นเชื่อมจากทางแยก src ไปยังทางแยก dest
+static Edge* find_link_edge(Graph* graph, int src, int dest) {
+    for (Edge* edge = graph->vertices[src].head; edge != NULL; edge = edge->next) {
+        if (edge->dest == dest) {
+            return edge;
+        }
+    }
+    return NULL;
+}
+
+// ฟังก์ชันสำหรับหาถนนถัดไปของการเดินทาง (-1 = ถึงจุดหมายแล้วหรือไม่มีถนน)
+static int next_trip_link(LinkModel* model, int trip) {
+    Route* route = model->trip_route[trip];
+    int index = model->trip_route_index[trip];
+    
+    if (index + 1 >= route->length) {
+        return -1;
+    }
+    
+    Edge* edge = find_link_edge(model->graph, route->path[index], route->path[index + 1]);
+    return (edge != NULL) ? edge->id : -1;
+}
+
+// ฟังก์ชันสำหรับนำการเดินทางเข้าท้ายคิวของถนน (ผู้เรียกตรวจแล้วว่าถนนยังมีที่ว่าง)
+static void push_link(LinkModel* model, int link, int trip) {
+    int slot = model->queue_head[link] + model->queue_count[link];
+    if (slot >= model->storage[link]) {
+        slot -= model->storage[link];
+    }
+    
+    model->queue_slots[model->queue_offset[link] + slot] = trip;
+    model->queue_count[link]++;
+    model->trip_route_index[trip]++;
+    model->trip_ready_time[trip] = model->time_step + model->free_flow_ticks[link];
+}
+
+// ฟังก์ชันสำหรับนำการเดินทางคันแรกออกจากคิวของถนน
+static void pop_link(LinkModel* model, int link) {
+    if (++model->queue_head[link] == model->storage[link]) {
+        model->queue_head[link] = 0;
+    }
+    model->queue_count[link]--;
+}
+
+// ฟังก์ชันสำหรับจบการเดินทางและคืนช่องให้ใช้ใหม่ (เก็บหน่วยความจำของเส้นทางไว้ในช่อง)
+static void complete_trip(LinkModel* model, int trip) {
+    model->trip_next_free[trip] = model->free_trip;
+    model->free_trip = trip;
+    model->active_trips--;
+    model->completed_trips++;
+}
+
+// ฟังก์ชันสำหรับเพิ่มการเดินทางลงในรายการรอเข้าถนนแรก
+static void push_waiting(LinkModel* model, int trip) {
+    if (model->num_waiting >= model->waiting_capacity) {
+        int new_capacity = (model->waiting_capacity > 0) ? model->waiting_capacity * 2 : 64;
+        model->waiting = (int*)resize_trip_column(model->waiting, new_capacity, sizeof(int));
+        model->waiting_capacity = new_capacity;
+    }
+    
+    model->waiting[model->num_waiting++] = trip;
+}
+
+// ฟังก์ชันสำหรับเพิ่มการเดินทางจาก origin ไปยัง destination (คืนค่าหมายเลขการเดินทาง หรือ -1 ถ้าไม่สำเร็จ)
+int add_link_trip(LinkModel* model, int origin, int destination) {
+    if (origin < 0 || origin >= model->graph->num_vertices ||
+        destination < 0 || destination >= model->graph->num_vertices) {
+        fprintf(stderr, "Error: Invalid vertex ID\n");
+        return -1;
+    }
+    
+    // ใช้ช่องของการเดินทางที่จบแล้วก่อน (รวมถึงหน่วยความจำของเส้นทางเดิม)
+    int trip;
+    Route* reuse = NULL;
+    if (model->free_trip >= 0) {
+        trip = model->free_trip;
+        reuse = model->trip_route[trip];
+    } else {
+        if (model->num_trip_slots >= model->trip_capacity) {
+            resize_trips(model, model->trip_capacity * 2);
+        }
+        trip = model->num_trip_slots;
+    }
+    
+    Route* route = find_optimal_path_cached(model->graph, model->route_costs, origin, destination, reuse);
+    if (route == NULL) {
+        fprintf(stderr, "Error: Unable to find route\n");
+        return -1;
+    }
+    
+    if (trip == model->free_trip) {
+        model->free_trip = model->trip_next_free[trip];
+    } else {
+        model->num_trip_slots++;
+    }
+    
+    model->trip_route[trip] = route;
+    model->trip_route_index[trip] = 0;
+    model->trip_ready_time[trip] = model->time_step;
+    model->trip_next_free[trip] = -1;
+    model->active_trips++;
+    model->total_trips++;
+    
+    // เส้นทางที่มีจุดเดียว (origin = destination) ถึงจุดหมายทันที
+    if (route->length <= 1) {
+        complete_trip(model, trip);
+        return trip;
+    }
+    
+    push_waiting(model, trip);
+    return trip;
+}
+
+// ฟังก์ชันสำหรับสะสมอัตราการไหลออกของทุกถนน (ไม่สะสมเกินหนึ่งขั้นตอนเวลาเพื่อไม่ให้ปล่อยรถเป็นกลุ่ม)
+static void accumulate_flow(LinkModel* model) {
+    float* restrict credit = model->flow_credit;
+    const float* restrict flow = model->flow_per_tick;
+    
+    for (int id = 0; id < model->num_links; id++) {
+        float limit = (flow[id] > 1.0f) ? flow[id] : 1.0f;
+        credit[id] += flow[id];
+        if (credit[id] > limit) credit[id] = limit;
+    }
+}
+
+// ฟังก์ชันสำหรับย้ายรถที่หัวคิวของทุกถนนไปยังถนนถัดไปตามอัตราการไหลออกและที่ว่างของถนนถัดไป
+static void transfer_links(LinkModel* model) {
+    int now = model->time_step;
+    
+    for (int link = 0; link < model->num_links; link++) {
+        while (model->queue_count[link] > 0 && model->flow_credit[link] >= 1.0f) {
+            int trip = model->queue_slots[model->queue_offset[link] + model->queue_head[link]];
+            if (model->trip_ready_time[trip] > now) {
+                break;
+            }
+            
+            int next = next_trip_link(model, trip);
+            if (next >= 0 && model->queue_count[next] >= model->storage[next]) {
+                // ถนนถัดไปเต็ม รถคันแรกค้างอยู่และรถคันหลังออกไม่ได้
+                break;
+            }
+            
+            pop_link(model, link);
+            model->flow_credit[link] -= 1.0f;
+            
+            if (next < 0) {
+                complete_trip(model, trip);
+            } else {
+                push_link(model, next, trip);
+            }
+        }
+    }
+}
+
+// ฟังก์ชันสำหรับนำการเดินทางที่รออยู่เข้าสู่ถนนแรกเมื่อถนนมีที่ว่าง (คงลำดับของการเดินทางที่ยังรอ)
+static void release_waiting(LinkModel* model) {
+    int kept = 0;
+    
+    for (int i = 0; i < model->num_waiting; i++) {
+        int trip = model->waiting[i];
+        int link = next_trip_link(model, trip);
+        
+        if (link < 0) {
+            complete_trip(model, trip);
+        } else if (model->queue_count[link] < model->storage[link]) {
+            push_link(model, link, trip);
+        } else {
+            model->waiting[kept++] = trip;
+        }
+    }
+    
+    model->num_waiting = kept;
+}
+
+// ฟังก์ชันสำหรับเขียนจำนวนรถบนถนนกลับไปยัง edge_loads และน้ำหนักของเส้นเชื่อมของกราฟ
+// เพื่อให้การหาเส้นทางและสัญญาณไฟเห็นสภาพการจราจรของแบบจำลองนี้
+static void sync_link_loads(LinkModel* model) {
+    for (int link = 0; link < model->num_links; link++) {
+        Edge* edge = model->link_edge[link];
+        int load = edge_load(model->graph, edge);
+        if (load != model->queue_count[link]) {
+            change_road_load(model->graph, edge, model->queue_count[link] - load);
+            refresh_edge_weight(model->graph, edge);
+            refresh_route_cost(model->graph, model->route_costs, edge);
+        }
+    }
+}
+
+// ฟังก์ชันสำหรับอัปเดตแบบจำลองหนึ่งขั้นตอนเวลา (หนึ่งวินาที)
+void update_link_model(LinkModel* model) {
+    model->time_step++;
+    
+    if (model->signal_system != NULL) {
+        update_signal_system(model->graph, model->signal_system);
+    }
+    
+    accumulate_flow(model);
+    transfer_links(model);
+    release_waiting(model);
+    sync_link_loads(model);
+}
+
+// ฟังก์ชันสำหรับแสดงสถานะของแบบจำลอง
+void print_link_model_status(LinkModel* model) {
+    long on_road = 0;
+    int full_links = 0;
+    
+    for (int link = 0; link < model->num_links; link++) {
+        on_road += model->queue_count[link];
+        if (model->queue_count[link] >= model->storage[link]) {
+            full_links++;
+        }
+    }
+    
+    printf("\nLink Model Status (Time: %d seconds):\n", model->time_step);
+    printf("Trips added: %ld, completed: %ld\n", model->total_trips, model->completed_trips);
+    printf("Vehicles on roads: %ld, waiting to enter: %d\n", on_road, model->num_waiting);
+    printf("Roads at storage capacity: %d / %d\n", full_links, model->num_links);
+}
+
+// ฟังก์ชันสำหรับลบแบบจำลองและคืนหน่วยความจำ (ไม่ลบกราฟและระบบสัญญาณไฟ)
+void free_link_model(LinkModel* model) {
+    if (model == NULL) return;
+    
+    for (int trip = 0; trip < model->num_trip_slots; trip++) {
+        free_route(model->trip_route[trip]);
+    }
+    
+    free_route_cost_table(model->route_costs);
+    free(model->link_edge);
+    free(model->free_flow_ticks);
+    free(model->storage);
+    free(model->flow_per_tick);
+    free(model->flow_credit);
+    free(model->queue_offset);
+    free(model->queue_head);
+    free(model->queue_count);
+    free(model->queue_slots);
+    free(model->trip_route);
+    free(model->trip_route_index);
+    free(model->trip_ready_time);
+    free(model->trip_next_free);
+    free(model->waiting);
+    free(model);
+}
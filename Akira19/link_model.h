@@ -0,0 +1,71 @@
+#ifndef LINK_MODEL_H
+#define LINK_MODEL_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include "graph.h"
+ #include "route.h"
+ #include "traffic_signal.h"
+ 
+ // อัตราการไหลอิ่มตัวของหนึ่งช่องทาง (คัน/ชม.)
+ #define LINK_SATURATION_FLOW 1800.0f
+ 
+ // แบบจำลองระดับกลาง (mesoscopic) แบบคิวของถนน (queue-link)
+ // แต่ละถนนเป็นคิวแบบ FIFO ที่ไม่ติดตามตำแหน่งเป็นเมตร ยานพาหนะออกจากถนนได้เมื่อ
+ // 1) อยู่บนถนนครบเวลาเดินทางเมื่อไม่มีการจราจร 2) ถนนยังมีอัตราการไหลออกเหลือในขั้นตอนเวลานี้
+ // และ 3) ถนนถัดไปยังมีที่ว่าง (ถ้าเต็ม รถจะค้างและคิวสะสมย้อนกลับ)
+ // ข้อมูลทั้งหมดเก็บเป็นอาเรย์ต่อเนื่องตามรหัสของเส้นเชื่อม (Edge.id) หรือหมายเลขการเดินทาง
+ typedef struct {
+     Graph* graph;                // เครือข่ายถนน
+     SignalSystem* signal_system; // ระบบสัญญาณไฟ (อ่าน edge_loads ที่แบบจำลองนี้เขียน)
+     RouteCostTable* route_costs; // ต้นทุนรวมของเส้นเชื่อมสำหรับหาเส้นทางของการเดินทาง
+ 
+     // ข้อมูลของถนน (ดัชนีตามรหัสของเส้นเชื่อม)
+     int num_links;               // จำนวนถนน
+     Edge** link_edge;            // เส้นเชื่อมของถนน
+     int* free_flow_ticks;        // เวลาเดินทางเมื่อไม่มีการจราจร (ขั้นตอนเวลา อย่างน้อย 1)
+     int* storage;                // จำนวนรถสูงสุดบนถนน (Road.capacity)
+     float* flow_per_tick;        // อัตราการไหลออกสูงสุดต่อขั้นตอนเวลา (lanes × อัตราอิ่มตัว)
+     float* flow_credit;          // อัตราการไหลออกที่สะสมไว้และยังไม่ได้ใช้
+     int* queue_offset;           // ตำแหน่งเริ่มต้นของคิวของถนนใน queue_slots
+     int* queue_head;             // ตำแหน่งของรถคันแรกในคิว (นับจาก queue_offset)
+     int* queue_count;            // จำนวนรถบนถนน
+     int* queue_slots;            // คิวของทุกถนนต่อกัน (หมายเลขการเดินทาง, ขนาดรวม = ผลรวมของ storage)
+ 
+     // ข้อมูลของการเดินทาง (ช่องของการเดินทางที่จบแล้วถูกนำกลับมาใช้ใหม่ พร้อมหน่วยความจำของเส้นทาง)
+     Route** trip_route;          // เส้นทางของการเดินทาง
+     int* trip_route_index;       // ดัชนีของทางแยกปลายทางของถนนปัจจุบันในเส้นทาง
+     int* trip_ready_time;        // ขั้นตอนเวลาที่ออกจากถนนปัจจุบันได้เร็วที่สุด
+     int* trip_next_free;         // ช่องว่างถัดไปในรายการช่องว่าง (-1 = ไม่มี)
+     int trip_capacity;           // ขนาดของอาเรย์การเดินทาง
+     int num_trip_slots;          // จำนวนช่องที่เคยใช้
+     int free_trip;               // ช่องว่างแรก (-1 = ไม่มี)
+ 
+     // การเดินทางที่รอเข้าสู่ถนนแรก (ถนนแรกเต็ม) เรียงตามลำดับที่เพิ่มเข้ามา
+     int* waiting;
+     int num_waiting;
+     int waiting_capacity;
+ 
+     int time_step;               // ขั้นตอนเวลาปัจจุบัน (วินาที)
+     int active_trips;            // จำนวนการเดินทางที่ยังไม่จบ (รวมที่รอเข้าถนน)
+     long total_trips;            // จำนวนการเดินทางที่เพิ่มทั้งหมด
+     long completed_trips;        // จำนวนการเดินทางที่ถึงจุดหมาย
+ } LinkModel;
+ 
+ // ฟังก์ชันสำหรับสร้างแบบจำลองคิวของถนนจากเครือข่ายถนน
+ LinkModel* create_link_model(Graph* graph, SignalSystem* signal_system, int initial_trips);
+ 
+ // ฟังก์ชันสำหรับเพิ่มการเดินทางจาก origin ไปยัง destination (คืนค่าหมายเลขการเดินทาง หรือ -1 ถ้าไม่สำเร็จ)
+ int add_link_trip(LinkModel* model, int origin, int destination);
+ 
+ // ฟังก์ชันสำหรับอัปเดตแบบจำลองหนึ่งขั้นตอนเวลา (หนึ่งวินาที)
+ void update_link_model(LinkModel* model);
+ 
+ // ฟังก์ชันสำหรับแสดงสถานะของแบบจำลอง
+ void print_link_model_status(LinkModel* model);
+ 
+ // ฟังก์ชันสำหรับลบแบบจำลองและคืนหน่วยความจำ (ไม่ลบกราฟและระบบสัญญาณไฟ)
+ void free_link_model(LinkModel* model);
+ 
+ #endif
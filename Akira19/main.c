@@ -10,6 +10,8 @@
 #include "traffic_signal.h"
 #include "route.h"
 #include "simulation.h"
+#include "benchmark.h"
+#include "headless.h"
 
 
 // ฟังก์ชันสำหรับสร้างเครือข่ายถนนตัวอย่าง
@@ -123,7 +125,17 @@ void simulate_evening_traffic(TrafficSimulation* sim) {
 }
 
 
-int main() {
+int main(int argc, char* argv[]) {
+    // โหมดวัดประสิทธิภาพ: ./program --benchmark [ชื่อชุดทดสอบ]
+    if (argc > 1 && strcmp(argv[1], "--benchmark") == 0) {
+        return run_benchmark((argc > 2) ? argv[2] : "all");
+    }
+    
+    // โหมดจำลองเร็วที่สุดโดยไม่แสดงผลระหว่างทาง: ./program --headless [--config ไฟล์] [--ชื่อ ค่า ...]
+    if (argc > 1 && strcmp(argv[1], "--headless") == 0) {
+        return run_headless(argc - 2, argv + 2);
+    }
+    
     printf("=== Intelligent Traffic Simulation System ===\n\n");
     
     // สร้างเครือข่ายถนน
@@ -166,10 +178,8 @@ int main() {
     printf("\n=== Morning Traffic Simulation Results ===\n");
     analyze_simulation_results(sim);
     
-    // เคลียร์ยานพาหนะเก่าออกไป (จำลองให้ทุกคันถึงจุดหมายแล้ว)
-    for (int i = 0; i < sim->num_vehicles; i++) {
-        sim->vehicles[i].completed = true;
-    }
+    // เคลียร์ยานพาหนะเก่าออกไป (นำออกจากถนนและคืนช่องให้ใช้ใหม่)
+    clear_vehicles(sim);
     
     // จำลองการจราจรช่วงเย็น (ออกจากเมือง)
     printf("\n=== Evening Rush Hour (Outbound) ===\n");
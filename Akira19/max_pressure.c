@@ -0,0 +1,282 @@
+/*
+* max_pressure.c
+* ตัวควบคุมสัญญาณไฟแบบ max-pressure ที่เลือกเฟสตามความต่างของจำนวนรถขาเข้าและขาออกของแต่ละทางแยก
+*/
+
+#include "max_pressure.h"
+#include "wall_clock.h"
+#include <string.h>
+
+// ข้อมูลที่ส่งให้แต่ละเธรดเมื่อประเมินทางแยกแบบขนาน
+typedef struct {
+    const SignalSystem* system;  // ระบบสัญญาณไฟ
+    const int* signals;          // ดัชนีของสัญญาณไฟที่ถึงเวลาตัดสินใจ
+} PressureTask;
+
+// ฟังก์ชันสำหรับอ่านคิวของถนน (รถที่รอที่เส้นหยุด หรือจำนวนรถบนถนนถ้าไม่ใช้คิวรอไฟเขียว)
+static inline int road_queue(const MaxPressureController* controller, const Edge* edge) {
+    if (controller->queues == NULL) {
+        return edge_load(controller->graph, edge);
+    }
+    
+    // ถนนที่ปลายทางไม่มีสัญญาณไฟไม่มีรถรอ
+    int approach = signal_approach_of(controller->queues, edge);
+    return (approach >= 0) ? controller->queues->approaches[approach].count : 0;
+}
+
+// ฟังก์ชันสำหรับคำนวณผลรวมของคิวบนถนนขาออกของทางแยก
+static void sum_outgoing_queues(const MaxPressureController* controller, int junction_id, int* total, int* count) {
+    *total = 0;
+    *count = 0;
+    for (const Edge* edge = controller->graph->vertices[junction_id].head; edge != NULL; edge = edge->next) {
+        *total += road_queue(controller, edge);
+        (*count)++;
+    }
+}
+
+// ฟังก์ชันสำหรับคำนวณความกดดันของเฟสเมื่อทราบผลรวมของคิวบนถนนขาออกแล้ว
+// คิวปลายน้ำของถนนขาเข้าแต่ละเส้นเป็นค่าเฉลี่ยของถนนขาออกที่ไม่ใช่การกลับรถ จึงใช้เวลาคงที่ต่อถนนขาเข้า
+static float pressure_with_downstream(const MaxPressureController* controller, const TrafficSignal* signal,
+                                      int phase, int out_total, int out_count) {
+    int index = signal->first_phase + phase;
+    float pressure = 0.0f;
+    for (int a = controller->approach_offset[index]; a < controller->approach_offset[index + 1]; a++) {
+        int total = out_total;
+        int count = out_count;
+        if (controller->u_turns[a] != NULL) {
+            total -= road_queue(controller, controller->u_turns[a]);
+            count--;
+        }
+        
+        float downstream = (count > 0) ? (float)total / count : 0.0f;
+        pressure += road_queue(controller, controller->approaches[a]) - downstream;
+    }
+    return pressure;
+}
+
+// ฟังก์ชันสำหรับคำนวณความกดดันของเฟสหนึ่งของสัญญาณไฟ
+float phase_pressure(const MaxPressureController* controller, const TrafficSignal* signal, int phase) {
+    if (phase < 0 || phase >= signal->num_phases) {
+        fprintf(stderr, "Error: Invalid phase index\n");
+        return 0.0f;
+    }
+    
+    int out_total, out_count;
+    sum_outgoing_queues(controller, signal->junction_id, &out_total, &out_count);
+    return pressure_with_downstream(controller, signal, phase, out_total, out_count);
+}
+
+// ฟังก์ชันสำหรับประเมินทางแยกในช่วง [begin, end) ของรายการสัญญาณไฟที่ถึงเวลา (แต่ละทางแยกเขียนเฉพาะช่องของตัวเอง)
+static void decide_signal_range(void* ctx, int worker, int begin, int end) {
+    (void)worker;
+    PressureTask* task = (PressureTask*)ctx;
+    const MaxPressureController* controller = task->system->controller;
+    
+    for (int k = begin; k < end; k++) {
+        const TrafficSignal* signal = &task->system->signals[task->signals[k]];
+        int out_total, out_count;
+        sum_outgoing_queues(controller, signal->junction_id, &out_total, &out_count);
+        
+        // เริ่มจากเฟสปัจจุบัน แล้วเปลี่ยนเฉพาะเมื่อเฟสอื่นมีความกดดันสูงกว่า
+        int best = signal->current_phase;
+        float best_pressure = pressure_with_downstream(controller, signal, best, out_total, out_count);
+        for (int p = 0; p < signal->num_phases; p++) {
+            float pressure = pressure_with_downstream(controller, signal, p, out_total, out_count);
+            if (pressure > best_pressure) {
+                best = p;
+                best_pressure = pressure;
+            }
+        }
+        controller->chosen_phase[k] = best;
+    }
+}
+
+// ฟังก์ชันสำหรับตัดสินใจเฟสของสัญญาณไฟที่ถึงเวลา (signals = ดัชนีของสัญญาณไฟ) แล้วตั้งเวลาตัดสินใจครั้งถัดไป
+// คืนค่าจำนวนสัญญาณไฟที่เปลี่ยนเฟส
+int run_max_pressure_decisions(SignalSystem* system, const int* signals, int count) {
+    MaxPressureController* controller = system->controller;
+    if (controller == NULL || count <= 0) {
+        return 0;
+    }
+    
+    // ประเมินทุกทางแยกแบบขนาน (อ่านจำนวนรถอย่างเดียว)
+    double start = monotonic_seconds();
+    PressureTask task = {system, signals};
+    parallel_for(controller->pool, count, 64, decide_signal_range, &task);
+    controller->decision_time += monotonic_seconds() - start;
+    controller->decisions += count;
+    
+    // เปลี่ยนเฟสตามที่เลือก และตั้งเวลาตัดสินใจครั้งถัดไปในวงล้อเวลา
+    long now = timing_wheel_time(system->phase_timers);
+    int switched = 0;
+    for (int k = 0; k < count; k++) {
+        TrafficSignal* signal = &system->signals[signals[k]];
+        int phase = controller->chosen_phase[k];
+        if (phase != signal->current_phase) {
+            signal->phases[signal->current_phase].state = RED;
+            signal->remaining_times[signal->current_phase] = 0;
+            signal->current_phase = phase;
+            signal->phases[phase].state = GREEN;
+            switched++;
+        }
+        
+        signal->remaining_times[phase] = controller->decision_interval;
+        schedule_timer(system->phase_timers, signals[k], now + controller->decision_interval);
+    }
+    controller->switches += switched;
+    
+    return switched;
+}
+
+// ฟังก์ชันสำหรับสร้างตารางถนนขาเข้าของแต่ละเฟส (CSR ตามตารางเฟสของระบบ)
+static void build_phase_approaches(MaxPressureController* controller, const Graph* graph, const SignalSystem* system) {
+    int num_phases = system->num_phases;
+    int* incoming = (int*)calloc(graph->num_vertices > 0 ? graph->num_vertices : 1, sizeof(int));
+    int* phase_of_edge = (int*)malloc((graph->num_edges > 0 ? graph->num_edges : 1) * sizeof(int));
+    controller->approach_offset = (int*)calloc(num_phases + 1, sizeof(int));
+    controller->approaches = (Edge**)malloc((graph->num_edges > 0 ? graph->num_edges : 1) * sizeof(Edge*));
+    controller->u_turns = (Edge**)malloc((graph->num_edges > 0 ? graph->num_edges : 1) * sizeof(Edge*));
+    if (incoming == NULL || phase_of_edge == NULL || controller->approach_offset == NULL || controller->approaches == NULL ||
+        controller->u_turns == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for max-pressure controller\n");
+        exit(1);
+    }
+    
+    // ถนนขาเข้าลำดับที่ k ของทางแยก (ตามลำดับของรายการเส้นเชื่อม) เป็นของเฟส k % num_phases
+    for (int v = 0; v < graph->num_vertices; v++) {
+        for (Edge* edge = graph->vertices[v].head; edge != NULL; edge = edge->next) {
+            int s = (edge->dest < system->num_junctions) ? system->signal_of_junction[edge->dest] : -1;
+            phase_of_edge[edge->id] = -1;
+            if (s < 0 || system->signals[s].num_phases == 0) {
+                continue;
+            }
+            
+            const TrafficSignal* signal = &system->signals[s];
+            phase_of_edge[edge->id] = signal->first_phase + incoming[edge->dest]++ % signal->num_phases;
+            controller->approach_offset[phase_of_edge[edge->id] + 1]++;
+        }
+    }
+    for (int p = 0; p < num_phases; p++) {
+        controller->approach_offset[p + 1] += controller->approach_offset[p];
+    }
+    
+    int* fill = (int*)malloc((num_phases > 0 ? num_phases : 1) * sizeof(int));
+    if (fill == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for max-pressure controller\n");
+        exit(1);
+    }
+    memcpy(fill, controller->approach_offset, num_phases * sizeof(int));
+    for (int v = 0; v < graph->num_vertices; v++) {
+        for (Edge* edge = graph->vertices[v].head; edge != NULL; edge = edge->next) {
+            if (phase_of_edge[edge->id] < 0) {
+                continue;
+            }
+            
+            // ถนนขาออกของทางแยกที่กลับไปยังต้นทางของถนนขาเข้านี้
+            int a = fill[phase_of_edge[edge->id]]++;
+            controller->approaches[a] = edge;
+            controller->u_turns[a] = NULL;
+            for (Edge* out = graph->vertices[edge->dest].head; out != NULL; out = out->next) {
+                if (out->dest == v) {
+                    controller->u_turns[a] = out;
+                    break;
+                }
+            }
+        }
+    }
+    
+    free(fill);
+    free(phase_of_edge);
+    free(incoming);
+}
+
+// ฟังก์ชันสำหรับสร้างตัวควบคุมแบบ max-pressure ของระบบสัญญาณไฟบนเครือข่ายถนน graph
+static MaxPressureController* create_max_pressure_controller(Graph* graph, const SignalSystem* system,
+                                                             const JunctionQueues* queues, int decision_interval,
+                                                             int num_threads) {
+    MaxPressureController* controller = (MaxPressureController*)calloc(1, sizeof(MaxPressureController));
+    if (controller == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for max-pressure controller\n");
+        exit(1);
+    }
+    
+    controller->graph = graph;
+    controller->queues = queues;
+    controller->decision_interval = decision_interval;
+    if (num_threads <= 0) {
+        num_threads = available_cpu_count();
+    }
+    controller->pool = (num_threads > 1) ? create_thread_pool(num_threads) : NULL;
+    controller->chosen_phase = (int*)malloc((system->num_signals > 0 ? system->num_signals : 1) * sizeof(int));
+    if (controller->chosen_phase == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for max-pressure controller\n");
+        exit(1);
+    }
+    build_phase_approaches(controller, graph, system);
+    return controller;
+}
+
+// ฟังก์ชันสำหรับเปิดการควบคุมแบบ max-pressure ของระบบสัญญาณไฟ (decision_interval <= 0 = กลับไปปรับระยะเวลาตามความหนาแน่น)
+// queues คือคิวรอไฟเขียวของการจำลอง (NULL ถ้าไม่ใช้ signal_gating)
+// num_threads คือจำนวนเธรดที่ใช้ประเมินทางแยก (1 = แบบลำดับ, 0 = ใช้จำนวนแกนของเครื่อง)
+void set_max_pressure_control(Graph* graph, SignalSystem* system, const JunctionQueues* queues,
+                              int decision_interval, int num_threads) {
+    free_max_pressure_controller(system->controller);
+    system->controller = NULL;
+    
+    // กลับไปใช้รอบของเฟสตามระยะเวลา (ระยะเวลาถูกปรับใหม่ในการอัปเดตครั้งถัดไป)
+    if (decision_interval <= 0) {
+        refresh_signal_schedule(system);
+        return;
+    }
+    
+    system->controller = create_max_pressure_controller(graph, system, queues, decision_interval, num_threads);
+    
+    // ทุกทางแยกตัดสินใจครั้งแรกในวินาทีถัดไป
+    long now = timing_wheel_time(system->phase_timers);
+    for (int i = 0; i < system->num_signals; i++) {
+        if (system->signals[i].num_phases > 0) {
+            schedule_timer(system->phase_timers, i, now + 1);
+        }
+    }
+}
+
+// ฟังก์ชันสำหรับติดตั้งตัวควบคุมแบบเดียวกับของ source ให้กับสำเนาของระบบสัญญาณไฟ (จาก clone_signal_system)
+// graph และ queues เป็นของสำเนา เวลาตัดสินใจครั้งถัดไปของแต่ละทางแยกถูกคัดลอกมากับวงล้อเวลาแล้วจึงไม่ตั้งใหม่
+// สำเนาทำงานแบบลำดับ เพราะสำเนาของเครือข่ายมักทำงานพร้อมกันหลายชุดอยู่แล้ว
+void copy_max_pressure_control(const SignalSystem* source, Graph* graph, SignalSystem* system,
+                               const JunctionQueues* queues) {
+    free_max_pressure_controller(system->controller);
+    system->controller = NULL;
+    if (source->controller == NULL) {
+        return;
+    }
+    
+    // ใช้คิวรอไฟเขียวเฉพาะเมื่อตัวควบคุมต้นฉบับใช้ ความกดดันจึงคำนวณแบบเดียวกัน
+    const JunctionQueues* replica_queues = (source->controller->queues != NULL) ? queues : NULL;
+    if (source->controller->queues != NULL && queues == NULL) {
+        fprintf(stderr, "Warning: Replica has no junction queues, max-pressure uses road loads\n");
+    }
+    system->controller = create_max_pressure_controller(graph, system, replica_queues,
+                                                        source->controller->decision_interval, 1);
+}
+
+// ฟังก์ชันสำหรับแสดงสถิติของตัวควบคุมแบบ max-pressure
+void print_max_pressure_stats(const MaxPressureController* controller) {
+    printf("Max-pressure control: decision every %d s, %ld decisions, %ld phase switches\n",
+           controller->decision_interval, controller->decisions, controller->switches);
+    printf("Decision time: %.3f ms (%.0f decisions/s)\n", controller->decision_time * 1e3,
+           (controller->decision_time > 0.0) ? controller->decisions / controller->decision_time : 0.0);
+}
+
+// ฟังก์ชันสำหรับลบตัวควบคุมแบบ max-pressure และคืนหน่วยความจำ
+void free_max_pressure_controller(MaxPressureController* controller) {
+    if (controller == NULL) return;
+    
+    free_thread_pool(controller->pool);
+    free(controller->approach_offset);
+    free(controller->approaches);
+    free(controller->u_turns);
+    free(controller->chosen_phase);
+    free(controller);
+}
@@ -0,0 +1,59 @@
+#ifndef MAX_PRESSURE_H
+#define MAX_PRESSURE_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include "graph.h"
+ #include "traffic_signal.h"
+ #include "thread_pool.h"
+ #include "junction_queue.h"
+ 
+ // ช่วงเวลาเริ่มต้นระหว่างการตัดสินใจของแต่ละทางแยก (วินาที, เป็นเวลาไฟเขียวขั้นต่ำของเฟสด้วย)
+ #define DEFAULT_PRESSURE_INTERVAL 10
+ 
+ // ตัวควบคุมสัญญาณไฟแบบ max-pressure (ตัดสินใจแยกกันที่แต่ละทางแยก)
+ // ความกดดันของเฟส = ผลรวมของ (คิวของถนนขาเข้า - คิวเฉลี่ยของถนนขาออกที่ไม่ใช่การกลับรถ) ของทุกถนนขาเข้าของเฟส
+ // คิวคือจำนวนรถที่รอที่เส้นหยุดเมื่อใช้ signal_gating และจำนวนรถบนถนนเมื่อไม่ใช้
+ // ทุก decision_interval วินาที แต่ละทางแยกเลือกเฟสที่มีความกดดันสูงสุด (เท่ากันแล้วคงเฟสเดิม)
+ // ถนนขาเข้าลำดับที่ k ของทางแยกเป็นของเฟส k % num_phases เหมือนกับคิวรอไฟเขียว (junction_queue)
+ // เวลาที่ใช้ต่อทางแยกขึ้นกับจำนวนถนนขาเข้าและขาออกของทางแยกนั้นเท่านั้น และประเมินทุกทางแยกแบบขนาน
+ typedef struct MaxPressureController {
+     Graph* graph;            // เครือข่ายถนนที่ใช้อ่านจำนวนรถ
+     const JunctionQueues* queues; // คิวรอไฟเขียว (NULL = ใช้จำนวนรถบนถนนเป็นคิว)
+     int decision_interval;   // ช่วงเวลาระหว่างการตัดสินใจ (วินาที)
+     ThreadPool* pool;        // กลุ่มเธรดสำหรับประเมินทางแยก (NULL = ทำงานแบบลำดับ)
+     int* approach_offset;    // ตำแหน่งเริ่มต้นของถนนขาเข้าของแต่ละเฟส (ตามตารางเฟสของระบบ) ใน approaches
+     Edge** approaches;       // ถนนขาเข้าเรียงตามสัญญาณไฟและเฟส
+     Edge** u_turns;          // ถนนขาออกที่กลับไปยังต้นทางของถนนขาเข้าแต่ละเส้น (NULL = ไม่มี)
+     int* chosen_phase;       // เฟสที่เลือกของสัญญาณไฟที่ตัดสินใจในวินาทีนี้ (ตามลำดับใน signals ที่ส่งมา)
+     long decisions;          // จำนวนครั้งที่ประเมินทางแยก
+     long switches;           // จำนวนครั้งที่เปลี่ยนเฟส
+     double decision_time;    // เวลาที่ใช้ประเมินทางแยกทั้งหมด (วินาที)
+ } MaxPressureController;
+ 
+ // ฟังก์ชันสำหรับเปิดการควบคุมแบบ max-pressure ของระบบสัญญาณไฟ (decision_interval <= 0 = กลับไปปรับระยะเวลาตามความหนาแน่น)
+ // queues คือคิวรอไฟเขียวของการจำลอง (NULL ถ้าไม่ใช้ signal_gating)
+ // num_threads คือจำนวนเธรดที่ใช้ประเมินทางแยก (1 = แบบลำดับ, 0 = ใช้จำนวนแกนของเครื่อง)
+ void set_max_pressure_control(Graph* graph, SignalSystem* system, const JunctionQueues* queues,
+                               int decision_interval, int num_threads);
+ 
+ // ฟังก์ชันสำหรับติดตั้งตัวควบคุมแบบเดียวกับของ source ให้กับสำเนาของระบบสัญญาณไฟ (จาก clone_signal_system)
+ // graph และ queues เป็นของสำเนา (เรียกหลังสร้างการจำลองบนสำเนา) ไม่ทำอะไรถ้า source ไม่มีตัวควบคุม
+ void copy_max_pressure_control(const SignalSystem* source, Graph* graph, SignalSystem* system,
+                                const JunctionQueues* queues);
+ 
+ // ฟังก์ชันสำหรับคำนวณความกดดันของเฟสหนึ่งของสัญญาณไฟ
+ float phase_pressure(const MaxPressureController* controller, const TrafficSignal* signal, int phase);
+ 
+ // ฟังก์ชันสำหรับตัดสินใจเฟสของสัญญาณไฟที่ถึงเวลา (signals = ดัชนีของสัญญาณไฟ) แล้วตั้งเวลาตัดสินใจครั้งถัดไป
+ // คืนค่าจำนวนสัญญาณไฟที่เปลี่ยนเฟส
+ int run_max_pressure_decisions(SignalSystem* system, const int* signals, int count);
+ 
+ // ฟังก์ชันสำหรับแสดงสถิติของตัวควบคุมแบบ max-pressure
+ void print_max_pressure_stats(const MaxPressureController* controller);
+ 
+ // ฟังก์ชันสำหรับลบตัวควบคุมแบบ max-pressure และคืนหน่วยความจำ
+ void free_max_pressure_controller(MaxPressureController* controller);
+ 
+ #endif
@@ -1,4 +1,5 @@
 #include "queue.h"
+#include <string.h>
 
 // ฟังก์ชันสำหรับสร้างคิวใหม่
 PriorityQueue* create_priority_queue(void) {
@@ -8,42 +9,130 @@ PriorityQueue* create_priority_queue(void) {
         exit(1);
     }
     
-    queue->head = NULL;
+    queue->nodes = NULL;
     queue->size = 0;
+    queue->capacity = 0;
+    queue->slot_of_junction = NULL;
+    queue->num_junctions = 0;
+    queue->next_order = 0;
     
     return queue;
 }
 
 // ฟังก์ชันสำหรับตรวจสอบว่าคิวว่างหรือไม่
 bool is_queue_empty(PriorityQueue* queue) {
-    return (queue->head == NULL);
+    return (queue->size == 0);
 }
 
-// ฟังก์ชันสำหรับเพิ่มสมาชิกใหม่ลงในคิว
-void enqueue(PriorityQueue* queue, int junction_id, float priority) {
-    QueueNode* new_node = (QueueNode*)malloc(sizeof(QueueNode));
-    if (new_node == NULL) {
-        fprintf(stderr, "Error: Unable to allocate memory for queue node\n");
+// ฟังก์ชันสำหรับเปรียบเทียบสมาชิก (true = a ต้องออกจากคิวก่อน b)
+static inline bool node_before(const QueueNode* a, const QueueNode* b) {
+    return a->priority > b->priority || (a->priority == b->priority && a->order < b->order);
+}
+
+// ฟังก์ชันสำหรับขยายอาเรย์ของฮีปให้มีขนาดอย่างน้อย capacity
+static void reserve_queue_nodes(PriorityQueue* queue, int capacity) {
+    if (capacity <= queue->capacity) {
         return;
     }
     
-    new_node->junction_id = junction_id;
-    new_node->priority = priority;
+    int new_capacity = (queue->capacity > 0) ? queue->capacity * 2 : 16;
+    while (new_capacity < capacity) {
+        new_capacity *= 2;
+    }
+    QueueNode* nodes = (QueueNode*)realloc(queue->nodes, new_capacity * sizeof(QueueNode));
+    if (nodes == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for queue node\n");
+        exit(1);
+    }
+    queue->nodes = nodes;
+    queue->capacity = new_capacity;
+}
+
+// ฟังก์ชันสำหรับขยายตารางตำแหน่งของทางแยกให้ครอบคลุม junction_id
+static void reserve_junction_slots(PriorityQueue* queue, int junction_id) {
+    if (junction_id < queue->num_junctions) {
+        return;
+    }
     
-    if (is_queue_empty(queue) || priority > queue->head->priority) {
-        new_node->next = queue->head;
-        queue->head = new_node;
-    } else {
-        QueueNode* current = queue->head;
-        while (current->next != NULL && current->next->priority >= priority) {
-            current = current->next;
+    int count = (queue->num_junctions > 0) ? queue->num_junctions * 2 : 16;
+    while (count <= junction_id) {
+        count *= 2;
+    }
+    int* slots = (int*)realloc(queue->slot_of_junction, count * sizeof(int));
+    if (slots == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for queue\n");
+        exit(1);
+    }
+    for (int i = queue->num_junctions; i < count; i++) {
+        slots[i] = -1;
+    }
+    queue->slot_of_junction = slots;
+    queue->num_junctions = count;
+}
+
+// ฟังก์ชันสำหรับวางสมาชิกที่ตำแหน่ง slot ของฮีปและบันทึกตำแหน่งของทางแยก
+static inline void place_node(PriorityQueue* queue, int slot, QueueNode node) {
+    queue->nodes[slot] = node;
+    queue->slot_of_junction[node.junction_id] = slot;
+}
+
+// ฟังก์ชันสำหรับเลื่อนสมาชิกขึ้นจนกว่าพ่อจะมาก่อน
+static void sift_up(PriorityQueue* queue, int slot) {
+    QueueNode node = queue->nodes[slot];
+    while (slot > 0) {
+        int parent = (slot - 1) / 2;
+        if (!node_before(&node, &queue->nodes[parent])) {
+            break;
+        }
+        place_node(queue, slot, queue->nodes[parent]);
+        slot = parent;
+    }
+    place_node(queue, slot, node);
+}
+
+// ฟังก์ชันสำหรับเลื่อนสมาชิกลงจนกว่าจะมาก่อนลูกทั้งสอง
+static void sift_down(PriorityQueue* queue, int slot) {
+    QueueNode node = queue->nodes[slot];
+    while (true) {
+        int child = 2 * slot + 1;
+        if (child >= queue->size) {
+            break;
+        }
+        if (child + 1 < queue->size && node_before(&queue->nodes[child + 1], &queue->nodes[child])) {
+            child++;
         }
-        
-        new_node->next = current->next;
-        current->next = new_node;
+        if (!node_before(&queue->nodes[child], &node)) {
+            break;
+        }
+        place_node(queue, slot, queue->nodes[child]);
+        slot = child;
+    }
+    place_node(queue, slot, node);
+}
+
+// ฟังก์ชันสำหรับเพิ่มสมาชิกใหม่ลงในคิว (ถ้าทางแยกอยู่ในคิวแล้วจะปรับค่าความสำคัญแทน)
+void enqueue(PriorityQueue* queue, int junction_id, float priority) {
+    if (junction_id < 0) {
+        fprintf(stderr, "Error: Invalid junction ID for queue\n");
+        return;
+    }
+    
+    reserve_junction_slots(queue, junction_id);
+    if (queue->slot_of_junction[junction_id] >= 0) {
+        update_priority(queue, junction_id, priority);
+        return;
     }
     
-    queue->size++;
+    reserve_queue_nodes(queue, queue->size + 1);
+    QueueNode node = {junction_id, priority, queue->next_order++};
+    int slot = queue->size++;
+    place_node(queue, slot, node);
+    sift_up(queue, slot);
+}
+
+// ฟังก์ชันสำหรับตรวจสอบว่าทางแยกอยู่ในคิวหรือไม่
+bool queue_contains(const PriorityQueue* queue, int junction_id) {
+    return junction_id >= 0 && junction_id < queue->num_junctions && queue->slot_of_junction[junction_id] >= 0;
 }
 
 // ฟังก์ชันสำหรับลบสมาชิกที่มีความสำคัญสูงสุดออกจากคิว
@@ -53,56 +142,101 @@ int dequeue(PriorityQueue* queue) {
         return -1;
     }
     
-    QueueNode* temp = queue->head;
-    int junction_id = temp->junction_id;
-    
-    queue->head = queue->head->next;
-    free(temp);
+    int junction_id = queue->nodes[0].junction_id;
+    queue->slot_of_junction[junction_id] = -1;
     
+    // ย้ายสมาชิกตัวสุดท้ายมาที่รากแล้วเลื่อนลง
     queue->size--;
+    if (queue->size > 0) {
+        place_node(queue, 0, queue->nodes[queue->size]);
+        sift_down(queue, 0);
+    }
     
     return junction_id;
 }
 
-// ฟังก์ชันสำหรับปรับค่าความสำคัญของสมาชิกในคิว
+// ฟังก์ชันสำหรับปรับค่าความสำคัญของสมาชิกในคิว (เพิ่มใหม่ถ้ายังไม่อยู่ในคิว)
+// สมาชิกที่ถูกปรับนับเป็นตัวที่เพิ่มล่าสุด เหมือนการนำออกแล้วเพิ่มใหม่
 void update_priority(PriorityQueue* queue, int junction_id, float new_priority) {
-    QueueNode* current = queue->head;
-    bool found = false;
+    if (!queue_contains(queue, junction_id)) {
+        enqueue(queue, junction_id, new_priority);
+        return;
+    }
     
-    while (current != NULL) {
-        if (current->junction_id == junction_id) {
-            found = true;
-            break;
+    int slot = queue->slot_of_junction[junction_id];
+    QueueNode* node = &queue->nodes[slot];
+    node->priority = new_priority;
+    node->order = queue->next_order++;
+    
+    // สมาชิกเลื่อนได้ทางเดียวเท่านั้น
+    if (slot > 0 && node_before(node, &queue->nodes[(slot - 1) / 2])) {
+        sift_up(queue, slot);
+    } else {
+        sift_down(queue, slot);
+    }
+}
+
+// ฟังก์ชันสำหรับสร้างคิวใหม่ทั้งหมดจากอาเรย์ใน O(n) (ค่าความสำคัญเท่ากันออกตามลำดับในอาเรย์)
+void rebuild_priority_queue(PriorityQueue* queue, const int* junction_ids, const float* priorities, int count) {
+    for (int i = 0; i < queue->size; i++) {
+        queue->slot_of_junction[queue->nodes[i].junction_id] = -1;
+    }
+    queue->size = 0;
+    reserve_queue_nodes(queue, count);
+    
+    // วางสมาชิกตามลำดับของอาเรย์ (ทางแยกที่ซ้ำใช้ค่าสุดท้าย) แล้วจัดฮีปจากล่างขึ้นบน
+    for (int i = 0; i < count; i++) {
+        if (junction_ids[i] < 0) {
+            fprintf(stderr, "Error: Invalid junction ID for queue\n");
+            continue;
         }
-        current = current->next;
-    }
-    
-    if (found) {
-        if (queue->head->junction_id == junction_id) {
-            QueueNode* temp = queue->head;
-            queue->head = queue->head->next;
-            free(temp);
-            queue->size--;
-        } else {
-            QueueNode* prev = queue->head;
-            current = queue->head->next;
-            
-            while (current != NULL && current->junction_id != junction_id) {
-                prev = current;
-                current = current->next;
-            }
-            
-            if (current != NULL) {
-                prev->next = current->next;
-                free(current);
-                queue->size--;
-            }
+        reserve_junction_slots(queue, junction_ids[i]);
+        QueueNode node = {junction_ids[i], priorities[i], queue->next_order++};
+        int slot = queue->slot_of_junction[junction_ids[i]];
+        if (slot < 0) {
+            slot = queue->size++;
         }
-        
-        enqueue(queue, junction_id, new_priority);
-    } else {
-        enqueue(queue, junction_id, new_priority);
+        place_node(queue, slot, node);
+    }
+    for (int slot = queue->size / 2 - 1; slot >= 0; slot--) {
+        sift_down(queue, slot);
+    }
+}
+
+// ฟังก์ชันสำหรับเปรียบเทียบสมาชิกตามลำดับการออกจากคิว (สำหรับ qsort)
+static int compare_queue_nodes(const void* a, const void* b) {
+    const QueueNode* na = (const QueueNode*)a;
+    const QueueNode* nb = (const QueueNode*)b;
+    if (node_before(na, nb)) return -1;
+    if (node_before(nb, na)) return 1;
+    return 0;
+}
+
+// ฟังก์ชันสำหรับคัดลอกสมาชิกทั้งหมดตามลำดับการออกจากคิวลงใน entries (ขนาดอย่างน้อย queue->size)
+int queue_entries_in_order(const PriorityQueue* queue, QueueNode* entries) {
+    if (queue->size > 0) {
+        memcpy(entries, queue->nodes, queue->size * sizeof(QueueNode));
+        qsort(entries, queue->size, sizeof(QueueNode), compare_queue_nodes);
     }
+    return queue->size;
+}
+
+// ฟังก์ชันสำหรับสร้างสำเนาของคิว (ลำดับของสมาชิกเหมือนคิวต้นฉบับ)
+PriorityQueue* copy_priority_queue(const PriorityQueue* queue) {
+    PriorityQueue* copy = create_priority_queue();
+    
+    reserve_queue_nodes(copy, queue->size);
+    if (queue->num_junctions > 0) {
+        reserve_junction_slots(copy, queue->num_junctions - 1);
+        memcpy(copy->slot_of_junction, queue->slot_of_junction, queue->num_junctions * sizeof(int));
+    }
+    if (queue->size > 0) {
+        memcpy(copy->nodes, queue->nodes, queue->size * sizeof(QueueNode));
+    }
+    copy->size = queue->size;
+    copy->next_order = queue->next_order;
+    
+    return copy;
 }
 
 // ฟังก์ชันสำหรับแสดงข้อมูลของคิว
@@ -114,28 +248,27 @@ void print_queue(PriorityQueue* queue) {
     
     printf("Priority Queue (Number of nodes: %d):\n", queue->size);
     
-    QueueNode* current = queue->head;
-    int position = 1;
+    // แสดงตามลำดับการออกจากคิว (อาเรย์ของฮีปไม่ได้เรียงไว้)
+    QueueNode* entries = (QueueNode*)malloc(queue->size * sizeof(QueueNode));
+    if (entries == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for queue\n");
+        return;
+    }
+    int count = queue_entries_in_order(queue, entries);
     
-    while (current != NULL) {
+    for (int position = 1; position <= count; position++) {
         printf("%d. Junction ID: %d, Priority: %.2f\n",
-               position, current->junction_id, current->priority);
-        
-        current = current->next;
-        position++;
+               position, entries[position - 1].junction_id, entries[position - 1].priority);
     }
+    
+    free(entries);
 }
 
 // ฟังก์ชันสำหรับลบคิวและคืนหน่วยความจำ
 void free_queue(PriorityQueue* queue) {
     if (queue == NULL) return;
     
-    QueueNode* current = queue->head;
-    while (current != NULL) {
-        QueueNode* temp = current;
-        current = current->next;
-        free(temp);
-    }
-    
+    free(queue->nodes);
+    free(queue->slot_of_junction);
     free(queue);
 }
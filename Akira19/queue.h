@@ -6,16 +6,22 @@
  #include <stdbool.h>
  
  // โครงสร้างข้อมูลของสมาชิกในคิว
- typedef struct QueueNode {
+ typedef struct {
      int junction_id;        // ID ของทางแยก
      float priority;         // ค่าความสำคัญ (ความหนาแน่นของการจราจร)
-     struct QueueNode* next; // ชี้ไปยังสมาชิกถัดไป
+     unsigned long order;    // ลำดับที่เพิ่มหรือปรับค่าความสำคัญ (ค่าความสำคัญเท่ากันออกตามลำดับนี้)
  } QueueNode;
  
- // โครงสร้างข้อมูลของคิวที่มีการจัดลำดับความสำคัญ
+ // โครงสร้างข้อมูลของคิวที่มีการจัดลำดับความสำคัญ (ฮีปแบบอาเรย์ ค่าสูงสุดอยู่ที่ราก)
+ // แต่ละทางแยกมีสมาชิกได้หนึ่งตัว และ slot_of_junction เก็บตำแหน่งในฮีป จึงปรับค่าความสำคัญได้ใน O(log n)
+ // ลำดับของการออกจากคิวเหมือนรายการที่เรียงไว้: ความสำคัญมากก่อน ถ้าเท่ากันตัวที่เพิ่มก่อนออกก่อน
  typedef struct {
-     QueueNode* head;        // ชี้ไปยังสมาชิกแรกของคิว
+     QueueNode* nodes;       // อาเรย์ของฮีป
      int size;              // จำนวนสมาชิกในคิว
+     int capacity;           // ขนาดของอาเรย์ nodes
+     int* slot_of_junction;  // ตำแหน่งในฮีปของแต่ละทางแยก (-1 = ไม่อยู่ในคิว)
+     int num_junctions;      // ขนาดของอาเรย์ slot_of_junction
+     unsigned long next_order; // ลำดับถัดไปของสมาชิกที่เพิ่มเข้ามา
  } PriorityQueue;
  
  // ฟังก์ชันสำหรับสร้างคิวใหม่
@@ -24,15 +30,27 @@
  // ฟังก์ชันสำหรับตรวจสอบว่าคิวว่างหรือไม่
  bool is_queue_empty(PriorityQueue* queue);
  
- // ฟังก์ชันสำหรับเพิ่มสมาชิกใหม่ลงในคิว
+ // ฟังก์ชันสำหรับเพิ่มสมาชิกใหม่ลงในคิว (ถ้าทางแยกอยู่ในคิวแล้วจะปรับค่าความสำคัญแทน)
  void enqueue(PriorityQueue* queue, int junction_id, float priority);
  
+ // ฟังก์ชันสำหรับตรวจสอบว่าทางแยกอยู่ในคิวหรือไม่
+ bool queue_contains(const PriorityQueue* queue, int junction_id);
+ 
  // ฟังก์ชันสำหรับลบสมาชิกที่มีความสำคัญสูงสุดออกจากคิว
  int dequeue(PriorityQueue* queue);
  
- // ฟังก์ชันสำหรับปรับค่าความสำคัญของสมาชิกในคิว
+ // ฟังก์ชันสำหรับปรับค่าความสำคัญของสมาชิกในคิว (เพิ่มใหม่ถ้ายังไม่อยู่ในคิว)
  void update_priority(PriorityQueue* queue, int junction_id, float new_priority);
  
+ // ฟังก์ชันสำหรับสร้างคิวใหม่ทั้งหมดจากอาเรย์ใน O(n) (ค่าความสำคัญเท่ากันออกตามลำดับในอาเรย์)
+ void rebuild_priority_queue(PriorityQueue* queue, const int* junction_ids, const float* priorities, int count);
+ 
+ // ฟังก์ชันสำหรับคัดลอกสมาชิกทั้งหมดตามลำดับการออกจากคิวลงใน entries (ขนาดอย่างน้อย queue->size)
+ int queue_entries_in_order(const PriorityQueue* queue, QueueNode* entries);
+ 
+ // ฟังก์ชันสำหรับสร้างสำเนาของคิว (ลำดับของสมาชิกเหมือนคิวต้นฉบับ)
+ PriorityQueue* copy_priority_queue(const PriorityQueue* queue);
+ 
  // ฟังก์ชันสำหรับแสดงข้อมูลของคิว
  void print_queue(PriorityQueue* queue);
  
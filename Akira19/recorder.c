@@ -0,0 +1,589 @@
+/*
+* recorder.c
+* การบันทึกเส้นทางการเคลื่อนที่ของยานพาหนะและจำนวนรถบนถนนลงไฟล์ด้วยเธรดเขียนเบื้องหลัง
+*/
+
+#include "recorder.h"
+#include "wall_clock.h"
+#include <string.h>
+#include <pthread.h>
+
+// ข้อมูลดิบของหลายขั้นตอนเวลาแบบคอลัมน์ (หนึ่งบัฟเฟอร์ของการบันทึกแบบสองบัฟเฟอร์)
+typedef struct {
+    int num_ticks;           // จำนวนขั้นตอนเวลาในก้อน
+    int* tick_time;          // ขั้นตอนเวลาของแต่ละขั้น
+    int* tick_rows;          // จำนวนแถวของยานพาหนะในแต่ละขั้น
+    long* trip_id;           // หมายเลขการเดินทางของทุกแถว (ต่อกันทุกขั้นตอนเวลา)
+    int* edge_id;            // Edge.id ของถนนของทุกแถว
+    int* position;           // ตำแหน่งของทุกแถว (มิลลิเมตร)
+    int num_rows;            // จำนวนแถวทั้งหมดในก้อน
+    int row_capacity;        // ขนาดของคอลัมน์ของแถว
+    int* load;               // จำนวนรถบนถนน (ticks_per_block × num_edges)
+} RecorderBlock;
+
+// โครงสร้างข้อมูลของตัวบันทึก
+struct TrajectoryRecorder {
+    FILE* file;                    // ไฟล์ที่เขียน
+    int num_edges;                 // จำนวนเส้นเชื่อม
+    const Graph* graph;            // เครือข่ายถนนที่อ่านจำนวนรถ (edge_loads)
+    int ticks_per_block;           // จำนวนขั้นตอนเวลาต่อก้อน
+    RecorderBlock blocks[2];       // บัฟเฟอร์สองชุด
+    int filling;                   // บัฟเฟอร์ที่เธรดของการจำลองกำลังเติม
+    
+    pthread_t writer;              // เธรดเขียน
+    pthread_mutex_t mutex;         // ล็อกของการส่งต่อบัฟเฟอร์
+    pthread_cond_t ready_cond;     // แจ้งเธรดเขียนว่ามีบัฟเฟอร์ที่เต็มแล้ว
+    pthread_cond_t free_cond;      // แจ้งเธรดของการจำลองว่าบัฟเฟอร์ถูกเขียนเสร็จแล้ว
+    int pending;                   // บัฟเฟอร์ที่รอหรือกำลังเขียน (-1 = ไม่มี)
+    bool stopping;                 // กำลังหยุดเธรดเขียน
+    bool finished;                 // หยุดเธรดเขียนและปิดไฟล์แล้ว
+    bool failed;                   // เขียนไฟล์ไม่สำเร็จ
+    
+    // หน่วยความจำของเธรดเขียน
+    unsigned char* bytes;          // ข้อมูลที่บีบอัดแล้วของก้อนปัจจุบัน
+    size_t bytes_capacity;         // ขนาดของ bytes
+    int* match;                    // แถวในขั้นตอนเวลาก่อนหน้าของการเดินทางเดียวกัน (-1 = ไม่มี)
+    int match_capacity;            // ขนาดของ match
+    
+    RecorderStats stats;           // สถิติ (ส่วนของเธรดเขียนแก้ไขภายใต้ mutex)
+};
+
+// โครงสร้างข้อมูลของตัวอ่าน
+struct TrajectoryReader {
+    FILE* file;                    // ไฟล์ที่อ่าน
+    int num_edges;                 // จำนวนเส้นเชื่อม
+    unsigned char* data;           // ข้อมูลของก้อนปัจจุบัน
+    size_t data_capacity;          // ขนาดของ data
+    const unsigned char* cursor;   // ตำแหน่งที่อ่านถึงในก้อน
+    const unsigned char* end;      // จุดสิ้นสุดของก้อน
+    int ticks_left;                // จำนวนขั้นตอนเวลาที่ยังไม่ได้อ่านในก้อน
+    bool first_in_block;           // ขั้นตอนเวลาถัดไปเป็นขั้นแรกของก้อนหรือไม่
+    TrajectoryFrame frames[2];     // ขั้นตอนเวลาปัจจุบันและก่อนหน้า
+    int current;                   // frame ของขั้นตอนเวลาล่าสุด
+};
+
+// ฟังก์ชันสำหรับแปลงจำนวนเต็มมีเครื่องหมายเป็นจำนวนเต็มไม่มีเครื่องหมาย (zigzag: 0, -1, 1, -2, ... เป็น 0, 1, 2, 3, ...)
+static inline uint64_t zigzag_encode(int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+// ฟังก์ชันสำหรับแปลงค่า zigzag กลับเป็นจำนวนเต็มมีเครื่องหมาย
+static inline int64_t zigzag_decode(uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+// ฟังก์ชันสำหรับเขียนจำนวนเต็มแบบ varint (7 บิตต่อไบต์ บิตสูงสุด = มีไบต์ถัดไป)
+static inline unsigned char* put_varint(unsigned char* out, uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = (unsigned char)value;
+    return out;
+}
+
+// ฟังก์ชันสำหรับเขียนจำนวนเต็มมีเครื่องหมายแบบ zigzag + varint
+static inline unsigned char* put_svarint(unsigned char* out, int64_t value) {
+    return put_varint(out, zigzag_encode(value));
+}
+
+// ฟังก์ชันสำหรับอ่านจำนวนเต็มแบบ varint (คืนค่า false ถ้าข้อมูลหมดก่อนหรือยาวเกิน 64 บิต)
+static inline bool get_varint(const unsigned char** cursor, const unsigned char* end, uint64_t* value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (*cursor >= end) {
+            return false;
+        }
+        unsigned char byte = *(*cursor)++;
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ฟังก์ชันสำหรับอ่านจำนวนเต็มมีเครื่องหมายแบบ zigzag + varint
+static inline bool get_svarint(const unsigned char** cursor, const unsigned char* end, int64_t* value) {
+    uint64_t raw;
+    if (!get_varint(cursor, end, &raw)) {
+        return false;
+    }
+    *value = zigzag_decode(raw);
+    return true;
+}
+
+// ฟังก์ชันสำหรับขยายอาเรย์ (ออกจากโปรแกรมถ้าหน่วยความจำไม่พอ)
+static void* grow_array(void* array, size_t count, size_t element_size) {
+    void* resized = realloc(array, (count > 0 ? count : 1) * element_size);
+    if (resized == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for trajectory recorder\n");
+        exit(1);
+    }
+    return resized;
+}
+
+// ฟังก์ชันสำหรับหาแถวของการเดินทางเดียวกันในขั้นตอนเวลาก่อนหน้า
+// แถวเรียงตามหมายเลขการเดินทาง (ยานพาหนะถูกเก็บตามลำดับที่เพิ่มเข้ามา) จึงเดินสองรายการพร้อมกันได้
+// ถ้าลำดับไม่เรียง ผลคือหาไม่พบบางแถว ซึ่งทั้งตัวเขียนและตัวอ่านได้ผลเหมือนกัน
+static void match_previous_rows(const long* trips, int count, const long* previous, int previous_count, int* match) {
+    int j = 0;
+    for (int i = 0; i < count; i++) {
+        while (j < previous_count && previous[j] < trips[i]) {
+            j++;
+        }
+        match[i] = (j < previous_count && previous[j] == trips[i]) ? j : -1;
+    }
+}
+
+// ฟังก์ชันสำหรับบีบอัดหนึ่งก้อนข้อมูลเป็นผลต่างแบบ varint (คืนค่าจำนวนไบต์)
+static size_t encode_block(TrajectoryRecorder* recorder, const RecorderBlock* block) {
+    // จองพื้นที่สำหรับกรณีที่แย่ที่สุด (10 ไบต์ต่อค่า)
+    size_t worst = (size_t)10 * (2 * block->num_ticks + 3 * (size_t)block->num_rows +
+                                 (size_t)block->num_ticks * recorder->num_edges);
+    if (worst > recorder->bytes_capacity) {
+        recorder->bytes = (unsigned char*)grow_array(recorder->bytes, worst, 1);
+        recorder->bytes_capacity = worst;
+    }
+    
+    unsigned char* out = recorder->bytes;
+    int previous_time = 0;
+    int previous_row = 0;
+    int previous_count = 0;
+    int row = 0;
+    
+    for (int t = 0; t < block->num_ticks; t++) {
+        int count = block->tick_rows[t];
+        const long* trips = &block->trip_id[row];
+        const int* edges = &block->edge_id[row];
+        const int* positions = &block->position[row];
+        const int* loads = &block->load[(size_t)t * recorder->num_edges];
+        
+        out = put_svarint(out, block->tick_time[t] - previous_time);
+        out = put_varint(out, (uint64_t)count);
+        
+        long last_trip = 0;
+        for (int i = 0; i < count; i++) {
+            out = put_svarint(out, trips[i] - last_trip);
+            last_trip = trips[i];
+        }
+        
+        if (count > recorder->match_capacity) {
+            recorder->match = (int*)grow_array(recorder->match, count, sizeof(int));
+            recorder->match_capacity = count;
+        }
+        match_previous_rows(trips, count, &block->trip_id[previous_row], previous_count, recorder->match);
+        
+        const int* previous_edges = &block->edge_id[previous_row];
+        const int* previous_positions = &block->position[previous_row];
+        for (int i = 0; i < count; i++) {
+            int j = recorder->match[i];
+            out = put_svarint(out, edges[i] - ((j >= 0) ? previous_edges[j] : -1));
+        }
+        for (int i = 0; i < count; i++) {
+            int j = recorder->match[i];
+            out = put_svarint(out, positions[i] - ((j >= 0) ? previous_positions[j] : 0));
+        }
+        
+        const int* previous_loads = (t > 0) ? loads - recorder->num_edges : NULL;
+        for (int e = 0; e < recorder->num_edges; e++) {
+            out = put_svarint(out, loads[e] - ((previous_loads != NULL) ? previous_loads[e] : 0));
+        }
+        
+        previous_time = block->tick_time[t];
+        previous_row = row;
+        previous_count = count;
+        row += count;
+    }
+    
+    return (size_t)(out - recorder->bytes);
+}
+
+// ฟังก์ชันสำหรับบีบอัดและเขียนหนึ่งก้อนข้อมูลลงไฟล์
+static bool write_block_to_file(TrajectoryRecorder* recorder, const RecorderBlock* block, size_t* written) {
+    size_t size = encode_block(recorder, block);
+    uint32_t header[2] = {(uint32_t)block->num_ticks, (uint32_t)size};
+    
+    *written = sizeof(header) + size;
+    return fwrite(header, sizeof(header), 1, recorder->file) == 1 &&
+           fwrite(recorder->bytes, 1, size, recorder->file) == size;
+}
+
+// ฟังก์ชันหลักของเธรดเขียน (รอบัฟเฟอร์ที่เต็ม บีบอัด เขียน แล้วคืนบัฟเฟอร์)
+static void* writer_main(void* arg) {
+    TrajectoryRecorder* recorder = (TrajectoryRecorder*)arg;
+    
+    while (true) {
+        pthread_mutex_lock(&recorder->mutex);
+        while (recorder->pending < 0 && !recorder->stopping) {
+            pthread_cond_wait(&recorder->ready_cond, &recorder->mutex);
+        }
+        if (recorder->pending < 0) {
+            pthread_mutex_unlock(&recorder->mutex);
+            break;
+        }
+        int index = recorder->pending;
+        pthread_mutex_unlock(&recorder->mutex);
+        
+        // บัฟเฟอร์ที่รอเขียนไม่ถูกแก้ไขจนกว่าจะคืน จึงอ่านได้โดยไม่ต้องถือล็อก
+        double start = monotonic_seconds();
+        size_t written = 0;
+        bool ok = write_block_to_file(recorder, &recorder->blocks[index], &written);
+        double elapsed = monotonic_seconds() - start;
+        
+        pthread_mutex_lock(&recorder->mutex);
+        if (!ok) {
+            recorder->failed = true;
+        }
+        recorder->stats.blocks++;
+        recorder->stats.encoded_bytes += written;
+        recorder->stats.encode_time += elapsed;
+        recorder->pending = -1;
+        pthread_cond_signal(&recorder->free_cond);
+        pthread_mutex_unlock(&recorder->mutex);
+    }
+    
+    return NULL;
+}
+
+// ฟังก์ชันสำหรับสร้างตัวบันทึกและเริ่มเธรดเขียน (คืนค่า NULL ถ้าเปิดไฟล์ไม่ได้)
+TrajectoryRecorder* create_trajectory_recorder(const char* path, Graph* graph, int ticks_per_block) {
+    if (ticks_per_block <= 0) {
+        ticks_per_block = DEFAULT_TICKS_PER_BLOCK;
+    }
+    
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Unable to open trajectory file %s\n", path);
+        return NULL;
+    }
+    
+    TrajectoryRecorder* recorder = (TrajectoryRecorder*)calloc(1, sizeof(TrajectoryRecorder));
+    if (recorder == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for trajectory recorder\n");
+        exit(1);
+    }
+    
+    recorder->file = file;
+    recorder->num_edges = graph->num_edges;
+    recorder->graph = graph;
+    recorder->ticks_per_block = ticks_per_block;
+    recorder->pending = -1;
+    
+    for (int b = 0; b < 2; b++) {
+        RecorderBlock* block = &recorder->blocks[b];
+        block->tick_time = (int*)grow_array(NULL, ticks_per_block, sizeof(int));
+        block->tick_rows = (int*)grow_array(NULL, ticks_per_block, sizeof(int));
+        block->load = (int*)grow_array(NULL, (size_t)ticks_per_block * graph->num_edges, sizeof(int));
+    }
+    
+    // ส่วนหัวของไฟล์
+    uint32_t header[2] = {TRAJECTORY_VERSION, (uint32_t)graph->num_edges};
+    if (fwrite(TRAJECTORY_MAGIC, 1, 4, file) != 4 || fwrite(header, sizeof(uint32_t), 2, file) != 2) {
+        recorder->failed = true;
+    }
+    
+    pthread_mutex_init(&recorder->mutex, NULL);
+    pthread_cond_init(&recorder->ready_cond, NULL);
+    pthread_cond_init(&recorder->free_cond, NULL);
+    if (pthread_create(&recorder->writer, NULL, writer_main, recorder) != 0) {
+        fprintf(stderr, "Error: Unable to create trajectory writer thread\n");
+        exit(1);
+    }
+    
+    return recorder;
+}
+
+// ฟังก์ชันสำหรับส่งบัฟเฟอร์ที่กำลังเติมให้เธรดเขียน แล้วสลับไปเติมอีกบัฟเฟอร์
+static void submit_filling_block(TrajectoryRecorder* recorder) {
+    pthread_mutex_lock(&recorder->mutex);
+    if (recorder->pending >= 0) {
+        // เธรดเขียนยังเขียนก้อนก่อนหน้าไม่เสร็จ (เขียนช้ากว่าการจำลอง)
+        double start = monotonic_seconds();
+        while (recorder->pending >= 0) {
+            pthread_cond_wait(&recorder->free_cond, &recorder->mutex);
+        }
+        recorder->stats.stalls++;
+        recorder->stats.stall_time += monotonic_seconds() - start;
+    }
+    recorder->pending = recorder->filling;
+    pthread_cond_signal(&recorder->ready_cond);
+    pthread_mutex_unlock(&recorder->mutex);
+    
+    recorder->filling ^= 1;
+    recorder->blocks[recorder->filling].num_ticks = 0;
+    recorder->blocks[recorder->filling].num_rows = 0;
+}
+
+// ฟังก์ชันสำหรับบันทึกสถานะของขั้นตอนเวลาปัจจุบัน (เรียกหลัง update_simulation)
+void record_trajectory_tick(TrajectoryRecorder* recorder, const TrafficSimulation* sim) {
+    if (recorder->finished) {
+        return;
+    }
+    
+    double start = monotonic_seconds();
+    RecorderBlock* block = &recorder->blocks[recorder->filling];
+    const VehicleStore* store = &sim->vehicles;
+    int count = sim->num_vehicles;
+    
+    if (block->num_rows + count > block->row_capacity) {
+        int capacity = (block->row_capacity > 0) ? block->row_capacity : 1024;
+        while (capacity < block->num_rows + count) {
+            capacity *= 2;
+        }
+        block->trip_id = (long*)grow_array(block->trip_id, capacity, sizeof(long));
+        block->edge_id = (int*)grow_array(block->edge_id, capacity, sizeof(int));
+        block->position = (int*)grow_array(block->position, capacity, sizeof(int));
+        block->row_capacity = capacity;
+    }
+    
+    // คัดลอกคอลัมน์ต่อท้ายก้อน
+    int row = block->num_rows;
+    memcpy(&block->trip_id[row], store->trip_id, count * sizeof(long));
+    memcpy(&block->position[row], store->current_pos, count * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        block->edge_id[row + i] = (store->current_edge[i] != NULL) ? store->current_edge[i]->id : -1;
+    }
+    
+    int* loads = &block->load[(size_t)block->num_ticks * recorder->num_edges];
+    memcpy(loads, recorder->graph->edge_loads, recorder->num_edges * sizeof(int));
+    
+    block->tick_time[block->num_ticks] = sim->time_step;
+    block->tick_rows[block->num_ticks] = count;
+    block->num_ticks++;
+    block->num_rows += count;
+    
+    recorder->stats.ticks++;
+    recorder->stats.rows += count;
+    recorder->stats.raw_bytes += 2 * sizeof(int) + (size_t)count * (sizeof(long) + 2 * sizeof(int)) +
+                                 (size_t)recorder->num_edges * sizeof(int);
+    
+    if (block->num_ticks == recorder->ticks_per_block) {
+        submit_filling_block(recorder);
+    }
+    
+    recorder->stats.snapshot_time += monotonic_seconds() - start;
+}
+
+// ฟังก์ชันสำหรับเขียนข้อมูลที่เหลือ หยุดเธรดเขียน และปิดไฟล์ (คืนค่า false ถ้าเขียนไม่สำเร็จ)
+bool finish_trajectory_recorder(TrajectoryRecorder* recorder) {
+    if (recorder->finished) {
+        return !recorder->failed;
+    }
+    
+    if (recorder->blocks[recorder->filling].num_ticks > 0) {
+        submit_filling_block(recorder);
+    }
+    
+    pthread_mutex_lock(&recorder->mutex);
+    recorder->stopping = true;
+    pthread_cond_signal(&recorder->ready_cond);
+    pthread_mutex_unlock(&recorder->mutex);
+    pthread_join(recorder->writer, NULL);
+    
+    if (fclose(recorder->file) != 0) {
+        recorder->failed = true;
+    }
+    recorder->file = NULL;
+    recorder->finished = true;
+    
+    if (recorder->failed) {
+        fprintf(stderr, "Error: Unable to write trajectory file\n");
+    }
+    return !recorder->failed;
+}
+
+// ฟังก์ชันสำหรับอ่านสถิติของตัวบันทึก
+RecorderStats get_recorder_stats(TrajectoryRecorder* recorder) {
+    pthread_mutex_lock(&recorder->mutex);
+    RecorderStats stats = recorder->stats;
+    pthread_mutex_unlock(&recorder->mutex);
+    return stats;
+}
+
+// ฟังก์ชันสำหรับแสดงสถิติของตัวบันทึก
+void print_recorder_stats(TrajectoryRecorder* recorder) {
+    RecorderStats stats = get_recorder_stats(recorder);
+    
+    printf("\n=== Trajectory Recorder ===\n");
+    printf("Ticks recorded: %ld (%ld vehicle rows, %ld blocks written)\n", stats.ticks, stats.rows, stats.blocks);
+    printf("Raw size: %.1f MB, written: %.1f MB (%.1fx smaller)\n", stats.raw_bytes / (1024.0 * 1024.0),
+           stats.encoded_bytes / (1024.0 * 1024.0),
+           (stats.encoded_bytes > 0) ? (double)stats.raw_bytes / stats.encoded_bytes : 0.0);
+    printf("Simulation thread: %.3f s copying, %.3f s waiting (%ld stalls)\n", stats.snapshot_time,
+           stats.stall_time, stats.stalls);
+    printf("Writer thread: %.3f s encoding and writing\n", stats.encode_time);
+}
+
+// ฟังก์ชันสำหรับลบตัวบันทึกและคืนหน่วยความจำ (เขียนข้อมูลที่เหลือก่อนถ้ายังไม่ได้เรียก finish)
+void free_trajectory_recorder(TrajectoryRecorder* recorder) {
+    if (recorder == NULL) return;
+    
+    finish_trajectory_recorder(recorder);
+    
+    pthread_mutex_destroy(&recorder->mutex);
+    pthread_cond_destroy(&recorder->ready_cond);
+    pthread_cond_destroy(&recorder->free_cond);
+    
+    for (int b = 0; b < 2; b++) {
+        RecorderBlock* block = &recorder->blocks[b];
+        free(block->tick_time);
+        free(block->tick_rows);
+        free(block->trip_id);
+        free(block->edge_id);
+        free(block->position);
+        free(block->load);
+    }
+    free(recorder->bytes);
+    free(recorder->match);
+    free(recorder);
+}
+
+// ฟังก์ชันสำหรับเปิดไฟล์เส้นทางการเคลื่อนที่เพื่ออ่าน (คืนค่า NULL ถ้าไฟล์ไม่ถูกต้อง)
+TrajectoryReader* open_trajectory_file(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Unable to open trajectory file %s\n", path);
+        return NULL;
+    }
+    
+    char magic[4];
+    uint32_t header[2];
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, TRAJECTORY_MAGIC, 4) != 0 ||
+        fread(header, sizeof(uint32_t), 2, file) != 2 || header[0] != TRAJECTORY_VERSION) {
+        fprintf(stderr, "Error: %s is not a trajectory file of version %d\n", path, TRAJECTORY_VERSION);
+        fclose(file);
+        return NULL;
+    }
+    
+    TrajectoryReader* reader = (TrajectoryReader*)calloc(1, sizeof(TrajectoryReader));
+    if (reader == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for trajectory reader\n");
+        exit(1);
+    }
+    
+    reader->file = file;
+    reader->num_edges = (int)header[1];
+    for (int f = 0; f < 2; f++) {
+        reader->frames[f].num_edges = reader->num_edges;
+        reader->frames[f].load = (int*)grow_array(NULL, reader->num_edges, sizeof(int));
+    }
+    
+    return reader;
+}
+
+// ฟังก์ชันสำหรับอ่านก้อนข้อมูลถัดไปจากไฟล์ (คืนค่า false เมื่อหมดไฟล์หรือไฟล์เสียหาย)
+static bool read_next_block(TrajectoryReader* reader) {
+    uint32_t header[2];
+    if (fread(header, sizeof(uint32_t), 2, reader->file) != 2) {
+        return false;
+    }
+    
+    if (header[1] > reader->data_capacity) {
+        reader->data = (unsigned char*)grow_array(reader->data, header[1], 1);
+        reader->data_capacity = header[1];
+    }
+    if (fread(reader->data, 1, header[1], reader->file) != header[1]) {
+        fprintf(stderr, "Error: Trajectory file ends inside a block\n");
+        return false;
+    }
+    
+    reader->cursor = reader->data;
+    reader->end = reader->data + header[1];
+    reader->ticks_left = (int)header[0];
+    reader->first_in_block = true;
+    return true;
+}
+
+// ฟังก์ชันสำหรับถอดรหัสหนึ่งขั้นตอนเวลาลงใน frame (previous = ขั้นตอนเวลาก่อนหน้าในก้อนเดียวกัน หรือ NULL)
+static bool decode_tick(TrajectoryReader* reader, TrajectoryFrame* frame, const TrajectoryFrame* previous) {
+    const unsigned char** cursor = &reader->cursor;
+    const unsigned char* end = reader->end;
+    int64_t value;
+    uint64_t count;
+    
+    if (!get_svarint(cursor, end, &value) || !get_varint(cursor, end, &count) || count > INT32_MAX) {
+        return false;
+    }
+    frame->time_step = (int)(value + ((previous != NULL) ? previous->time_step : 0));
+    frame->num_vehicles = (int)count;
+    
+    if (frame->num_vehicles > frame->capacity) {
+        frame->trip_id = (long*)grow_array(frame->trip_id, frame->num_vehicles, sizeof(long));
+        frame->edge_id = (int*)grow_array(frame->edge_id, frame->num_vehicles, sizeof(int));
+        frame->position = (int*)grow_array(frame->position, frame->num_vehicles, sizeof(int));
+        frame->capacity = frame->num_vehicles;
+    }
+    
+    long last_trip = 0;
+    for (int i = 0; i < frame->num_vehicles; i++) {
+        if (!get_svarint(cursor, end, &value)) return false;
+        last_trip += (long)value;
+        frame->trip_id[i] = last_trip;
+    }
+    
+    // หาแถวเดิมแบบเดียวกับตัวเขียน (ใช้คอลัมน์ edge_id เก็บดัชนีของแถวเดิมชั่วคราว)
+    int* match = frame->edge_id;
+    if (previous != NULL) {
+        match_previous_rows(frame->trip_id, frame->num_vehicles, previous->trip_id, previous->num_vehicles, match);
+    } else {
+        for (int i = 0; i < frame->num_vehicles; i++) {
+            match[i] = -1;
+        }
+    }
+    
+    // เก็บตำแหน่งเดิมไว้ในคอลัมน์ position ก่อนที่ดัชนีใน edge_id จะถูกเขียนทับด้วยถนนที่ถอดรหัส
+    for (int i = 0; i < frame->num_vehicles; i++) {
+        int j = match[i];
+        frame->position[i] = (j >= 0) ? previous->position[j] : 0;
+        if (!get_svarint(cursor, end, &value)) return false;
+        match[i] = (int)value + ((j >= 0) ? previous->edge_id[j] : -1);
+    }
+    for (int i = 0; i < frame->num_vehicles; i++) {
+        if (!get_svarint(cursor, end, &value)) return false;
+        frame->position[i] += (int)value;
+    }
+    
+    for (int e = 0; e < reader->num_edges; e++) {
+        if (!get_svarint(cursor, end, &value)) return false;
+        frame->load[e] = (int)value + ((previous != NULL) ? previous->load[e] : 0);
+    }
+    
+    return true;
+}
+
+// ฟังก์ชันสำหรับอ่านขั้นตอนเวลาถัดไป (คืนค่า NULL เมื่อหมดไฟล์หรือไฟล์เสียหาย)
+const TrajectoryFrame* read_trajectory_tick(TrajectoryReader* reader) {
+    if (reader->ticks_left == 0 && !read_next_block(reader)) {
+        return NULL;
+    }
+    
+    TrajectoryFrame* previous = reader->first_in_block ? NULL : &reader->frames[reader->current];
+    TrajectoryFrame* frame = &reader->frames[reader->current ^ 1];
+    if (!decode_tick(reader, frame, previous)) {
+        fprintf(stderr, "Error: Trajectory block is corrupted\n");
+        reader->ticks_left = 0;
+        return NULL;
+    }
+    
+    reader->current ^= 1;
+    reader->ticks_left--;
+    reader->first_in_block = false;
+    return frame;
+}
+
+// ฟังก์ชันสำหรับปิดไฟล์และคืนหน่วยความจำของตัวอ่าน
+void close_trajectory_file(TrajectoryReader* reader) {
+    if (reader == NULL) return;
+    
+    fclose(reader->file);
+    for (int f = 0; f < 2; f++) {
+        free(reader->frames[f].trip_id);
+        free(reader->frames[f].edge_id);
+        free(reader->frames[f].position);
+        free(reader->frames[f].load);
+    }
+    free(reader->data);
+    free(reader);
+}
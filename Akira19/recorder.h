@@ -0,0 +1,85 @@
+#ifndef RECORDER_H
+#define RECORDER_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include <stdint.h>
+ #include "simulation.h"
+ 
+ // รหัสและรุ่นของรูปแบบไฟล์เส้นทางการเคลื่อนที่
+ #define TRAJECTORY_MAGIC "TSTR"
+ #define TRAJECTORY_VERSION 1
+ 
+ // จำนวนขั้นตอนเวลาเริ่มต้นในแต่ละก้อนข้อมูล
+ #define DEFAULT_TICKS_PER_BLOCK 16
+ 
+ // ไฟล์ประกอบด้วยส่วนหัว ("TSTR", รุ่น, จำนวนเส้นเชื่อม) แล้วตามด้วยก้อนข้อมูล
+ // แต่ละก้อนมี (จำนวนขั้นตอนเวลา, จำนวนไบต์) และข้อมูลของทุกขั้นตอนเวลาแบบคอลัมน์:
+ //   ขั้นตอนเวลา, จำนวนยานพาหนะ, หมายเลขการเดินทาง, Edge.id ของถนน, ตำแหน่ง (มม.), จำนวนรถของทุกถนน
+ // ทุกค่าเก็บเป็นผลต่าง (zigzag + varint): หมายเลขการเดินทางเทียบกับแถวก่อนหน้า
+ // ถนนและตำแหน่งเทียบกับการเดินทางเดียวกันในขั้นตอนเวลาก่อนหน้า จำนวนรถเทียบกับขั้นตอนเวลาก่อนหน้า
+ // ขั้นตอนเวลาแรกของทุกก้อนเทียบกับศูนย์ จึงอ่านแต่ละก้อนแยกกันได้
+ 
+ // สถิติของตัวบันทึก
+ typedef struct {
+     long ticks;              // จำนวนขั้นตอนเวลาที่บันทึก
+     long rows;               // จำนวนแถวของยานพาหนะที่บันทึก
+     long blocks;             // จำนวนก้อนข้อมูลที่เขียนลงไฟล์แล้ว
+     long stalls;             // จำนวนครั้งที่เธรดของการจำลองต้องรอเธรดเขียน
+     size_t raw_bytes;        // ขนาดของข้อมูลก่อนบีบอัด
+     size_t encoded_bytes;    // ขนาดของข้อมูลที่เขียนลงไฟล์
+     double snapshot_time;    // เวลาที่เธรดของการจำลองใช้คัดลอกข้อมูล (วินาที)
+     double stall_time;       // เวลาที่เธรดของการจำลองรอเธรดเขียน (วินาที)
+     double encode_time;      // เวลาที่เธรดเขียนใช้บีบอัดและเขียนไฟล์ (วินาที)
+ } RecorderStats;
+ 
+ // ตัวบันทึกเส้นทางการเคลื่อนที่แบบสองบัฟเฟอร์
+ // เธรดของการจำลองคัดลอกคอลัมน์ลงบัฟเฟอร์หนึ่ง ขณะที่เธรดเขียนบีบอัดและเขียนอีกบัฟเฟอร์ลงไฟล์
+ typedef struct TrajectoryRecorder TrajectoryRecorder;
+ 
+ // ข้อมูลของหนึ่งขั้นตอนเวลาที่อ่านจากไฟล์
+ typedef struct {
+     int time_step;           // ขั้นตอนเวลา
+     int num_vehicles;        // จำนวนยานพาหนะที่กำลังเดินทาง
+     long* trip_id;           // หมายเลขการเดินทางของแต่ละแถว
+     int* edge_id;            // Edge.id ของถนนปัจจุบัน (-1 = ไม่ได้อยู่บนถนน)
+     int* position;           // ตำแหน่งบนถนน (มิลลิเมตร)
+     int num_edges;           // จำนวนเส้นเชื่อม
+     int* load;               // จำนวนรถบนถนนตาม Edge.id
+     int capacity;            // ขนาดของคอลัมน์ของยานพาหนะ
+ } TrajectoryFrame;
+ 
+ // ตัวอ่านไฟล์เส้นทางการเคลื่อนที่
+ typedef struct TrajectoryReader TrajectoryReader;
+ 
+ // ฟังก์ชันสำหรับสร้างตัวบันทึกและเริ่มเธรดเขียน (คืนค่า NULL ถ้าเปิดไฟล์ไม่ได้)
+ TrajectoryRecorder* create_trajectory_recorder(const char* path, Graph* graph, int ticks_per_block);
+ 
+ // ฟังก์ชันสำหรับบันทึกสถานะของขั้นตอนเวลาปัจจุบัน (เรียกหลัง update_simulation)
+ // คัดลอกคอลัมน์เท่านั้น ต้องรอเฉพาะเมื่อเธรดเขียนยังเขียนก้อนก่อนหน้าไม่เสร็จ
+ void record_trajectory_tick(TrajectoryRecorder* recorder, const TrafficSimulation* sim);
+ 
+ // ฟังก์ชันสำหรับเขียนข้อมูลที่เหลือ หยุดเธรดเขียน และปิดไฟล์ (คืนค่า false ถ้าเขียนไม่สำเร็จ)
+ bool finish_trajectory_recorder(TrajectoryRecorder* recorder);
+ 
+ // ฟังก์ชันสำหรับอ่านสถิติของตัวบันทึก
+ RecorderStats get_recorder_stats(TrajectoryRecorder* recorder);
+ 
+ // ฟังก์ชันสำหรับแสดงสถิติของตัวบันทึก
+ void print_recorder_stats(TrajectoryRecorder* recorder);
+ 
+ // ฟังก์ชันสำหรับลบตัวบันทึกและคืนหน่วยความจำ (เขียนข้อมูลที่เหลือก่อนถ้ายังไม่ได้เรียก finish)
+ void free_trajectory_recorder(TrajectoryRecorder* recorder);
+ 
+ // ฟังก์ชันสำหรับเปิดไฟล์เส้นทางการเคลื่อนที่เพื่ออ่าน (คืนค่า NULL ถ้าไฟล์ไม่ถูกต้อง)
+ TrajectoryReader* open_trajectory_file(const char* path);
+ 
+ // ฟังก์ชันสำหรับอ่านขั้นตอนเวลาถัดไป (คืนค่า NULL เมื่อหมดไฟล์หรือไฟล์เสียหาย)
+ // ข้อมูลที่คืนเป็นของตัวอ่าน และใช้ได้จนถึงการเรียกครั้งถัดไป
+ const TrajectoryFrame* read_trajectory_tick(TrajectoryReader* reader);
+ 
+ // ฟังก์ชันสำหรับปิดไฟล์และคืนหน่วยความจำของตัวอ่าน
+ void close_trajectory_file(TrajectoryReader* reader);
+ 
+ #endif
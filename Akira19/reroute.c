@@ -0,0 +1,375 @@
+/*
+* reroute.c
+* การเปลี่ยนเส้นทางของยานพาหนะระหว่างเดินทางเมื่อการจราจรบนเส้นทางเดิมแย่ลง
+*/
+
+#include "reroute.h"
+#include "wall_clock.h"
+#include <string.h>
+
+// ยานพาหนะที่ต้นทุนของเส้นทางเพิ่มขึ้นเกินเกณฑ์
+typedef struct {
+    int destination;         // ปลายทาง (ใช้จัดกลุ่มการค้นหา)
+    int position;            // ตำแหน่งในที่เก็บยานพาหนะ
+    float current_cost;      // ต้นทุนของส่วนที่เหลือของเส้นทางเดิม ณ ตอนนี้
+} RerouteCandidate;
+
+// หน่วยความจำสำหรับค้นหาเส้นทางใหม่ (ใช้ซ้ำทุกครั้งเพื่อไม่ต้องจองใหม่)
+struct RerouteWorkspace {
+    ReverseAdjacency* reverse;   // เส้นเชื่อมขาเข้าของแต่ละทางแยก
+    int num_vertices;            // จำนวนทางแยกเมื่อสร้าง
+    int num_edges;               // จำนวนเส้นเชื่อมเมื่อสร้าง (สร้างใหม่ถ้ากราฟเปลี่ยน)
+    float* cost_to_dest;         // ต้นทุนต่ำสุดจากแต่ละทางแยกไปยังปลายทางของกลุ่มปัจจุบัน
+    int* next_vertex;            // ทางแยกถัดไปบนเส้นทางที่ดีที่สุดไปยังปลายทาง
+    int* path_index;             // ตำแหน่งของทางแยกในเส้นทางเดิม (ใช้ได้เมื่อ path_stamp ตรงกับ stamp)
+    unsigned int* path_stamp;
+    unsigned int stamp;
+    MinHeap* heap;
+    RerouteCandidate* candidates;
+    int num_candidates;
+    int candidate_capacity;
+    float* suffix_cost;          // ต้นทุนปัจจุบันจากแต่ละจุดของเส้นทางเดิมถึงปลายทาง
+    int* new_path;               // ส่วนท้ายของเส้นทางใหม่
+    int path_capacity;
+};
+
+// ฟังก์ชันสำหรับหาเส้นเชื่อมจากทางแยก src ไปยังทางแยก dest
+static Edge* find_route_edge(Graph* graph, int src, int dest) {
+    for (Edge* edge = graph->vertices[src].head; edge != NULL; edge = edge->next) {
+        if (edge->dest == dest) {
+            return edge;
+        }
+    }
+    return NULL;
+}
+
+// ฟังก์ชันสำหรับบันทึกต้นทุนสะสมตามแผนของเส้นทางจากตารางต้นทุนปัจจุบัน
+void record_planned_cost(Graph* graph, const RouteCostTable* table, Route* route) {
+    if (route->planned_cost == NULL) {
+        route->planned_cost = (float*)malloc((route->capacity > 0 ? route->capacity : 1) * sizeof(float));
+        if (route->planned_cost == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for route\n");
+            exit(1);
+        }
+    }
+    
+    if (route->length <= 0) {
+        return;
+    }
+    
+    route->planned_cost[0] = 0.0f;
+    for (int j = 0; j + 1 < route->length; j++) {
+        Edge* edge = find_route_edge(graph, route->path[j], route->path[j + 1]);
+        float cost = (edge != NULL && edge->id < table->num_edges) ? table->edge_cost[edge->id] : 0.0f;
+        route->planned_cost[j + 1] = route->planned_cost[j] + cost;
+    }
+}
+
+// ฟังก์ชันสำหรับสร้างหรือสร้างใหม่ของหน่วยความจำสำหรับค้นหา (เมื่อกราฟเปลี่ยน)
+static struct RerouteWorkspace* prepare_workspace(TrafficSimulation* sim) {
+    Graph* graph = sim->graph;
+    struct RerouteWorkspace* ws = sim->reroute_workspace;
+    
+    if (ws != NULL && ws->num_vertices == graph->num_vertices && ws->num_edges == graph->num_edges) {
+        return ws;
+    }
+    
+    free_reroute_workspace(ws);
+    
+    ws = (struct RerouteWorkspace*)calloc(1, sizeof(struct RerouteWorkspace));
+    if (ws == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for reroute workspace\n");
+        exit(1);
+    }
+    
+    int n = graph->num_vertices;
+    ws->reverse = build_reverse_adjacency(graph);
+    ws->num_vertices = n;
+    ws->num_edges = graph->num_edges;
+    ws->cost_to_dest = (float*)malloc(n * sizeof(float));
+    ws->next_vertex = (int*)malloc(n * sizeof(int));
+    ws->path_index = (int*)malloc(n * sizeof(int));
+    ws->path_stamp = (unsigned int*)calloc(n, sizeof(unsigned int));
+    if (ws->cost_to_dest == NULL || ws->next_vertex == NULL || ws->path_index == NULL || ws->path_stamp == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for reroute workspace\n");
+        exit(1);
+    }
+    ws->heap = create_min_heap(graph->num_edges + 1);
+    
+    sim->reroute_workspace = ws;
+    return ws;
+}
+
+// ฟังก์ชันสำหรับขยายอาเรย์ของเส้นทางชั่วคราวให้มีขนาดอย่างน้อย length
+static void reserve_path_buffers(struct RerouteWorkspace* ws, int length) {
+    if (length <= ws->path_capacity) {
+        return;
+    }
+    
+    int capacity = (ws->path_capacity > 0) ? ws->path_capacity : 64;
+    while (capacity < length) {
+        capacity *= 2;
+    }
+    
+    ws->suffix_cost = (float*)realloc(ws->suffix_cost, capacity * sizeof(float));
+    ws->new_path = (int*)realloc(ws->new_path, capacity * sizeof(int));
+    if (ws->suffix_cost == NULL || ws->new_path == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for reroute workspace\n");
+        exit(1);
+    }
+    ws->path_capacity = capacity;
+}
+
+// ฟังก์ชันสำหรับคำนวณต้นทุนปัจจุบันจากจุดที่ index ของเส้นทางถึงปลายทาง (เก็บไว้ใน suffix_cost)
+static float compute_suffix_cost(Graph* graph, const float* edge_cost, struct RerouteWorkspace* ws,
+                                 const Route* route, int index) {
+    reserve_path_buffers(ws, route->length);
+    
+    ws->suffix_cost[route->length - 1] = 0.0f;
+    for (int j = route->length - 2; j >= index; j--) {
+        Edge* edge = find_route_edge(graph, route->path[j], route->path[j + 1]);
+        float cost = (edge != NULL) ? edge_cost[edge->id] : 0.0f;
+        ws->suffix_cost[j] = ws->suffix_cost[j + 1] + cost;
+    }
+    
+    return ws->suffix_cost[index];
+}
+
+// ฟังก์ชันสำหรับเพิ่มยานพาหนะลงในรายการที่ต้องค้นหาเส้นทางใหม่
+static void push_candidate(struct RerouteWorkspace* ws, RerouteCandidate candidate) {
+    if (ws->num_candidates >= ws->candidate_capacity) {
+        int new_capacity = (ws->candidate_capacity > 0) ? ws->candidate_capacity * 2 : 256;
+        RerouteCandidate* grown = (RerouteCandidate*)realloc(ws->candidates, new_capacity * sizeof(RerouteCandidate));
+        if (grown == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for reroute candidates\n");
+            exit(1);
+        }
+        ws->candidates = grown;
+        ws->candidate_capacity = new_capacity;
+    }
+    
+    ws->candidates[ws->num_candidates++] = candidate;
+}
+
+// ฟังก์ชันสำหรับเปรียบเทียบยานพาหนะตามปลายทาง (และตำแหน่งเพื่อให้ลำดับคงที่)
+static int compare_candidates(const void* a, const void* b) {
+    const RerouteCandidate* x = (const RerouteCandidate*)a;
+    const RerouteCandidate* y = (const RerouteCandidate*)b;
+    
+    if (x->destination != y->destination) {
+        return (x->destination < y->destination) ? -1 : 1;
+    }
+    return (x->position < y->position) ? -1 : (x->position > y->position);
+}
+
+// ฟังก์ชันสำหรับค้นหาต้นทุนต่ำสุดจากทุกทางแยกไปยังปลายทาง (Dijkstra บนเส้นเชื่อมขาเข้า)
+static void search_to_destination(const float* edge_cost, struct RerouteWorkspace* ws, int destination) {
+    for (int i = 0; i < ws->num_vertices; i++) {
+        ws->cost_to_dest[i] = FLT_MAX;
+        ws->next_vertex[i] = -1;
+    }
+    
+    MinHeap* heap = ws->heap;
+    heap->size = 0;
+    ws->cost_to_dest[destination] = 0.0f;
+    insert_min_heap(heap, destination, 0.0f, 0.0f);
+    
+    while (heap->size > 0) {
+        HeapNode min = extract_min(heap);
+        int u = min.vertex;
+        
+        if (min.dist > ws->cost_to_dest[u]) {
+            continue;
+        }
+        
+        for (int k = ws->reverse->offset[u]; k < ws->reverse->offset[u + 1]; k++) {
+            int v = ws->reverse->source[k];
+            float new_cost = min.dist + edge_cost[ws->reverse->edge[k]->id];
+            
+            if (new_cost < ws->cost_to_dest[v]) {
+                ws->cost_to_dest[v] = new_cost;
+                ws->next_vertex[v] = u;
+                insert_min_heap(heap, v, new_cost, new_cost);
+            }
+        }
+    }
+}
+
+// ฟังก์ชันสำหรับขยายเส้นทางให้เก็บได้อย่างน้อย length จุดยอด (รวมต้นทุนตามแผน)
+static void reserve_route(Route* route, int length) {
+    if (route->capacity >= length) {
+        return;
+    }
+    
+    int* path = (int*)realloc(route->path, length * sizeof(int));
+    float* planned_cost = (float*)realloc(route->planned_cost, length * sizeof(float));
+    if (path == NULL || planned_cost == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for route\n");
+        exit(1);
+    }
+    route->path = path;
+    route->planned_cost = planned_cost;
+    route->capacity = length;
+}
+
+// ฟังก์ชันสำหรับซ่อมเส้นทางของยานพาหนะหนึ่งคันจากผลการค้นหาย้อนกลับ (คืนค่า true ถ้าเปลี่ยนเส้นทาง)
+// เก็บส่วนต้น path[0..index] ไว้ (ยานพาหนะกำลังอยู่บนถนนที่สิ้นสุดที่ path[index])
+// แล้วเดินตามทางแยกถัดไปที่ดีที่สุด ถ้าไปถึงทางแยกบนเส้นทางเดิมที่ส่วนท้ายเดิมยังดีที่สุดอยู่ จะต่อส่วนท้ายเดิมแทน
+static bool repair_route(TrafficSimulation* sim, struct RerouteWorkspace* ws, const RerouteCandidate* candidate) {
+    Graph* graph = sim->graph;
+    const float* edge_cost = sim->route_costs->edge_cost;
+    int position = candidate->position;
+    Route* route = sim->vehicles.route[position];
+    int index = sim->vehicles.route_index[position];
+    int start = route->path[index];
+    
+    // ต้องดีกว่าเส้นทางเดิมอย่างชัดเจนจึงเปลี่ยน (ไม่เปลี่ยนไปมาระหว่างเส้นทางที่ต้นทุนเท่ากัน)
+    float best = ws->cost_to_dest[start];
+    if (best >= candidate->current_cost * 0.99f) {
+        return false;
+    }
+    
+    // จดตำแหน่งของทางแยกในส่วนที่เหลือของเส้นทางเดิม
+    compute_suffix_cost(graph, edge_cost, ws, route, index);
+    ws->stamp++;
+    for (int j = index; j < route->length; j++) {
+        ws->path_index[route->path[j]] = j;
+        ws->path_stamp[route->path[j]] = ws->stamp;
+    }
+    
+    int count = 0;
+    int splice_from = -1;
+    int current = start;
+    
+    while (current != candidate->destination) {
+        int next = ws->next_vertex[current];
+        if (next < 0 || count >= ws->num_vertices) {
+            return false;
+        }
+        
+        // บรรจบกับเส้นทางเดิมที่ยังเป็นเส้นทางที่ดีที่สุด: ใช้ส่วนท้ายเดิมต่อได้เลย
+        if (ws->path_stamp[next] == ws->stamp) {
+            int j = ws->path_index[next];
+            float expected = ws->cost_to_dest[next];
+            if (j > index && ws->suffix_cost[j] <= expected + 1e-4f * (1.0f + expected)) {
+                splice_from = j;
+                reserve_path_buffers(ws, count + 1);
+                ws->new_path[count++] = next;
+                break;
+            }
+        }
+        
+        reserve_path_buffers(ws, count + 1);
+        ws->new_path[count++] = next;
+        current = next;
+    }
+    
+    // ความยาวใหม่ = ส่วนต้นที่เก็บไว้ + ส่วนใหม่ + ส่วนท้ายเดิมที่ต่อกลับ
+    int tail = (splice_from >= 0) ? route->length - 1 - splice_from : 0;
+    int length = index + 1 + count + tail;
+    reserve_route(route, length);
+    
+    if (tail > 0) {
+        memmove(&route->path[index + 1 + count], &route->path[splice_from + 1], tail * sizeof(int));
+    }
+    memcpy(&route->path[index + 1], ws->new_path, count * sizeof(int));
+    route->length = length;
+    
+    route->total_time = calculate_route_time(graph, route);
+    route->total_distance = calculate_route_distance(graph, route);
+    record_planned_cost(graph, sim->route_costs, route);
+    
+    if (tail > 0) {
+        sim->reroute_last.spliced++;
+    }
+    return true;
+}
+
+// ฟังก์ชันสำหรับตรวจและเปลี่ยนเส้นทางของยานพาหนะที่ต้นทุนของเส้นทางเพิ่มขึ้นเกินเกณฑ์
+void reroute_vehicles(TrafficSimulation* sim) {
+    double start_time = monotonic_seconds();
+    
+    struct RerouteWorkspace* ws = prepare_workspace(sim);
+    Graph* graph = sim->graph;
+    VehicleStore* store = &sim->vehicles;
+    const float* edge_cost = sim->route_costs->edge_cost;
+    float threshold = 1.0f + sim->config.reroute_threshold;
+    
+    memset(&sim->reroute_last, 0, sizeof(RerouteStats));
+    ws->num_candidates = 0;
+    
+    // ตรวจเฉพาะส่วนที่เหลือของเส้นทาง (หลังจากถนนที่กำลังอยู่) เทียบกับต้นทุนตามแผนของส่วนเดียวกัน
+    for (int i = 0; i < sim->num_vehicles; i++) {
+        Route* route = store->route[i];
+        int index = store->route_index[i];
+        if (store->completed[i] || store->current_edge[i] == NULL || route->planned_cost == NULL ||
+            index + 1 >= route->length) {
+            continue;
+        }
+        
+        sim->reroute_last.checked++;
+        float planned = route->planned_cost[route->length - 1] - route->planned_cost[index];
+        float current = compute_suffix_cost(graph, edge_cost, ws, route, index);
+        
+        if (current > planned * threshold && current > planned + 1e-6f) {
+            RerouteCandidate candidate = {store->destination[i], i, current};
+            push_candidate(ws, candidate);
+        }
+    }
+    
+    sim->reroute_last.candidates = ws->num_candidates;
+    
+    // ค้นหาย้อนกลับหนึ่งครั้งต่อปลายทาง แล้วซ่อมเส้นทางของทุกคันที่ไปปลายทางเดียวกัน
+    qsort(ws->candidates, ws->num_candidates, sizeof(RerouteCandidate), compare_candidates);
+    
+    for (int k = 0; k < ws->num_candidates; ) {
+        int destination = ws->candidates[k].destination;
+        search_to_destination(edge_cost, ws, destination);
+        sim->reroute_last.searches++;
+        
+        for (; k < ws->num_candidates && ws->candidates[k].destination == destination; k++) {
+            if (repair_route(sim, ws, &ws->candidates[k])) {
+                sim->reroute_last.rerouted++;
+            }
+        }
+    }
+    
+    sim->reroute_last.routing_time = monotonic_seconds() - start_time;
+    
+    sim->reroute_total.checked += sim->reroute_last.checked;
+    sim->reroute_total.candidates += sim->reroute_last.candidates;
+    sim->reroute_total.rerouted += sim->reroute_last.rerouted;
+    sim->reroute_total.spliced += sim->reroute_last.spliced;
+    sim->reroute_total.searches += sim->reroute_last.searches;
+    sim->reroute_total.routing_time += sim->reroute_last.routing_time;
+    sim->route_queries += sim->reroute_last.searches;
+}
+
+// ฟังก์ชันสำหรับแสดงสถิติของการเปลี่ยนเส้นทาง
+void print_reroute_stats(const TrafficSimulation* sim) {
+    const RerouteStats* total = &sim->reroute_total;
+    int interval = sim->config.reroute_interval;
+    int rounds = (interval > 0) ? sim->time_step / interval : 0;
+    
+    printf("Rerouting (every %d ticks, threshold %.0f%%):\n", interval, sim->config.reroute_threshold * 100.0);
+    printf("  Vehicles checked: %ld, over threshold: %ld, rerouted: %ld (%ld reused the old route's tail)\n",
+           total->checked, total->candidates, total->rerouted, total->spliced);
+    printf("  Destination searches: %ld, routing time: %.3f ms per reroute tick\n",
+           total->searches, (rounds > 0) ? total->routing_time * 1e3 / rounds : 0.0);
+}
+
+// ฟังก์ชันสำหรับลบหน่วยความจำที่ใช้ค้นหาเส้นทางใหม่
+void free_reroute_workspace(struct RerouteWorkspace* workspace) {
+    if (workspace == NULL) return;
+    
+    free_reverse_adjacency(workspace->reverse);
+    free(workspace->cost_to_dest);
+    free(workspace->next_vertex);
+    free(workspace->path_index);
+    free(workspace->path_stamp);
+    free_heap(workspace->heap);
+    free(workspace->candidates);
+    free(workspace->suffix_cost);
+    free(workspace->new_path);
+    free(workspace);
+}
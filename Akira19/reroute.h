@@ -0,0 +1,29 @@
+#ifndef REROUTE_H
+#define REROUTE_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ #include "graph.h"
+ #include "route.h"
+ #include "simulation.h"
+ 
+ // การเปลี่ยนเส้นทางระหว่างเดินทาง (en-route rerouting)
+ // ทุก reroute_interval ขั้นตอนเวลา จะตรวจต้นทุนของส่วนที่เหลือของเส้นทางของยานพาหนะแต่ละคันเทียบกับต้นทุนตามแผน
+ // เฉพาะยานพาหนะที่ต้นทุนเพิ่มขึ้นเกิน reroute_threshold จึงถูกค้นหาเส้นทางใหม่ โดยรวมการค้นหาตามปลายทาง
+ // (ค้นหาย้อนกลับจากปลายทางหนึ่งครั้งต่อปลายทาง) เก็บส่วนต้นของเส้นทางที่ผ่านมาแล้วไว้
+ // และต่อส่วนท้ายของเส้นทางเดิมกลับเข้าไปเมื่อเส้นทางใหม่มาบรรจบกับเส้นทางเดิมที่ยังดีที่สุดอยู่
+ 
+ // ฟังก์ชันสำหรับบันทึกต้นทุนสะสมตามแผนของเส้นทางจากตารางต้นทุนปัจจุบัน
+ void record_planned_cost(Graph* graph, const RouteCostTable* table, Route* route);
+ 
+ // ฟังก์ชันสำหรับตรวจและเปลี่ยนเส้นทางของยานพาหนะที่ต้นทุนของเส้นทางเพิ่มขึ้นเกินเกณฑ์
+ void reroute_vehicles(TrafficSimulation* sim);
+ 
+ // ฟังก์ชันสำหรับแสดงสถิติของการเปลี่ยนเส้นทาง
+ void print_reroute_stats(const TrafficSimulation* sim);
+ 
+ // ฟังก์ชันสำหรับลบหน่วยความจำที่ใช้ค้นหาเส้นทางใหม่
+ void free_reroute_workspace(struct RerouteWorkspace* workspace);
+ 
+ #endif
@@ -0,0 +1,36 @@
+/*
+* rng.c
+* เลขสุ่มแบบนับที่กำหนดค่าเริ่มต้นได้ สำหรับผลการจำลองที่ทำซ้ำได้
+*/
+
+#include "rng.h"
+
+// ฟังก์ชันสำหรับผสมบิตแบบ SplitMix64
+static inline uint64_t splitmix64_mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+}
+
+// ฟังก์ชันสำหรับสุ่มจำนวนเต็ม 64 บิต
+// ผสม seed กับ stream เป็นกุญแจของกระแสก่อน แล้วจึงผสมกับ counter ตามลำดับของ SplitMix64
+uint64_t random_u64(uint64_t seed, uint64_t stream, uint64_t counter) {
+    uint64_t key = splitmix64_mix(seed + UINT64_C(0x9E3779B97F4A7C15) * (stream + 1));
+    return splitmix64_mix(key + UINT64_C(0x9E3779B97F4A7C15) * (counter + 1));
+}
+
+// ฟังก์ชันสำหรับสุ่มจำนวนเต็มในช่วง [0, bound)
+int random_int(uint64_t seed, uint64_t stream, uint64_t counter, int bound) {
+    if (bound <= 0) {
+        return 0;
+    }
+    
+    // ใช้การคูณแล้วเลื่อนบิตแทนการหารเอาเศษ ได้การกระจายสม่ำเสมอกว่าและเร็วกว่า
+    uint64_t x = random_u64(seed, stream, counter) >> 32;
+    return (int)((x * (uint64_t)bound) >> 32);
+}
+
+// ฟังก์ชันสำหรับสุ่มจำนวนจริงในช่วง [0, 1)
+double random_double(uint64_t seed, uint64_t stream, uint64_t counter) {
+    return (double)(random_u64(seed, stream, counter) >> 11) * (1.0 / 9007199254740992.0);
+}
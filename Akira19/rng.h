@@ -0,0 +1,29 @@
+#ifndef RNG_H
+#define RNG_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdint.h>
+ 
+ // หมายเลขกระแสของเลขสุ่มที่ใช้ร่วมกันทั้งการจำลอง (ยานพาหนะใช้หมายเลขการเดินทางของตัวเองเป็นกระแส)
+ #define RNG_STREAM_TRAFFIC UINT64_C(0xFFFFFFFF00000001)
+ 
+ // หมายเลขกระแสของเลขสุ่มสำหรับสร้าง seed ของการจำลองแต่ละชุดในกลุ่มการจำลอง (ensemble)
+ #define RNG_STREAM_ENSEMBLE UINT64_C(0xFFFFFFFF00000002)
+ 
+ // หมายเลขกระแสของเลขสุ่มสำหรับสร้าง seed ของการจำลองที่ใช้ประเมินการตั้งเวลาของสัญญาณไฟ (คลื่นไฟเขียว)
+ #define RNG_STREAM_GREEN_WAVE UINT64_C(0xFFFFFFFF00000003)
+ 
+ // เลขสุ่มแบบนับ (counter-based): ผลลัพธ์ขึ้นกับ (seed, stream, counter) เท่านั้น ไม่มีสถานะที่ใช้ร่วมกัน
+ // จึงได้ค่าเดียวกันเสมอไม่ว่าจะเรียกจากเธรดใดหรือลำดับใด
+ 
+ // ฟังก์ชันสำหรับสุ่มจำนวนเต็ม 64 บิต
+ uint64_t random_u64(uint64_t seed, uint64_t stream, uint64_t counter);
+ 
+ // ฟังก์ชันสำหรับสุ่มจำนวนเต็มในช่วง [0, bound)
+ int random_int(uint64_t seed, uint64_t stream, uint64_t counter, int bound);
+ 
+ // ฟังก์ชันสำหรับสุ่มจำนวนจริงในช่วง [0, 1)
+ double random_double(uint64_t seed, uint64_t stream, uint64_t counter);
+ 
+ #endif
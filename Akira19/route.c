@@ -1,4 +1,5 @@
 #include "route.h"
+#include "landmark.h"
 
 // ฟังก์ชันสำหรับสร้างเส้นทางใหม่
 Route* create_route(int capacity) {
@@ -18,6 +19,8 @@ Route* create_route(int capacity) {
     route->length = 0;
     route->total_time = 0.0;
     route->total_distance = 0.0;
+    route->capacity = capacity;
+    route->planned_cost = NULL;
     
     return route;
 }
@@ -37,7 +40,7 @@ float calculate_route_time(Graph* graph, Route* route) {
         Edge* current = graph->vertices[src].head;
         while (current != NULL) {
             if (current->dest == dest) {
-                total_time += current->weight;
+                total_time += edge_weight(graph, current);
                 break;
             }
             current = current->next;
@@ -72,21 +75,6 @@ float calculate_route_distance(Graph* graph, Route* route) {
     return total_distance;
 }
 
-// ฟังก์ชันเปรียบเทียบสำหรับการจัดลำดับความสำคัญในฮีป
-// ใช้สำหรับอัลกอริทึม Dijkstra
-typedef struct {
-    int vertex;     // จุดยอด
-    float dist;     // ระยะทาง/เวลาจากจุดเริ่มต้น
-    float priority; // ค่าฮิวริสติก
-} HeapNode;
-
-// ฟังก์ชันสำหรับสร้างฮีปใหม่
-typedef struct {
-    HeapNode* array;  // อาเรย์ของสมาชิกในฮีป
-    int capacity;     // ความจุของฮีป
-    int size;         // จำนวนสมาชิกในฮีปปัจจุบัน
-} MinHeap;
-
 // ฟังก์ชันสำหรับสร้างฮีปใหม่
 MinHeap* create_min_heap(int capacity) {
     MinHeap* heap = (MinHeap*)malloc(sizeof(MinHeap));
@@ -147,9 +135,16 @@ void heapify_down(MinHeap* heap, int idx) {
 
 // ฟังก์ชันสำหรับเพิ่มสมาชิกใหม่ลงในฮีป
 void insert_min_heap(MinHeap* heap, int vertex, float dist, float priority) {
+    // ขยายฮีปเมื่อเต็ม (A* อาจเปิดจุดยอดซ้ำได้มากกว่าจำนวนเส้นเชื่อม)
     if (heap->size >= heap->capacity) {
-        fprintf(stderr, "Error: Heap is full\n");
-        return;
+        int new_capacity = (heap->capacity > 0) ? heap->capacity * 2 : 16;
+        HeapNode* array = (HeapNode*)realloc(heap->array, new_capacity * sizeof(HeapNode));
+        if (array == NULL) {
+            fprintf(stderr, "Error: Heap is full\n");
+            return;
+        }
+        heap->array = array;
+        heap->capacity = new_capacity;
     }
     
     heap->array[heap->size].vertex = vertex;
@@ -214,6 +209,11 @@ void free_heap(MinHeap* heap) {
 
 // ฟังก์ชันสำหรับสร้างเส้นทางจากอาเรย์ของจุดก่อนหน้า
 Route* build_path(Graph* graph, int* prev, int src, int dest) {
+    return build_path_reuse(graph, prev, src, dest, NULL);
+}
+
+// ฟังก์ชันสำหรับสร้างเส้นทางลงในเส้นทางเดิม reuse (NULL = สร้างใหม่) เพื่อไม่ต้องจองหน่วยความจำใหม่
+Route* build_path_reuse(Graph* graph, int* prev, int src, int dest, Route* reuse) {
     int count = 0;
     int current = dest;
     
@@ -222,7 +222,28 @@ Route* build_path(Graph* graph, int* prev, int src, int dest) {
         current = prev[current];
     }
     
-    Route* route = create_route(count);
+    Route* route = reuse;
+    if (route == NULL) {
+        route = create_route(count);
+    } else if (route->capacity < count) {
+        int* path = (int*)realloc(route->path, count * sizeof(int));
+        if (path == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for route\n");
+            exit(1);
+        }
+        route->path = path;
+        route->capacity = count;
+        
+        // ขยายต้นทุนตามแผนด้วยถ้าเคยบันทึกไว้ (ผู้ใช้จะบันทึกค่าใหม่ของเส้นทางนี้เอง)
+        if (route->planned_cost != NULL) {
+            float* planned_cost = (float*)realloc(route->planned_cost, count * sizeof(float));
+            if (planned_cost == NULL) {
+                fprintf(stderr, "Error: Unable to allocate memory for route\n");
+                exit(1);
+            }
+            route->planned_cost = planned_cost;
+        }
+    }
     route->length = count;
     
     current = dest;
@@ -240,154 +261,166 @@ Route* build_path(Graph* graph, int* prev, int src, int dest) {
     return route;
 }
 
-// ฟังก์ชันสำหรับสร้างเส้นทางโดยใช้อัลกอริทึม Dijkstra
-Route* find_shortest_path(Graph* graph, int src, int dest) {
+// ฟังก์ชันสำหรับคำนวณความหนาแน่นของถนน (0.0 - 1.0)
+static inline float road_congestion(const Graph* graph, const Edge* edge) {
+    float congestion = (float)edge_load(graph, edge) / edge->road->capacity;
+    return (congestion > 1.0f) ? 1.0f : congestion;
+}
+
+// ค่าน้ำหนักของแต่ละปัจจัยสำหรับ find_optimal_path
+typedef struct {
+    float time_weight;
+    float distance_weight;
+    float congestion_weight;
+} RouteWeights;
+
+// ฟังก์ชันสำหรับคำนวณต้นทุนรวมของเส้นเชื่อมตามค่าน้ำหนักของแต่ละปัจจัย
+static inline float weighted_edge_cost(const Graph* graph, const Edge* edge, const RouteWeights* weights) {
+    return (weights->time_weight * edge_weight(graph, edge)) +
+           (weights->distance_weight * edge->road->length) +
+           (weights->congestion_weight * road_congestion(graph, edge));
+}
+
+// วิธีรวมต้นทุนสะสมของเส้นทางกับต้นทุนของเส้นเชื่อม
+#define COST_SUM(path_cost, edge_cost) ((path_cost) + (edge_cost))
+#define COST_MAX(path_cost, edge_cost) (((path_cost) > (edge_cost)) ? (path_cost) : (edge_cost))
+
+// ต้นทุนของเส้นเชื่อมสำหรับแต่ละตัวชี้วัด
+#define EDGE_TIME_COST(graph, edge, ctx) edge_weight((graph), (edge))
+#define EDGE_CONGESTION_COST(graph, edge, ctx) road_congestion((graph), (edge))
+#define EDGE_WEIGHTED_COST(graph, edge, ctx) weighted_edge_cost((graph), (edge), (const RouteWeights*)(ctx))
+#define EDGE_TABLE_COST(graph, edge, ctx) (((const float*)(ctx))[(edge)->id])
+
+// ข้อมูลสำหรับการค้นหาแบบ ALT: ข้อมูลของตัวชี้วัดและจุดอ้างอิงที่เลือกใช้
+typedef struct {
+    const void* metric;       // ข้อมูลของตัวชี้วัด (เหมือนกับการค้นหาแบบปกติ)
+    float heuristic_scale;    // ตัวคูณของขอบล่างจากตารางของจุดอ้างอิง
+    LandmarkQuery query;      // จุดอ้างอิงที่เลือกใช้สำหรับปลายทาง
+} AltSearchContext;
+
+#define ALT_METRIC(ctx) (((const AltSearchContext*)(ctx))->metric)
+#define EDGE_WEIGHTED_COST_ALT(graph, edge, ctx) EDGE_WEIGHTED_COST(graph, edge, ALT_METRIC(ctx))
+#define EDGE_TABLE_COST_ALT(graph, edge, ctx) EDGE_TABLE_COST(graph, edge, ALT_METRIC(ctx))
+
+// ค่าฮิวริสติกของ A* (Dijkstra ปกติใช้ค่าศูนย์)
+#define NO_HEURISTIC(vertex, ctx) 0.0f
+#define LANDMARK_HEURISTIC(vertex, ctx) \
+    (((const AltSearchContext*)(ctx))->heuristic_scale * \
+     landmark_lower_bound(&((const AltSearchContext*)(ctx))->query, (vertex)))
+
+// แมโครสำหรับสร้างลูปค้นหาแบบ Dijkstra/A* เฉพาะสำหรับแต่ละตัวชี้วัด
+// ต้นทุนของเส้นเชื่อม วิธีรวมต้นทุน และค่าฮิวริสติกถูกแทนที่ตอนคอมไพล์ จึงไม่มีการแตกแขนงตามตัวชี้วัดภายในลูป
+// ฮีปใช้การเพิ่มซ้ำแทนการค้นหาและปรับค่า (สมาชิกที่ล้าสมัยจะถูกข้าม)
+// จุดยอดอาจถูกเปิดซ้ำได้ถ้าค่าฮิวริสติกไม่สอดคล้อง (consistent) ทั้งหมด
+#define DEFINE_ROUTE_SEARCH(NAME, EDGE_COST, COMBINE, HEURISTIC)                \
+static void NAME(Graph* graph, int src, int dest, const void* ctx,             \
+                 float* cost, int* prev, MinHeap* heap) {                      \
+    (void)ctx;                                                                 \
+    cost[src] = 0.0f;                                                          \
+    insert_min_heap(heap, src, 0.0f, HEURISTIC(src, ctx));                     \
+                                                                               \
+    while (heap->size > 0) {                                                   \
+        HeapNode min = extract_min(heap);                                      \
+        int u = min.vertex;                                                    \
+                                                                               \
+        if (min.dist > cost[u]) {                                              \
+            continue;                                                          \
+        }                                                                      \
+                                                                               \
+        if (u == dest) {                                                       \
+            break;                                                             \
+        }                                                                      \
+                                                                               \
+        float cost_u = cost[u];                                                \
+                                                                               \
+        for (Edge* current = graph->vertices[u].head; current != NULL;         \
+             current = current->next) {                                        \
+            int v = current->dest;                                             \
+            float new_cost = COMBINE(cost_u, EDGE_COST(graph, current, ctx));  \
+                                                                               \
+            if (new_cost < cost[v]) {                                          \
+                cost[v] = new_cost;                                            \
+                prev[v] = u;                                                   \
+                insert_min_heap(heap, v, new_cost,                             \
+                                new_cost + HEURISTIC(v, ctx));                 \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+}
+
+DEFINE_ROUTE_SEARCH(search_by_time, EDGE_TIME_COST, COST_SUM, NO_HEURISTIC)
+DEFINE_ROUTE_SEARCH(search_by_congestion, EDGE_CONGESTION_COST, COST_MAX, NO_HEURISTIC)
+DEFINE_ROUTE_SEARCH(search_by_weighted_cost, EDGE_WEIGHTED_COST, COST_SUM, NO_HEURISTIC)
+DEFINE_ROUTE_SEARCH(search_by_cost_table, EDGE_TABLE_COST, COST_SUM, NO_HEURISTIC)
+DEFINE_ROUTE_SEARCH(search_by_time_alt, EDGE_TIME_COST, COST_SUM, LANDMARK_HEURISTIC)
+DEFINE_ROUTE_SEARCH(search_by_weighted_cost_alt, EDGE_WEIGHTED_COST_ALT, COST_SUM, LANDMARK_HEURISTIC)
+DEFINE_ROUTE_SEARCH(search_by_cost_table_alt, EDGE_TABLE_COST_ALT, COST_SUM, LANDMARK_HEURISTIC)
+
+typedef void (*RouteSearchKernel)(Graph* graph, int src, int dest, const void* ctx,
+                                  float* cost, int* prev, MinHeap* heap);
+
+// ฟังก์ชันสำหรับจัดเตรียมหน่วยความจำ เรียกลูปค้นหา และสร้างเส้นทางผลลัพธ์
+// ถ้ากราฟมีจุดอ้างอิงที่ให้ขอบล่างของตัวชี้วัด (time_weight * เวลา + distance_weight * ระยะทาง + ...)
+// ได้ จะใช้ alt_kernel แทน
+static Route* run_route_search(Graph* graph, int src, int dest, RouteSearchKernel kernel,
+                               RouteSearchKernel alt_kernel, const void* ctx,
+                               float time_weight, float distance_weight, Route* reuse) {
     if (src < 0 || src >= graph->num_vertices ||
         dest < 0 || dest >= graph->num_vertices) {
         fprintf(stderr, "Error: Invalid vertex ID\n");
         return NULL;
     }
     
-    float* dist = (float*)malloc(graph->num_vertices * sizeof(float));
+    float* cost = (float*)malloc(graph->num_vertices * sizeof(float));
     int* prev = (int*)malloc(graph->num_vertices * sizeof(int));
-    bool* visited = (bool*)malloc(graph->num_vertices * sizeof(bool));
     
-    if (dist == NULL || prev == NULL || visited == NULL) {
+    if (cost == NULL || prev == NULL) {
         fprintf(stderr, "Error: Unable to allocate memory\n");
         exit(1);
     }
     
     for (int i = 0; i < graph->num_vertices; i++) {
-        dist[i] = FLT_MAX;
+        cost[i] = FLT_MAX;
         prev[i] = -1;
-        visited[i] = false;
     }
     
-    dist[src] = 0.0;
-    
-    MinHeap* heap = create_min_heap(graph->num_vertices);
+    // แต่ละการผ่อนคลายเส้นเชื่อมเพิ่มสมาชิกได้หนึ่งตัว
+    MinHeap* heap = create_min_heap(graph->num_edges + 1);
     
-    insert_min_heap(heap, src, 0.0, 0.0);
+    const LandmarkSet* landmarks = graph->landmarks;
+    float heuristic_scale = 0.0f;
+    if (alt_kernel != NULL && landmarks != NULL && landmarks->num_vertices == graph->num_vertices) {
+        heuristic_scale = landmark_heuristic_scale(landmarks, time_weight, distance_weight);
+    }
     
-    while (heap->size > 0) {
-        HeapNode min = extract_min(heap);
-        int u = min.vertex;
-        
-        if (u == dest) {
-            break;
-        }
-        
-        if (visited[u]) {
-            continue;
-        }
+    if (heuristic_scale > 0.0f) {
+        AltSearchContext alt_ctx;
+        alt_ctx.metric = ctx;
+        alt_ctx.heuristic_scale = heuristic_scale;
+        prepare_landmark_query(landmarks, src, dest, &alt_ctx.query);
         
-        visited[u] = true;
-        
-        Edge* current = graph->vertices[u].head;
-        while (current != NULL) {
-            int v = current->dest;
-            float weight = current->weight;
-            
-            if (!visited[v] && dist[u] + weight < dist[v]) {
-                dist[v] = dist[u] + weight;
-                prev[v] = u;
-                
-                if (is_in_heap(heap, v)) {
-                    update_dist_in_heap(heap, v, dist[v], dist[v]);
-                } else {
-                    insert_min_heap(heap, v, dist[v], dist[v]);
-                }
-            }
-            
-            current = current->next;
-        }
+        alt_kernel(graph, src, dest, &alt_ctx, cost, prev, heap);
+    } else {
+        kernel(graph, src, dest, ctx, cost, prev, heap);
     }
     
-    Route* route = build_path(graph, prev, src, dest);
+    Route* route = build_path_reuse(graph, prev, src, dest, reuse);
     
-    free(dist);
+    free(cost);
     free(prev);
-    free(visited);
     free_heap(heap);
     
     return route;
 }
 
+// ฟังก์ชันสำหรับสร้างเส้นทางโดยใช้อัลกอริทึม Dijkstra
+Route* find_shortest_path(Graph* graph, int src, int dest) {
+    return run_route_search(graph, src, dest, search_by_time, search_by_time_alt, NULL, 1.0f, 0.0f, NULL);
+}
+
 // ฟังก์ชันสำหรับค้นหาเส้นทางที่มีการจราจรน้อยที่สุด
 Route* find_least_congested_path(Graph* graph, int src, int dest) {
-    if (src < 0 || src >= graph->num_vertices ||
-        dest < 0 || dest >= graph->num_vertices) {
-        fprintf(stderr, "Error: Invalid vertex ID\n");
-        return NULL;
-    }
-    
-    float* congestion = (float*)malloc(graph->num_vertices * sizeof(float));
-    int* prev = (int*)malloc(graph->num_vertices * sizeof(int));
-    bool* visited = (bool*)malloc(graph->num_vertices * sizeof(bool));
-    
-    if (congestion == NULL || prev == NULL || visited == NULL) {
-        fprintf(stderr, "Error: Unable to allocate memory\n");
-        exit(1);
-    }
-    
-    for (int i = 0; i < graph->num_vertices; i++) {
-        congestion[i] = FLT_MAX;
-        prev[i] = -1;
-        visited[i] = false;
-    }
-    
-    congestion[src] = 0.0;
-    
-    MinHeap* heap = create_min_heap(graph->num_vertices);
-    
-    insert_min_heap(heap, src, 0.0, 0.0);
-    
-    while (heap->size > 0) {
-        HeapNode min = extract_min(heap);
-        int u = min.vertex;
-        
-        if (u == dest) {
-            break;
-        }
-        
-        if (visited[u]) {
-            continue;
-        }
-        
-        visited[u] = true;
-        
-        Edge* current = graph->vertices[u].head;
-        while (current != NULL) {
-            int v = current->dest;
-            
-            float road_congestion = (float)current->road->current_load / current->road->capacity;
-            if (road_congestion > 1.0) road_congestion = 1.0;
-            
-            float path_congestion = (congestion[u] > road_congestion) ? congestion[u] : road_congestion;
-            
-            if (!visited[v] && path_congestion < congestion[v]) {
-                congestion[v] = path_congestion;
-                prev[v] = u;
-                
-                if (is_in_heap(heap, v)) {
-                    update_dist_in_heap(heap, v, congestion[v], congestion[v]);
-                } else {
-                    insert_min_heap(heap, v, congestion[v], congestion[v]);
-                }
-            }
-            
-            current = current->next;
-        }
-    }
-    
-    Route* route = build_path(graph, prev, src, dest);
-    
-    free(congestion);
-    free(prev);
-    free(visited);
-    free_heap(heap);
-    
-    return route;
+    return run_route_search(graph, src, dest, search_by_congestion, NULL, NULL, 0.0f, 0.0f, NULL);
 }
 
 // ฟังก์ชันสำหรับค้นหาเส้นทางที่ใช้เวลาน้อยที่สุด
@@ -422,8 +455,8 @@ void print_route(Graph* graph, Route* route) {
                 if (current->dest == next_junction_id) {
                     printf("     Road to next intersection: Lanes=%d, Length=%.2f km, Speed Limit=%.2f km/h, Capacity=%d, Current Load=%d\n",
                            current->road->lanes, current->road->length, current->road->speed_limit,
-                           current->road->capacity, current->road->current_load);
-                    printf("     Travel Time: %.2f hours\n", current->weight);
+                           current->road->capacity, edge_load(graph, current));
+                    printf("     Travel Time: %.2f hours\n", edge_weight(graph, current));
                     break;
                 }
                 current = current->next;
@@ -496,88 +529,86 @@ void free_route(Route* route) {
         free(route->path);
     }
     
+    free(route->planned_cost);
     free(route);
 }
 
 // ฟังก์ชันสำหรับค้นหาเส้นทางที่ดีที่สุดโดยพิจารณาหลายปัจจัย
 Route* find_optimal_path(Graph* graph, int src, int dest, float time_weight, float distance_weight, float congestion_weight) {
-    if (src < 0 || src >= graph->num_vertices ||
-        dest < 0 || dest >= graph->num_vertices) {
-        fprintf(stderr, "Error: Invalid vertex ID\n");
-        return NULL;
-    }
-    
-    float* cost = (float*)malloc(graph->num_vertices * sizeof(float));
-    int* prev = (int*)malloc(graph->num_vertices * sizeof(int));
-    bool* visited = (bool*)malloc(graph->num_vertices * sizeof(bool));
-    
-    if (cost == NULL || prev == NULL || visited == NULL) {
-        fprintf(stderr, "Error: Unable to allocate memory\n");
+    RouteWeights weights = {time_weight, distance_weight, congestion_weight};
+    return run_route_search(graph, src, dest, search_by_weighted_cost, search_by_weighted_cost_alt,
+                            &weights, time_weight, distance_weight, NULL);
+}
+
+// ฟังก์ชันสำหรับสร้างตารางต้นทุนรวมของเส้นเชื่อมสำหรับชุดค่าน้ำหนักคงที่
+RouteCostTable* create_route_cost_table(Graph* graph, float time_weight, float distance_weight, float congestion_weight) {
+    RouteCostTable* table = (RouteCostTable*)malloc(sizeof(RouteCostTable));
+    if (table == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for route cost table\n");
         exit(1);
     }
     
-    for (int i = 0; i < graph->num_vertices; i++) {
-        cost[i] = FLT_MAX;
-        prev[i] = -1;
-        visited[i] = false;
-    }
-    
-    cost[src] = 0.0;
+    table->time_weight = time_weight;
+    table->distance_weight = distance_weight;
+    table->congestion_weight = congestion_weight;
+    table->num_edges = 0;
+    table->edge_cost = NULL;
     
-    MinHeap* heap = create_min_heap(graph->num_vertices);
+    refresh_route_cost_table(graph, table);
     
-    insert_min_heap(heap, src, 0.0, 0.0);
-    
-    while (heap->size > 0) {
-        HeapNode min = extract_min(heap);
-        int u = min.vertex;
-        
-        if (u == dest) {
-            break;
-        }
-        
-        if (visited[u]) {
-            continue;
+    return table;
+}
+
+// ฟังก์ชันสำหรับคำนวณต้นทุนรวมของเส้นเชื่อมใหม่ทั้งหมด
+void refresh_route_cost_table(Graph* graph, RouteCostTable* table) {
+    // ขยายตารางถ้ามีการเพิ่มเส้นเชื่อมหลังจากสร้างตาราง
+    if (graph->num_edges > table->num_edges) {
+        float* edge_cost = (float*)realloc(table->edge_cost, graph->num_edges * sizeof(float));
+        if (edge_cost == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for route cost table\n");
+            exit(1);
         }
-        
-        visited[u] = true;
-        
-        Edge* current = graph->vertices[u].head;
+        table->edge_cost = edge_cost;
+        table->num_edges = graph->num_edges;
+    }
+    
+    for (int i = 0; i < graph->num_vertices; i++) {
+        Edge* current = graph->vertices[i].head;
         while (current != NULL) {
-            int v = current->dest;
-            
-            float travel_time = current->weight;
-            float distance = current->road->length;
-            
-            float congestion = (float)current->road->current_load / current->road->capacity;
-            if (congestion > 1.0) congestion = 1.0;
-            
-            float total_cost = cost[u] +
-                              (time_weight * travel_time) +
-                              (distance_weight * distance) +
-                              (congestion_weight * congestion);
-            
-            if (!visited[v] && total_cost < cost[v]) {
-                cost[v] = total_cost;
-                prev[v] = u;
-                
-                if (is_in_heap(heap, v)) {
-                    update_dist_in_heap(heap, v, cost[v], cost[v]);
-                } else {
-                    insert_min_heap(heap, v, cost[v], cost[v]);
-                }
-            }
-            
+            refresh_route_cost(graph, table, current);
             current = current->next;
         }
     }
+}
+
+// ฟังก์ชันสำหรับคำนวณต้นทุนรวมของเส้นเชื่อมเดียว (เรียกเมื่อน้ำหนักหรือการจราจรบนถนนเปลี่ยน)
+void refresh_route_cost(const Graph* graph, RouteCostTable* table, Edge* edge) {
+    if (edge->id < 0 || edge->id >= table->num_edges) {
+        return;
+    }
+    
+    RouteWeights weights = {table->time_weight, table->distance_weight, table->congestion_weight};
+    table->edge_cost[edge->id] = weighted_edge_cost(graph, edge, &weights);
+}
+
+// ฟังก์ชันสำหรับค้นหาเส้นทางที่ดีที่สุดโดยใช้ตารางต้นทุนที่คำนวณไว้ล่วงหน้า
+// reuse คือเส้นทางเดิมที่ไม่ใช้แล้วสำหรับเก็บผลลัพธ์ (NULL = สร้างใหม่)
+Route* find_optimal_path_cached(Graph* graph, RouteCostTable* table, int src, int dest, Route* reuse) {
+    if (table->num_edges < graph->num_edges) {
+        refresh_route_cost_table(graph, table);
+    }
     
-    Route* route = build_path(graph, prev, src, dest);
+    return run_route_search(graph, src, dest, search_by_cost_table, search_by_cost_table_alt,
+                            table->edge_cost, table->time_weight, table->distance_weight, reuse);
+}
+
+// ฟังก์ชันสำหรับลบตารางต้นทุนและคืนหน่วยความจำ
+void free_route_cost_table(RouteCostTable* table) {
+    if (table == NULL) return;
     
-    free(cost);
-    free(prev);
-    free(visited);
-    free_heap(heap);
+    if (table->edge_cost != NULL) {
+        free(table->edge_cost);
+    }
     
-    return route;
+    free(table);
 }
@@ -13,11 +13,54 @@
      int length;         // จำนวนจุดยอดในเส้นทาง
      float total_time;   // เวลาการเดินทางทั้งหมด
      float total_distance; // ระยะทางทั้งหมด
+     int capacity;       // ขนาดของอาเรย์ path (ใช้เมื่อนำเส้นทางกลับมาใช้ใหม่)
+     float* planned_cost; // ต้นทุนสะสมตามแผนถึงแต่ละจุดยอด (ขนาด capacity, NULL = ไม่ได้บันทึก)
  } Route;
  
+ // ตารางต้นทุนรวมของเส้นเชื่อมสำหรับชุดค่าน้ำหนักคงที่ (เช่น 0.6, 0.2, 0.2 ที่ใช้ใน add_vehicle)
+ typedef struct {
+     float time_weight;       // ค่าน้ำหนักของเวลาการเดินทาง
+     float distance_weight;   // ค่าน้ำหนักของระยะทาง
+     float congestion_weight; // ค่าน้ำหนักของความหนาแน่น
+     int num_edges;           // จำนวนเส้นเชื่อมในตาราง
+     float* edge_cost;        // ต้นทุนรวมของแต่ละเส้นเชื่อม (ดัชนีตาม Edge.id)
+ } RouteCostTable;
+ 
+ // สมาชิกของฮีปสำหรับอัลกอริทึม Dijkstra
+ typedef struct {
+     int vertex;     // จุดยอด
+     float dist;     // ระยะทาง/เวลาจากจุดเริ่มต้น
+     float priority; // ค่าที่ใช้จัดลำดับ (ระยะทาง + ค่าฮิวริสติก)
+ } HeapNode;
+ 
+ // ฮีปแบบน้อยที่สุด (Min Heap)
+ typedef struct {
+     HeapNode* array;  // อาเรย์ของสมาชิกในฮีป
+     int capacity;     // ความจุของฮีป
+     int size;         // จำนวนสมาชิกในฮีปปัจจุบัน
+ } MinHeap;
+ 
  // ฟังก์ชันสำหรับสร้างเส้นทางใหม่
  Route* create_route(int capacity);
  
+ // ฟังก์ชันสำหรับสร้างฮีปใหม่
+ MinHeap* create_min_heap(int capacity);
+ 
+ // ฟังก์ชันสำหรับเพิ่มสมาชิกใหม่ลงในฮีป
+ void insert_min_heap(MinHeap* heap, int vertex, float dist, float priority);
+ 
+ // ฟังก์ชันสำหรับลบสมาชิกที่มีค่าน้อยที่สุดออกจากฮีป
+ HeapNode extract_min(MinHeap* heap);
+ 
+ // ฟังก์ชันสำหรับลบฮีปและคืนหน่วยความจำ
+ void free_heap(MinHeap* heap);
+ 
+ // ฟังก์ชันสำหรับสร้างเส้นทางจากอาเรย์ของจุดก่อนหน้า
+ Route* build_path(Graph* graph, int* prev, int src, int dest);
+ 
+ // ฟังก์ชันสำหรับสร้างเส้นทางลงในเส้นทางเดิม reuse (NULL = สร้างใหม่) เพื่อไม่ต้องจองหน่วยความจำใหม่
+ Route* build_path_reuse(Graph* graph, int* prev, int src, int dest, Route* reuse);
+ 
  // ฟังก์ชันสำหรับสร้างเส้นทางโดยใช้อัลกอริทึม Dijkstra
  Route* find_shortest_path(Graph* graph, int src, int dest);
  
@@ -30,6 +73,22 @@
  // ฟังก์ชันสำหรับค้นหาเส้นทางที่ดีที่สุดโดยพิจารณาหลายปัจจัย
  Route* find_optimal_path(Graph* graph, int src, int dest, float time_weight, float distance_weight, float congestion_weight);
  
+ // ฟังก์ชันสำหรับสร้างตารางต้นทุนรวมของเส้นเชื่อมสำหรับชุดค่าน้ำหนักคงที่
+ RouteCostTable* create_route_cost_table(Graph* graph, float time_weight, float distance_weight, float congestion_weight);
+ 
+ // ฟังก์ชันสำหรับคำนวณต้นทุนรวมของเส้นเชื่อมใหม่ทั้งหมด
+ void refresh_route_cost_table(Graph* graph, RouteCostTable* table);
+ 
+ // ฟังก์ชันสำหรับคำนวณต้นทุนรวมของเส้นเชื่อมเดียว (เรียกเมื่อน้ำหนักหรือการจราจรบนถนนเปลี่ยน)
+ void refresh_route_cost(const Graph* graph, RouteCostTable* table, Edge* edge);
+ 
+ // ฟังก์ชันสำหรับค้นหาเส้นทางที่ดีที่สุดโดยใช้ตารางต้นทุนที่คำนวณไว้ล่วงหน้า
+ // reuse คือเส้นทางเดิมที่ไม่ใช้แล้วสำหรับเก็บผลลัพธ์ (NULL = สร้างใหม่, ถ้าคืนค่า NULL ผู้เรียกยังเป็นเจ้าของ reuse)
+ Route* find_optimal_path_cached(Graph* graph, RouteCostTable* table, int src, int dest, Route* reuse);
+ 
+ // ฟังก์ชันสำหรับลบตารางต้นทุนและคืนหน่วยความจำ
+ void free_route_cost_table(RouteCostTable* table);
+ 
  // ฟังก์ชันสำหรับคำนวณเวลาการเดินทางของเส้นทาง
  float calculate_route_time(Graph* graph, Route* route);
  
@@ -4,9 +4,305 @@
 */
 
 #include "simulation.h"
+#include "reroute.h"
+#include "junction_queue.h"
+#include <string.h>
+
+// ฟังก์ชันสำหรับขยายอาเรย์ของคอลัมน์หนึ่งคอลัมน์
+static void* resize_column(void* column, size_t count, size_t element_size) {
+    void* resized = realloc(column, count * element_size);
+    if (resized == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for vehicles\n");
+        exit(1);
+    }
+    return resized;
+}
+
+// ฟังก์ชันสำหรับจองหรือขยายหน่วยความจำของคอลัมน์ข้อมูลยานพาหนะ
+static void resize_vehicle_store(VehicleStore* store, int capacity) {
+    size_t n = (size_t)capacity;
+    
+    store->current_pos = (int*)resize_column(store->current_pos, n, sizeof(int));
+    store->speed = (float*)resize_column(store->speed, n, sizeof(float));
+    store->road_end = (int*)resize_column(store->road_end, n, sizeof(int));
+    store->current_edge = (Edge**)resize_column(store->current_edge, n, sizeof(Edge*));
+    store->route_index = (int*)resize_column(store->route_index, n, sizeof(int));
+    store->completed = (bool*)resize_column(store->completed, n, sizeof(bool));
+    store->handle_index = (int*)resize_column(store->handle_index, n, sizeof(int));
+    store->trip_id = (long*)resize_column(store->trip_id, n, sizeof(long));
+    store->origin = (int*)resize_column(store->origin, n, sizeof(int));
+    store->destination = (int*)resize_column(store->destination, n, sizeof(int));
+    store->current_road = (int*)resize_column(store->current_road, n, sizeof(int));
+    store->entered_at = (int*)resize_column(store->entered_at, n, sizeof(int));
+    store->route = (Route**)resize_column(store->route, n, sizeof(Route*));
+    
+    // จำนวนตัวระบุที่ใช้งานและเส้นทางที่รอนำกลับมาใช้ไม่เกินขนาดของคอลัมน์
+    store->handle_slot = (int*)resize_column(store->handle_slot, n, sizeof(int));
+    store->handle_generation = (unsigned int*)resize_column(store->handle_generation, n, sizeof(unsigned int));
+    store->free_handles = (int*)resize_column(store->free_handles, n, sizeof(int));
+    store->spare_routes = (Route**)resize_column(store->spare_routes, n, sizeof(Route*));
+    
+    store->capacity = capacity;
+}
+
+// ฟังก์ชันสำหรับสร้างที่เก็บข้อมูลยานพาหนะ
+static void create_vehicle_store(VehicleStore* store, int capacity) {
+    memset(store, 0, sizeof(VehicleStore));
+    resize_vehicle_store(store, (capacity > 0) ? capacity : 1);
+}
+
+// ฟังก์ชันสำหรับคืนหน่วยความจำของคอลัมน์ข้อมูลยานพาหนะ (รวมเส้นทางที่รอนำกลับมาใช้)
+static void free_vehicle_store(VehicleStore* store) {
+    for (int i = 0; i < store->num_spare_routes; i++) {
+        free_route(store->spare_routes[i]);
+    }
+    
+    free(store->current_pos);
+    free(store->speed);
+    free(store->road_end);
+    free(store->current_edge);
+    free(store->route_index);
+    free(store->completed);
+    free(store->handle_index);
+    free(store->trip_id);
+    free(store->origin);
+    free(store->destination);
+    free(store->current_road);
+    free(store->entered_at);
+    free(store->route);
+    free(store->handle_slot);
+    free(store->handle_generation);
+    free(store->free_handles);
+    free(store->spare_routes);
+}
+
+// ฟังก์ชันสำหรับจองตัวระบุให้ยานพาหนะที่ตำแหน่ง position (ใช้ตัวระบุที่ว่างก่อน)
+static VehicleHandle acquire_vehicle_handle(VehicleStore* store, int position) {
+    int index;
+    if (store->num_free_handles > 0) {
+        index = store->free_handles[--store->num_free_handles];
+    } else {
+        index = store->num_handles++;
+        store->handle_generation[index] = 0;
+    }
+    
+    store->handle_slot[index] = position;
+    store->handle_index[position] = index;
+    
+    VehicleHandle handle = {index, store->handle_generation[index]};
+    return handle;
+}
+
+// ฟังก์ชันสำหรับคืนตัวระบุ (เพิ่มรุ่นเพื่อให้ตัวระบุเดิมใช้ไม่ได้)
+static void release_vehicle_handle(VehicleStore* store, int index) {
+    store->handle_slot[index] = -1;
+    store->handle_generation[index]++;
+    store->free_handles[store->num_free_handles++] = index;
+}
+
+// ฟังก์ชันสำหรับขยายที่เก็บยานพาหนะให้มีขนาดอย่างน้อย capacity (ใช้เมื่อกู้คืนสถานะจากไฟล์)
+void reserve_vehicle_store(TrafficSimulation* sim, int capacity) {
+    if (capacity > sim->vehicles.capacity) {
+        resize_vehicle_store(&sim->vehicles, capacity);
+    }
+}
+
+// ฟังก์ชันสำหรับหาเส้นเชื่อมจากทางแยก src ไปยังทางแยก dest
+static Edge* find_road_edge(Graph* graph, int src, int dest) {
+    Edge* edge = graph->vertices[src].head;
+    while (edge != NULL) {
+        if (edge->dest == dest) {
+            return edge;
+        }
+        edge = edge->next;
+    }
+    return NULL;
+}
+
+// ฟังก์ชันสำหรับนำยานพาหนะเข้าสู่ถนน (เพิ่มการจราจรและเก็บเส้นเชื่อมไว้ในคอลัมน์)
+static void enter_road(TrafficSimulation* sim, int position, Edge* edge) {
+    VehicleStore* store = &sim->vehicles;
+    
+    // เพิ่มการจราจรบนถนนนี้
+    change_road_load(sim->graph, edge, 1);
+    
+    // อัปเดตน้ำหนักของเส้นเชื่อม
+    refresh_edge_weight(sim->graph, edge);
+    refresh_route_cost(sim->graph, sim->route_costs, edge);
+    
+    store->current_edge[position] = edge;
+    store->current_road[position] = edge->dest;
+    store->road_end[position] = (int)(edge->road->length * 1000000); // กม. เป็น มม.
+    store->current_pos[position] = 0;
+    store->entered_at[position] = sim->time_step;
+}
+
+// ฟังก์ชันสำหรับนำยานพาหนะออกจากถนนที่อยู่ (ลดการจราจร)
+static void leave_road(TrafficSimulation* sim, int position) {
+    Edge* edge = sim->vehicles.current_edge[position];
+    if (edge == NULL) return;
+    
+    change_road_load(sim->graph, edge, -1);
+    
+    // อัปเดตน้ำหนักของเส้นเชื่อม
+    refresh_edge_weight(sim->graph, edge);
+    refresh_route_cost(sim->graph, sim->route_costs, edge);
+    
+    sim->vehicles.current_edge[position] = NULL;
+}
+
+// ฟังก์ชันสำหรับทำเครื่องหมายว่ายานพาหนะถึงจุดหมายแล้ว (ถูกบีบอัดออกเมื่อจบขั้นตอนเวลา)
+static void complete_vehicle(VehicleStore* store, int position) {
+    store->completed[position] = true;
+    store->speed[position] = 0.0f;
+}
+
+// ฟังก์ชันสำหรับบันทึกการเปลี่ยนแปลงจำนวนรถบนถนน (นำไปรวมเมื่อจบขั้นตอนเวลา)
+static void record_load_change(TickWorker* worker, Edge* edge, int delta) {
+    if (worker->num_changes >= worker->capacity) {
+        int new_capacity = (worker->capacity > 0) ? worker->capacity * 2 : 256;
+        LoadChange* changes = (LoadChange*)realloc(worker->changes, new_capacity * sizeof(LoadChange));
+        if (changes == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for load changes\n");
+            exit(1);
+        }
+        worker->changes = changes;
+        worker->capacity = new_capacity;
+    }
+    
+    worker->changes[worker->num_changes].edge = edge;
+    worker->changes[worker->num_changes].delta = delta;
+    worker->num_changes++;
+}
+
+// ฟังก์ชันสำหรับบันทึกยานพาหนะที่เพิ่งหยุดที่เส้นหยุด (นำเข้าคิวเมื่อจบการอัปเดตแบบขนาน)
+static void record_signal_arrival(TickWorker* worker, int position) {
+    if (worker->num_arrivals >= worker->arrivals_capacity) {
+        int new_capacity = (worker->arrivals_capacity > 0) ? worker->arrivals_capacity * 2 : 256;
+        int* arrivals = (int*)realloc(worker->arrivals, new_capacity * sizeof(int));
+        if (arrivals == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for signal arrivals\n");
+            exit(1);
+        }
+        worker->arrivals = arrivals;
+        worker->arrivals_capacity = new_capacity;
+    }
+    
+    worker->arrivals[worker->num_arrivals++] = position;
+}
+
+// ฟังก์ชันสำหรับล้างข้อมูลของเธรดก่อนเริ่มขั้นตอนเวลา
+void reset_tick_worker(TickWorker* worker) {
+    worker->num_changes = 0;
+    worker->completed = 0;
+    worker->first_completed = -1;
+    worker->num_arrivals = 0;
+}
+
+// ฟังก์ชันสำหรับรวมการเปลี่ยนแปลงจำนวนรถของเธรดเข้ากับถนน
+// refresh_edges = true จะอัปเดตน้ำหนักของเส้นเชื่อมที่เปลี่ยนทันที (ใช้เมื่อไม่ได้อยู่ใน update_simulation)
+void apply_load_changes(TrafficSimulation* sim, TickWorker* worker, bool refresh_edges) {
+    for (int i = 0; i < worker->num_changes; i++) {
+        Edge* edge = worker->changes[i].edge;
+        change_road_load(sim->graph, edge, worker->changes[i].delta);
+        
+        if (refresh_edges) {
+            refresh_edge_weight(sim->graph, edge);
+            refresh_route_cost(sim->graph, sim->route_costs, edge);
+        }
+    }
+    
+    sim->completed_vehicles += worker->completed;
+    worker->num_changes = 0;
+    worker->completed = 0;
+}
+
+// ฟังก์ชันสำหรับบีบอัดยานพาหนะที่ถูกทำเครื่องหมายออกจากคอลัมน์ (เริ่มตรวจที่ตำแหน่ง first)
+// คงลำดับของยานพาหนะที่เหลือไว้ และคืนตัวระบุกับเส้นทางของยานพาหนะที่ถูกนำออกให้ใช้ใหม่
+void compact_vehicles(TrafficSimulation* sim, int first) {
+    VehicleStore* store = &sim->vehicles;
+    int kept = first;
+    
+    for (int i = first; i < sim->num_vehicles; i++) {
+        if (store->completed[i]) {
+            release_vehicle_handle(store, store->handle_index[i]);
+            store->spare_routes[store->num_spare_routes++] = store->route[i];
+            continue;
+        }
+        
+        if (kept != i) {
+            store->current_pos[kept] = store->current_pos[i];
+            store->speed[kept] = store->speed[i];
+            store->road_end[kept] = store->road_end[i];
+            store->current_edge[kept] = store->current_edge[i];
+            store->route_index[kept] = store->route_index[i];
+            store->completed[kept] = false;
+            store->handle_index[kept] = store->handle_index[i];
+            store->trip_id[kept] = store->trip_id[i];
+            store->origin[kept] = store->origin[i];
+            store->destination[kept] = store->destination[i];
+            store->current_road[kept] = store->current_road[i];
+            store->entered_at[kept] = store->entered_at[i];
+            store->route[kept] = store->route[i];
+            store->handle_slot[store->handle_index[kept]] = kept;
+        }
+        kept++;
+    }
+    
+    sim->num_vehicles = kept;
+}
+
+// ฟังก์ชันสำหรับหาตำแหน่งของยานพาหนะจากตัวระบุ (-1 = ตัวระบุใช้ไม่ได้แล้ว)
+int vehicle_position(const TrafficSimulation* sim, VehicleHandle handle) {
+    const VehicleStore* store = &sim->vehicles;
+    if (handle.index < 0 || handle.index >= store->num_handles ||
+        store->handle_generation[handle.index] != handle.generation) {
+        return -1;
+    }
+    return store->handle_slot[handle.index];
+}
+
+// ฟังก์ชันสำหรับคำนวณตัวคูณความเร็วของผู้ขับขี่บนถนนลำดับที่ route_index ของเส้นทาง
+// ใช้หมายเลขการเดินทางเป็นกระแสของเลขสุ่ม จึงได้ค่าเดียวกันไม่ว่าจะอัปเดตยานพาหนะจากเธรดใด
+static inline float driver_speed_factor(const TrafficSimulation* sim, int position, int route_index) {
+    if (sim->config.speed_variation <= 0.0f) {
+        return 1.0f;
+    }
+    
+    double u = random_double(sim->config.seed, (uint64_t)sim->vehicles.trip_id[position], (uint64_t)route_index);
+    return 1.0f + sim->config.speed_variation * (float)(2.0 * u - 1.0);
+}
+
+// ฟังก์ชันสำหรับอ่านการตั้งค่าเริ่มต้นของการจำลอง
+SimulationConfig default_simulation_config(void) {
+    SimulationConfig config;
+    config.seed = DEFAULT_SIMULATION_SEED;
+    config.initial_capacity = 64;
+    config.num_threads = 1;
+    config.speed_variation = 0.0f;
+    config.dt = 1.0f;
+    config.reroute_interval = 0;
+    config.reroute_threshold = 0.25f;
+    config.signal_gating = false;
+    return config;
+}
 
 // ฟังก์ชันสำหรับสร้างการจำลองระบบการจราจรใหม่
-TrafficSimulation* create_simulation(Graph* graph, SignalSystem* signal_system, int max_vehicles) {
+TrafficSimulation* create_simulation(Graph* graph, SignalSystem* signal_system, int initial_capacity) {
+    SimulationConfig config = default_simulation_config();
+    config.initial_capacity = initial_capacity;
+    
+    return create_simulation_with_config(graph, signal_system, &config);
+}
+
+// ฟังก์ชันสำหรับสร้างการจำลองระบบการจราจรใหม่ตามการตั้งค่า
+TrafficSimulation* create_simulation_with_config(Graph* graph, SignalSystem* signal_system,
+                                                 const SimulationConfig* config) {
+    if (config->dt <= 0.0f) {
+        fprintf(stderr, "Error: Time step must be greater than 0\n");
+        return NULL;
+    }
+    
     TrafficSimulation* sim = (TrafficSimulation*)malloc(sizeof(TrafficSimulation));
     if (sim == NULL) {
         fprintf(stderr, "Error: Unable to allocate memory for simulation\n");
@@ -15,206 +311,434 @@ TrafficSimulation* create_simulation(Graph* graph, SignalSystem* signal_system,
     
     sim->graph = graph;
     sim->signal_system = signal_system;
+    sim->config = *config;
+    sim->route_costs = create_route_cost_table(graph,
+                                               VEHICLE_ROUTE_TIME_WEIGHT,
+                                               VEHICLE_ROUTE_DISTANCE_WEIGHT,
+                                               VEHICLE_ROUTE_CONGESTION_WEIGHT);
     
-    sim->vehicles = (Vehicle*)malloc(max_vehicles * sizeof(Vehicle));
-    if (sim->vehicles == NULL && max_vehicles > 0) {
-        fprintf(stderr, "Error: Unable to allocate memory for vehicles\n");
-        free(sim);
-        exit(1);
-    }
+    create_vehicle_store(&sim->vehicles, config->initial_capacity);
     
     sim->num_vehicles = 0;
-    sim->max_vehicles = max_vehicles;
+    sim->total_vehicles = 0;
+    sim->completed_vehicles = 0;
+    sim->vehicle_updates = 0;
+    sim->route_queries = 0;
+    sim->next_trip_id = 0;
+    sim->traffic_counter = 0;
     sim->time_step = 0;
+    sim->step_scale = config->dt * 1000000.0f / 3600.0f; // กม./ชม. เป็น มม. ต่อขั้นตอนเวลา
+    sim->signal_seconds = 0;
     sim->is_running = false;
-    
-    // ตั้งค่าเริ่มต้นสำหรับเลขสุ่ม
-    srand((unsigned int)time(NULL));
+    sim->pool = NULL;
+    sim->workers = NULL;
+    sim->num_workers = 0;
+    memset(&sim->reroute_last, 0, sizeof(RerouteStats));
+    memset(&sim->reroute_total, 0, sizeof(RerouteStats));
+    sim->reroute_workspace = NULL;
+    sim->junction_queues = (config->signal_gating && signal_system != NULL)
+                               ? create_junction_queues(graph, signal_system, config->dt)
+                               : NULL;
+    set_simulation_threads(sim, config->num_threads);
     
     return sim;
 }
 
-// ฟังก์ชันสำหรับสร้างยานพาหนะใหม่ในการจำลอง
-int add_vehicle(TrafficSimulation* sim, int origin, int destination) {
-    if (sim->num_vehicles >= sim->max_vehicles) {
-        fprintf(stderr, "Error: Cannot add vehicle because limit exceeded\n");
-        return -1;
-    }
+// ฟังก์ชันสำหรับสร้างยานพาหนะใหม่ในการจำลอง (คืนค่าตัวระบุที่มี index = -1 ถ้าไม่สำเร็จ)
+VehicleHandle add_vehicle(TrafficSimulation* sim, int origin, int destination) {
+    VehicleHandle none = {-1, 0};
     
     if (origin < 0 || origin >= sim->graph->num_vertices ||
         destination < 0 || destination >= sim->graph->num_vertices) {
         fprintf(stderr, "Error: Invalid vertex ID\n");
-        return -1;
+        return none;
     }
     
-    // สร้างยานพาหนะใหม่
-    int vehicle_id = sim->num_vehicles;
+    VehicleStore* store = &sim->vehicles;
     
-    sim->vehicles[vehicle_id].id = vehicle_id;
-    sim->vehicles[vehicle_id].origin = origin;
-    sim->vehicles[vehicle_id].destination = destination;
+    // ขยายที่เก็บเป็นสองเท่าเมื่อเต็ม
+    if (sim->num_vehicles >= store->capacity) {
+        resize_vehicle_store(store, store->capacity * 2);
+    }
     
-    // หาเส้นทางที่ดีที่สุด
-    sim->vehicles[vehicle_id].route = find_optimal_path(
-        sim->graph, origin, destination, 0.6, 0.2, 0.2);
+    // หาเส้นทางที่ดีที่สุด (ใช้หน่วยความจำของเส้นทางเก่าถ้ามี)
+    Route* spare = (store->num_spare_routes > 0) ? store->spare_routes[--store->num_spare_routes] : NULL;
+    Route* route = find_optimal_path_cached(sim->graph, sim->route_costs, origin, destination, spare);
+    sim->route_queries++;
     
-    if (sim->vehicles[vehicle_id].route == NULL) {
+    if (route == NULL) {
+        if (spare != NULL) {
+            store->spare_routes[store->num_spare_routes++] = spare;
+        }
         fprintf(stderr, "Error: Unable to find route\n");
-        return -1;
+        return none;
+    }
+    
+    // บันทึกต้นทุนตามแผนไว้เทียบเมื่อตรวจเส้นทางระหว่างเดินทาง
+    if (sim->config.reroute_interval > 0) {
+        record_planned_cost(sim->graph, sim->route_costs, route);
     }
     
+    // สร้างยานพาหนะใหม่ที่ท้ายคอลัมน์
+    int position = sim->num_vehicles;
+    VehicleHandle handle = acquire_vehicle_handle(store, position);
+    
+    store->trip_id[position] = sim->next_trip_id++;
+    store->origin[position] = origin;
+    store->destination[position] = destination;
+    store->route[position] = route;
+    
     // ตั้งค่าเริ่มต้น
-    sim->vehicles[vehicle_id].route_index = 0;
-    sim->vehicles[vehicle_id].current_road = -1;
-    sim->vehicles[vehicle_id].current_pos = 0;
-    sim->vehicles[vehicle_id].speed = 0.0;
-    sim->vehicles[vehicle_id].completed = false;
+    store->route_index[position] = 0;
+    store->current_edge[position] = NULL;
+    store->current_road[position] = -1;
+    store->entered_at[position] = sim->time_step;
+    store->road_end[position] = 0;
+    store->current_pos[position] = 0;
+    store->speed[position] = 0.0f;
+    store->completed[position] = false;
+    
+    sim->num_vehicles++;
+    sim->total_vehicles++;
     
     // เพิ่มยานพาหนะลงบนถนนแรกในเส้นทาง
-    if (sim->vehicles[vehicle_id].route->length > 1) {
-        int src = sim->vehicles[vehicle_id].route->path[0];
-        int dest = sim->vehicles[vehicle_id].route->path[1];
-        
-        // หาเส้นเชื่อมไปยังทางแยกถัดไป
-        Edge* current = sim->graph->vertices[src].head;
-        while (current != NULL) {
-            if (current->dest == dest) {
-                // เพิ่มการจราจรบนถนนนี้
-                current->road->current_load++;
-                
-                // อัปเดตน้ำหนักของเส้นเชื่อม
-                current->weight = calculate_travel_time(current->road);
-                
-                // ตั้งค่าถนนปัจจุบัน
-                sim->vehicles[vehicle_id].current_road = dest;
-                
-                // ตั้งค่าความเร็วเริ่มต้น
-                sim->vehicles[vehicle_id].speed = current->road->speed_limit;
-                
-                break;
-            }
-            current = current->next;
+    if (route->length > 1) {
+        Edge* edge = find_road_edge(sim->graph, route->path[0], route->path[1]);
+        if (edge != NULL) {
+            enter_road(sim, position, edge);
+            
+            // ตั้งค่าความเร็วเริ่มต้น
+            store->speed[position] = edge->road->speed_limit * driver_speed_factor(sim, position, 1);
         }
         
-        sim->vehicles[vehicle_id].route_index = 1;
+        store->route_index[position] = 1;
     } else {
-        // หากเส้นทางมีเพียงจุดเดียว (origin = destination)
-        sim->vehicles[vehicle_id].completed = true;
+        // หากเส้นทางมีเพียงจุดเดียว (origin = destination) ถึงจุดหมายทันที
+        complete_vehicle(store, position);
+        sim->completed_vehicles++;
+        compact_vehicles(sim, position);
     }
     
-    sim->num_vehicles++;
+    return handle;
+}
+
+// ฟังก์ชันสำหรับตรวจสอบว่าตัวระบุยังชี้ไปยังยานพาหนะที่กำลังเดินทางหรือไม่
+bool vehicle_handle_valid(const TrafficSimulation* sim, VehicleHandle handle) {
+    return vehicle_position(sim, handle) >= 0;
+}
+
+// ฟังก์ชันสำหรับอ่านตัวระบุของยานพาหนะที่ตำแหน่ง position ในที่เก็บ
+VehicleHandle get_vehicle_handle(const TrafficSimulation* sim, int position) {
+    VehicleHandle handle = {-1, 0};
+    if (position < 0 || position >= sim->num_vehicles) {
+        return handle;
+    }
+    
+    handle.index = sim->vehicles.handle_index[position];
+    handle.generation = sim->vehicles.handle_generation[handle.index];
+    return handle;
+}
+
+// ฟังก์ชันสำหรับอ่านข้อมูลของยานพาหนะหนึ่งคัน (คืนค่า false ถ้าตัวระบุใช้ไม่ได้แล้ว)
+bool get_vehicle(const TrafficSimulation* sim, VehicleHandle handle, Vehicle* vehicle) {
+    int position = vehicle_position(sim, handle);
+    if (position < 0) {
+        return false;
+    }
+    
+    const VehicleStore* store = &sim->vehicles;
+    vehicle->id = handle.index;
+    vehicle->origin = store->origin[position];
+    vehicle->destination = store->destination[position];
+    vehicle->current_road = store->current_road[position];
+    vehicle->current_pos = store->current_pos[position] / 1000.0;
+    vehicle->speed = store->speed[position];
+    vehicle->route = store->route[position];
+    vehicle->route_index = store->route_index[position];
+    vehicle->completed = store->completed[position];
+    
+    return true;
+}
+
+// ฟังก์ชันสำหรับเลื่อนตำแหน่งของยานพาหนะในช่วง [begin, end) ไปหนึ่งขั้นตอนเวลา
+// อ่านและเขียนเฉพาะคอลัมน์ความเร็วและตำแหน่ง จึงเป็นลูปบนอาเรย์ต่อเนื่องที่คอมไพเลอร์ทำ vectorize ได้
+// ยานพาหนะที่ไม่ได้อยู่บนถนนหรือถึงจุดหมายแล้วมีความเร็วเป็น 0 จึงไม่ต้องตรวจสอบเงื่อนไขในลูป
+static void move_vehicles(VehicleStore* store, float step_scale, int begin, int end) {
+    int* restrict current_pos = store->current_pos;
+    const float* restrict speed = store->speed;
+    
+    for (int i = begin; i < end; i++) {
+        current_pos[i] += vehicle_step_mm(speed[i], step_scale);
+    }
+}
+
+// ฟังก์ชันสำหรับย้ายยานพาหนะไปยังถนนถัดไปเมื่อถึงปลายถนนปัจจุบัน
+// ไม่เขียนข้อมูลของถนนโดยตรง แต่บันทึกการเปลี่ยนแปลงจำนวนรถไว้ใน worker จึงเรียกจากหลายเธรดพร้อมกันได้
+// คืนค่า true ถ้ายานพาหนะถึงจุดหมายแล้ว
+bool advance_vehicle(TrafficSimulation* sim, TickWorker* worker, int position) {
+    VehicleStore* store = &sim->vehicles;
+    Edge* current_edge = store->current_edge[position];
+    int dest = current_edge->dest;
+    
+    // ลดการจราจรบนถนนปัจจุบัน
+    record_load_change(worker, current_edge, -1);
+    store->current_edge[position] = NULL;
+    
+    // ถ้าถึงจุดหมายปลายทางแล้ว หรือไม่มีถนนถัดไป
+    Route* route = store->route[position];
+    int route_index = ++store->route_index[position];
+    
+    if (dest == store->destination[position] || route_index >= route->length) {
+        complete_vehicle(store, position);
+        worker->completed++;
+        if (worker->first_completed < 0 || position < worker->first_completed) {
+            worker->first_completed = position;
+        }
+        return true;
+    }
+    
+    // หาถนนถัดไป
+    Edge* next_edge = find_road_edge(sim->graph, dest, route->path[route_index]);
+    
+    if (next_edge == NULL) {
+        fprintf(stderr, "Error: Next road not found\n");
+        store->speed[position] = 0.0f;
+        return false;
+    }
+    
+    // เพิ่มการจราจรบนถนนถัดไปและอัปเดตตำแหน่งปัจจุบัน
+    record_load_change(worker, next_edge, 1);
+    store->current_edge[position] = next_edge;
+    store->current_road[position] = next_edge->dest;
+    store->road_end[position] = (int)(next_edge->road->length * 1000000);
+    store->current_pos[position] = 0;
+    store->entered_at[position] = sim->time_step;
+    
+    // ปรับความเร็วตามความเร็วจำกัดของถนนใหม่
+    float speed = next_edge->road->speed_limit;
     
-    return vehicle_id;
+    // ปรับความเร็วตามความหนาแน่นของการจราจร ณ ต้นขั้นตอนเวลา (รวมยานพาหนะคันนี้)
+    float congestion = (float)(edge_load(sim->graph, next_edge) + 1) / next_edge->road->capacity;
+    if (congestion > 1.0) congestion = 1.0;
+    
+    // ลดความเร็วตามความหนาแน่น
+    speed *= (1.0 - 0.7 * congestion);
+    store->speed[position] = speed * driver_speed_factor(sim, position, route_index);
+    
+    return false;
+}
+
+// ฟังก์ชันสำหรับตรวจสอบว่ายานพาหนะต้องเปลี่ยนถนนหรือไม่
+static inline bool vehicle_at_road_end(const VehicleStore* store, int position) {
+    return !store->completed[position] && store->current_edge[position] != NULL &&
+           store->current_pos[position] >= store->road_end[position];
+}
+
+// ฟังก์ชันสำหรับตรวจสอบว่ายานพาหนะต้องรอไฟเขียวที่ปลายถนนหรือไม่ (ยานพาหนะที่ถึงจุดหมายที่ทางแยกนี้ไม่ต้องรอ)
+static inline bool stops_at_signal(const TrafficSimulation* sim, int position) {
+    const VehicleStore* store = &sim->vehicles;
+    const Edge* edge = store->current_edge[position];
+    return signal_approach_of(sim->junction_queues, edge) >= 0 && edge->dest != store->destination[position] &&
+           store->route_index[position] + 1 < store->route[position]->length;
+}
+
+// ฟังก์ชันสำหรับหยุดยานพาหนะที่เส้นหยุด (ตำแหน่งอยู่ที่ปลายถนน ความเร็วเป็น 0 และรอถูกปล่อยจากคิว)
+static void hold_at_stop_line(VehicleStore* store, TickWorker* worker, int position) {
+    store->current_pos[position] = store->road_end[position];
+    store->road_end[position] = ROAD_END_WAITING;
+    store->speed[position] = 0.0f;
+    record_signal_arrival(worker, position);
+}
+
+// ฟังก์ชันสำหรับเปรียบเทียบตำแหน่งของยานพาหนะ (ใช้กับ qsort)
+static int compare_positions(const void* a, const void* b) {
+    return *(const int*)a - *(const int*)b;
+}
+
+// ฟังก์ชันสำหรับนำยานพาหนะที่เพิ่งหยุดของทุกเธรดเข้าคิวของถนนขาเข้า
+// เรียงตามตำแหน่งในที่เก็บก่อน ลำดับในคิวจึงเหมือนกันทุกจำนวนเธรด
+static void queue_signal_arrivals(TrafficSimulation* sim) {
+    TickWorker* first = &sim->workers[0];
+    for (int w = 1; w < sim->num_workers; w++) {
+        TickWorker* worker = &sim->workers[w];
+        for (int k = 0; k < worker->num_arrivals; k++) {
+            record_signal_arrival(first, worker->arrivals[k]);
+        }
+        worker->num_arrivals = 0;
+    }
+    if (sim->num_workers > 1 && first->num_arrivals > 1) {
+        qsort(first->arrivals, first->num_arrivals, sizeof(int), compare_positions);
+    }
+    
+    for (int k = 0; k < first->num_arrivals; k++) {
+        int position = first->arrivals[k];
+        int approach = signal_approach_of(sim->junction_queues, sim->vehicles.current_edge[position]);
+        push_approach_vehicle(sim->junction_queues, approach, get_vehicle_handle(sim, position));
+    }
+    first->num_arrivals = 0;
+}
+
+// ฟังก์ชันสำหรับนำยานพาหนะที่เพิ่งหยุดเข้าคิว แล้วปล่อยยานพาหนะจากคิวของเฟสที่เป็นไฟเขียว
+// ทำงานแบบลำดับหลังการอัปเดตแบบขนาน ใช้เวลาตามจำนวนยานพาหนะที่หยุดและถูกปล่อย ไม่ใช่จำนวนยานพาหนะทั้งหมด
+static void serve_signal_queues(TrafficSimulation* sim) {
+    queue_signal_arrivals(sim);
+    
+    TickWorker* worker = &sim->workers[0];
+    release_green_approaches(sim, worker);
+    apply_load_changes(sim, worker, false);
+}
+
+// ฟังก์ชันสำหรับอัปเดตยานพาหนะในช่วง [begin, end) หนึ่งขั้นตอนเวลา (ทำงานในแต่ละเธรด)
+static void update_vehicle_range(void* ctx, int worker, int begin, int end) {
+    TrafficSimulation* sim = (TrafficSimulation*)ctx;
+    TickWorker* tick_worker = &sim->workers[worker];
+    
+    // เลื่อนตำแหน่งก่อน (ไม่ขึ้นกับการจราจร) แล้วจึงย้ายยานพาหนะที่ถึงปลายถนน
+    move_vehicles(&sim->vehicles, sim->step_scale, begin, end);
+    
+    for (int i = begin; i < end; i++) {
+        if (vehicle_at_road_end(&sim->vehicles, i)) {
+            if (sim->junction_queues != NULL && stops_at_signal(sim, i)) {
+                hold_at_stop_line(&sim->vehicles, tick_worker, i);
+            } else {
+                advance_vehicle(sim, tick_worker, i);
+            }
+        }
+    }
 }
 
 // ฟังก์ชันสำหรับอัปเดตตำแหน่งของยานพาหนะ
-void update_vehicle(TrafficSimulation* sim, int vehicle_id) {
-    if (vehicle_id < 0 || vehicle_id >= sim->num_vehicles) {
+void update_vehicle(TrafficSimulation* sim, VehicleHandle handle) {
+    int position = vehicle_position(sim, handle);
+    if (position < 0) {
         fprintf(stderr, "Error: Invalid vehicle ID\n");
         return;
     }
     
-    Vehicle* vehicle = &sim->vehicles[vehicle_id];
+    TickWorker* worker = &sim->workers[0];
+    reset_tick_worker(worker);
     
-    // ถ้ายานพาหนะถึงจุดหมายแล้ว ไม่ต้องอัปเดต
-    if (vehicle->completed) {
-        return;
+    update_vehicle_range(sim, 0, position, position + 1);
+    if (sim->junction_queues != NULL) {
+        queue_signal_arrivals(sim);
     }
+    apply_load_changes(sim, worker, true);
     
-    // ถ้ายานพาหนะยังไม่ได้อยู่บนถนน (เพิ่งสร้าง) ไม่ต้องอัปเดต
-    if (vehicle->current_road == -1) {
-        return;
+    if (worker->first_completed >= 0) {
+        compact_vehicles(sim, worker->first_completed);
+    }
+}
+
+// ฟังก์ชันสำหรับนำยานพาหนะออกจากการจำลอง (ลดการจราจรบนถนนที่อยู่และคืนช่องให้ใช้ใหม่)
+bool remove_vehicle(TrafficSimulation* sim, VehicleHandle handle) {
+    int position = vehicle_position(sim, handle);
+    if (position < 0) {
+        return false;
     }
     
-    // หาถนนปัจจุบันที่ยานพาหนะกำลังเดินทาง
-    int current_junction_idx = vehicle->route_index - 1;
-    int src = vehicle->route->path[current_junction_idx];
-    int dest = vehicle->route->path[current_junction_idx + 1];
-    
-    Edge* current_edge = NULL;
-    Edge* edge = sim->graph->vertices[src].head;
+    leave_road(sim, position);
+    sim->vehicles.completed[position] = true;
+    compact_vehicles(sim, position);
     
-    while (edge != NULL) {
-        if (edge->dest == dest) {
-            current_edge = edge;
-            break;
+    return true;
+}
+
+// ฟังก์ชันสำหรับนำยานพาหนะทั้งหมดออกและล้างตัวนับ (เริ่มช่วงการจำลองใหม่บนเครือข่ายเดิม)
+void clear_vehicles(TrafficSimulation* sim) {
+    for (int i = 0; i < sim->num_vehicles; i++) {
+        leave_road(sim, i);
+        sim->vehicles.completed[i] = true;
+    }
+    compact_vehicles(sim, 0);
+    
+    // ล้างคิวรอไฟเขียว (ตัวระบุในคิวชี้ไปยังยานพาหนะที่ถูกนำออกแล้ว)
+    if (sim->junction_queues != NULL) {
+        for (int a = 0; a < sim->junction_queues->num_approaches; a++) {
+            SignalApproach* approach = &sim->junction_queues->approaches[a];
+            approach->head = 0;
+            approach->count = 0;
+            approach->credit = 0.0f;
         }
-        edge = edge->next;
     }
     
-    if (current_edge == NULL) {
-        fprintf(stderr, "Error: Current road not found\n");
-        return;
+    sim->total_vehicles = 0;
+    sim->completed_vehicles = 0;
+}
+
+// ฟังก์ชันสำหรับกำหนดจำนวนเธรดที่ใช้อัปเดตยานพาหนะ (1 = แบบลำดับ, 0 = ใช้จำนวนแกนของเครื่อง)
+// ผลรวมของการจำลองเหมือนกันทุกจำนวนเธรด เพราะการจราจรบนถนนถูกรวมเมื่อจบขั้นตอนเวลาเสมอ
+void set_simulation_threads(TrafficSimulation* sim, int num_threads) {
+    if (num_threads <= 0) {
+        num_threads = available_cpu_count();
     }
     
-    // คำนวณการเคลื่อนที่ของยานพาหนะ (ระยะทางต่อวินาที)
-    float distance_per_second = vehicle->speed / 3600.0; // กม./ชม. เป็น กม./วินาที
+    free_thread_pool(sim->pool);
+    sim->pool = (num_threads > 1) ? create_thread_pool(num_threads) : NULL;
     
-    // เพิ่มตำแหน่งปัจจุบัน
-    vehicle->current_pos += (int)(distance_per_second * 1000); // เป็นเมตร
+    for (int w = 0; w < sim->num_workers; w++) {
+        free(sim->workers[w].changes);
+        free(sim->workers[w].arrivals);
+    }
+    free(sim->workers);
     
-    // ถ้าถึงปลายทางของถนนปัจจุบัน
-    if (vehicle->current_pos >= (int)(current_edge->road->length * 1000)) {
-        // ลดการจราจรบนถนนปัจจุบัน
-        current_edge->road->current_load--;
-        
-        // อัปเดตน้ำหนักของเส้นเชื่อม
-        current_edge->weight = calculate_travel_time(current_edge->road);
-        
-        // ถ้าถึงจุดหมายปลายทางแล้ว
-        if (dest == vehicle->destination) {
-            vehicle->completed = true;
-            return;
-        }
-        
-        // เลื่อนไปยังถนนถัดไปในเส้นทาง
-        vehicle->route_index++;
-        
-        // ถ้าไม่มีถนนถัดไป (ถึงจุดหมายปลายทางแล้ว)
-        if (vehicle->route_index >= vehicle->route->length) {
-            vehicle->completed = true;
-            return;
-        }
-        
-        // หาถนนถัดไป
-        int next_src = dest;
-        int next_dest = vehicle->route->path[vehicle->route_index];
-        
-        Edge* next_edge = NULL;
-        edge = sim->graph->vertices[next_src].head;
-        
-        while (edge != NULL) {
-            if (edge->dest == next_dest) {
-                next_edge = edge;
-                break;
-            }
-            edge = edge->next;
-        }
-        
-        if (next_edge == NULL) {
-            fprintf(stderr, "Error: Next road not found\n");
-            return;
+    sim->workers = (TickWorker*)aligned_alloc(alignof(TickWorker), num_threads * sizeof(TickWorker));
+    if (sim->workers == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for simulation workers\n");
+        exit(1);
+    }
+    
+    for (int w = 0; w < num_threads; w++) {
+        sim->workers[w].changes = NULL;
+        sim->workers[w].capacity = 0;
+        sim->workers[w].arrivals = NULL;
+        sim->workers[w].arrivals_capacity = 0;
+        reset_tick_worker(&sim->workers[w]);
+    }
+    sim->num_workers = num_threads;
+}
+
+// ฟังก์ชันสำหรับอัปเดตสัญญาณไฟให้ทันเวลาปัจจุบันของการจำลอง (หนึ่งครั้งต่อวินาทีที่ผ่านไป)
+void sync_signal_clock(TrafficSimulation* sim) {
+    // บวกค่าเล็กน้อยเพื่อไม่ให้ผลคูณของ dt ที่ปัดเศษลงเล็กน้อย (เช่น 10 × 0.7) ตกไปเป็นวินาทีก่อนหน้า
+    int seconds = (int)(simulation_seconds(sim) + 1e-6) - sim->signal_seconds;
+    if (seconds <= 0) {
+        return;
+    }
+    
+    if (sim->signal_system != NULL) {
+        advance_signal_system(sim->graph, sim->signal_system, seconds);
+    }
+    sim->signal_seconds += seconds;
+}
+
+// ฟังก์ชันสำหรับเลื่อนยานพาหนะทุกคันไปหนึ่งขั้นตอนเวลา (ไม่รวมสัญญาณไฟและน้ำหนักของเส้นเชื่อม)
+static void step_vehicles(TrafficSimulation* sim) {
+    // อัปเดตยานพาหนะทุกคัน (แบ่งเป็นก้อนให้แต่ละเธรด)
+    for (int w = 0; w < sim->num_workers; w++) {
+        reset_tick_worker(&sim->workers[w]);
+    }
+    sim->vehicle_updates += sim->num_vehicles;
+    parallel_for(sim->pool, sim->num_vehicles, VEHICLE_CHUNK_SIZE, update_vehicle_range, sim);
+    
+    // รวมการเปลี่ยนแปลงจำนวนรถของทุกเธรด (ผลบวกไม่ขึ้นกับลำดับ จึงเหมือนกับการทำงานแบบลำดับ)
+    int first_completed = -1;
+    for (int w = 0; w < sim->num_workers; w++) {
+        TickWorker* worker = &sim->workers[w];
+        if (worker->first_completed >= 0 &&
+            (first_completed < 0 || worker->first_completed < first_completed)) {
+            first_completed = worker->first_completed;
         }
-        
-        // เพิ่มการจราจรบนถนนถัดไป
-        next_edge->road->current_load++;
-        
-        // อัปเดตน้ำหนักของเส้นเชื่อม
-        next_edge->weight = calculate_travel_time(next_edge->road);
-        
-        // อัปเดตตำแหน่งปัจจุบัน
-        vehicle->current_road = next_dest;
-        vehicle->current_pos = 0;
-        
-        // ปรับความเร็วตามความเร็วจำกัดของถนนใหม่
-        vehicle->speed = next_edge->road->speed_limit;
-        
-        // ปรับความเร็วตามความหนาแน่นของการจราจร
-        float congestion = (float)next_edge->road->current_load / next_edge->road->capacity;
-        if (congestion > 1.0) congestion = 1.0;
-        
-        // ลดความเร็วตามความหนาแน่น
-        vehicle->speed *= (1.0 - 0.7 * congestion);
+        apply_load_changes(sim, worker, false);
+    }
+    
+    // ยานพาหนะที่รอไฟเขียวถูกปล่อยก่อนบีบอัด เพราะตำแหน่งของยานพาหนะที่เพิ่งหยุดยังไม่เปลี่ยน
+    if (sim->junction_queues != NULL) {
+        serve_signal_queues(sim);
+    }
+    
+    // นำยานพาหนะที่ถึงจุดหมายออกจากชุดที่กำลังเดินทาง
+    if (first_completed >= 0) {
+        compact_vehicles(sim, first_completed);
     }
 }
 
@@ -227,16 +751,48 @@ void update_simulation(TrafficSimulation* sim) {
     // เพิ่มขั้นตอนเวลา
     sim->time_step++;
     
-    // อัปเดตระบบสัญญาณไฟจราจร
-    update_signal_system(sim->graph, sim->signal_system);
+    // อัปเดตระบบสัญญาณไฟจราจร (เมื่อผ่านไปครบวินาที)
+    sync_signal_clock(sim);
     
-    // อัปเดตยานพาหนะทุกคัน
-    for (int i = 0; i < sim->num_vehicles; i++) {
-        update_vehicle(sim, i);
-    }
+    step_vehicles(sim);
     
     // อัปเดตน้ำหนักของเส้นเชื่อมทั้งหมด
     update_edge_weight(sim->graph);
+    refresh_route_cost_table(sim->graph, sim->route_costs);
+    
+    // ตรวจและเปลี่ยนเส้นทางของยานพาหนะที่เส้นทางแย่ลง
+    if (sim->config.reroute_interval > 0 && sim->time_step % sim->config.reroute_interval == 0) {
+        reroute_vehicles(sim);
+    }
+}
+
+// ฟังก์ชันสำหรับเร่งการจำลองไปข้างหน้า num_ticks ขั้นตอนเวลาในครั้งเดียว
+// น้ำหนักของเส้นเชื่อมใช้เฉพาะตอนหาเส้นทาง ซึ่งไม่เกิดขึ้นระหว่างการเร่ง จึงอัปเดตครั้งเดียวตอนจบ
+// ถ้าสัญญาณไฟไม่ได้ควบคุมการจราจร (ไม่มีคิวที่ทางแยก) สัญญาณไฟจะถูกเลื่อนครั้งเดียวตอนจบเช่นกัน
+// ผลของยานพาหนะจึงไม่เปลี่ยน แต่ระยะเวลาของเฟสถูกปรับตามการจราจร ณ ตอนจบเท่านั้น
+// ถ้าสัญญาณไฟควบคุมการจราจร สัญญาณไฟจะถูกเลื่อนทุกขั้นตอนเวลาเหมือน update_simulation
+// (ผลเหมือนกับการเรียก update_simulation ทีละขั้นตอนเวลาเมื่อไม่ได้เปลี่ยนเส้นทางระหว่างเดินทาง)
+void fast_forward_simulation(TrafficSimulation* sim, int num_ticks) {
+    if (!sim->is_running || num_ticks <= 0) {
+        return;
+    }
+    
+    for (int t = 0; t < num_ticks; t++) {
+        sim->time_step++;
+        if (sim->junction_queues != NULL) {
+            sync_signal_clock(sim);
+        }
+        step_vehicles(sim);
+    }
+    
+    sync_signal_clock(sim);
+    update_edge_weight(sim->graph);
+    refresh_route_cost_table(sim->graph, sim->route_costs);
+    
+    // การเปลี่ยนเส้นทางต้องใช้น้ำหนักล่าสุด จึงทำครั้งเดียวตอนจบเช่นกัน
+    if (sim->config.reroute_interval > 0) {
+        reroute_vehicles(sim);
+    }
 }
 
 // ฟังก์ชันสำหรับเริ่มการจำลอง
@@ -258,19 +814,15 @@ void generate_random_traffic(TrafficSimulation* sim, int num_vehicles) {
         return;
     }
     
-    if (sim->num_vehicles + num_vehicles > sim->max_vehicles) {
-        fprintf(stderr, "Error: Number of vehicles exceeds limit\n");
-        return;
-    }
-    
     for (int i = 0; i < num_vehicles; i++) {
-        // สุ่มจุดต้นทางและปลายทาง
-        int origin = rand() % sim->graph->num_vertices;
+        // สุ่มจุดต้นทางและปลายทางจากกระแสเลขสุ่มของการสร้างการจราจร
+        uint64_t seed = sim->config.seed;
+        int origin = random_int(seed, RNG_STREAM_TRAFFIC, sim->traffic_counter++, sim->graph->num_vertices);
         int destination;
         
         // สุ่มจุดปลายทางที่ไม่ใช่จุดต้นทาง
         do {
-            destination = rand() % sim->graph->num_vertices;
+            destination = random_int(seed, RNG_STREAM_TRAFFIC, sim->traffic_counter++, sim->graph->num_vertices);
         } while (destination == origin);
         
         // เพิ่มยานพาหนะ
@@ -280,19 +832,15 @@ void generate_random_traffic(TrafficSimulation* sim, int num_vehicles) {
 
 // ฟังก์ชันสำหรับวิเคราะห์ผลการจำลอง
 void analyze_simulation_results(TrafficSimulation* sim) {
-    printf("\nSimulation Analysis Results (Time: %d seconds):\n", sim->time_step);
+    printf("\nSimulation Analysis Results (Time: %g seconds):\n", simulation_seconds(sim));
     
-    // นับจำนวนยานพาหนะที่เดินทางถึงจุดหมายแล้ว
-    int completed_count = 0;
-    for (int i = 0; i < sim->num_vehicles; i++) {
-        if (sim->vehicles[i].completed) {
-            completed_count++;
-        }
-    }
+    // ยานพาหนะที่ถึงจุดหมายถูกนำออกจากที่เก็บแล้ว จึงใช้ตัวนับของการจำลอง
+    float completed_percent = (sim->total_vehicles > 0) ?
+        ((float)sim->completed_vehicles / sim->total_vehicles) * 100.0 : 0.0;
     
-    printf("Total vehicles: %d\n", sim->num_vehicles);
-    printf("Vehicles reached destination: %d (%.2f%%)\n",
-           completed_count, ((float)completed_count / sim->num_vehicles) * 100.0);
+    printf("Total vehicles: %ld\n", sim->total_vehicles);
+    printf("Vehicles reached destination: %ld (%.2f%%)\n", sim->completed_vehicles, completed_percent);
+    printf("Vehicles still traveling: %d\n", sim->num_vehicles);
     
     // คำนวณความหนาแน่นของการจราจรเฉลี่ย
     float total_congestion = 0.0;
@@ -301,7 +849,7 @@ void analyze_simulation_results(TrafficSimulation* sim) {
     for (int i = 0; i < sim->graph->num_vertices; i++) {
         Edge* current = sim->graph->vertices[i].head;
         while (current != NULL) {
-            float congestion = (float)current->road->current_load / current->road->capacity;
+            float congestion = (float)edge_load(sim->graph, current) / current->road->capacity;
             if (congestion > 1.0) congestion = 1.0;
             
             total_congestion += congestion;
@@ -322,7 +870,7 @@ void analyze_simulation_results(TrafficSimulation* sim) {
     for (int i = 0; i < sim->graph->num_vertices; i++) {
         Edge* current = sim->graph->vertices[i].head;
         while (current != NULL) {
-            float congestion = (float)current->road->current_load / current->road->capacity;
+            float congestion = (float)edge_load(sim->graph, current) / current->road->capacity;
             if (congestion > max_congestion) {
                 max_congestion = congestion;
                 max_congestion_src = i;
@@ -337,39 +885,40 @@ void analyze_simulation_results(TrafficSimulation* sim) {
         printf("Most congested road: from intersection %d to intersection %d (%.2f%%)\n",
                max_congestion_src, max_congestion_dest, max_congestion * 100.0);
     }
+    
+    if (sim->config.reroute_interval > 0) {
+        print_reroute_stats(sim);
+    }
+    
+    if (sim->junction_queues != NULL) {
+        print_junction_queue_stats(sim->junction_queues);
+    }
 }
 
 // ฟังก์ชันสำหรับแสดงข้อมูลของการจำลอง
 void print_simulation_status(TrafficSimulation* sim) {
-    printf("\nSimulation Status (Time: %d seconds):\n", sim->time_step);
+    printf("\nSimulation Status (Time: %g seconds):\n", simulation_seconds(sim));
     printf("Status: %s\n", sim->is_running ? "Running" : "Stopped");
-    printf("Number of vehicles: %d / %d\n", sim->num_vehicles, sim->max_vehicles);
-    
-    // นับจำนวนยานพาหนะที่เดินทางถึงจุดหมายแล้ว
-    int completed_count = 0;
-    for (int i = 0; i < sim->num_vehicles; i++) {
-        if (sim->vehicles[i].completed) {
-            completed_count++;
-        }
-    }
-    
-    printf("Vehicles reached destination: %d\n", completed_count);
+    printf("Number of vehicles: %d traveling / %ld added (storage capacity %d)\n",
+           sim->num_vehicles, sim->total_vehicles, sim->vehicles.capacity);
+    printf("Vehicles reached destination: %ld\n", sim->completed_vehicles);
     
     // แสดงข้อมูลของยานพาหนะบางส่วน (แสดงเพียง 5 คันแรก)
     int display_count = (sim->num_vehicles < 5) ? sim->num_vehicles : 5;
     printf("\nVehicle Information (showing first %d):\n", display_count);
     
     for (int i = 0; i < display_count; i++) {
-        Vehicle* vehicle = &sim->vehicles[i];
+        Vehicle vehicle;
+        get_vehicle(sim, get_vehicle_handle(sim, i), &vehicle);
         
-        printf("Vehicle ID: %d\n", vehicle->id);
-        printf("  Origin: %d, Destination: %d\n", vehicle->origin, vehicle->destination);
-        printf("  Status: %s\n", vehicle->completed ? "Reached destination" : "Traveling");
+        printf("Vehicle ID: %d\n", vehicle.id);
+        printf("  Origin: %d, Destination: %d\n", vehicle.origin, vehicle.destination);
+        printf("  Status: %s\n", vehicle.completed ? "Reached destination" : "Traveling");
         
-        if (!vehicle->completed) {
+        if (!vehicle.completed) {
             printf("  Current position: Road to intersection %d (%.2f km)\n",
-                 vehicle->current_road, (float)vehicle->current_pos / 1000.0);
-            printf("  Current speed: %.2f km/h\n", vehicle->speed);
+                 vehicle.current_road, vehicle.current_pos / 1000.0);
+            printf("  Current speed: %.2f km/h\n", vehicle.speed);
         }
         
         printf("\n");
@@ -380,17 +929,28 @@ void print_simulation_status(TrafficSimulation* sim) {
 void free_simulation(TrafficSimulation* sim) {
     if (sim == NULL) return;
     
-    // ลบยานพาหนะทั้งหมด
+    // ลบเส้นทางของยานพาหนะที่กำลังเดินทาง
     for (int i = 0; i < sim->num_vehicles; i++) {
-        if (sim->vehicles[i].route != NULL) {
-            free_route(sim->vehicles[i].route);
+        if (sim->vehicles.route[i] != NULL) {
+            free_route(sim->vehicles.route[i]);
         }
     }
     
-    // ลบอาเรย์ของยานพาหนะ
-    if (sim->vehicles != NULL) {
-        free(sim->vehicles);
+    // ลบคอลัมน์ข้อมูลของยานพาหนะและเส้นทางที่รอนำกลับมาใช้
+    free_vehicle_store(&sim->vehicles);
+    
+    // ลบตารางต้นทุนของเส้นเชื่อม
+    free_route_cost_table(sim->route_costs);
+    free_reroute_workspace(sim->reroute_workspace);
+    free_junction_queues(sim->junction_queues);
+    
+    // หยุดเธรดและลบข้อมูลของแต่ละเธรด
+    free_thread_pool(sim->pool);
+    for (int w = 0; w < sim->num_workers; w++) {
+        free(sim->workers[w].changes);
+        free(sim->workers[w].arrivals);
     }
+    free(sim->workers);
     
     // ลบการจำลอง
     free(sim);
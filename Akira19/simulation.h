@@ -9,43 +9,227 @@
  #include "queue.h"
  #include "traffic_signal.h"
  #include "route.h"
+ #include "thread_pool.h"
+ #include "rng.h"
+ #include <stdalign.h>
+ #include <limits.h>
  
- // โครงสร้างข้อมูลของยานพาหนะ
+ // ค่าน้ำหนักของปัจจัยที่ใช้หาเส้นทางของยานพาหนะ (เวลา, ระยะทาง, ความหนาแน่น)
+ #define VEHICLE_ROUTE_TIME_WEIGHT 0.6f
+ #define VEHICLE_ROUTE_DISTANCE_WEIGHT 0.2f
+ #define VEHICLE_ROUTE_CONGESTION_WEIGHT 0.2f
+ 
+ // ค่าของ road_end เมื่อยานพาหนะหยุดรอไฟเขียวที่เส้นหยุด (ตำแหน่งไม่ถึงค่านี้ จึงไม่ถูกย้ายถนนจนกว่าจะถูกปล่อย)
+ #define ROAD_END_WAITING INT_MAX
+ 
+ // ค่า seed เริ่มต้นของเลขสุ่มในการจำลอง
+ #define DEFAULT_SIMULATION_SEED UINT64_C(20240101)
+ 
+ // การตั้งค่าของการจำลอง
+ typedef struct {
+     uint64_t seed;           // seed ของเลขสุ่ม (ค่าเดียวกันให้ผลการจำลองเหมือนกันทุกครั้ง)
+     int initial_capacity;    // ขนาดเริ่มต้นของที่เก็บยานพาหนะ
+     int num_threads;         // จำนวนเธรดที่ใช้อัปเดตยานพาหนะ (1 = แบบลำดับ, 0 = ใช้จำนวนแกนของเครื่อง)
+     float speed_variation;   // ความแตกต่างของความเร็วระหว่างผู้ขับขี่ (0 = ไม่มี, 0.1 = สุ่ม ±10% ต่อถนน)
+     float dt;                // ความยาวของหนึ่งขั้นตอนเวลา (วินาที, เช่น 0.5 = ครึ่งวินาที)
+     int reroute_interval;    // ตรวจเส้นทางของยานพาหนะทุกกี่ขั้นตอนเวลา (0 = ไม่เปลี่ยนเส้นทางระหว่างเดินทาง)
+     float reroute_threshold; // เปลี่ยนเส้นทางเมื่อต้นทุนที่เหลือเพิ่มขึ้นเกินสัดส่วนนี้ของต้นทุนตามแผน (0.25 = 25%)
+     bool signal_gating;      // ยานพาหนะต้องรอไฟเขียวที่ทางแยกที่มีสัญญาณไฟ (false = ผ่านทางแยกทันที)
+ } SimulationConfig;
+ 
+ // ตัวระบุยานพาหนะแบบมีรุ่น (generation)
+ // ช่องของยานพาหนะที่ถึงจุดหมายแล้วถูกนำกลับมาใช้ใหม่ รุ่นที่เพิ่มขึ้นทำให้ตัวระบุเดิมใช้ไม่ได้อีก
  typedef struct {
-     int id;              // ID ของยานพาหนะ
+     int index;              // ดัชนีในตารางตัวระบุ (-1 = ไม่ถูกต้อง)
+     unsigned int generation; // รุ่นของช่องเมื่อสร้างตัวระบุ
+ } VehicleHandle;
+ 
+ // ข้อมูลของยานพาหนะหนึ่งคัน (สำเนาที่อ่านจากคอลัมน์ของ VehicleStore)
+ typedef struct {
+     int id;              // ID ของยานพาหนะ (ดัชนีของตัวระบุ)
      int origin;          // จุดต้นทาง
      int destination;     // จุดปลายทาง
      int current_road;    // ถนนที่กำลังเดินทาง (ดัชนีของเส้นเชื่อมในกราฟ)
-     int current_pos;     // ตำแหน่งปัจจุบัน (ระยะทางจากจุดเริ่มต้นของถนน)
+     double current_pos;  // ตำแหน่งปัจจุบัน (เมตรจากจุดเริ่มต้นของถนน)
      float speed;         // ความเร็วปัจจุบัน
      Route* route;        // เส้นทางที่วางแผนไว้
      int route_index;     // ดัชนีปัจจุบันในเส้นทาง
      bool completed;      // เดินทางถึงจุดหมายแล้วหรือไม่
  } Vehicle;
  
+ // ที่เก็บข้อมูลของยานพาหนะแบบคอลัมน์ (structure of arrays)
+ // ข้อมูลที่ใช้ทุกขั้นตอนเวลาแยกเป็นอาเรย์ต่อเนื่อง เพื่อให้ลูปเลื่อนตำแหน่งอ่านเฉพาะข้อมูลที่จำเป็น
+ // เก็บเฉพาะยานพาหนะที่ยังเดินทางอยู่ในช่วง [0, num_vehicles) เรียงตามลำดับที่เพิ่มเข้ามา
+ // ยานพาหนะที่ถึงจุดหมายถูกบีบอัดออกเมื่อจบขั้นตอนเวลา ส่วนตัวระบุจะชี้ไปยังตำแหน่งใหม่ผ่าน handle_slot
+ typedef struct {
+     // ข้อมูลที่ใช้ทุกขั้นตอนเวลา
+     int* current_pos;        // ตำแหน่งปัจจุบัน (มิลลิเมตรจากจุดเริ่มต้นของถนน, fixed-point)
+     float* speed;            // ความเร็วปัจจุบัน (กม./ชม., 0 = ไม่เคลื่อนที่)
+     int* road_end;           // ความยาวของถนนปัจจุบัน (มิลลิเมตร)
+     Edge** current_edge;     // เส้นเชื่อมของถนนปัจจุบัน (NULL = ไม่ได้อยู่บนถนน)
+     int* route_index;        // ดัชนีปัจจุบันในเส้นทาง
+     bool* completed;         // ถึงจุดหมายในขั้นตอนเวลานี้ (รอถูกบีบอัดออก)
+ 
+     // ข้อมูลที่ใช้เฉพาะเมื่อเปลี่ยนถนนหรือแสดงผล
+     int* handle_index;       // ดัชนีของตัวระบุของยานพาหนะในแต่ละตำแหน่ง
+     long* trip_id;           // หมายเลขการเดินทาง (ไม่ซ้ำกันตลอดการจำลอง ใช้เป็นกระแสของเลขสุ่ม)
+     int* origin;             // จุดต้นทาง
+     int* destination;        // จุดปลายทาง
+     int* current_road;       // ทางแยกปลายทางของถนนที่กำลังเดินทาง
+     int* entered_at;         // ขั้นตอนเวลาที่เข้าสู่ถนนปัจจุบัน
+     Route** route;           // เส้นทางที่วางแผนไว้
+     int capacity;            // ขนาดของคอลัมน์ (ขยายเป็นสองเท่าเมื่อเต็ม)
+ 
+     // ตารางตัวระบุและรายการช่องว่าง
+     int* handle_slot;           // ตำแหน่งในคอลัมน์ของแต่ละตัวระบุ (-1 = ว่าง)
+     unsigned int* handle_generation; // รุ่นปัจจุบันของแต่ละตัวระบุ
+     int* free_handles;          // ตัวระบุที่ว่างและนำกลับมาใช้ได้
+     int num_free_handles;       // จำนวนตัวระบุที่ว่าง
+     int num_handles;            // จำนวนตัวระบุที่เคยใช้
+     Route** spare_routes;       // เส้นทางของยานพาหนะที่ถึงจุดหมายแล้ว (นำหน่วยความจำกลับมาใช้ใหม่)
+     int num_spare_routes;       // จำนวนเส้นทางที่รอนำกลับมาใช้
+ } VehicleStore;
+ 
+ // จำนวนยานพาหนะในแต่ละก้อนงานของการอัปเดตแบบขนาน
+ #define VEHICLE_CHUNK_SIZE 2048
+ 
+ // การเปลี่ยนแปลงจำนวนรถบนถนนที่รอนำไปรวมเมื่อจบขั้นตอนเวลา
+ typedef struct {
+     Edge* edge;              // เส้นเชื่อมของถนน
+     int delta;               // +1 = รถเข้าถนน, -1 = รถออกจากถนน
+ } LoadChange;
+ 
+ // ข้อมูลของแต่ละเธรดระหว่างขั้นตอนเวลา (แยกแคชไลน์เพื่อไม่ให้เธรดแย่งกันเขียน)
+ // ระหว่างขั้นตอนเวลาไม่มีเธรดใดเขียน edge_loads ของกราฟ ทุกเธรดจึงเห็นการจราจรชุดเดียวกัน
+ typedef struct {
+     alignas(64) LoadChange* changes; // การเปลี่ยนแปลงจำนวนรถที่บันทึกไว้
+     int num_changes;         // จำนวนการเปลี่ยนแปลง
+     int capacity;            // ขนาดของอาเรย์ changes
+     long completed;          // จำนวนยานพาหนะที่ถึงจุดหมายในขั้นตอนเวลานี้
+     int first_completed;     // ตำแหน่งแรกของยานพาหนะที่ถึงจุดหมาย (-1 = ไม่มี)
+     int* arrivals;           // ตำแหน่งของยานพาหนะที่เพิ่งหยุดที่เส้นหยุดของทางแยกที่มีสัญญาณไฟ
+     int num_arrivals;        // จำนวนยานพาหนะที่เพิ่งหยุด
+     int arrivals_capacity;   // ขนาดของอาเรย์ arrivals
+ } TickWorker;
+ 
+ // สถิติของการเปลี่ยนเส้นทางระหว่างเดินทาง
+ typedef struct {
+     long checked;            // จำนวนยานพาหนะที่ตรวจต้นทุนของเส้นทาง
+     long candidates;         // จำนวนยานพาหนะที่ต้นทุนเพิ่มขึ้นเกินเกณฑ์
+     long rerouted;           // จำนวนยานพาหนะที่เปลี่ยนเส้นทาง
+     long spliced;            // จำนวนเส้นทางใหม่ที่ต่อกับส่วนท้ายของเส้นทางเดิม
+     long searches;           // จำนวนการค้นหาย้อนกลับ (หนึ่งครั้งต่อปลายทาง)
+     double routing_time;     // เวลาที่ใช้ (วินาที)
+ } RerouteStats;
+ 
+ struct RerouteWorkspace;
+ struct JunctionQueues;
+ 
  // โครงสร้างข้อมูลของการจำลองระบบการจราจร
  typedef struct {
      Graph* graph;                // เครือข่ายถนน
      SignalSystem* signal_system; // ระบบสัญญาณไฟจราจร
-     Vehicle* vehicles;           // อาเรย์ของยานพาหนะ
-     int num_vehicles;            // จำนวนยานพาหนะทั้งหมด
-     int max_vehicles;            // จำนวนยานพาหนะสูงสุดที่รองรับ
-     int time_step;               // ขั้นตอนเวลาปัจจุบัน (วินาที)
+     SimulationConfig config;     // การตั้งค่าของการจำลอง
+     RouteCostTable* route_costs; // ตารางต้นทุนของเส้นเชื่อมสำหรับหาเส้นทางของยานพาหนะ
+     VehicleStore vehicles;       // ข้อมูลของยานพาหนะแบบคอลัมน์
+     int num_vehicles;            // จำนวนยานพาหนะที่กำลังเดินทาง
+     long total_vehicles;         // จำนวนยานพาหนะที่เพิ่มเข้ามาทั้งหมด
+     long completed_vehicles;     // จำนวนยานพาหนะที่เดินทางถึงจุดหมายแล้ว
+     long vehicle_updates;        // จำนวนการอัปเดตยานพาหนะทั้งหมด (คัน × ขั้นตอนเวลา)
+     long route_queries;          // จำนวนการค้นหาเส้นทางทั้งหมด (เพิ่มยานพาหนะและเปลี่ยนเส้นทาง)
+     long next_trip_id;           // หมายเลขการเดินทางถัดไป
+     uint64_t traffic_counter;    // ตัวนับของกระแสเลขสุ่มสำหรับสร้างการจราจร
+     int time_step;               // จำนวนขั้นตอนเวลาตั้งแต่เริ่มการจำลอง (ขั้นละ config.dt วินาที)
+     float step_scale;            // ระยะทางต่อขั้นตอนเวลาที่ความเร็ว 1 กม./ชม. (มิลลิเมตร)
+     int signal_seconds;          // จำนวนวินาทีที่อัปเดตสัญญาณไฟไปแล้ว
      bool is_running;             // การจำลองกำลังทำงานหรือไม่
+     ThreadPool* pool;            // กลุ่มเธรดสำหรับอัปเดตยานพาหนะ (NULL = ทำงานแบบลำดับ)
+     TickWorker* workers;         // ข้อมูลของแต่ละเธรดระหว่างขั้นตอนเวลา
+     int num_workers;             // จำนวนเธรด
+     RerouteStats reroute_last;   // สถิติของการเปลี่ยนเส้นทางครั้งล่าสุด
+     RerouteStats reroute_total;  // สถิติของการเปลี่ยนเส้นทางทั้งหมด
+     struct RerouteWorkspace* reroute_workspace; // หน่วยความจำสำหรับค้นหาเส้นทางใหม่ (สร้างเมื่อใช้ครั้งแรก)
+     struct JunctionQueues* junction_queues;     // คิวรอไฟเขียวของถนนขาเข้า (NULL = ไม่ใช้ signal_gating)
  } TrafficSimulation;
  
- // ฟังก์ชันสำหรับสร้างการจำลองระบบการจราจรใหม่
- TrafficSimulation* create_simulation(Graph* graph, SignalSystem* signal_system, int max_vehicles);
+ // ฟังก์ชันสำหรับคำนวณระยะทางที่ยานพาหนะเคลื่อนที่ได้ในหนึ่งขั้นตอนเวลา (มิลลิเมตร, ปัดเศษลง)
+ // ใช้หน่วยมิลลิเมตรแบบจำนวนเต็มเพื่อให้รถที่ช้ามากยังเคลื่อนที่ได้ และผลรวมของระยะทางไม่มีความคลาดเคลื่อนสะสม
+ static inline int vehicle_step_mm(float speed, float step_scale) {
+     return (int)(speed * step_scale);
+ }
+ 
+ // ฟังก์ชันสำหรับอ่านเวลาของการจำลอง (วินาที)
+ static inline double simulation_seconds(const TrafficSimulation* sim) {
+     return sim->time_step * (double)sim->config.dt;
+ }
  
- // ฟังก์ชันสำหรับสร้างยานพาหนะใหม่ในการจำลอง
- int add_vehicle(TrafficSimulation* sim, int origin, int destination);
+ // ฟังก์ชันสำหรับอ่านการตั้งค่าเริ่มต้นของการจำลอง
+ SimulationConfig default_simulation_config(void);
+ 
+ // ฟังก์ชันสำหรับสร้างการจำลองระบบการจราจรใหม่ (initial_capacity = ขนาดเริ่มต้นของที่เก็บยานพาหนะ)
+ TrafficSimulation* create_simulation(Graph* graph, SignalSystem* signal_system, int initial_capacity);
+ 
+ // ฟังก์ชันสำหรับสร้างการจำลองระบบการจราจรใหม่ตามการตั้งค่า
+ TrafficSimulation* create_simulation_with_config(Graph* graph, SignalSystem* signal_system,
+                                                  const SimulationConfig* config);
+ 
+ // ฟังก์ชันสำหรับสร้างยานพาหนะใหม่ในการจำลอง (คืนค่าตัวระบุที่มี index = -1 ถ้าไม่สำเร็จ)
+ VehicleHandle add_vehicle(TrafficSimulation* sim, int origin, int destination);
+ 
+ // ฟังก์ชันสำหรับตรวจสอบว่าตัวระบุยังชี้ไปยังยานพาหนะที่กำลังเดินทางหรือไม่
+ bool vehicle_handle_valid(const TrafficSimulation* sim, VehicleHandle handle);
+ 
+ // ฟังก์ชันสำหรับอ่านตัวระบุของยานพาหนะที่ตำแหน่ง position ในที่เก็บ
+ VehicleHandle get_vehicle_handle(const TrafficSimulation* sim, int position);
+ 
+ // ฟังก์ชันสำหรับอ่านข้อมูลของยานพาหนะหนึ่งคัน (คืนค่า false ถ้าตัวระบุใช้ไม่ได้แล้ว)
+ bool get_vehicle(const TrafficSimulation* sim, VehicleHandle handle, Vehicle* vehicle);
  
  // ฟังก์ชันสำหรับอัปเดตตำแหน่งของยานพาหนะ
- void update_vehicle(TrafficSimulation* sim, int vehicle_id);
+ void update_vehicle(TrafficSimulation* sim, VehicleHandle handle);
+ 
+ // ฟังก์ชันสำหรับนำยานพาหนะออกจากการจำลอง (ลดการจราจรบนถนนที่อยู่และคืนช่องให้ใช้ใหม่)
+ bool remove_vehicle(TrafficSimulation* sim, VehicleHandle handle);
+ 
+ // ฟังก์ชันสำหรับนำยานพาหนะทั้งหมดออกและล้างตัวนับ (เริ่มช่วงการจำลองใหม่บนเครือข่ายเดิม)
+ void clear_vehicles(TrafficSimulation* sim);
+ 
+ // ฟังก์ชันสำหรับกำหนดจำนวนเธรดที่ใช้อัปเดตยานพาหนะ (1 = แบบลำดับ, 0 = ใช้จำนวนแกนของเครื่อง)
+ // ผลรวมของการจำลองเหมือนกันทุกจำนวนเธรด เพราะการจราจรบนถนนถูกรวมเมื่อจบขั้นตอนเวลาเสมอ
+ void set_simulation_threads(TrafficSimulation* sim, int num_threads);
  
  // ฟังก์ชันสำหรับอัปเดตสถานะของการจำลองในแต่ละขั้นตอนเวลา
  void update_simulation(TrafficSimulation* sim);
  
+ // ฟังก์ชันสำหรับเร่งการจำลองไปข้างหน้า num_ticks ขั้นตอนเวลาในครั้งเดียว
+ // ยานพาหนะเคลื่อนที่ทุกขั้นตอนเวลาเหมือน update_simulation แต่อัปเดตน้ำหนักของเส้นเชื่อมครั้งเดียวตอนจบ
+ // สัญญาณไฟถูกเลื่อนครั้งเดียวตอนจบ ยกเว้นเมื่อสัญญาณไฟควบคุมการจราจร (signal_gating) ซึ่งเลื่อนทุกขั้นตอนเวลา
+ void fast_forward_simulation(TrafficSimulation* sim, int num_ticks);
+ 
+ // ฟังก์ชันสำหรับอัปเดตสัญญาณไฟให้ทันเวลาปัจจุบันของการจำลอง (หนึ่งครั้งต่อวินาทีที่ผ่านไป)
+ void sync_signal_clock(TrafficSimulation* sim);
+ 
+ // ฟังก์ชันภายในที่ใช้ร่วมกับโหมดจำลองอื่น (เช่น event_engine.c) ซึ่งจัดลำดับการอัปเดตยานพาหนะเอง
+ 
+ // ฟังก์ชันสำหรับขยายที่เก็บยานพาหนะให้มีขนาดอย่างน้อย capacity (ใช้เมื่อกู้คืนสถานะจากไฟล์)
+ void reserve_vehicle_store(TrafficSimulation* sim, int capacity);
+ 
+ // ฟังก์ชันสำหรับหาตำแหน่งของยานพาหนะในที่เก็บจากตัวระบุ (-1 = ตัวระบุใช้ไม่ได้แล้ว)
+ int vehicle_position(const TrafficSimulation* sim, VehicleHandle handle);
+ 
+ // ฟังก์ชันสำหรับย้ายยานพาหนะที่ตำแหน่ง position ไปยังถนนถัดไป (คืนค่า true ถ้าถึงจุดหมายแล้ว)
+ // การเปลี่ยนแปลงจำนวนรถถูกบันทึกไว้ใน worker จนกว่าจะเรียก apply_load_changes
+ bool advance_vehicle(TrafficSimulation* sim, TickWorker* worker, int position);
+ 
+ // ฟังก์ชันสำหรับล้างข้อมูลของ worker ก่อนเริ่มขั้นตอนเวลา
+ void reset_tick_worker(TickWorker* worker);
+ 
+ // ฟังก์ชันสำหรับรวมการเปลี่ยนแปลงจำนวนรถของ worker เข้ากับถนน
+ void apply_load_changes(TrafficSimulation* sim, TickWorker* worker, bool refresh_edges);
+ 
+ // ฟังก์ชันสำหรับบีบอัดยานพาหนะที่ถึงจุดหมายออกจากที่เก็บ (เริ่มตรวจที่ตำแหน่ง first)
+ void compact_vehicles(TrafficSimulation* sim, int first);
+ 
  // ฟังก์ชันสำหรับเริ่มการจำลอง
  void start_simulation(TrafficSimulation* sim);
  
@@ -63,7 +247,7 @@
  
  // ฟังก์ชันสำหรับลบการจำลองและคืนหน่วยความจำ
  void free_simulation(TrafficSimulation* sim);
-
+ 
  void simulate_morning_traffic(TrafficSimulation* sim);
  
  #endif
@@ -0,0 +1,224 @@
+/*
+* thread_pool.c
+* กลุ่มเธรดสำหรับแบ่งงานแบบขนานพร้อมการขโมยงาน (work stealing)
+*/
+
+#include "thread_pool.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdalign.h>
+#include <unistd.h>
+
+// ตำแหน่งของก้อนงานถัดไปของแต่ละเธรด (แยกแคชไลน์เพื่อไม่ให้เธรดแย่งกันเขียน)
+typedef struct {
+    alignas(64) atomic_int next; // ก้อนงานถัดไปที่ยังไม่มีเธรดรับไป
+    int end;                     // ก้อนงานสุดท้าย (ไม่รวม) ในส่วนของเธรดนี้
+} WorkerCursor;
+
+// ข้อมูลเริ่มต้นของเธรดช่วย
+struct HelperArgs {
+    ThreadPool* pool;              // กลุ่มเธรดที่เธรดนี้สังกัด
+    int worker;                    // หมายเลขของเธรด (1 ถึง num_threads - 1)
+};
+
+// โครงสร้างข้อมูลของกลุ่มเธรด
+struct ThreadPool {
+    int num_threads;               // จำนวนเธรดทั้งหมด (รวมเธรดที่เรียก parallel_for)
+    pthread_t* threads;            // เธรดช่วย (num_threads - 1 เธรด)
+    struct HelperArgs* helpers;    // ข้อมูลเริ่มต้นของเธรดช่วยแต่ละเธรด
+    pthread_mutex_t mutex;         // ล็อกสำหรับเริ่มและรอจบงาน
+    pthread_cond_t start_cond;     // แจ้งเธรดช่วยว่ามีงานใหม่
+    pthread_cond_t done_cond;      // แจ้งเธรดหลักว่าเธรดช่วยทำงานเสร็จแล้ว
+    unsigned long generation;      // เพิ่มขึ้นทุกครั้งที่มีงานใหม่
+    int pending_helpers;           // จำนวนเธรดช่วยที่ยังทำงานปัจจุบันไม่เสร็จ
+    bool shutdown;                 // กำลังหยุดกลุ่มเธรดหรือไม่
+    
+    // งานปัจจุบัน
+    ParallelRangeFunction function;
+    void* ctx;
+    int count;
+    int chunk_size;
+    WorkerCursor* cursors;
+};
+
+// ฟังก์ชันสำหรับอ่านจำนวนแกนประมวลผลของเครื่อง
+int available_cpu_count(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (int)count : 1;
+}
+
+// ฟังก์ชันสำหรับทำก้อนงานที่รับมาจากตำแหน่งของเธรด victim จนหมด
+static void drain_cursor(ThreadPool* pool, int worker, int victim) {
+    WorkerCursor* cursor = &pool->cursors[victim];
+    int chunk;
+    
+    while ((chunk = atomic_fetch_add_explicit(&cursor->next, 1, memory_order_relaxed)) < cursor->end) {
+        int begin = chunk * pool->chunk_size;
+        int end = begin + pool->chunk_size;
+        if (end > pool->count) end = pool->count;
+        
+        pool->function(pool->ctx, worker, begin, end);
+    }
+}
+
+// ฟังก์ชันสำหรับทำงานในส่วนของตัวเองก่อน แล้วขโมยงานที่เหลือของเธรดอื่น
+static void run_worker(ThreadPool* pool, int worker) {
+    drain_cursor(pool, worker, worker);
+    
+    for (int i = 1; i < pool->num_threads; i++) {
+        drain_cursor(pool, worker, (worker + i) % pool->num_threads);
+    }
+}
+
+// ฟังก์ชันหลักของเธรดช่วย (รองานใหม่ ทำงาน แล้วแจ้งว่าเสร็จ)
+static void* helper_main(void* arg) {
+    struct HelperArgs* args = (struct HelperArgs*)arg;
+    ThreadPool* pool = args->pool;
+    unsigned long seen = 0;
+    
+    pthread_mutex_lock(&pool->mutex);
+    while (true) {
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->start_cond, &pool->mutex);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
+        
+        run_worker(pool, args->worker);
+        
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->pending_helpers == 0) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    
+    return NULL;
+}
+
+// ฟังก์ชันสำหรับสร้างกลุ่มเธรด (num_threads <= 0 = ใช้จำนวนแกนของเครื่อง)
+ThreadPool* create_thread_pool(int num_threads) {
+    if (num_threads <= 0) {
+        num_threads = available_cpu_count();
+    }
+    
+    ThreadPool* pool = (ThreadPool*)malloc(sizeof(ThreadPool));
+    if (pool == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for thread pool\n");
+        exit(1);
+    }
+    
+    pool->num_threads = num_threads;
+    pool->threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    pool->helpers = (struct HelperArgs*)malloc(num_threads * sizeof(struct HelperArgs));
+    pool->cursors = (WorkerCursor*)aligned_alloc(64, ((num_threads * sizeof(WorkerCursor) + 63) / 64) * 64);
+    if (pool->threads == NULL || pool->helpers == NULL || pool->cursors == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for thread pool\n");
+        exit(1);
+    }
+    
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->start_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+    pool->generation = 0;
+    pool->pending_helpers = 0;
+    pool->shutdown = false;
+    pool->function = NULL;
+    pool->ctx = NULL;
+    pool->count = 0;
+    pool->chunk_size = 1;
+    
+    for (int w = 0; w < num_threads; w++) {
+        atomic_init(&pool->cursors[w].next, 0);
+        pool->cursors[w].end = 0;
+    }
+    
+    // เธรดที่เรียก parallel_for ทำงานเป็น worker 0 จึงสร้างเธรดช่วยเพิ่มเพียง num_threads - 1 เธรด
+    for (int w = 1; w < num_threads; w++) {
+        pool->helpers[w].pool = pool;
+        pool->helpers[w].worker = w;
+        if (pthread_create(&pool->threads[w], NULL, helper_main, &pool->helpers[w]) != 0) {
+            fprintf(stderr, "Error: Unable to create worker thread\n");
+            exit(1);
+        }
+    }
+    
+    return pool;
+}
+
+// ฟังก์ชันสำหรับอ่านจำนวนเธรดในกลุ่ม
+int thread_pool_size(const ThreadPool* pool) {
+    return (pool != NULL) ? pool->num_threads : 1;
+}
+
+// ฟังก์ชันสำหรับแบ่งงาน count ชิ้นเป็นก้อนละ chunk_size ชิ้นให้ทุกเธรดทำจนเสร็จ
+// แต่ละเธรดเริ่มจากก้อนในส่วนของตัวเอง แล้วขโมยก้อนที่เหลือของเธรดอื่นเมื่อทำส่วนของตัวเองเสร็จ
+void parallel_for(ThreadPool* pool, int count, int chunk_size, ParallelRangeFunction function, void* ctx) {
+    if (count <= 0) {
+        return;
+    }
+    
+    if (pool == NULL || pool->num_threads == 1) {
+        function(ctx, 0, 0, count);
+        return;
+    }
+    
+    if (chunk_size <= 0) {
+        chunk_size = 1;
+    }
+    
+    int num_chunks = (count + chunk_size - 1) / chunk_size;
+    
+    pthread_mutex_lock(&pool->mutex);
+    
+    pool->function = function;
+    pool->ctx = ctx;
+    pool->count = count;
+    pool->chunk_size = chunk_size;
+    
+    // แบ่งก้อนงานเป็นช่วงต่อเนื่องให้แต่ละเธรดเท่าๆ กัน
+    for (int w = 0; w < pool->num_threads; w++) {
+        atomic_store_explicit(&pool->cursors[w].next,
+                              (int)((long)num_chunks * w / pool->num_threads), memory_order_relaxed);
+        pool->cursors[w].end = (int)((long)num_chunks * (w + 1) / pool->num_threads);
+    }
+    
+    pool->pending_helpers = pool->num_threads - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start_cond);
+    pthread_mutex_unlock(&pool->mutex);
+    
+    run_worker(pool, 0);
+    
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->pending_helpers > 0) {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+// ฟังก์ชันสำหรับหยุดเธรดทั้งหมดและคืนหน่วยความจำ
+void free_thread_pool(ThreadPool* pool) {
+    if (pool == NULL) return;
+    
+    pthread_mutex_lock(&pool->mutex);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->start_cond);
+    pthread_mutex_unlock(&pool->mutex);
+    
+    for (int w = 1; w < pool->num_threads; w++) {
+        pthread_join(pool->threads[w], NULL);
+    }
+    
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->start_cond);
+    pthread_cond_destroy(&pool->done_cond);
+    
+    free(pool->threads);
+    free(pool->helpers);
+    free(pool->cursors);
+    free(pool);
+}
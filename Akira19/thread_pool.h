@@ -0,0 +1,30 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ 
+ // ฟังก์ชันที่ทำงานกับช่วง [begin, end) ของงาน (worker = หมายเลขของเธรดที่ทำงาน 0 ถึง num_threads - 1)
+ typedef void (*ParallelRangeFunction)(void* ctx, int worker, int begin, int end);
+ 
+ // กลุ่มเธรดสำหรับแบ่งงานแบบขนาน (เธรดที่เรียก parallel_for ทำงานเป็น worker 0)
+ typedef struct ThreadPool ThreadPool;
+ 
+ // ฟังก์ชันสำหรับสร้างกลุ่มเธรด (num_threads <= 0 = ใช้จำนวนแกนของเครื่อง)
+ ThreadPool* create_thread_pool(int num_threads);
+ 
+ // ฟังก์ชันสำหรับอ่านจำนวนเธรดในกลุ่ม
+ int thread_pool_size(const ThreadPool* pool);
+ 
+ // ฟังก์ชันสำหรับอ่านจำนวนแกนประมวลผลของเครื่อง
+ int available_cpu_count(void);
+ 
+ // ฟังก์ชันสำหรับแบ่งงาน count ชิ้นเป็นก้อนละ chunk_size ชิ้นให้ทุกเธรดทำจนเสร็จ
+ // แต่ละเธรดเริ่มจากก้อนในส่วนของตัวเอง แล้วขโมยก้อนที่เหลือของเธรดอื่นเมื่อทำส่วนของตัวเองเสร็จ
+ void parallel_for(ThreadPool* pool, int count, int chunk_size, ParallelRangeFunction function, void* ctx);
+ 
+ // ฟังก์ชันสำหรับหยุดเธรดทั้งหมดและคืนหน่วยความจำ
+ void free_thread_pool(ThreadPool* pool);
+ 
+ #endif
@@ -0,0 +1,184 @@
+/*
+* timing_wheel.c
+* วงล้อเวลาแบบลำดับชั้นสำหรับเหตุการณ์ที่เกิดห่างกัน (เช่น การเปลี่ยนเฟสของสัญญาณไฟ)
+*/
+
+#include "timing_wheel.h"
+
+// ช่วงเวลาที่ไกลที่สุดที่วางได้ตรงตำแหน่ง (ไกลกว่านี้จะวางที่ขอบของชั้นบนสุดแล้วถูกวางใหม่เมื่อย้ายชั้น)
+#define TIMING_WHEEL_SPAN (1L << (TIMING_WHEEL_BITS * TIMING_WHEEL_LEVELS))
+
+// โครงสร้างข้อมูลของวงล้อเวลา (รายการเชื่อมโยงสองทางแบบดัชนีในแต่ละช่อง)
+struct TimingWheel {
+    long now;                // เวลาปัจจุบัน
+    int num_timers;          // จำนวนตัวจับเวลา
+    long* expires;           // เวลาที่ตัวจับเวลาจะหมด
+    int* slot;               // ช่องที่ตัวจับเวลาอยู่ (ชั้น * TIMING_WHEEL_SLOTS + ช่อง, -1 = ไม่ได้ตั้งไว้)
+    int* next;               // ตัวจับเวลาถัดไปในช่องเดียวกัน (-1 = ไม่มี)
+    int* prev;               // ตัวจับเวลาก่อนหน้าในช่องเดียวกัน (-1 = เป็นตัวแรก)
+    int heads[TIMING_WHEEL_LEVELS * TIMING_WHEEL_SLOTS]; // ตัวจับเวลาตัวแรกของแต่ละช่อง (-1 = ว่าง)
+};
+
+// ฟังก์ชันสำหรับสร้างวงล้อเวลาที่เริ่มที่เวลา start_time
+TimingWheel* create_timing_wheel(int num_timers, long start_time) {
+    TimingWheel* wheel = (TimingWheel*)malloc(sizeof(TimingWheel));
+    if (wheel == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for timing wheel\n");
+        exit(1);
+    }
+    
+    int count = (num_timers > 0) ? num_timers : 1;
+    wheel->now = start_time;
+    wheel->num_timers = num_timers;
+    wheel->expires = (long*)malloc(count * sizeof(long));
+    wheel->slot = (int*)malloc(count * sizeof(int));
+    wheel->next = (int*)malloc(count * sizeof(int));
+    wheel->prev = (int*)malloc(count * sizeof(int));
+    if (wheel->expires == NULL || wheel->slot == NULL || wheel->next == NULL || wheel->prev == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for timing wheel\n");
+        exit(1);
+    }
+    
+    for (int i = 0; i < num_timers; i++) {
+        wheel->expires[i] = -1;
+        wheel->slot[i] = -1;
+    }
+    for (int s = 0; s < TIMING_WHEEL_LEVELS * TIMING_WHEEL_SLOTS; s++) {
+        wheel->heads[s] = -1;
+    }
+    
+    return wheel;
+}
+
+// ฟังก์ชันสำหรับอ่านเวลาปัจจุบันของวงล้อ
+long timing_wheel_time(const TimingWheel* wheel) {
+    return wheel->now;
+}
+
+// ฟังก์ชันสำหรับนำตัวจับเวลาออกจากช่องที่อยู่
+static void unlink_timer(TimingWheel* wheel, int timer) {
+    int slot = wheel->slot[timer];
+    if (slot < 0) {
+        return;
+    }
+    
+    if (wheel->prev[timer] >= 0) {
+        wheel->next[wheel->prev[timer]] = wheel->next[timer];
+    } else {
+        wheel->heads[slot] = wheel->next[timer];
+    }
+    if (wheel->next[timer] >= 0) {
+        wheel->prev[wheel->next[timer]] = wheel->prev[timer];
+    }
+    wheel->slot[timer] = -1;
+}
+
+// ฟังก์ชันสำหรับวางตัวจับเวลาลงในช่องตามระยะเวลาที่เหลือ (ชั้นล่างสุดที่ครอบคลุมระยะนั้น)
+static void place_timer(TimingWheel* wheel, int timer) {
+    long expires = wheel->expires[timer];
+    long delta = expires - wheel->now;
+    if (delta >= TIMING_WHEEL_SPAN) {
+        expires = wheel->now + TIMING_WHEEL_SPAN - 1;
+        delta = TIMING_WHEEL_SPAN - 1;
+    }
+    
+    int level = 0;
+    while (level < TIMING_WHEEL_LEVELS - 1 && delta >= (1L << (TIMING_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+    int slot = level * TIMING_WHEEL_SLOTS + (int)((expires >> (TIMING_WHEEL_BITS * level)) & (TIMING_WHEEL_SLOTS - 1));
+    
+    wheel->slot[timer] = slot;
+    wheel->prev[timer] = -1;
+    wheel->next[timer] = wheel->heads[slot];
+    if (wheel->heads[slot] >= 0) {
+        wheel->prev[wheel->heads[slot]] = timer;
+    }
+    wheel->heads[slot] = timer;
+}
+
+// ฟังก์ชันสำหรับตั้งตัวจับเวลาให้หมดที่เวลา expires (ต้องมากกว่าเวลาปัจจุบัน, ย้ายตัวจับเวลาเดิมถ้าตั้งไว้แล้ว)
+void schedule_timer(TimingWheel* wheel, int timer, long expires) {
+    if (timer < 0 || timer >= wheel->num_timers) {
+        fprintf(stderr, "Error: Invalid timer %d\n", timer);
+        return;
+    }
+    
+    if (expires <= wheel->now) {
+        expires = wheel->now + 1;
+    }
+    unlink_timer(wheel, timer);
+    wheel->expires[timer] = expires;
+    place_timer(wheel, timer);
+}
+
+// ฟังก์ชันสำหรับยกเลิกตัวจับเวลา
+void cancel_timer(TimingWheel* wheel, int timer) {
+    if (timer < 0 || timer >= wheel->num_timers) {
+        return;
+    }
+    
+    unlink_timer(wheel, timer);
+    wheel->expires[timer] = -1;
+}
+
+// ฟังก์ชันสำหรับอ่านเวลาที่ตัวจับเวลาจะหมด (-1 = ไม่ได้ตั้งไว้)
+long timer_expiry(const TimingWheel* wheel, int timer) {
+    if (timer < 0 || timer >= wheel->num_timers) {
+        return -1;
+    }
+    return wheel->expires[timer];
+}
+
+// ฟังก์ชันสำหรับย้ายตัวจับเวลาทั้งหมดในช่องหนึ่งของชั้นบนลงไปยังชั้นที่ตรงกับระยะเวลาที่เหลือ
+static void cascade_slot(TimingWheel* wheel, int slot) {
+    int timer = wheel->heads[slot];
+    wheel->heads[slot] = -1;
+    while (timer >= 0) {
+        int next = wheel->next[timer];
+        place_timer(wheel, timer);
+        timer = next;
+    }
+}
+
+// ฟังก์ชันสำหรับเดินหน้าวงล้อหนึ่งหน่วยเวลา แล้วเขียนหมายเลขของตัวจับเวลาที่หมดลงใน fired (คืนค่าจำนวน)
+// ตัวจับเวลาที่หมดถูกยกเลิกแล้ว fired ต้องมีขนาดอย่างน้อย num_timers
+int advance_timing_wheel(TimingWheel* wheel, int* fired) {
+    wheel->now++;
+    long now = wheel->now;
+    
+    // เมื่อชั้นล่างครบรอบ ย้ายช่องถัดไปของชั้นบนลงมา (เริ่มจากชั้นบนสุดที่ครบรอบพร้อมกัน)
+    int top = 0;
+    while (top < TIMING_WHEEL_LEVELS - 1 && (now & ((1L << (TIMING_WHEEL_BITS * (top + 1))) - 1)) == 0) {
+        top++;
+    }
+    for (int level = top; level >= 1; level--) {
+        cascade_slot(wheel, level * TIMING_WHEEL_SLOTS + (int)((now >> (TIMING_WHEEL_BITS * level)) & (TIMING_WHEEL_SLOTS - 1)));
+    }
+    
+    // ตัวจับเวลาทั้งหมดในช่องปัจจุบันของชั้นล่างหมดที่เวลานี้
+    int slot = (int)(now & (TIMING_WHEEL_SLOTS - 1));
+    int count = 0;
+    int timer = wheel->heads[slot];
+    wheel->heads[slot] = -1;
+    while (timer >= 0) {
+        int next = wheel->next[timer];
+        wheel->slot[timer] = -1;
+        wheel->expires[timer] = -1;
+        fired[count++] = timer;
+        timer = next;
+    }
+    
+    return count;
+}
+
+// ฟังก์ชันสำหรับลบวงล้อเวลาและคืนหน่วยความจำ
+void free_timing_wheel(TimingWheel* wheel) {
+    if (wheel == NULL) return;
+    
+    free(wheel->expires);
+    free(wheel->slot);
+    free(wheel->next);
+    free(wheel->prev);
+    free(wheel);
+}
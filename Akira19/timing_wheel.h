@@ -0,0 +1,40 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+ 
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdbool.h>
+ 
+ // จำนวนช่องต่อชั้นและจำนวนชั้นของวงล้อเวลา (ชั้นที่ k มีช่องละ 64^k หน่วยเวลา)
+ #define TIMING_WHEEL_BITS 6
+ #define TIMING_WHEEL_SLOTS (1 << TIMING_WHEEL_BITS)
+ #define TIMING_WHEEL_LEVELS 4
+ 
+ // วงล้อเวลาแบบลำดับชั้น (hierarchical timing wheel) สำหรับตัวจับเวลาที่มีหมายเลข 0 ถึง num_timers - 1
+ // ตัวจับเวลาที่ใกล้หมดอยู่ในชั้นล่าง (ช่องละหนึ่งหน่วยเวลา) ส่วนที่ไกลกว่าอยู่ในชั้นบนและถูกย้ายลงมาเมื่อใกล้ถึงเวลา
+ // การตั้ง ย้าย และยกเลิกตัวจับเวลาใช้ O(1) ส่วนการเดินหน้าหนึ่งหน่วยเวลาใช้เวลาตามจำนวนตัวจับเวลาที่หมดหรือถูกย้ายชั้น
+ typedef struct TimingWheel TimingWheel;
+ 
+ // ฟังก์ชันสำหรับสร้างวงล้อเวลาที่เริ่มที่เวลา start_time
+ TimingWheel* create_timing_wheel(int num_timers, long start_time);
+ 
+ // ฟังก์ชันสำหรับอ่านเวลาปัจจุบันของวงล้อ
+ long timing_wheel_time(const TimingWheel* wheel);
+ 
+ // ฟังก์ชันสำหรับตั้งตัวจับเวลาให้หมดที่เวลา expires (ต้องมากกว่าเวลาปัจจุบัน, ย้ายตัวจับเวลาเดิมถ้าตั้งไว้แล้ว)
+ void schedule_timer(TimingWheel* wheel, int timer, long expires);
+ 
+ // ฟังก์ชันสำหรับยกเลิกตัวจับเวลา
+ void cancel_timer(TimingWheel* wheel, int timer);
+ 
+ // ฟังก์ชันสำหรับอ่านเวลาที่ตัวจับเวลาจะหมด (-1 = ไม่ได้ตั้งไว้)
+ long timer_expiry(const TimingWheel* wheel, int timer);
+ 
+ // ฟังก์ชันสำหรับเดินหน้าวงล้อหนึ่งหน่วยเวลา แล้วเขียนหมายเลขของตัวจับเวลาที่หมดลงใน fired (คืนค่าจำนวน)
+ // ตัวจับเวลาที่หมดถูกยกเลิกแล้ว fired ต้องมีขนาดอย่างน้อย num_timers
+ int advance_timing_wheel(TimingWheel* wheel, int* fired);
+ 
+ // ฟังก์ชันสำหรับลบวงล้อเวลาและคืนหน่วยความจำ
+ void free_timing_wheel(TimingWheel* wheel);
+ 
+ #endif
@@ -1,4 +1,80 @@
 #include "traffic_signal.h"
+#include "max_pressure.h"
+#include <string.h>
+
+// ฟังก์ชันสำหรับจองตารางเฟสของระบบสัญญาณไฟ (ทิศทางและสถานะ ระยะเวลา และเวลาที่เหลือ)
+static void allocate_phase_tables(SignalSystem* system, int num_phases) {
+    int count = (num_phases > 0) ? num_phases : 1;
+    system->num_phases = num_phases;
+    system->phases = (SignalPhase*)malloc(count * sizeof(SignalPhase));
+    system->phase_durations = (int*)malloc(count * sizeof(int));
+    system->phase_remaining = (int*)malloc(count * sizeof(int));
+    if (system->phases == NULL || system->phase_durations == NULL || system->phase_remaining == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for signal phases\n");
+        exit(1);
+    }
+}
+
+// ฟังก์ชันสำหรับชี้เฟสของสัญญาณไฟเข้าไปในตารางเฟสที่ตำแหน่ง first_phase
+static void bind_signal_phases(TrafficSignal* signal, SignalPhase* phases, int* durations, int* remaining_times) {
+    signal->phases = phases + signal->first_phase;
+    signal->durations = durations + signal->first_phase;
+    signal->remaining_times = remaining_times + signal->first_phase;
+}
+
+// ฟังก์ชันสำหรับกำหนดค่าเริ่มต้นของสัญญาณไฟจราจร (เฟสต้องชี้เข้าไปในตารางแล้ว)
+static void init_traffic_signal(TrafficSignal* signal, int junction_id, bool is_adaptive) {
+    signal->junction_id = junction_id;
+    signal->current_phase = 0;
+    signal->is_adaptive = is_adaptive;
+    
+    // กำหนดค่าเริ่มต้นสำหรับแต่ละเฟส
+    for (int i = 0; i < signal->num_phases; i++) {
+        signal->phases[i].direction = i % 4; // 0 = เหนือ, 1 = ตะวันออก, 2 = ใต้, 3 = ตะวันตก
+        signal->phases[i].state = (i == 0) ? GREEN : RED; // เฟสแรกเป็นไฟเขียว ที่เหลือเป็นไฟแดง
+        signal->durations[i] = 30; // ค่าเริ่มต้น 30 วินาที
+        signal->remaining_times[i] = (i == 0) ? 30 : 0; // เฟสแรกเริ่มนับเวลา
+    }
+}
+
+// ฟังก์ชันสำหรับสร้างดัชนีของสัญญาณไฟตามทางแยกและวงล้อเวลาของการเปลี่ยนเฟส
+static void create_signal_schedule(SignalSystem* system, int num_junctions, long start_time) {
+    system->num_junctions = num_junctions;
+    system->signal_of_junction = (int*)malloc((num_junctions > 0 ? num_junctions : 1) * sizeof(int));
+    system->expired = (int*)malloc((system->num_signals > 0 ? system->num_signals : 1) * sizeof(int));
+    if (system->signal_of_junction == NULL || system->expired == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for traffic signal system\n");
+        exit(1);
+    }
+    
+    for (int v = 0; v < num_junctions; v++) {
+        system->signal_of_junction[v] = -1;
+    }
+    for (int i = 0; i < system->num_signals; i++) {
+        int junction_id = system->signals[i].junction_id;
+        if (junction_id >= 0 && junction_id < num_junctions) {
+            system->signal_of_junction[junction_id] = i;
+        }
+    }
+    
+    system->phase_timers = create_timing_wheel(system->num_signals, start_time);
+}
+
+// ฟังก์ชันสำหรับตั้งเวลาที่เฟสปัจจุบันของทุกสัญญาณไฟจะหมดจาก remaining_times
+static void schedule_all_signals(SignalSystem* system) {
+    long now = timing_wheel_time(system->phase_timers);
+    for (int i = 0; i < system->num_signals; i++) {
+        const TrafficSignal* signal = &system->signals[i];
+        if (signal->num_phases == 0) {
+            cancel_timer(system->phase_timers, i);
+            continue;
+        }
+        
+        // เวลาที่เหลือ 0 หรือน้อยกว่าหมายถึงเปลี่ยนเฟสในวินาทีถัดไป (เหมือนกับการนับถอยหลัง)
+        int remaining = signal->remaining_times[signal->current_phase];
+        schedule_timer(system->phase_timers, i, now + (remaining > 1 ? remaining : 1));
+    }
+}
 
 // ฟังก์ชันสำหรับสร้างระบบสัญญาณไฟจราจรใหม่
 SignalSystem* create_signal_system(Graph* graph) {
@@ -24,11 +100,11 @@ SignalSystem* create_signal_system(Graph* graph) {
         exit(1);
     }
     
-    // สร้างสัญญาณไฟจราจรสำหรับแต่ละทางแยกที่มีสัญญาณไฟ
+    // นับจำนวนเส้นทางที่เชื่อมต่อกับแต่ละทางแยก (หนึ่งเฟสต่อเส้นทาง) และตำแหน่งในตารางเฟส
     int j = 0;
+    int num_phases = 0;
     for (int i = 0; i < graph->num_vertices; i++) {
         if (graph->vertices[i].has_signal) {
-            // นับจำนวนเส้นทางที่เชื่อมต่อกับทางแยก
             int num_roads = 0;
             Edge* current = graph->vertices[i].head;
             while (current != NULL) {
@@ -36,8 +112,21 @@ SignalSystem* create_signal_system(Graph* graph) {
                 current = current->next;
             }
             
-            // สร้างสัญญาณไฟจราจรสำหรับทางแยกนี้
-            system->signals[j] = *create_traffic_signal(i, num_roads, true);
+            system->signals[j].num_phases = num_roads;
+            system->signals[j].first_phase = num_phases;
+            num_phases += num_roads;
+            j++;
+        }
+    }
+    
+    // สร้างสัญญาณไฟจราจรสำหรับแต่ละทางแยกที่มีสัญญาณไฟ โดยเฟสอยู่ในตารางเดียวกัน
+    allocate_phase_tables(system, num_phases);
+    j = 0;
+    for (int i = 0; i < graph->num_vertices; i++) {
+        if (graph->vertices[i].has_signal) {
+            TrafficSignal* signal = &system->signals[j];
+            bind_signal_phases(signal, system->phases, system->phase_durations, system->phase_remaining);
+            init_traffic_signal(signal, i, true);
             j++;
         }
     }
@@ -45,16 +134,41 @@ SignalSystem* create_signal_system(Graph* graph) {
     // สร้างคิวสำหรับจัดลำดับความสำคัญ
     system->queue = create_priority_queue();
     
-    // เพิ่มทางแยกที่มีสัญญาณไฟลงในคิว
+    // เพิ่มทางแยกที่มีสัญญาณไฟลงในคิว (สร้างฮีปครั้งเดียวจากอาเรย์)
+    int* junction_ids = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+    float* congestion = (float*)malloc((count > 0 ? count : 1) * sizeof(float));
+    if (junction_ids == NULL || congestion == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for traffic signal system\n");
+        exit(1);
+    }
     for (int i = 0; i < system->num_signals; i++) {
-        int junction_id = system->signals[i].junction_id;
-        float congestion = calculate_junction_congestion(graph, junction_id);
-        enqueue(system->queue, junction_id, congestion);
+        junction_ids[i] = system->signals[i].junction_id;
+        congestion[i] = calculate_junction_congestion(graph, junction_ids[i]);
     }
+    rebuild_priority_queue(system->queue, junction_ids, congestion, system->num_signals);
+    free(junction_ids);
+    free(congestion);
+    
+    // ตั้งเวลาของเฟสแรกของทุกสัญญาณไฟ (ระยะเวลาถูกปรับตามการจราจรในการอัปเดตครั้งแรก)
+    create_signal_schedule(system, graph->num_vertices, 0);
+    schedule_all_signals(system);
+    system->timing_ready = false;
+    system->phase_changes = 0;
+    system->controller = NULL;
     
     return system;
 }
 
+// ฟังก์ชันสำหรับสร้างระบบสัญญาณไฟจราจรใหม่แล้วเลื่อนรอบของสัญญาณไฟตามไฟล์ offset (คืนค่า NULL ถ้าอ่านไม่สำเร็จ)
+SignalSystem* create_signal_system_with_offsets(Graph* graph, const char* path) {
+    SignalSystem* system = create_signal_system(graph);
+    if (!load_signal_offsets(system, path)) {
+        free_signal_system(system);
+        return NULL;
+    }
+    return system;
+}
+
 // ฟังก์ชันสำหรับสร้างสัญญาณไฟจราจรที่ทางแยก
 TrafficSignal* create_traffic_signal(int junction_id, int num_phases, bool is_adaptive) {
     TrafficSignal* signal = (TrafficSignal*)malloc(sizeof(TrafficSignal));
@@ -63,25 +177,19 @@ TrafficSignal* create_traffic_signal(int junction_id, int num_phases, bool is_ad
         exit(1);
     }
     
-    signal->junction_id = junction_id;
+    // สัญญาณไฟที่สร้างแยกมีตารางเฟสของตัวเอง
+    int count = (num_phases > 0) ? num_phases : 1;
     signal->num_phases = num_phases;
-    signal->phases = (SignalPhase*)malloc(num_phases * sizeof(SignalPhase));
-    if (signal->phases == NULL && num_phases > 0) {
+    signal->first_phase = 0;
+    signal->phases = (SignalPhase*)malloc(count * sizeof(SignalPhase));
+    signal->durations = (int*)malloc(count * sizeof(int));
+    signal->remaining_times = (int*)malloc(count * sizeof(int));
+    if (signal->phases == NULL || signal->durations == NULL || signal->remaining_times == NULL) {
         fprintf(stderr, "Error: Unable to allocate memory for signal phases\n");
-        free(signal);
         exit(1);
     }
     
-    signal->current_phase = 0;
-    signal->is_adaptive = is_adaptive;
-    
-    // กำหนดค่าเริ่มต้นสำหรับแต่ละเฟส
-    for (int i = 0; i < num_phases; i++) {
-        signal->phases[i].direction = i % 4; // 0 = เหนือ, 1 = ตะวันออก, 2 = ใต้, 3 = ตะวันตก
-        signal->phases[i].state = (i == 0) ? GREEN : RED; // เฟสแรกเป็นไฟเขียว ที่เหลือเป็นไฟแดง
-        signal->phases[i].duration = 30; // ค่าเริ่มต้น 30 วินาที
-        signal->phases[i].remaining_time = (i == 0) ? 30 : 0; // เฟสแรกเริ่มนับเวลา
-    }
+    init_traffic_signal(signal, junction_id, is_adaptive);
     
     return signal;
 }
@@ -95,32 +203,37 @@ void set_signal_phase(TrafficSignal* signal, int phase_index, int direction, Sig
     
     signal->phases[phase_index].direction = direction;
     signal->phases[phase_index].state = state;
-    signal->phases[phase_index].duration = duration;
+    signal->durations[phase_index] = duration;
     
     // ถ้าเป็นเฟสปัจจุบัน ให้ตั้งค่าเวลาที่เหลือ
     if (phase_index == signal->current_phase) {
-        signal->phases[phase_index].remaining_time = duration;
+        signal->remaining_times[phase_index] = duration;
     } else {
-        signal->phases[phase_index].remaining_time = 0;
+        signal->remaining_times[phase_index] = 0;
     }
 }
 
+// ฟังก์ชันสำหรับเปลี่ยนสัญญาณไฟไปเฟสถัดไป
+static void switch_signal_phase(TrafficSignal* signal) {
+    // เปลี่ยนสถานะเฟสปัจจุบันเป็นไฟแดง
+    signal->phases[signal->current_phase].state = RED;
+    
+    // เปลี่ยนไปเฟสถัดไป
+    signal->current_phase = (signal->current_phase + 1) % signal->num_phases;
+    
+    // เปลี่ยนสถานะเฟสใหม่เป็นไฟเขียว และตั้งค่าเวลาที่เหลือ
+    signal->phases[signal->current_phase].state = GREEN;
+    signal->remaining_times[signal->current_phase] = signal->durations[signal->current_phase];
+}
+
 // ฟังก์ชันสำหรับอัปเดตสัญญาณไฟจราจร (ลดเวลาที่เหลือและเปลี่ยนเฟส)
 void update_traffic_signal(TrafficSignal* signal) {
     // ลดเวลาที่เหลือของเฟสปัจจุบัน
-    signal->phases[signal->current_phase].remaining_time--;
+    signal->remaining_times[signal->current_phase]--;
     
     // ถ้าเวลาหมด ให้เปลี่ยนเฟส
-    if (signal->phases[signal->current_phase].remaining_time <= 0) {
-        // เปลี่ยนสถานะเฟสปัจจุบันเป็นไฟแดง
-        signal->phases[signal->current_phase].state = RED;
-        
-        // เปลี่ยนไปเฟสถัดไป
-        signal->current_phase = (signal->current_phase + 1) % signal->num_phases;
-        
-        // เปลี่ยนสถานะเฟสใหม่เป็นไฟเขียว และตั้งค่าเวลาที่เหลือ
-        signal->phases[signal->current_phase].state = GREEN;
-        signal->phases[signal->current_phase].remaining_time = signal->phases[signal->current_phase].duration;
+    if (signal->remaining_times[signal->current_phase] <= 0) {
+        switch_signal_phase(signal);
     }
 }
 
@@ -131,16 +244,9 @@ float calculate_junction_congestion(Graph* graph, int junction_id) {
         return 0.0;
     }
     
-    // นับจำนวนรถทั้งหมดและความจุทั้งหมดของถนนที่เชื่อมต่อกับทางแยก
-    int total_load = 0;
-    int total_capacity = 0;
-    
-    Edge* current = graph->vertices[junction_id].head;
-    while (current != NULL) {
-        total_load += current->road->current_load;
-        total_capacity += current->road->capacity;
-        current = current->next;
-    }
+    // จำนวนรถทั้งหมดและความจุทั้งหมดของถนนที่เชื่อมต่อกับทางแยก (ผลรวมที่อัปเดตทุกครั้งที่จำนวนรถเปลี่ยน)
+    int total_load = graph->junction_loads[junction_id].total_load;
+    int total_capacity = graph->junction_loads[junction_id].total_capacity;
     
     // คำนวณความหนาแน่น (0.0 - 1.0)
     float congestion = (total_capacity > 0) ? (float)total_load / total_capacity : 0.0;
@@ -156,25 +262,9 @@ void adjust_signal_timing(Graph* graph, TrafficSignal* signal) {
         return;
     }
     
-    // คำนวณความหนาแน่นของการจราจรในแต่ละทิศทาง
-    float direction_congestion[4] = {0.0, 0.0, 0.0, 0.0}; // เหนือ, ตะวันออก, ใต้, ตะวันตก
-    
-    Edge* current = graph->vertices[signal->junction_id].head;
-    while (current != NULL) {
-        // ใช้ความรู้ภายนอกสมมติว่าเราสามารถกำหนดทิศทางของถนนได้
-        int direction = current->dest % 4; // ใช้ปลายทางเป็นตัวกำหนดทิศทาง (นี่เป็นเพียงตัวอย่าง)
-        
-        // คำนวณความหนาแน่นของถนนนี้
-        float road_congestion = (float)current->road->current_load / current->road->capacity;
-        if (road_congestion > 1.0) road_congestion = 1.0;
-        
-        // อัปเดตความหนาแน่นสูงสุดในทิศทางนี้
-        if (road_congestion > direction_congestion[direction]) {
-            direction_congestion[direction] = road_congestion;
-        }
-        
-        current = current->next;
-    }
+    // ความหนาแน่นสูงสุดของการจราจรในแต่ละทิศทาง (เหนือ, ตะวันออก, ใต้, ตะวันตก)
+    // คำนวณใหม่เฉพาะเมื่อจำนวนรถบนถนนของทางแยกนี้เปลี่ยน
+    const float* direction_congestion = junction_direction_congestion(graph, signal->junction_id);
     
     // ปรับระยะเวลาของแต่ละเฟสตามความหนาแน่น
     for (int i = 0; i < signal->num_phases; i++) {
@@ -187,39 +277,242 @@ void adjust_signal_timing(Graph* graph, TrafficSignal* signal) {
         int new_duration = base_duration + (int)(direction_congestion[direction] * max_additional);
         
         // ตั้งค่าระยะเวลาใหม่
-        signal->phases[i].duration = new_duration;
+        signal->durations[i] = new_duration;
         
         // ถ้าเป็นเฟสปัจจุบันและเวลาที่เหลือมากกว่าระยะเวลาใหม่ ให้ปรับเวลาที่เหลือด้วย
-        if (i == signal->current_phase && signal->phases[i].remaining_time > new_duration) {
-            signal->phases[i].remaining_time = new_duration;
+        if (i == signal->current_phase && signal->remaining_times[i] > new_duration) {
+            signal->remaining_times[i] = new_duration;
         }
     }
 }
 
+// ฟังก์ชันสำหรับปรับระยะเวลาของสัญญาณไฟหนึ่งจุด แล้วย้ายเวลาที่เฟสปัจจุบันจะหมดในวงล้อเวลา
+static void retime_signal(Graph* graph, SignalSystem* system, int index) {
+    TrafficSignal* signal = &system->signals[index];
+    if (signal->num_phases == 0) {
+        return;
+    }
+    
+    long now = timing_wheel_time(system->phase_timers);
+    int* remaining = &signal->remaining_times[signal->current_phase];
+    *remaining = (int)(timer_expiry(system->phase_timers, index) - now);
+    adjust_signal_timing(graph, signal);
+    schedule_timer(system->phase_timers, index, now + (*remaining > 1 ? *remaining : 1));
+}
+
 // ฟังก์ชันสำหรับจัดการคิวสัญญาณไฟจราจรอัจฉริยะ
 void manage_signal_queue(Graph* graph, SignalSystem* system) {
-    // ประเมินความหนาแน่นของการจราจรที่ทางแยกทั้งหมด
-    for (int i = 0; i < system->num_signals; i++) {
-        int junction_id = system->signals[i].junction_id;
-        float congestion = calculate_junction_congestion(graph, junction_id);
+    // ประเมินความหนาแน่นใหม่เฉพาะทางแยกที่จำนวนรถเปลี่ยนตั้งแต่ครั้งก่อน (ทางแยกอื่นมีค่าในคิวถูกต้องอยู่แล้ว)
+    for (int k = 0; k < graph->num_changed_junctions; k++) {
+        int junction_id = graph->changed_junctions[k];
+        graph->junction_loads[junction_id].changed = false;
         
-        // อัปเดตค่าความสำคัญในคิว
-        update_priority(system->queue, junction_id, congestion);
+        // อัปเดตค่าความสำคัญในคิว (เฉพาะทางแยกที่มีสัญญาณไฟ)
+        if (queue_contains(system->queue, junction_id)) {
+            update_priority(system->queue, junction_id, calculate_junction_congestion(graph, junction_id));
+        }
+        
+        // ปรับระยะเวลาของเฟสตามความหนาแน่นใหม่ (ถ้ายังไม่ได้ปรับครั้งแรก จะปรับทุกสัญญาณไฟใน advance_signal_system)
+        if (system->timing_ready && system->controller == NULL && junction_id < system->num_junctions && system->signal_of_junction[junction_id] >= 0) {
+            retime_signal(graph, system, system->signal_of_junction[junction_id]);
+        }
     }
+    graph->num_changed_junctions = 0;
 }
 
 // ฟังก์ชันสำหรับอัปเดตระบบสัญญาณไฟจราจรทั้งหมด
 void update_signal_system(Graph* graph, SignalSystem* system) {
-    // จัดการคิวสัญญาณไฟจราจรอัจฉริยะ
+    advance_signal_system(graph, system, 1);
+}
+
+// ฟังก์ชันสำหรับอัปเดตระบบสัญญาณไฟจราจรไปข้างหน้า seconds วินาที
+// ประเมินการจราจรและปรับระยะเวลาของเฟสครั้งเดียว (เฉพาะทางแยกที่จำนวนรถเปลี่ยน) แล้วเดินหน้าวงล้อเวลาทีละวินาที
+// สัญญาณไฟถูกอัปเดตเฉพาะเมื่อเฟสหมด เวลาที่ใช้จึงขึ้นกับจำนวนครั้งที่เปลี่ยนเฟส ไม่ใช่จำนวนสัญญาณไฟ
+// ถ้าการจราจรไม่เปลี่ยนระหว่างนั้น ผลลัพธ์เหมือนกับเรียก update_signal_system ทุกวินาที
+void advance_signal_system(Graph* graph, SignalSystem* system, int seconds) {
+    // จัดการคิวสัญญาณไฟจราจรอัจฉริยะและปรับระยะเวลาของทางแยกที่การจราจรเปลี่ยน
     manage_signal_queue(graph, system);
     
-    // ปรับระยะเวลาของสัญญาณไฟจราจรตามความหนาแน่น
+    // ตัวควบคุมแบบ max-pressure ตัดสินใจเฟสของสัญญาณไฟที่ถึงเวลาในแต่ละวินาที (ไม่ใช้รอบของเฟส)
+    if (system->controller != NULL) {
+        for (int s = 0; s < seconds; s++) {
+            int count = advance_timing_wheel(system->phase_timers, system->expired);
+            system->phase_changes += run_max_pressure_decisions(system, system->expired, count);
+        }
+        return;
+    }
+    
+    // ครั้งแรกปรับระยะเวลาของสัญญาณไฟจราจรทุกจุดตามความหนาแน่น
+    if (!system->timing_ready) {
+        for (int i = 0; i < system->num_signals; i++) {
+            retime_signal(graph, system, i);
+        }
+        system->timing_ready = true;
+    }
+    
+    // เปลี่ยนเฟสของสัญญาณไฟที่เฟสหมดในแต่ละวินาที แล้วตั้งเวลาของเฟสถัดไป
+    for (int s = 0; s < seconds; s++) {
+        int count = advance_timing_wheel(system->phase_timers, system->expired);
+        long now = timing_wheel_time(system->phase_timers);
+        for (int k = 0; k < count; k++) {
+            TrafficSignal* signal = &system->signals[system->expired[k]];
+            signal->remaining_times[signal->current_phase] = 0;
+            switch_signal_phase(signal);
+            
+            int duration = signal->durations[signal->current_phase];
+            schedule_timer(system->phase_timers, system->expired[k], now + (duration > 1 ? duration : 1));
+        }
+        system->phase_changes += count;
+    }
+}
+
+// ฟังก์ชันสำหรับเขียนเวลาที่เหลือของเฟสปัจจุบันของทุกสัญญาณไฟจากวงล้อเวลา
+void sync_signal_remaining_times(SignalSystem* system) {
+    long now = timing_wheel_time(system->phase_timers);
     for (int i = 0; i < system->num_signals; i++) {
-        adjust_signal_timing(graph, &system->signals[i]);
+        TrafficSignal* signal = &system->signals[i];
+        long expires = timer_expiry(system->phase_timers, i);
+        if (signal->num_phases > 0 && expires >= 0) {
+            signal->remaining_times[signal->current_phase] = (int)(expires - now);
+        }
+    }
+}
+
+// ฟังก์ชันสำหรับตั้งเวลาของทุกสัญญาณไฟใหม่จาก current_phase และ remaining_times
+void refresh_signal_schedule(SignalSystem* system) {
+    schedule_all_signals(system);
+    system->timing_ready = false;
+}
+
+// ฟังก์ชันสำหรับตั้งรอบคงที่ cycle วินาทีให้สัญญาณไฟ (แบ่งเท่า ๆ กันทุกเฟส และไม่ปรับตามความหนาแน่นอีก)
+bool set_signal_fixed_cycle(TrafficSignal* signal, int cycle) {
+    if (signal->num_phases == 0 || cycle < signal->num_phases) {
+        return false;
+    }
+    
+    // เศษของการแบ่งให้เฟสแรก ๆ เฟสละหนึ่งวินาที ผลรวมจึงเท่ากับ cycle พอดี
+    for (int i = 0; i < signal->num_phases; i++) {
+        signal->durations[i] = cycle / signal->num_phases + ((i < cycle % signal->num_phases) ? 1 : 0);
+    }
+    signal->is_adaptive = false;
+    return true;
+}
+
+// ฟังก์ชันสำหรับเลื่อนรอบของสัญญาณไฟให้เฟส 0 เริ่มไฟเขียวที่วินาที offset ของรอบ (elapsed = เวลาปัจจุบัน)
+// ต้องเรียก refresh_signal_schedule หลังเลื่อนรอบของสัญญาณไฟในระบบ
+void set_signal_offset(TrafficSignal* signal, int offset, long elapsed) {
+    int cycle = 0;
+    for (int i = 0; i < signal->num_phases; i++) {
+        cycle += (signal->durations[i] > 1) ? signal->durations[i] : 1;
+    }
+    if (cycle == 0) {
+        return;
+    }
+    
+    // ตำแหน่งในรอบ ณ เวลาปัจจุบัน แล้วหาเฟสที่ครอบคลุมตำแหน่งนั้น
+    long position = ((elapsed - offset) % cycle + cycle) % cycle;
+    int start = 0;
+    for (int i = 0; i < signal->num_phases; i++) {
+        int duration = (signal->durations[i] > 1) ? signal->durations[i] : 1;
+        signal->phases[i].state = RED;
+        signal->remaining_times[i] = 0;
+        if (position >= start && position < start + duration) {
+            signal->current_phase = i;
+            signal->phases[i].state = GREEN;
+            signal->remaining_times[i] = start + duration - (int)position;
+        }
+        start += duration;
+    }
+}
+
+// ฟังก์ชันสำหรับอ่านไฟล์ offset แล้วตั้งรอบคงที่และเลื่อนรอบของสัญญาณไฟ (คืนค่า false ถ้าอ่านไม่สำเร็จ)
+bool load_signal_offsets(SignalSystem* system, const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Unable to open signal offset file '%s'\n", path);
+        return false;
+    }
+    
+    long now = timing_wheel_time(system->phase_timers);
+    char line[256];
+    int line_number = 0;
+    int cycle = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), file) != NULL) {
+        line_number++;
+        
+        char* token = strtok(line, " \t\r\n");
+        if (token == NULL || token[0] == '#') {
+            continue;
+        }
         
-        // อัปเดตสัญญาณไฟจราจร
-        update_traffic_signal(&system->signals[i]);
+        // ความยาวรอบคงที่ของสัญญาณไฟในบรรทัดที่ตามมา
+        if (strcmp(token, "cycle") == 0) {
+            char* seconds = strtok(NULL, " \t\r\n");
+            cycle = (seconds != NULL) ? atoi(seconds) : 0;
+            if (cycle <= 0) {
+                fprintf(stderr, "Error: Expected 'cycle <seconds>' at %s:%d\n", path, line_number);
+                ok = false;
+            }
+            continue;
+        }
+        
+        char* junction = strtok(NULL, " \t\r\n");
+        char* seconds = strtok(NULL, " \t\r\n");
+        if (strcmp(token, "offset") != 0 || junction == NULL || seconds == NULL) {
+            fprintf(stderr, "Error: Expected 'offset <junction> <seconds>' at %s:%d\n", path, line_number);
+            ok = false;
+            break;
+        }
+        
+        int junction_id = atoi(junction);
+        int index = (junction_id >= 0 && junction_id < system->num_junctions) ? system->signal_of_junction[junction_id] : -1;
+        if (index < 0) {
+            fprintf(stderr, "Error: Junction %s at %s:%d has no traffic signal\n", junction, path, line_number);
+            ok = false;
+            break;
+        }
+        if (cycle > 0 && !set_signal_fixed_cycle(&system->signals[index], cycle)) {
+            fprintf(stderr, "Error: Cycle of %d s is too short for junction %s at %s:%d\n", cycle, junction, path,
+                    line_number);
+            ok = false;
+            break;
+        }
+        set_signal_offset(&system->signals[index], atoi(seconds), now);
     }
+    
+    fclose(file);
+    refresh_signal_schedule(system);
+    return ok;
+}
+
+// ฟังก์ชันสำหรับเขียนไฟล์ offset ของรอบคงที่ cycle วินาที (offsets ตามดัชนีของสัญญาณไฟ, -1 = ไม่อยู่ในไฟล์)
+bool save_signal_offsets(const SignalSystem* system, int cycle, const int* offsets, const char* path) {
+    if (cycle <= 0) {
+        fprintf(stderr, "Error: Invalid signal cycle length %d\n", cycle);
+        return false;
+    }
+    
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Unable to open signal offset file '%s'\n", path);
+        return false;
+    }
+    
+    fprintf(file, "# รอบคงที่และ offset ของสัญญาณไฟ (วินาทีของรอบที่เฟส 0 เริ่มไฟเขียว)\n");
+    fprintf(file, "# offset <ID ของทางแยก> <วินาที>\n");
+    fprintf(file, "cycle %d\n", cycle);
+    for (int i = 0; i < system->num_signals; i++) {
+        if (offsets[i] >= 0) {
+            fprintf(file, "offset %d %d\n", system->signals[i].junction_id, offsets[i]);
+        }
+    }
+    
+    bool ok = (fclose(file) == 0);
+    if (!ok) {
+        fprintf(stderr, "Error: Unable to write signal offset file '%s'\n", path);
+    }
+    return ok;
 }
 
 // ฟังก์ชันสำหรับแสดงข้อมูลของสัญญาณไฟจราจร
@@ -254,8 +547,8 @@ void print_traffic_signal(TrafficSignal* signal) {
         }
         printf("      State: %s\n", state_str);
         
-        printf("      Duration: %d seconds\n", signal->phases[i].duration);
-        printf("      Remaining time: %d seconds\n", signal->phases[i].remaining_time);
+        printf("      Duration: %d seconds\n", signal->durations[i]);
+        printf("      Remaining time: %d seconds\n", signal->remaining_times[i]);
     }
 }
 
@@ -264,6 +557,9 @@ void print_signal_system(SignalSystem* system) {
     printf("Traffic Signal System:\n");
     printf("Total number of traffic signals: %d\n", system->num_signals);
     
+    // เวลาที่เหลือของเฟสปัจจุบันอยู่ในวงล้อเวลา
+    sync_signal_remaining_times(system);
+    
     // แสดงข้อมูลคิว
     printf("\nPriority Queue:\n");
     print_queue(system->queue);
@@ -280,30 +576,79 @@ void print_signal_system(SignalSystem* system) {
 void free_traffic_signal(TrafficSignal* signal) {
     if (signal == NULL) return;
     
-    // ลบเฟส
-    if (signal->phases != NULL) {
-        free(signal->phases);
-    }
+    // ลบตารางเฟสของสัญญาณไฟ
+    free(signal->phases);
+    free(signal->durations);
+    free(signal->remaining_times);
     
     // ลบสัญญาณไฟจราจร
     free(signal);
 }
 
-// ฟังก์ชันสำหรับลบระบบสัญญาณไฟจราจรและคืนหน่วยความจำ
-void free_signal_system(SignalSystem* system) {
-    if (system == NULL) return;
+// ฟังก์ชันสำหรับสร้างสำเนาของระบบสัญญาณไฟจราจร (เฟส เวลาที่เหลือ และคิวเหมือนต้นฉบับ)
+SignalSystem* clone_signal_system(const SignalSystem* system) {
+    SignalSystem* copy = (SignalSystem*)malloc(sizeof(SignalSystem));
+    if (copy == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for traffic signal system\n");
+        exit(1);
+    }
+    
+    copy->num_signals = system->num_signals;
+    copy->signals = (TrafficSignal*)malloc((system->num_signals > 0 ? system->num_signals : 1) * sizeof(TrafficSignal));
+    if (copy->signals == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for traffic signals\n");
+        exit(1);
+    }
+    
+    // คัดลอกตารางเฟสทั้งก้อน แล้วชี้เฟสของสัญญาณไฟเข้าไปในตารางใหม่
+    allocate_phase_tables(copy, system->num_phases);
+    memcpy(copy->phases, system->phases, system->num_phases * sizeof(SignalPhase));
+    memcpy(copy->phase_durations, system->phase_durations, system->num_phases * sizeof(int));
+    memcpy(copy->phase_remaining, system->phase_remaining, system->num_phases * sizeof(int));
+    for (int i = 0; i < system->num_signals; i++) {
+        copy->signals[i] = system->signals[i];
+        bind_signal_phases(&copy->signals[i], copy->phases, copy->phase_durations, copy->phase_remaining);
+    }
+    
+    copy->queue = copy_priority_queue(system->queue);
     
-    // ลบสัญญาณไฟจราจรทั้งหมด
+    // วงล้อเวลาใหม่ที่มีเวลาที่เฟสหมดเหมือนต้นฉบับ
+    long now = timing_wheel_time(system->phase_timers);
     for (int i = 0; i < system->num_signals; i++) {
-        free(system->signals[i].phases);
+        TrafficSignal* signal = &copy->signals[i];
+        long expires = timer_expiry(system->phase_timers, i);
+        if (signal->num_phases > 0 && expires >= 0) {
+            signal->remaining_times[signal->current_phase] = (int)(expires - now);
+        }
     }
+    create_signal_schedule(copy, system->num_junctions, now);
+    schedule_all_signals(copy);
+    copy->timing_ready = system->timing_ready && system->controller == NULL;
+    copy->phase_changes = system->phase_changes;
+    copy->controller = NULL; // ติดตั้งใหม่บนสำเนาของเครือข่ายด้วย copy_max_pressure_control
+    
+    return copy;
+}
+
+// ฟังก์ชันสำหรับลบระบบสัญญาณไฟจราจรและคืนหน่วยความจำ
+void free_signal_system(SignalSystem* system) {
+    if (system == NULL) return;
     
-    // ลบอาเรย์ของสัญญาณไฟจราจร
+    // ลบอาเรย์ของสัญญาณไฟจราจรและตารางเฟส
     free(system->signals);
+    free(system->phases);
+    free(system->phase_durations);
+    free(system->phase_remaining);
     
     // ลบคิว
     free_queue(system->queue);
     
+    // ลบวงล้อเวลา ดัชนีของสัญญาณไฟ และตัวควบคุม
+    free_max_pressure_controller(system->controller);
+    free_timing_wheel(system->phase_timers);
+    free(system->signal_of_junction);
+    free(system->expired);
+    
     // ลบระบบ
     free(system);
 }
@@ -6,6 +6,7 @@
  #include <stdbool.h>
  #include "graph.h"
  #include "queue.h"
+ #include "timing_wheel.h"
  
  // สถานะของสัญญาณไฟจราจร
  typedef enum {
@@ -14,33 +15,57 @@
      YELLOW
  } SignalState;
  
- // โครงสร้างข้อมูลของเฟสสัญญาณไฟจราจร
+ // โครงสร้างข้อมูลของเฟสสัญญาณไฟจราจร (ระยะเวลาและเวลาที่เหลืออยู่ในอาเรย์คู่ขนานของสัญญาณไฟ)
  typedef struct {
      int direction;       // ทิศทาง (0 = เหนือ, 1 = ตะวันออก, 2 = ใต้, 3 = ตะวันตก)
      SignalState state;   // สถานะปัจจุบัน
-     int duration;        // ระยะเวลา (วินาที)
-     int remaining_time;  // เวลาที่เหลือ (วินาที)
  } SignalPhase;
  
  // โครงสร้างข้อมูลของสัญญาณไฟจราจรที่ทางแยก
+ // phases, durations และ remaining_times ชี้เข้าไปในตารางเฟสของ SignalSystem ที่ตำแหน่ง first_phase
+ // (สัญญาณไฟที่สร้างด้วย create_traffic_signal มีตารางของตัวเอง)
  typedef struct {
      int junction_id;     // ID ของทางแยก
      int num_phases;      // จำนวนเฟส
-     SignalPhase* phases; // อาเรย์ของเฟส
+     int first_phase;     // ตำแหน่งของเฟสแรกในตารางเฟส
+     SignalPhase* phases; // ทิศทางและสถานะของแต่ละเฟส
+     int* durations;      // ระยะเวลาของแต่ละเฟส (วินาที)
+     int* remaining_times; // เวลาที่เหลือของแต่ละเฟส (วินาที)
      int current_phase;   // เฟสปัจจุบัน
      bool is_adaptive;    // เป็นระบบปรับตัวหรือไม่
  } TrafficSignal;
  
+ // ตัวควบคุมสัญญาณไฟแบบ max-pressure (max_pressure.h)
+ struct MaxPressureController;
+ 
  // โครงสร้างข้อมูลของระบบสัญญาณไฟจราจร
+ // เฟสของทุกสัญญาณไฟเก็บต่อกันในตารางเดียว (ทิศทางและสถานะ ระยะเวลา และเวลาที่เหลือเป็นอาเรย์คู่ขนาน)
+ // การอัปเดตทั้งระบบจึงอ่านหน่วยความจำต่อเนื่อง และไม่ต้องจองหน่วยความจำแยกต่อสัญญาณไฟ
+ // เวลาที่เฟสปัจจุบันของแต่ละสัญญาณไฟจะหมดเก็บในวงล้อเวลา (ไม่ได้ลดเวลาที่เหลือทุกวินาที)
+ // เวลาที่เหลือของเฟสปัจจุบันจึงถูกต้องหลังเรียก sync_signal_remaining_times เท่านั้น
  typedef struct {
      int num_signals;         // จำนวนสัญญาณไฟจราจร
      TrafficSignal* signals;  // อาเรย์ของสัญญาณไฟจราจร
+     int num_phases;          // จำนวนเฟสทั้งหมดของทุกสัญญาณไฟ
+     SignalPhase* phases;     // ตารางเฟสของทุกสัญญาณไฟ (เรียงตามสัญญาณไฟ)
+     int* phase_durations;    // ระยะเวลาของทุกเฟส (วินาที)
+     int* phase_remaining;    // เวลาที่เหลือของทุกเฟส (วินาที)
      PriorityQueue* queue;    // คิวสำหรับจัดลำดับความสำคัญ
+     TimingWheel* phase_timers; // เวลาที่เฟสปัจจุบันของแต่ละสัญญาณไฟจะหมด (ตามดัชนีของสัญญาณไฟ)
+     int* signal_of_junction; // ดัชนีของสัญญาณไฟของแต่ละทางแยก (-1 = ไม่มี)
+     int num_junctions;       // จำนวนทางแยกของกราฟ
+     int* expired;            // บัฟเฟอร์ของสัญญาณไฟที่เฟสหมดในวินาทีเดียวกัน
+     bool timing_ready;       // ปรับระยะเวลาของทุกสัญญาณไฟแล้ว (false = ปรับทุกสัญญาณไฟในการอัปเดตครั้งถัดไป)
+     long phase_changes;      // จำนวนครั้งที่เปลี่ยนเฟสทั้งหมด
+     struct MaxPressureController* controller; // ตัวควบคุมแบบ max-pressure (NULL = รอบของเฟสที่ปรับระยะเวลาตามความหนาแน่น)
  } SignalSystem;
  
  // ฟังก์ชันสำหรับสร้างระบบสัญญาณไฟจราจรใหม่
  SignalSystem* create_signal_system(Graph* graph);
  
+ // ฟังก์ชันสำหรับสร้างระบบสัญญาณไฟจราจรใหม่แล้วเลื่อนรอบของสัญญาณไฟตามไฟล์ offset (คืนค่า NULL ถ้าอ่านไม่สำเร็จ)
+ SignalSystem* create_signal_system_with_offsets(Graph* graph, const char* path);
+ 
  // ฟังก์ชันสำหรับสร้างสัญญาณไฟจราจรที่ทางแยก
  TrafficSignal* create_traffic_signal(int junction_id, int num_phases, bool is_adaptive);
  
@@ -62,6 +87,37 @@
  // ฟังก์ชันสำหรับอัปเดตระบบสัญญาณไฟจราจรทั้งหมด
  void update_signal_system(Graph* graph, SignalSystem* system);
  
+ // ฟังก์ชันสำหรับอัปเดตระบบสัญญาณไฟจราจรไปข้างหน้า seconds วินาที (ประเมินการจราจรครั้งเดียว)
+ void advance_signal_system(Graph* graph, SignalSystem* system, int seconds);
+ 
+ // ฟังก์ชันสำหรับเขียนเวลาที่เหลือของเฟสปัจจุบันของทุกสัญญาณไฟจากวงล้อเวลา
+ void sync_signal_remaining_times(SignalSystem* system);
+ 
+ // ฟังก์ชันสำหรับตั้งเวลาของทุกสัญญาณไฟใหม่จาก current_phase และเวลาที่เหลือของเฟสปัจจุบัน
+ // เรียกหลังแก้ไขเฟสของสัญญาณไฟโดยตรง (เช่น โหลดจุดบันทึก) ระยะเวลาจะถูกปรับใหม่ในการอัปเดตครั้งถัดไป
+ void refresh_signal_schedule(SignalSystem* system);
+ 
+ // ไฟล์ offset ของรอบสัญญาณไฟเป็นข้อความ (# = หมายเหตุ):
+ //   cycle <วินาที>                  ความยาวรอบคงที่ของสัญญาณไฟในบรรทัด offset ที่ตามมา
+ //   offset <ID ของทางแยก> <วินาที>   วินาทีของรอบที่เฟส 0 เริ่มไฟเขียว นับจากเวลา 0 ของระบบ
+ // สัญญาณไฟในไฟล์ใช้รอบคงที่ (ไม่ปรับตามความหนาแน่น) รอบจึงไม่เลื่อนหลังเริ่มการจำลอง
+ // ทางแยกที่ไม่อยู่ในไฟล์เริ่มรอบตามปกติและปรับระยะเวลาตามความหนาแน่น
+ 
+ // ฟังก์ชันสำหรับตั้งรอบคงที่ cycle วินาทีให้สัญญาณไฟ (แบ่งเท่า ๆ กันทุกเฟส และไม่ปรับตามความหนาแน่นอีก)
+ // คืนค่า false ถ้ารอบสั้นกว่าหนึ่งวินาทีต่อเฟส
+ bool set_signal_fixed_cycle(TrafficSignal* signal, int cycle);
+ 
+ // ฟังก์ชันสำหรับเลื่อนรอบของสัญญาณไฟให้เฟส 0 เริ่มไฟเขียวที่วินาที offset ของรอบ (elapsed = เวลาปัจจุบัน)
+ // ใช้ระยะเวลาปัจจุบันของเฟส ต้องเรียก refresh_signal_schedule หลังเลื่อนรอบของสัญญาณไฟในระบบ
+ void set_signal_offset(TrafficSignal* signal, int offset, long elapsed);
+ 
+ // ฟังก์ชันสำหรับอ่านไฟล์ offset แล้วตั้งรอบคงที่และเลื่อนรอบของสัญญาณไฟ (คืนค่า false ถ้าอ่านไม่สำเร็จ)
+ bool load_signal_offsets(SignalSystem* system, const char* path);
+ 
+ // ฟังก์ชันสำหรับเขียนไฟล์ offset ของรอบคงที่ cycle วินาที (offsets ตามดัชนีของสัญญาณไฟ, -1 = ไม่อยู่ในไฟล์)
+ // คืนค่า false ถ้าเขียนไม่สำเร็จ
+ bool save_signal_offsets(const SignalSystem* system, int cycle, const int* offsets, const char* path);
+ 
  // ฟังก์ชันสำหรับแสดงข้อมูลของสัญญาณไฟจราจร
  void print_traffic_signal(TrafficSignal* signal);
  
@@ -71,6 +127,11 @@
  // ฟังก์ชันสำหรับลบสัญญาณไฟจราจรและคืนหน่วยความจำ
  void free_traffic_signal(TrafficSignal* signal);
  
+ // ฟังก์ชันสำหรับสร้างสำเนาของระบบสัญญาณไฟจราจร (เฟส เวลาที่เหลือ และคิวเหมือนต้นฉบับ)
+ // สำเนายังไม่มีตัวควบคุมแบบ max-pressure เพราะตัวควบคุมอ้างอิงถนนของเครือข่ายต้นฉบับ
+ // ผู้เรียกต้องติดตั้งใหม่บนสำเนาของเครือข่ายด้วย copy_max_pressure_control
+ SignalSystem* clone_signal_system(const SignalSystem* system);
+ 
  // ฟังก์ชันสำหรับลบระบบสัญญาณไฟจราจรและคืนหน่วยความจำ
  void free_signal_system(SignalSystem* system);
  
@@ -0,0 +1,13 @@
+/*
+* wall_clock.c
+* นาฬิกาแบบ monotonic สำหรับจับเวลาที่ใช้ร่วมกันทุกโมดูล
+*/
+
+#include "wall_clock.h"
+
+// ฟังก์ชันสำหรับอ่านเวลาปัจจุบันจากนาฬิกาแบบ monotonic (วินาที) สำหรับจับเวลา
+double monotonic_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
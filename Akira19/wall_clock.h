@@ -0,0 +1,10 @@
+#ifndef WALL_CLOCK_H
+#define WALL_CLOCK_H
+ 
+ #include <time.h>
+ 
+ // ฟังก์ชันสำหรับอ่านเวลาปัจจุบันจากนาฬิกาแบบ monotonic (วินาที) สำหรับจับเวลา
+ // ไม่ได้รับผลจากการปรับเวลาของระบบ จึงใช้ได้เฉพาะหาผลต่างระหว่างสองครั้งที่อ่าน
+ double monotonic_seconds(void);
+ 
+ #endif